@@ -19,22 +19,38 @@
 * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
 * OTHER DEALINGS IN THE SOFTWARE.
 */
+#include <algorithm>
+#include <map>
+#include <new>
 #include "cm_perf_statistics.h"
 #include "cm_mem.h"
 #include "cm_sdk_provider.h"
 
 #if MDF_PROFILER_ENABLED
 
-CmPerfStatistics::CmPerfStatistics()
+// Record buffer of calling thread, there is only one profiler instance in process
+static thread_local ApiCallRecordBuffer *sThreadBuffer = nullptr;
+
+struct FunctionNameLess
 {
+    bool operator()(const char *a, const char *b) const
+    {
+        return strcmp(a, b) < 0;
+    }
+};
 
-    m_apiCallRecordCount  = 0;
+CmPerfStatistics::CmPerfStatistics()
+{
     m_apiCallFile         = nullptr;
-
     m_perfStatisticFile   = nullptr;
-    m_perfStatisticCount = 0;
 
-    m_profilerOn      = false;
+    m_threadBuffers.store(nullptr);
+    m_threadBufferCount.store(0);
+
+    m_freq.QuadPart = 0;
+    QueryPerformanceFrequency(&m_freq);
+
+    m_profilerOn.store(false);
     m_profilerLevel    = CM_RT_PERF_LOG_LEVEL_DEFAULT;
 
     GetProfilerLevel(); // get profiler level from env variable "CM_RT_PERF_LOG"
@@ -48,138 +64,251 @@ CmPerfStatistics::CmPerfStatistics()
 
 CmPerfStatistics::~CmPerfStatistics()
 {
-    DumpApiCallRecords();
+    if(m_profilerOn.exchange(false))
+    {
+        std::vector<ApiCallRecord>    records;
+        std::vector<ApiPerfStatistic> statistics;
+
+        MergeApiCallRecords(records);
+        AggregatePerfStatistics(records, statistics);
 
-    DumpPerfStatisticRecords();
+        DumpApiCallRecords(records);
+        DumpPerfStatisticRecords(statistics);
+    }
+
+    ReleaseThreadBuffers();
 }
 
 void CmPerfStatistics::GetProfilerLevel()
 {   // Enabled Profiler in Debug Mode
     m_profilerLevel = CM_RT_PERF_LOG_LEVEL_RECORDS;
-    m_profilerOn   = true;
+    m_profilerOn.store(true);
     return;
 }
 
-//! Insert API Call Records Into m_apiCallRecords Array and Update Perf Statistic Array accordingly
-void CmPerfStatistics::InsertApiCallRecord(char *functionName, float time, LARGE_INTEGER start, LARGE_INTEGER end)
+ApiCallRecordBuffer *CmPerfStatistics::GetThreadBuffer()
 {
-    CLock locker(m_criticalSectionOnApiCallRecords);
-
-    ApiCallRecord *records = new ApiCallRecord ;
+    if(sThreadBuffer != nullptr)
+    {
+        return sThreadBuffer;
+    }
 
-    records->startTime = start;
-    records->endTime   = end;
-    records->duration   = time;
+    ApiCallRecordBuffer *buffer = new (std::nothrow) ApiCallRecordBuffer;
+    ApiCallRecordChunk  *chunk  = new (std::nothrow) ApiCallRecordChunk;
+    if(buffer == nullptr || chunk == nullptr)
+    {
+        CmSafeRelease(buffer);
+        CmSafeRelease(chunk);
+        return nullptr;
+    }
 
-    CM_STRCPY(records->functionName, MSG_STRING_SIZE, functionName);
+    chunk->count.store(0);
+    chunk->next.store(nullptr);
 
-    m_apiCallRecords.push_back(records);
-    m_apiCallRecordCount++;
+    buffer->threadIndex = m_threadBufferCount.fetch_add(1);
+    buffer->head        = chunk;
+    buffer->tail        = chunk;
 
-    InsertPerfStatistic(records);
+    // Push to the buffer list, the only place threads contend and only once per thread
+    ApiCallRecordBuffer *head = m_threadBuffers.load(std::memory_order_relaxed);
+    do
+    {
+        buffer->next.store(head, std::memory_order_relaxed);
+    } while(!m_threadBuffers.compare_exchange_weak(head, buffer, std::memory_order_release, std::memory_order_relaxed));
 
+    sThreadBuffer = buffer;
+    return buffer;
 }
 
-//Update Perf Statistic Array
-void CmPerfStatistics::InsertPerfStatistic(ApiCallRecord *record)
+//! Append API Call Record to the Buffer of Calling Thread
+void CmPerfStatistics::InsertApiCallRecord(const char *functionName, LARGE_INTEGER start, LARGE_INTEGER end)
 {
-    uint32_t index = 0;
-
-    for( index = 0 ; index < m_perfStatisticCount ; index ++)
+    if(!m_profilerOn.load(std::memory_order_relaxed))
     {
-        ApiPerfStatistic *perfStatisticRecords = m_perfStatisticRecords[index];
-        if(perfStatisticRecords != nullptr)
-        {
-            if(!strcmp(record->functionName, perfStatisticRecords->functionName))
-            { // existing
-               perfStatisticRecords->callTimes ++ ;
-               perfStatisticRecords->time += record->duration;
+        return;
+    }
 
-               //Update statistic records
-               m_perfStatisticRecords[index] = perfStatisticRecords;
+    ApiCallRecordBuffer *buffer = GetThreadBuffer();
+    if(buffer == nullptr)
+    {
+        return;
+    }
 
-               break;
-            }
+    ApiCallRecordChunk *chunk = buffer->tail;
+    uint32_t            count = chunk->count.load(std::memory_order_relaxed);
+    if(count == CM_PERF_RECORDS_PER_CHUNK)
+    {
+        ApiCallRecordChunk *newChunk = new (std::nothrow) ApiCallRecordChunk;
+        if(newChunk == nullptr)
+        {
+            return;
         }
+        newChunk->count.store(0, std::memory_order_relaxed);
+        newChunk->next.store(nullptr, std::memory_order_relaxed);
+
+        chunk->next.store(newChunk, std::memory_order_release);
+        buffer->tail = chunk = newChunk;
+        count        = 0;
     }
 
-    if(index == m_perfStatisticCount)
-    { // record does not exist, create new entry
-        ApiPerfStatistic *perfStatisticRecords = new ApiPerfStatistic;
-        CM_STRCPY(perfStatisticRecords->functionName, MSG_STRING_SIZE, record->functionName);
+    ApiCallRecord &record = chunk->records[count];
+    record.functionName   = functionName;
+    record.startTime      = start;
+    record.endTime        = end;
+    record.threadIndex    = buffer->threadIndex;
 
-        perfStatisticRecords->callTimes = 1;
-        perfStatisticRecords->time       = record->duration;
+    // Publish the record to the dumping thread
+    chunk->count.store(count + 1, std::memory_order_release);
+}
 
-        m_perfStatisticRecords.push_back(perfStatisticRecords);
-        m_perfStatisticCount ++;
+void CmPerfStatistics::MergeApiCallRecords(std::vector<ApiCallRecord> &records)
+{
+    for(ApiCallRecordBuffer *buffer = m_threadBuffers.load(std::memory_order_acquire);
+        buffer != nullptr;
+        buffer = buffer->next.load(std::memory_order_relaxed))
+    {
+        for(ApiCallRecordChunk *chunk = buffer->head;
+            chunk != nullptr;
+            chunk = chunk->next.load(std::memory_order_acquire))
+        {
+            uint32_t count = chunk->count.load(std::memory_order_acquire);
+            records.insert(records.end(), chunk->records, chunk->records + count);
+        }
     }
 
-    return ;
+    std::stable_sort(records.begin(), records.end(),
+        [](const ApiCallRecord &a, const ApiCallRecord &b) { return a.startTime.QuadPart < b.startTime.QuadPart; });
 }
 
-//Dump APICall Records and Release m_apiCallRecords Array
-void CmPerfStatistics::DumpApiCallRecords()
+double CmPerfStatistics::GetDurationInMs(const ApiCallRecord &record)
 {
-    if(!m_profilerOn)
+    if(m_freq.QuadPart == 0)
     {
-        return ;
+        return 0.0;
+    }
+    return (double)(record.endTime.QuadPart - record.startTime.QuadPart) * 1000.0 / (double)m_freq.QuadPart;
+}
+
+//Aggregate Records into One Perf Statistic Record per Function
+void CmPerfStatistics::AggregatePerfStatistics(const std::vector<ApiCallRecord> &records, std::vector<ApiPerfStatistic> &statistics)
+{
+    std::map<const char *, ApiPerfStatistic, FunctionNameLess> statisticMap;
+
+    for(const ApiCallRecord &record : records)
+    {
+        double duration = GetDurationInMs(record);
+
+        auto it = statisticMap.find(record.functionName);
+        if(it == statisticMap.end())
+        { // record does not exist, create new entry
+            ApiPerfStatistic statistic = {};
+            statistic.functionName = record.functionName;
+            statistic.minTime      = duration;
+            statistic.maxTime      = duration;
+            it = statisticMap.insert(std::make_pair(record.functionName, statistic)).first;
+        }
+
+        ApiPerfStatistic &statistic = it->second;
+        statistic.callTimes ++;
+        statistic.time   += duration;
+        statistic.minTime = std::min(statistic.minTime, duration);
+        statistic.maxTime = std::max(statistic.maxTime, duration);
+
+        // Bucket k holds [2^(k-1), 2^k) us, the last one holds all longer calls
+        double   us     = duration * 1000.0;
+        uint32_t bucket = 0;
+        while(bucket < CM_PERF_HISTOGRAM_BUCKETS - 1 && us >= (double)(1u << bucket))
+        {
+            bucket ++;
+        }
+        statistic.histogram[bucket] ++;
     }
 
+    for(auto &entry : statisticMap)
+    {
+        statistics.push_back(entry.second);
+    }
+}
+
+//Dump APICall Records
+void CmPerfStatistics::DumpApiCallRecords(const std::vector<ApiCallRecord> &records)
+{
     CM_FOPEN(m_apiCallFile, "CmPerfLog.csv", "wb");
     if(! m_apiCallFile )
     {
         fprintf(stdout, "Fail to create file CmPerfLog.csv \n ");
         return ;
     }
-    fprintf(m_apiCallFile,  "%-40s %s \t %s \t %s \n", "FunctionName", "StartTime", "EndTime", "Duration");
+    fprintf(m_apiCallFile,  "%-40s %s \t %s \t %s \t %s \n", "FunctionName", "Thread", "StartTime", "EndTime", "Duration");
 
-    for(uint32_t i=0 ; i< m_apiCallRecordCount ; i++)
+    for(const ApiCallRecord &record : records)
     {
-        ApiCallRecord *records = m_apiCallRecords[i];
-
-        fprintf(m_apiCallFile,  "%-40s  %lld \t %lld \t %fms \n", records->functionName,
-           records->startTime.QuadPart, records->endTime.QuadPart, records->duration);
-
-        CmSafeRelease(records);
+        fprintf(m_apiCallFile,  "%-40s  %u \t %lld \t %lld \t %fms \n", record.functionName, record.threadIndex,
+           (long long)record.startTime.QuadPart, (long long)record.endTime.QuadPart, GetDurationInMs(record));
     }
 
-    m_apiCallRecords.clear();
-
     fclose(m_apiCallFile);
+    m_apiCallFile = nullptr;
 
 }
 
-//Dump Perf Statistic Records and Release m_perfStatisticRecords Array
-void CmPerfStatistics::DumpPerfStatisticRecords()
+//Dump Perf Statistic Records with Latency Histograms
+void CmPerfStatistics::DumpPerfStatisticRecords(const std::vector<ApiPerfStatistic> &statistics)
 {
-    if(!m_profilerOn)
-    {
-        return ;
-    }
-
     CM_FOPEN(m_perfStatisticFile, "CmPerfStatistics.txt","wb");
     if(!m_perfStatisticFile )
     {
         fprintf(stdout, "Fail to create file CmPerfStatistics.txt \n ");
         return ;
     }
-    fprintf(m_perfStatisticFile,  "%-40s %s \t %s \n", "FunctionName", "Total Time(ms)", "Called Times");
-
-    for(uint32_t i=0 ; i< m_perfStatisticCount; i++)
+    fprintf(m_perfStatisticFile,  "%-40s %s \t %s \t %s \t %s \t %s", "FunctionName", "Total Time(ms)", "Called Times",
+        "Avg Time(ms)", "Min Time(ms)", "Max Time(ms)");
+    for(uint32_t bucket = 0; bucket < CM_PERF_HISTOGRAM_BUCKETS - 1; bucket ++)
     {
-        ApiPerfStatistic *perfStatisticRecords = m_perfStatisticRecords[i];
+        fprintf(m_perfStatisticFile, " \t <%uus", 1u << bucket);
+    }
+    fprintf(m_perfStatisticFile, " \t >=%uus \n", 1u << (CM_PERF_HISTOGRAM_BUCKETS - 2));
 
-        fprintf(m_perfStatisticFile,  "%-40s %fms \t %d \n", perfStatisticRecords->functionName,
-           perfStatisticRecords->time, perfStatisticRecords->callTimes);
+    uint32_t totalCalls = 0;
+    double   totalTime  = 0.0;
+    for(const ApiPerfStatistic &statistic : statistics)
+    {
+        fprintf(m_perfStatisticFile,  "%-40s %fms \t %u \t %fms \t %fms \t %fms", statistic.functionName,
+           statistic.time, statistic.callTimes, statistic.time / statistic.callTimes,
+           statistic.minTime, statistic.maxTime);
+        for(uint32_t bucket = 0; bucket < CM_PERF_HISTOGRAM_BUCKETS; bucket ++)
+        {
+            fprintf(m_perfStatisticFile, " \t %u", statistic.histogram[bucket]);
+        }
+        fprintf(m_perfStatisticFile, " \n");
 
-        CmSafeRelease(perfStatisticRecords);
+        totalCalls += statistic.callTimes;
+        totalTime  += statistic.time;
     }
-
-    m_perfStatisticRecords.clear();
+    fprintf(m_perfStatisticFile,  "%-40s %fms \t %u \n", "Total", totalTime, totalCalls);
 
     fclose(m_perfStatisticFile);
+    m_perfStatisticFile = nullptr;
 
 }
 
+void CmPerfStatistics::ReleaseThreadBuffers()
+{
+    ApiCallRecordBuffer *buffer = m_threadBuffers.exchange(nullptr);
+    while(buffer != nullptr)
+    {
+        ApiCallRecordChunk *chunk = buffer->head;
+        while(chunk != nullptr)
+        {
+            ApiCallRecordChunk *next = chunk->next.load();
+            CmSafeRelease(chunk);
+            chunk = next;
+        }
+
+        ApiCallRecordBuffer *next = buffer->next.load();
+        CmSafeRelease(buffer);
+        buffer = next;
+    }
+}
+
 #endif
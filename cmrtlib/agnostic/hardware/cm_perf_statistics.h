@@ -22,6 +22,7 @@
 #ifndef CMRTLIB_AGNOSTIC_HARDWARE_CM_PERF_STATISTICS_H_
 #define CMRTLIB_AGNOSTIC_HARDWARE_CM_PERF_STATISTICS_H_
 
+#include <atomic>
 #include <vector>
 #include <cstdio>
 #include "cm_def_hw.h"
@@ -33,19 +34,46 @@
 #define MSG_STRING_SIZE 256
 #define INIT_ARRAY_ZIE  256
 
+#define CM_PERF_RECORDS_PER_CHUNK   4096   // records preallocated per thread each time its buffer is full
+#define CM_PERF_HISTOGRAM_BUCKETS   16     // latency histogram buckets: <1us, <2us, <4us, ... , >=16384us
+
 struct ApiPerfStatistic
 {
-    char  functionName[MSG_STRING_SIZE];       // function name
-    float time;                                 // accumulative api duration
-    uint32_t callTimes;                           // called times
+    const char *functionName;                          // function name
+    double      time;                                  // accumulative api duration in ms
+    double      minTime;                               // shortest api duration in ms
+    double      maxTime;                               // longest api duration in ms
+    uint32_t    callTimes;                             // called times
+    uint32_t    histogram[CM_PERF_HISTOGRAM_BUCKETS];  // called times by duration
 };
 
 struct ApiCallRecord
 {
-    char  functionName[MSG_STRING_SIZE];       // function name
+    const char    *functionName;               // function name, must be a string literal such as __FUNCTION__
     LARGE_INTEGER  startTime;                  // start time
     LARGE_INTEGER  endTime;                    // end time
-    float          duration;                    // duration
+    uint32_t       threadIndex;                // index of the thread buffer holding the record
+};
+
+//!
+//! \brief  Chunk of preallocated API call records owned by one thread
+//!
+struct ApiCallRecordChunk
+{
+    ApiCallRecord                     records[CM_PERF_RECORDS_PER_CHUNK];
+    std::atomic<uint32_t>             count;   // records filled, published by the owner thread
+    std::atomic<ApiCallRecordChunk *> next;
+};
+
+//!
+//! \brief  API call records of one thread, only the owner thread writes to it
+//!
+struct ApiCallRecordBuffer
+{
+    uint32_t                           threadIndex;
+    ApiCallRecordChunk                *head;
+    ApiCallRecordChunk                *tail;   // chunk being filled, accessed by the owner thread only
+    std::atomic<ApiCallRecordBuffer *> next;   // next buffer in the list of all threads
 };
 
 enum PerfLogLevel
@@ -55,6 +83,12 @@ enum PerfLogLevel
     CM_RT_PERF_LOG_LEVEL_RECORDS = 2 , // records each call in m_log_file ;  generate etw logs ; dump statistics results
 };
 
+//!
+//! \brief  Profiler of CM runtime APIs
+//! \details Each thread appends its API call records to its own preallocated buffer without
+//!          any lock. Buffers of all threads are merged and aggregated when the records are dumped.
+//!          Only one instance is expected, i.e. gCmPerfStatistics.
+//!
 class CmPerfStatistics
 {
 public:
@@ -63,25 +97,16 @@ public:
 
     //!
     //! \brief    Insert API call record 
-    //! \details  Insert API call record which contains function name, start time, end and duration.
+    //! \details  Insert API call record which contains function name, start time and end time
+    //!           into the buffer of calling thread.
     //! \param    [in] functionName
-    //!           pointer to function name's string
-    //! \param    [in] time
-    //!           function's duration
+    //!           pointer to function name's string, which must outlive the profiler
     //! \param    [in] start
     //!           function's start time
     //! \param    [in] end
     //!           function's end time
     //!
-    void InsertApiCallRecord(char *functionName, float time, LARGE_INTEGER start, LARGE_INTEGER end);
-
-    //!
-    //! \brief    Insert API call record into performace statistic record
-    //! \details  Insert API call record into performace statistic record.
-    //! \param    [in] pRecords
-    //!           pointer to API call record
-    //!
-    void InsertPerfStatistic(ApiCallRecord *records);
+    void InsertApiCallRecord(const char *functionName, LARGE_INTEGER start, LARGE_INTEGER end);
 
 private:
 
@@ -91,33 +116,63 @@ private:
     //!
     void GetProfilerLevel();
 
+    //!
+    //! \brief    Get the record buffer of calling thread
+    //! \details  Buffer is created and added to the buffer list at the first call of each thread.
+    //! \return   ApiCallRecordBuffer*
+    //!           nullptr if out of memory
+    //!
+    ApiCallRecordBuffer *GetThreadBuffer();
+
+    //!
+    //! \brief    Merge the records of all threads in the order of start time
+    //! \param    [out] records
+    //!           merged records
+    //!
+    void MergeApiCallRecords(std::vector<ApiCallRecord> &records);
+
+    //!
+    //! \brief    Aggregate API call records into performace statistic records
+    //! \param    [in] records
+    //!           merged records
+    //! \param    [out] statistics
+    //!           one statistic record per function
+    //!
+    void AggregatePerfStatistics(const std::vector<ApiCallRecord> &records, std::vector<ApiPerfStatistic> &statistics);
+
+    //!
+    //! \brief    Convert duration of record to ms
+    //!
+    double GetDurationInMs(const ApiCallRecord &record);
+
     //!
     //! \brief    Dump API call records into file
     //! \details  Dump API call records into file, 
     //!           "CmPerfLog.csv" under app's location.
     //!
-    void DumpApiCallRecords();
+    void DumpApiCallRecords(const std::vector<ApiCallRecord> &records);
 
     //!
     //! \brief    Dump API call statistic records into file
-    //! \details  Dump API call statistic records into file, 
-    //!           "CmPerfStatistics" under app's location.
+    //! \details  Dump API call statistic records with latency histograms into file, 
+    //!           "CmPerfStatistics.txt" under app's location.
     //!
-    void DumpPerfStatisticRecords();
+    void DumpPerfStatisticRecords(const std::vector<ApiPerfStatistic> &statistics);
 
-    CSync           m_criticalSectionOnApiCallRecords;
-    uint32_t        m_apiCallRecordCount;
-    FILE           *m_apiCallFile;
+    //!
+    //! \brief    Free the record buffers of all threads
+    //!
+    void ReleaseThreadBuffers();
 
-    CSync           m_criticalSectionOnPerfStatisticRecords;
+    FILE           *m_apiCallFile;
     FILE           *m_perfStatisticFile;
-    uint32_t        m_perfStatisticCount;
 
-    std::vector<ApiCallRecord*>      m_apiCallRecords;  // array to store api call records
-    std::vector<ApiPerfStatistic*>   m_perfStatisticRecords; // array to store perf statistic information
+    std::atomic<ApiCallRecordBuffer *> m_threadBuffers;     // list of record buffers of all threads
+    std::atomic<uint32_t>              m_threadBufferCount;
+    LARGE_INTEGER                      m_freq;              // frequency of the counter used for start and end time
 
-    PerfLogLevel m_profilerLevel; // profiler level
-    bool m_profilerOn;   // profiler on or off
+    PerfLogLevel       m_profilerLevel; // profiler level
+    std::atomic<bool>  m_profilerOn;    // profiler on or off
 
 private:
     CmPerfStatistics(const CmPerfStatistics &other);
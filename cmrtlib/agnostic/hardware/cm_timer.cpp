@@ -28,12 +28,8 @@
 extern CmPerfStatistics gCmPerfStatistics;
 
 CmTimer::CmTimer(const char *functionName):
-    m_cycles(0),
-    m_funcName(const_cast<char*>(functionName))
+    m_funcName(functionName)
 {
-    //Get frequency
-    QueryPerformanceFrequency(&m_freq);
-
     // initialize private variables
     m_start.QuadPart = 0;
     m_end.QuadPart   = 0;
@@ -47,8 +43,7 @@ CmTimer::CmTimer(const char *functionName):
 CmTimer::~CmTimer()
 {
     Stop();
-    gCmPerfStatistics.InsertApiCallRecord(m_funcName, GetTimeinMs(), m_start,
-                                          m_end);
+    gCmPerfStatistics.InsertApiCallRecord(m_funcName, m_start, m_end);
 }
 
 void CmTimer::Start()
@@ -61,14 +56,8 @@ void CmTimer::Start()
 void CmTimer::Stop()
 {
     QueryPerformanceCounter(&m_end);
-    m_cycles = m_end.QuadPart - m_start.QuadPart;
     InsertEventEndFlag();
     return;
 }
 
-float CmTimer::GetTimeinMs()
-{
-    return (float)m_cycles * (float)1000.0 / (float)m_freq.QuadPart;
-}
-
 #endif  // #if MDF_PROFILER_ENABLED
@@ -41,21 +41,15 @@ private:
 
     void Stop();
 
-    float GetTimeinMs();
-
     void InsertEventStartFlag();
 
     void InsertEventEndFlag();
 
-    uint64_t m_cycles;
-
     LARGE_INTEGER m_start;
 
     LARGE_INTEGER m_end;
 
-    LARGE_INTEGER m_freq;
-
-    char *m_funcName;
+    const char *m_funcName;
 };
 
 #endif  // #if MDF_PROFILER_ENABLED
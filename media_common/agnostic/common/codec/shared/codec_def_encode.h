@@ -123,6 +123,7 @@ struct EncoderParams
     uint32_t                        uiSlcStructCaps                 = 0;                        //!< [AVC] Slice capability information, formatted as CODEC_SLICE_STRUCTS
     bool                            bMADEnabled                     = false;                    //!< MAD is enabled
     bool                            bMbQpDataEnabled                = false;                    //!< [AVC & MPEG2] Indicates that psMbQpDataSurface is present.
+    bool                            bMbQpDataUnchanged              = false;                    //!< [HEVC] Indicates that psMbQpDataSurface is known to be unchanged since previous frame.
     bool                            bMbDisableSkipMapEnabled        = false;                    //!< [AVC] Indicates that psMbDisableSkipMapSurface is present.
     bool                            bReportStatisticsEnabled        = false;                    //!< [HEVC] Indicates whether statistic reporting is enabled, disabled by default.
     bool                            bQualityImprovementEnable       = false;                    //!< [HEVC] Indicates whether quality improvement is enabled, disabled by default.
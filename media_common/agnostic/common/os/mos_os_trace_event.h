@@ -287,6 +287,7 @@ typedef enum _MEDIA_EVENT
     EVENT_ENCODE_DDI_11_CHECKFORMAT,               //! event for Encode check format
     EVENT_ENCODE_DDI_11_GETCONFIGCOUNT,            //! event for Encode get config count
     EVENT_ENCODE_DDI_11_GETCONFIG,                 //! event for Encode get config
+    EVENT_OCA_SUBMISSION_HISTORY,                  //! event for OCA submission history dump
 } MEDIA_EVENT;
 
 typedef enum _MEDIA_EVENT_TYPE
@@ -61,6 +61,8 @@
 
 #define __MEDIA_USER_FEATURE_VALUE_ENABLE_HCP_SCALABILITY_DECODE        "Enable HCP Scalability Decode"
 #define __MEDIA_USER_FEATURE_VALUE_ENABLE_VEBOX_SCALABILITY_MODE        "Enable Vebox Scalability"
+#define __MEDIA_USER_FEATURE_VALUE_DISABLE_VDBOX_LOAD_AWARE_SCHEDULING  "Disable VDBox Load Aware Scheduling"
+#define __MEDIA_USER_FEATURE_VALUE_ENABLE_GMM_RESINFO_CACHE             "Enable GMM Resource Info Cache"
 
 #if (_DEBUG || _RELEASE_INTERNAL)
 
@@ -353,6 +355,7 @@
 #define __VPHAL_ENABLE_VEBOX_MMC_DECOMPRESS                                     "Enable Vebox Decompress"
 
 #define __MEDIA_USER_FEATURE_VALUE_NULLHW_ENABLE                                "NULL HW Enable"
+#define __MEDIA_USER_FEATURE_VALUE_NULLHW_CPU_REPORT                            "NULL HW CPU Report"
 #define __MEDIA_USER_FEATURE_VALUE_MOCKADAPTOR_PLATFORM                         "MockAdaptor Platform"
 #define __MEDIA_USER_FEATURE_VALUE_MOCKADAPTOR_STEPPING                         "MockAdaptor Stepping"
 #define __MEDIA_USER_FEATURE_VALUE_MOCKADAPTOR_DEVICE                           "MockAdaptor Device ID"
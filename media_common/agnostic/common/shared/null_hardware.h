@@ -36,6 +36,29 @@ public:
     NullHW() = delete;
     ~NullHW() = delete;
 
+    //!
+    //! \brief  Driver layers the CPU cost is accounted to when NULL Hardware enabled
+    //!
+    enum Layer
+    {
+        LayerDdi = 0,
+        LayerHal,
+        LayerMos,
+        LayerNum
+    };
+
+    //!
+    //! \brief  CPU cost of one layer
+    //!
+    struct LayerCost
+    {
+        uint64_t cpuTime         = 0;  //!< Time in us spent in the layer, excluding nested layers
+        uint64_t calls           = 0;  //!< Entries into the layer from another layer
+        uint64_t allocations     = 0;  //!< MOS memory allocations made in the layer
+        uint64_t lockContentions = 0;  //!< Contended mutex locks in the layer
+        uint64_t lockWaitTime    = 0;  //!< Time in us blocked on contended locks in the layer
+    };
+
     //!
     //! \brief    Interface for initializing NULL Hardware.
     //! \details  Interface for initializing NULL Hardware.
@@ -121,8 +144,82 @@ public:
     //!
     static bool IsEnabled() { return m_enabled; }
 
+    //!
+    //! \brief    Enter a driver layer.
+    //! \details  The time, allocations and lock contentions since the last layer
+    //!           transition of the calling thread are charged to the layer being
+    //!           left. Allocation and contention counters are process wide, so
+    //!           the split is exact only for single threaded submission.
+    //! \param    [in] layer
+    //!           Layer entered.
+    //! \return   void
+    //!
+    static void EnterLayer(Layer layer);
+
+    //!
+    //! \brief    Exit the layer last entered by the calling thread.
+    //! \return   void
+    //!
+    static void ExitLayer();
+
+    //!
+    //! \brief    Mark the end of a frame.
+    //! \details  Logs the cost of each layer since the previous frame end.
+    //! \return   void
+    //!
+    static void FrameEnd();
+
+    //!
+    //! \brief    Get the cost accounted to a layer since NULL Hardware enabled.
+    //! \param    [in] layer
+    //!           Layer to query.
+    //! \param    [out] cost
+    //!           Cost of the layer.
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    static MOS_STATUS GetLayerCost(Layer layer, LayerCost &cost);
+
+    //!
+    //! \brief    Report the total and per frame cost of each layer.
+    //! \details  Written to the file set by "NULL HW CPU Report", or to the log
+    //!           if not set.
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    static MOS_STATUS ReportCost();
+
 private:
     static bool m_initilized;
     static bool m_enabled;
 };
+
+//!
+//! \brief  Accounts the CPU cost of the enclosing scope to a layer when NULL Hardware enabled
+//!
+class NullHWLayerScope
+{
+public:
+    NullHWLayerScope(NullHW::Layer layer)
+    {
+        if (NullHW::IsEnabled())
+        {
+            NullHW::EnterLayer(layer);
+            m_entered = true;
+        }
+    }
+
+    ~NullHWLayerScope()
+    {
+        if (m_entered)
+        {
+            NullHW::ExitLayer();
+        }
+    }
+
+private:
+    bool m_entered = false;
+};
+
+#define NULLHW_LAYER_SCOPE(layer) NullHWLayerScope nullHwLayerScope(layer)
 #endif
\ No newline at end of file
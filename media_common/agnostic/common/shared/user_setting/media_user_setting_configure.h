@@ -169,7 +169,7 @@ public:
     inline bool IsDefinitionExist(const std::string &itemName)
     {
         bool ret = false;
-        for (auto defs : m_definitions)
+        for (auto &defs : m_definitions)
         {
             auto it = defs.find(MakeHash(itemName));
             if (it != defs.end())
@@ -198,6 +198,34 @@ public:
         return m_definitions[group];
     }
 protected:
+    //!
+    //! \brief    Read value of specific item from env variable or registry
+    //! \param    [out] value
+    //!           The return value of the item, unchanged if failed
+    //! \param    [in] itemName
+    //!           Name of the item
+    //! \param    [in] path
+    //!           Registry path of the item
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if the item is set, otherwise failed reason
+    //!
+    MOS_STATUS ReadFromSource(
+        Value &value,
+        const std::string &itemName,
+        const std::string &path);
+
+    //!
+    //! \brief    Resolve value of internal item and publish it as snapshot
+    //! \param    [in] def
+    //!           Definition of the item
+    //! \param    [in] itemName
+    //!           Name of the item
+    //! \return   Definition::SnapshotPtr
+    //!           The published snapshot, nullptr if failed
+    //!
+    Definition::SnapshotPtr ResolveSnapshot(
+        const std::shared_ptr<Definition> &def,
+        const std::string &itemName);
 
     //!
     //! \brief    Get hash value of specific string
@@ -214,6 +242,7 @@ protected:
 
 protected:
     MosMutex m_mutexLock; //!< mutex for protecting definitions
+    MosMutex m_snapshotLock; //!< mutex for serializing snapshot publish and invalidate
     Definitions m_definitions[Group::MaxCount]{}; //!< definitions of media user setting
     bool m_isDebugMode = false; //!< whether in debug/release-internal mode
     RegBufferMap m_regBufferMap{};
@@ -58,6 +58,18 @@ namespace Internal {
 class Definition
 {
 public:
+    //!
+    //! \brief   Resolved value of the item
+    //! \details Published once resolved from env variable or registry. A published
+    //!          snapshot is never modified, readers can use it without lock.
+    //!
+    struct Snapshot
+    {
+        MOS_STATUS status = MOS_STATUS_SUCCESS; //!< Resolve status, success if the value is set in env or registry
+        Value      value{};                     //!< Resolved value, valid only if status is success
+    };
+    using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
     //!
     //! \brief    Constructor
     //! \param    [in] itemName
@@ -149,6 +161,36 @@ public:
     //!           the custom path
     //!
     bool UseStatePath() const { return m_statePath; }
+
+    //!
+    //! \brief    Get the published snapshot of the item
+    //! \details  The returned snapshot stays valid while the caller holds it, even
+    //!           if it is invalidated or replaced meanwhile.
+    //! \return   SnapshotPtr
+    //!           the snapshot, nullptr if the item is not resolved yet or invalidated
+    //!
+    SnapshotPtr GetSnapshot() const { return std::atomic_load(&m_snapshot); }
+
+    //!
+    //! \brief    Publish the resolved value of the item
+    //! \details  Caller must serialize publish and invalidate calls. The previous
+    //!           snapshot is freed once the last reader holding it drops it.
+    //! \param    [in] status
+    //!           Resolve status
+    //! \param    [in] value
+    //!           Resolved value
+    //! \return   SnapshotPtr
+    //!           the published snapshot, nullptr if out of memory
+    //!
+    SnapshotPtr PublishSnapshot(MOS_STATUS status, const Value &value);
+
+    //!
+    //! \brief    Invalidate the published snapshot, next read resolves the item again
+    //! \details  Caller must serialize publish and invalidate calls.
+    //! \return   void
+    //!
+    void InvalidateSnapshot() { std::atomic_store(&m_snapshot, SnapshotPtr()); }
+
 private:
     //!
     //! \brief    Set the values of definition
@@ -165,6 +207,8 @@ private:
     std::string m_subPath{};    //!< custome path is a relative path, it could be null
     UFKEY_NEXT m_rootKey{};    //!< root key
     bool m_statePath      = true;    //!< Whether the item read from a specific path
+
+    SnapshotPtr m_snapshot{};   //!< Current published snapshot, only accessed through std::atomic_load/store
 };
 
 using Definitions = std::map<std::size_t, std::shared_ptr<Definition>>;
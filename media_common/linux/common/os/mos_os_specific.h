@@ -578,6 +578,7 @@ struct _MOS_OS_CONTEXT
     //For 2VD box
     int32_t             bKMDHasVCS2;
     bool                bPerCmdBufferBalancing;
+    bool                bVdboxLoadAware = false;    //!< Place sessions and unbound command buffers by VDBox load
     int32_t             semid;
     int32_t             shmid;
     void                *pShm;
@@ -123,6 +123,8 @@ public:
 
     int32_t Query();
 
+    int32_t WaitForFlushedTask(uint32_t timeOutMs);
+
     CM_STATUS GetStatusWithoutFlush();
 
 #if CM_LOG_ON
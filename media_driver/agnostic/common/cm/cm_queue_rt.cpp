@@ -148,6 +148,7 @@ CmQueueRT::CmQueueRT(CmDeviceRT *device,
     m_syncBufferHandle(INVALID_SYNC_BUFFER_HANDLE)
 {
     MOS_ZeroMemory(&m_mosVeHintParams, sizeof(m_mosVeHintParams));
+    MOS_ZeroMemory(&m_perfStats, sizeof(m_perfStats));
     MosUtilities::MosQueryPerformanceFrequency(&m_CPUperformanceFrequency);
 }
 
@@ -157,6 +158,13 @@ CmQueueRT::CmQueueRT(CmDeviceRT *device,
 //*-----------------------------------------------------------------------------
 CmQueueRT::~CmQueueRT()
 {
+    CM_NORMALMESSAGE("Queue flushed %llu tasks, flush cpu time %llu ns, blocked %llu times for %llu ns, peak depth %d.",
+        (unsigned long long)m_perfStats.flushedTaskCount,
+        (unsigned long long)m_perfStats.flushCpuTimeNs,
+        (unsigned long long)m_perfStats.blockedWaitCount,
+        (unsigned long long)m_perfStats.blockedTimeNs,
+        m_perfStats.peakFlushedTaskDepth);
+
     m_osSyncEvent = nullptr;
     uint32_t eventArrayUsedSize = m_eventArray.GetMaxSize();
     for( uint32_t i = 0; i < eventArrayUsedSize; i ++ )
@@ -2622,6 +2630,56 @@ finish:
     return hr;
 }
 
+//*-----------------------------------------------------------------------------
+//! Block until the oldest task in flushed queue is signaled by GPU or timeout.
+//! Tasks finish in order, so it is the first one to free a flushed queue slot.
+//! The flushed task lock is only held to take a reference to the task event,
+//! so enqueue, flush and query on other threads are not blocked by the wait.
+//! Callers query the flushed queue afterwards to retire the finished tasks.
+//! OUTPUT:
+//!     CM_SUCCESS if the task is signaled or the flushed queue is empty.
+//!     CM_EXCEED_MAX_TIMEOUT if timeout.
+//!     CM_FAILURE if the task has no event to wait on.
+//*-----------------------------------------------------------------------------
+int32_t CmQueueRT::WaitForOldestFlushedTask()
+{
+    CmEventRT *event = nullptr;
+
+    m_criticalSectionFlushedTask.Acquire();
+    if( m_flushedTasks.IsEmpty() )
+    {
+        m_criticalSectionFlushedTask.Release();
+        return CM_SUCCESS;
+    }
+
+    CmTaskInternal *task = (CmTaskInternal*)m_flushedTasks.Top();
+    if( task != nullptr )
+    {
+        task->GetTaskEvent( event );
+    }
+    if( event != nullptr )
+    {
+        // The task may be popped and destroyed once the lock is released,
+        // the reference keeps its event alive until the wait returns
+        m_criticalSectionEvent.Acquire();
+        event->Acquire();
+        m_criticalSectionEvent.Release();
+    }
+    m_criticalSectionFlushedTask.Release();
+
+    if( event == nullptr )
+    {
+        return CM_FAILURE;
+    }
+
+    int32_t hr = event->WaitForFlushedTask( CM_MAX_TIMEOUT_MS );
+
+    CmEvent *eventBase = event;
+    DestroyEvent( eventBase );
+
+    return hr;
+}
+
 //*-----------------------------------------------------------------------------
 //! This is a blocking call. It will NOT return untill
 //! all tasks in GPU and all tasks in queue finishes execution.
@@ -2694,6 +2752,7 @@ int32_t CmQueueRT::CleanQueue( )
 
     while( !m_flushedTasks.IsEmpty() && status != CM_EXCEED_MAX_TIMEOUT )
     {
+        WaitForOldestFlushedTask();
         QueryFlushedTasks();
 
         LARGE_INTEGER current;
@@ -2720,6 +2779,34 @@ int32_t CmQueueRT::GetTaskCount( uint32_t& numTasks )
     return CM_SUCCESS;
 }
 
+//*-----------------------------------------------------------------------------
+//| Purpose:    Get CPU side performance statistics of the queue
+//| Returns:    Result of the operation.
+//*-----------------------------------------------------------------------------
+int32_t CmQueueRT::GetPerfStatistics( CM_QUEUE_PERF_STATISTICS& stats )
+{
+    CLock Lock(m_criticalSectionPerfStats);
+
+    stats                   = m_perfStats;
+    stats.enqueuedTaskDepth = m_enqueuedTasks.GetCount();
+    stats.flushedTaskDepth  = m_flushedTasks.GetCount();
+    return CM_SUCCESS;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Get the time elapsed since startTicks in nanoseconds
+//*-----------------------------------------------------------------------------
+uint64_t CmQueueRT::ElapsedTimeNs( uint64_t startTicks )
+{
+    uint64_t endTicks = 0;
+    if ( !MosUtilities::MosQueryPerformanceCounter( &endTicks ) ||
+         m_CPUperformanceFrequency == 0 || endTicks < startTicks )
+    {
+        return 0;
+    }
+    return (uint64_t)((double)(endTicks - startTicks) * 1000000000.0 / m_CPUperformanceFrequency);
+}
+
 //*-----------------------------------------------------------------------------
 //| Purpose:   Use GPU to init Surface2D
 //| Returns:   result of operation
@@ -3331,12 +3418,24 @@ int32_t CmQueueRT::FlushTaskWithoutSync( bool flushBlocked )
         uint32_t flushedTaskCount = m_flushedTasks.GetCount();
         if ( flushBlocked )
         {
-            while( flushedTaskCount >= m_halMaxValues->maxTasks )
+            if( flushedTaskCount >= m_halMaxValues->maxTasks )
             {
-                // If the task count in flushed queue is no less than hw restrictiion,
-                // query the staus of flushed task queue. Remove any finished tasks from the queue
-                QueryFlushedTasks();
-                flushedTaskCount = m_flushedTasks.GetCount();
+                uint64_t waitStart = 0;
+                MosUtilities::MosQueryPerformanceCounter( &waitStart );
+
+                while( flushedTaskCount >= m_halMaxValues->maxTasks )
+                {
+                    // If the task count in flushed queue is no less than hw restrictiion,
+                    // block on the oldest flushed task instead of polling, then
+                    // remove any finished tasks from the queue
+                    WaitForOldestFlushedTask();
+                    QueryFlushedTasks();
+                    flushedTaskCount = m_flushedTasks.GetCount();
+                }
+
+                CLock Lock(m_criticalSectionPerfStats);
+                m_perfStats.blockedWaitCount++;
+                m_perfStats.blockedTimeNs += ElapsedTimeNs( waitStart );
             }
         }
         else
@@ -3366,6 +3465,9 @@ int32_t CmQueueRT::FlushTaskWithoutSync( bool flushBlocked )
 
         task->GetTaskType(taskType);
 
+        uint64_t flushStart = 0;
+        MosUtilities::MosQueryPerformanceCounter( &flushStart );
+
         switch(taskType)
         {
             case CM_INTERNAL_TASK_WITH_THREADSPACE:
@@ -3393,6 +3495,11 @@ int32_t CmQueueRT::FlushTaskWithoutSync( bool flushBlocked )
         {
             m_flushedTasks.Push( task );
             task->VtuneSetFlushTime(); // Record Flush Time
+
+            CLock Lock(m_criticalSectionPerfStats);
+            m_perfStats.flushedTaskCount++;
+            m_perfStats.flushCpuTimeNs      += ElapsedTimeNs( flushStart );
+            m_perfStats.peakFlushedTaskDepth = MOS_MAX( m_perfStats.peakFlushedTaskDepth, (uint32_t)m_flushedTasks.GetCount() );
         }
         else
         {
@@ -57,6 +57,20 @@ struct CM_GPUCOPY_KERNEL
     bool locked;
 };
 
+//!
+//! \brief    CPU side performance statistics of CmQueueRT
+//!
+struct CM_QUEUE_PERF_STATISTICS
+{
+    uint64_t flushedTaskCount;      // Tasks submitted to HAL
+    uint64_t flushCpuTimeNs;        // CPU time spent in submitting tasks to HAL
+    uint64_t blockedWaitCount;      // Waits for a free slot of flushed queue
+    uint64_t blockedTimeNs;         // Time blocked on waiting for a free slot of flushed queue
+    uint32_t enqueuedTaskDepth;     // Tasks enqueued and not flushed yet
+    uint32_t flushedTaskDepth;      // Tasks flushed and not finished yet
+    uint32_t peakFlushedTaskDepth;  // Peak of flushed task depth
+};
+
 class ThreadSafeQueue
 {
 public:
@@ -226,6 +240,8 @@ public:
 
     int32_t GetTaskCount(uint32_t &numTasks);
 
+    int32_t GetPerfStatistics(CM_QUEUE_PERF_STATISTICS &stats);
+
     int32_t TouchFlushedTasks();
 
     int32_t GetTaskHasThreadArg(CmKernelRT *kernelArray[],
@@ -292,6 +308,10 @@ protected:
 
     int32_t QueryFlushedTasks();
 
+    int32_t WaitForOldestFlushedTask();
+
+    uint64_t ElapsedTimeNs(uint64_t startTicks);
+
     //New sub functions for different task flush
     int32_t FlushGeneralTask(CmTaskInternal *task);
 
@@ -350,6 +370,9 @@ protected:
     uint32_t m_eventCount;
     uint64_t m_CPUperformanceFrequency;
 
+    CM_QUEUE_PERF_STATISTICS m_perfStats;
+    CSync m_criticalSectionPerfStats;    // Protect m_perfStats
+
     CmDynamicArray m_copyKernelParamArray;
     uint32_t m_copyKernelParamArrayCount;
 
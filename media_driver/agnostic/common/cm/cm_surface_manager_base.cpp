@@ -82,7 +82,7 @@ int32_t CmSurfaceManagerBase::UpdateStateForRealDestroy(uint32_t index,
         }
     }
 
-    m_surfaceArray[index] = nullptr;
+    SetSurfaceArrayElement(index, nullptr);
 
     m_surfaceSizes[index] = 0;
 
@@ -199,6 +199,14 @@ CmSurfaceManagerBase::CmSurfaceManagerBase(CmDeviceRT* device) :
     m_garbageCollection1DSize(0),
     m_garbageCollection2DSize(0),
     m_garbageCollection3DSize(0),
+    m_gcRequested(false),
+    m_gcExit(false),
+    m_lowWaterFreeSlots(0),
+    m_allocationsSinceGc(0),
+    m_proactiveGcCount(0),
+    m_proactiveGcFreedCount(0),
+    m_blockingGcTime(0),
+    m_maxBlockingGcTime(0),
     m_latestVeboxTracker(nullptr),
     m_delayDestroyHead(nullptr),
     m_delayDestroyTail(nullptr)
@@ -213,6 +221,8 @@ CmSurfaceManagerBase::CmSurfaceManagerBase(CmDeviceRT* device) :
 //*-----------------------------------------------------------------------------
 CmSurfaceManagerBase::~CmSurfaceManagerBase()
 {
+    StopGcThread();
+
     for (uint32_t i = ValidSurfaceIndexStart(); i < m_surfaceArraySize; i++)
     {
         DestroySurfaceArrayElement(i);
@@ -228,6 +238,12 @@ CmSurfaceManagerBase::~CmSurfaceManagerBase()
     printf("Garbage collection 1D surface size: %d\n", m_garbageCollection1DSize);
     printf("Garbage collection 2D surface size: %d\n", m_garbageCollection2DSize);
     printf("Garbage collection 3D surface size: %d\n", m_garbageCollection3DSize);
+    printf("Garbage collection stall time: %llu us, max: %llu us\n",
+           (unsigned long long)m_blockingGcTime, (unsigned long long)m_maxBlockingGcTime);
+    printf("Proactive garbage collection times: %d, surfaces freed: %d\n",
+           m_proactiveGcCount, m_proactiveGcFreedCount);
+    printf("Peak surface slots occupied: %d of %d\n",
+           m_freeSlots.GetPeakOccupiedCount(), m_freeSlots.GetTotalCount());
 
     printf("\n\n");
 #endif
@@ -385,9 +401,36 @@ int32_t CmSurfaceManagerBase::Initialize( CM_HAL_MAX_VALUES halMaxValues,
     CmSafeMemSet( m_surfaceArray, 0, m_surfaceArraySize * sizeof( CmSurface* ) );
     CmSafeMemSet( m_surfaceSizes, 0, m_surfaceArraySize * sizeof( int32_t ) );
 
+    m_freeSlots.Initialize(m_surfaceArraySize, ValidSurfaceIndexStart());
+
+    // Collect garbage ahead once fewer than 1/8 of the entries are left
+    m_lowWaterFreeSlots = m_freeSlots.GetTotalCount() / 8;
+
+    StartGcThread();
+
     return CM_SUCCESS;
 }
 
+//*-----------------------------------------------------------------------------
+//| Purpose:    Set one entry of the surface array, keeping the free slot
+//|             bitmap and the occupancy counters in step
+//| Returns:    None
+//*-----------------------------------------------------------------------------
+void CmSurfaceManagerBase::SetSurfaceArrayElement(uint32_t index, CmSurface *surface)
+{
+    m_surfaceArray[index] = surface;
+
+    // Reserved entries are never handed out from the pool, and are ignored by m_freeSlots
+    if (surface)
+    {
+        m_freeSlots.Occupy(index);
+    }
+    else
+    {
+        m_freeSlots.Release(index);
+    }
+}
+
 // Sysmem based surface allocation will always use new surface entry.
 int32_t CmSurfaceManagerBase::RefreshDelayDestroySurfaces(uint32_t &freeSurfaceCount)
 {
@@ -476,6 +519,7 @@ int32_t CmSurfaceManagerBase::TouchSurfaceInPoolForDestroy()
 {
     uint32_t freeNum = 0;
     std::vector<CmQueueRT*> &pCmQueue = m_device->GetQueue();
+    uint64_t startTime = MosUtilities::MosGetCurTime();
 
     RefreshDelayDestroySurfaces(freeNum);
     if (pCmQueue.size() == 0)
@@ -504,25 +548,144 @@ int32_t CmSurfaceManagerBase::TouchSurfaceInPoolForDestroy()
 
     m_garbageCollectionTriggerTimes++;
 
+    uint64_t gcTime = MosUtilities::MosGetCurTime() - startTime;
+    m_blockingGcTime += gcTime;
+    m_maxBlockingGcTime = Max(gcTime, m_maxBlockingGcTime);
+    m_allocationsSinceGc = 0;
+
     return freeNum;
 }
 
-int32_t CmSurfaceManagerBase::GetFreeSurfaceIndexFromPool(uint32_t &freeIndex)
+//*-----------------------------------------------------------------------------
+//| Purpose:    Destroy the delayed surfaces whose tasks completed, without
+//|             waiting on tasks in flight, so that the pool rarely runs dry
+//|             and falls into the blocking TouchSurfaceInPoolForDestroy
+//| Returns:    Result of the operation.
+//*-----------------------------------------------------------------------------
+int32_t CmSurfaceManagerBase::ProactiveGarbageCollection()
 {
-    uint32_t index = ValidSurfaceIndexStart();
+    uint32_t freeNum = 0;
+    std::vector<CmQueueRT*> &queues = m_device->GetQueue();
 
-    while( ( index < m_surfaceArraySize ) && m_surfaceArray[ index ] )
+    CSync *lock = m_device->GetQueueLock();
+    lock->Acquire();
+    for (auto iter = queues.begin(); iter != queues.end(); iter++)
     {
-        index ++;
+        int32_t result = (*iter)->TouchFlushedTasks();
+        if (FAILED(result))
+        {
+            CM_ASSERTMESSAGE("Error: Flush tasks to flushed queue failure.");
+            lock->Release();
+            return result;
+        }
     }
+    lock->Release();
+
+    RefreshDelayDestroySurfaces(freeNum);
+
+    m_proactiveGcCount++;
+    m_proactiveGcFreedCount += freeNum;
+    m_allocationsSinceGc = 0;
+
+    return CM_SUCCESS;
+}
 
-    if( index >= m_surfaceArraySize )
+//*-----------------------------------------------------------------------------
+//| Purpose:    Start the thread running proactive GC off the allocation path
+//| Returns:    None
+//*-----------------------------------------------------------------------------
+void CmSurfaceManagerBase::StartGcThread()
+{
+    if (m_gcThread.joinable())
     {
-        CM_ASSERTMESSAGE("Error: Invalid surface index.");
-        return CM_FAILURE;
+        return;
     }
 
-    freeIndex = index;
+    m_gcExit = false;
+    m_gcRequested = false;
+    try
+    {
+        m_gcThread = std::thread(&CmSurfaceManagerBase::GcThreadLoop, this);
+    }
+    catch (const std::system_error &)
+    {
+        // Allocation still falls back to the blocking GC once the pool runs dry
+        CM_NORMALMESSAGE("Warning: Failed to create surface GC thread.");
+    }
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Stop the GC thread. Must not be called with the surface
+//|             creation lock held, which the GC thread may be waiting on.
+//| Returns:    None
+//*-----------------------------------------------------------------------------
+void CmSurfaceManagerBase::StopGcThread()
+{
+    if (!m_gcThread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_gcMutex);
+        m_gcExit = true;
+    }
+    m_gcCondition.notify_one();
+    m_gcThread.join();
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Run proactive GC on request of GetFreeSurfaceIndex
+//| Returns:    None
+//*-----------------------------------------------------------------------------
+void CmSurfaceManagerBase::GcThreadLoop()
+{
+    std::unique_lock<std::mutex> gcLock(m_gcMutex);
+    while (true)
+    {
+        m_gcCondition.wait(gcLock, [this] { return m_gcRequested || m_gcExit; });
+        if (m_gcExit)
+        {
+            break;
+        }
+        m_gcRequested = false;
+        gcLock.unlock();
+
+        {
+            // The surface manager is only safe to touch under the surface creation lock,
+            // which allocation holds as well, before the queue lock taken inside
+            CLock locker(*m_device->GetSurfaceCreationLock());
+            if (m_delayDestroyHead != nullptr)
+            {
+                ProactiveGarbageCollection();
+            }
+        }
+
+        gcLock.lock();
+    }
+}
+
+int32_t CmSurfaceManagerBase::GetFreeSurfaceIndexFromPool(uint32_t &freeIndex)
+{
+    if (m_freeSlots.FindFirstFree(freeIndex))
+    {
+        return CM_SUCCESS;
+    }
+
+    CM_ASSERTMESSAGE("Error: Invalid surface index.");
+    return CM_FAILURE;
+}
+
+int32_t CmSurfaceManagerBase::GetSurfacePoolStatistics(CM_SURFACE_POOL_STATISTICS &statistics)
+{
+    statistics.totalSlots            = m_freeSlots.GetTotalCount();
+    statistics.occupiedSlots         = m_freeSlots.GetOccupiedCount();
+    statistics.peakOccupiedSlots     = m_freeSlots.GetPeakOccupiedCount();
+    statistics.blockingGcCount       = m_garbageCollectionTriggerTimes;
+    statistics.blockingGcTime        = m_blockingGcTime;
+    statistics.maxBlockingGcTime     = m_maxBlockingGcTime;
+    statistics.proactiveGcCount      = m_proactiveGcCount;
+    statistics.proactiveGcFreedCount = m_proactiveGcFreedCount;
 
     return CM_SUCCESS;
 }
@@ -531,6 +694,18 @@ int32_t CmSurfaceManagerBase::GetFreeSurfaceIndex(uint32_t &freeIndex)
 {
     uint32_t index = 0;
 
+    // Let the GC thread collect garbage ahead of running out of entries,
+    // instead of stalling on tasks in flight once the pool is exhausted
+    if (++m_allocationsSinceGc >= m_proactiveGcInterval &&
+        m_freeSlots.GetFreeCount() <= m_lowWaterFreeSlots &&
+        m_delayDestroyHead != nullptr)
+    {
+        m_allocationsSinceGc = 0;
+        std::lock_guard<std::mutex> lock(m_gcMutex);
+        m_gcRequested = true;
+        m_gcCondition.notify_one();
+    }
+
     if (GetFreeSurfaceIndexFromPool(index) != CM_SUCCESS)
     {
         if (!TouchSurfaceInPoolForDestroy())
@@ -765,7 +940,7 @@ int32_t CmSurfaceManagerBase::CreateBuffer(size_t size, CM_BUFFER_TYPE type,
         return result;
     }
 
-    m_surfaceArray[ index ] = buffer;
+    SetSurfaceArrayElement(index, buffer);
     UpdateProfileFor1DSurface(index, size);
 
     if (type == CM_BUFFER_STATELESS || type == CM_BUFFER_SVM) {
@@ -905,7 +1080,7 @@ int32_t CmSurfaceManagerBase::CreateSurface2DUP(uint32_t width, uint32_t height,
         return result;
     }
 
-    m_surfaceArray[ index ] = surface;
+    SetSurfaceArrayElement(index, surface);
     m_2DUPSurfaceCount ++;
     uint32_t sizeperpixel = 1;
 
@@ -1136,7 +1311,7 @@ int32_t CmSurfaceManagerBase::CreateSampler8x8Surface(CmSurface2DRT* currentSurf
 
     if(cmSurfaceSampler8x8)
     {
-        m_surfaceArray[ index ] = cmSurfaceSampler8x8;
+        SetSurfaceArrayElement(index, cmSurfaceSampler8x8);
         cmSurfaceSampler8x8->GetIndex( sampler8x8SurfaceIndex );
         return CM_SUCCESS;
     }
@@ -1177,7 +1352,7 @@ int32_t CmSurfaceManagerBase::CreateSampler8x8SurfaceFromAlias(
         CM_ASSERTMESSAGE("Error: Falied to create sampler8x8 surface.");
         return result;
     }
-    m_surfaceArray[surface_index_value] = sampler8x8_surface;
+    SetSurfaceArrayElement(surface_index_value, sampler8x8_surface);
     sampler8x8_surface->GetIndex(sampler8x8SurfaceIndex);
     return CM_SUCCESS;
 }
@@ -1370,7 +1545,7 @@ int32_t CmSurfaceManagerBase::CreateVmeSurface( CmSurface2DRT* currentSurface,
         return result;
     }
 
-    m_surfaceArray[ index ] = cmSurfaceVme;
+    SetSurfaceArrayElement(index, cmSurfaceVme);
     cmSurfaceVme->GetIndex( vmeSurfaceIndex );
 
     return CM_SUCCESS;
@@ -1942,7 +2117,7 @@ int32_t CmSurfaceManagerBase::CreateSurface3D(uint32_t width, uint32_t height, u
         return result;
     }
 
-    m_surfaceArray[ index ] = surface3d;
+    SetSurfaceArrayElement(index, surface3d);
 
     result = UpdateProfileFor3DSurface(index, width, height, depth, format);
     if (result != CM_SUCCESS)
@@ -2101,7 +2276,7 @@ int32_t CmSurfaceManagerBase::CreateSamplerSurface(CmSurface2DRT* currentSurface
         return result;
     }
 
-    m_surfaceArray[ index ] = cmSurfaceSampler;
+    SetSurfaceArrayElement(index, cmSurfaceSampler);
     cmSurfaceSampler->GetSurfaceIndex( samplerSurfaceIndex );
 
     return CM_SUCCESS;
@@ -2138,7 +2313,7 @@ int32_t CmSurfaceManagerBase::CreateSamplerSurface(CmSurface2DUPRT* currentSurfa
         return result;
     }
 
-    m_surfaceArray[ index ] = cmSurfaceSampler;
+    SetSurfaceArrayElement(index, cmSurfaceSampler);
     cmSurfaceSampler->GetSurfaceIndex( samplerSurfaceIndex );
 
     return CM_SUCCESS;
@@ -2173,7 +2348,7 @@ int32_t CmSurfaceManagerBase::CreateSamplerSurface(CmSurface3DRT* currentSurface
         return result;
     }
 
-    m_surfaceArray[ index ] = cmSurfaceSampler;
+    SetSurfaceArrayElement(index, cmSurfaceSampler);
     cmSurfaceSampler->GetSurfaceIndex( samplerSurfaceIndex );
 
     return CM_SUCCESS;
@@ -2649,7 +2824,7 @@ int32_t CmSurfaceManagerBase::CreateSurface2D(uint32_t width, uint32_t height,
         return result;
     }
 
-    m_surfaceArray[index] = surface;
+    SetSurfaceArrayElement(index, surface);
 
     result = UpdateProfileFor2DSurface(index, width, height, format);
     if (result != CM_SUCCESS)
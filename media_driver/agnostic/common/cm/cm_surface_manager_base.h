@@ -30,13 +30,30 @@
 
 #include "cm_def.h"
 #include "cm_hal.h"
+#include "cm_surface_slot_bitmap.h"
+#include <condition_variable>
+#include <mutex>
 #include <set>
+#include <thread>
 
 typedef enum _MOS_FORMAT MOS_FORMAT;
 
 namespace CMRT_UMD
 {
 
+//! Occupancy and garbage collection counters of the surface pool
+struct CM_SURFACE_POOL_STATISTICS
+{
+    uint32_t totalSlots;            // entries of surface array available for allocation
+    uint32_t occupiedSlots;         // entries in use, including surfaces pending destroy
+    uint32_t peakOccupiedSlots;
+    uint32_t blockingGcCount;       // GC passes run with allocation stalled on tasks
+    uint64_t blockingGcTime;        // total stall of blocking GC in us
+    uint64_t maxBlockingGcTime;     // longest stall of blocking GC in us
+    uint32_t proactiveGcCount;      // GC passes run under the low water mark without waiting
+    uint32_t proactiveGcFreedCount; // surfaces destroyed by proactive GC
+};
+
 class CmDeviceRT;
 class CmSurface;
 class CmBuffer_RT;
@@ -118,12 +135,14 @@ public:
     int32_t TouchSurfaceInPoolForDestroy();
     int32_t GetFreeSurfaceIndexFromPool(uint32_t &freeIndex);
     int32_t GetFreeSurfaceIndex(uint32_t &index);
+    int32_t GetSurfacePoolStatistics(CM_SURFACE_POOL_STATISTICS &statistics);
 
     int32_t AllocateSurfaceIndex(size_t width, uint32_t height,
                                  uint32_t depth, CM_SURFACE_FORMAT format,
                                  uint32_t &index, void *pSysMem);
 
     int32_t DestroySurfaceArrayElement( uint32_t index );
+    void SetSurfaceArrayElement(uint32_t index, CmSurface *surface);
     inline int32_t GetMemorySizeOfSurfaces();
 
     int32_t GetSurfaceArraySize(uint32_t& surfaceArraySize);
@@ -197,6 +216,11 @@ protected:
 
     int32_t GetSurfaceBTIInfo();
 
+    int32_t ProactiveGarbageCollection();
+    void StartGcThread();
+    void StopGcThread();
+    void GcThreadLoop();
+
 public:
     // mamimum number of cm device allowed for creating a cm surf2d wrapper for a mos resource
     static const uint32_t MAX_DEVICE_FOR_SAME_SURF = 64;
@@ -207,6 +231,8 @@ protected:
     uint32_t m_surfaceArraySize;
 
     CmSurface** m_surfaceArray;
+    // Free entries of m_surfaceArray from ValidSurfaceIndexStart()
+    CmSurfaceSlotBitmap m_freeSlots;
     // the max index allocated in the m_SurfaceArray
     uint32_t m_maxSurfaceIndexAllocated;
     // Size of each surface in surface array
@@ -237,6 +263,21 @@ protected:
     uint32_t m_garbageCollection2DSize;
     uint32_t m_garbageCollection3DSize;
 
+    // Proactive GC is requested from the GC thread when free entries drop
+    // to the low water mark, at most once per m_proactiveGcInterval allocations
+    std::thread m_gcThread;
+    std::mutex m_gcMutex;
+    std::condition_variable m_gcCondition;
+    bool m_gcRequested;
+    bool m_gcExit;
+    uint32_t m_lowWaterFreeSlots;
+    uint32_t m_allocationsSinceGc;
+    uint32_t m_proactiveGcCount;
+    uint32_t m_proactiveGcFreedCount;
+    uint64_t m_blockingGcTime;
+    uint64_t m_maxBlockingGcTime;
+    static const uint32_t m_proactiveGcInterval = 16;
+
     CM_SURFACE_BTI_INFO m_surfaceBTIInfo;
 
     uint32_t *m_latestVeboxTracker;
@@ -0,0 +1,158 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file      cm_surface_slot_bitmap.h
+//! \brief     Contains Class CmSurfaceSlotBitmap definitions
+//!
+
+#ifndef MEDIADRIVER_COMMON_CM_CMSURFACESLOTBITMAP_H_
+#define MEDIADRIVER_COMMON_CM_CMSURFACESLOTBITMAP_H_
+
+#include <stdint.h>
+#include <vector>
+
+namespace CMRT_UMD
+{
+//! Two level bitmap of the free entries in the surface array. A bit is set
+//! in the summary for each bitmap word having a free entry, so the lowest
+//! free entry is found with two find-first-set operations.
+class CmSurfaceSlotBitmap
+{
+public:
+    //! Mark entries from firstSlot to slotCount - 1 free. Entries under
+    //! firstSlot are reserved and never handed out.
+    void Initialize(uint32_t slotCount, uint32_t firstSlot)
+    {
+        uint32_t wordCount = (slotCount + 63) / 64;
+        m_bitmap.assign(wordCount, 0);
+        m_summary.assign((wordCount + 63) / 64, 0);
+        m_slotCount         = slotCount;
+        m_firstSlot         = firstSlot;
+        m_occupiedCount     = 0;
+        m_peakOccupiedCount = 0;
+
+        for (uint32_t index = firstSlot; index < slotCount; index++)
+        {
+            MarkFree(index, true);
+        }
+    }
+
+    void Occupy(uint32_t index)
+    {
+        if (!IsManaged(index) || !IsFree(index))
+        {
+            return;
+        }
+        MarkFree(index, false);
+        m_occupiedCount++;
+        m_peakOccupiedCount = m_occupiedCount > m_peakOccupiedCount ? m_occupiedCount : m_peakOccupiedCount;
+    }
+
+    void Release(uint32_t index)
+    {
+        if (!IsManaged(index) || IsFree(index))
+        {
+            return;
+        }
+        MarkFree(index, true);
+        m_occupiedCount--;
+    }
+
+    //! Get the lowest free entry, false if all entries are occupied
+    bool FindFirstFree(uint32_t &index) const
+    {
+        for (uint32_t summary = 0; summary < m_summary.size(); summary++)
+        {
+            if (m_summary[summary] == 0)
+            {
+                continue;
+            }
+
+            uint32_t word = summary * 64 + FindFirstSetBit(m_summary[summary]);
+            index = word * 64 + FindFirstSetBit(m_bitmap[word]);
+            return true;
+        }
+        return false;
+    }
+
+    bool IsFree(uint32_t index) const
+    {
+        return index < m_slotCount && (m_bitmap[index / 64] & (1ULL << (index % 64)));
+    }
+
+    uint32_t GetTotalCount() const { return m_slotCount > m_firstSlot ? m_slotCount - m_firstSlot : 0; }
+    uint32_t GetOccupiedCount() const { return m_occupiedCount; }
+    uint32_t GetPeakOccupiedCount() const { return m_peakOccupiedCount; }
+    uint32_t GetFreeCount() const { return GetTotalCount() - m_occupiedCount; }
+
+protected:
+    bool IsManaged(uint32_t index) const
+    {
+        return index >= m_firstSlot && index < m_slotCount;
+    }
+
+    void MarkFree(uint32_t index, bool free)
+    {
+        uint32_t word = index / 64;
+        uint64_t bit  = 1ULL << (index % 64);
+
+        if (free)
+        {
+            m_bitmap[word] |= bit;
+            m_summary[word / 64] |= 1ULL << (word % 64);
+        }
+        else
+        {
+            m_bitmap[word] &= ~bit;
+            if (m_bitmap[word] == 0)
+            {
+                m_summary[word / 64] &= ~(1ULL << (word % 64));
+            }
+        }
+    }
+
+    //! Index of the lowest set bit of a non-zero word
+    static uint32_t FindFirstSetBit(uint64_t word)
+    {
+#if defined(__GNUC__)
+        return (uint32_t)__builtin_ctzll(word);
+#else
+        uint32_t bit = 0;
+        while (!(word & 1))
+        {
+            word >>= 1;
+            bit++;
+        }
+        return bit;
+#endif
+    }
+
+    std::vector<uint64_t> m_bitmap;
+    std::vector<uint64_t> m_summary;
+    uint32_t m_slotCount = 0;
+    uint32_t m_firstSlot = 0;
+    uint32_t m_occupiedCount = 0;
+    uint32_t m_peakOccupiedCount = 0;
+};
+}; //namespace
+
+#endif  // #ifndef MEDIADRIVER_COMMON_CM_CMSURFACESLOTBITMAP_H_
@@ -122,6 +122,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/cm_execution_adv.h
     ${CMAKE_CURRENT_LIST_DIR}/cm_rt_umd.h
     ${CMAKE_CURRENT_LIST_DIR}/cm_surface_manager_base.h
+    ${CMAKE_CURRENT_LIST_DIR}/cm_surface_slot_bitmap.h
     ${CMAKE_CURRENT_LIST_DIR}/cm_device_rt_base.h
     ${CMAKE_CURRENT_LIST_DIR}/cm_ish_base.h
     ${CMAKE_CURRENT_LIST_DIR}/cm_kernel_ex.h
@@ -1198,6 +1198,7 @@ MOS_STATUS CodechalDecode::Execute(void *params)
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
     
     PERF_UTILITY_AUTO(__FUNCTION__, PERF_DECODE, PERF_LEVEL_HAL);
+    NULLHW_LAYER_SCOPE(NullHW::LayerHal);
 
     CODECHAL_DECODE_FUNCTION_ENTER;
 
@@ -591,6 +591,7 @@ MOS_STATUS CodechalEncoderState::Allocate(CodechalSetting * codecHalSettings)
 MOS_STATUS CodechalEncoderState::Execute(void *params)
 {
     CODECHAL_ENCODE_FUNCTION_ENTER;
+    NULLHW_LAYER_SCOPE(NullHW::LayerHal);
 
     MOS_TraceEventExt(EVENT_CODECHAL_EXECUTE, EVENT_TYPE_START,
             &m_codecFunction, sizeof(m_codecFunction),
@@ -26,10 +26,62 @@
 #include "null_hardware.h"
 #include "mhw_mi.h"
 #include "mhw_mi_itf.h"
+#include <mutex>
+#include <string>
+#include <vector>
 
 bool  NullHW::m_initilized = false;
 bool  NullHW::m_enabled = false;
 
+//!
+//! \brief  Layers entered by a thread, and counters at its last layer transition
+//!
+struct NullHWLayerStack
+{
+    std::vector<NullHW::Layer> layers;
+    uint64_t                   time         = 0;
+    uint32_t                   allocations  = 0;
+    uint32_t                   contentions  = 0;
+    uint64_t                   waitTime     = 0;
+};
+
+static thread_local NullHWLayerStack s_layerStack;
+
+static std::mutex        s_costMutex;
+static NullHW::LayerCost s_layerCost[NullHW::LayerNum];
+static NullHW::LayerCost s_frameStartCost[NullHW::LayerNum];
+static uint32_t          s_frameCount    = 0;
+static uint64_t          s_maxFrameTime  = 0;
+static std::string       s_reportPath;
+
+static const char *s_layerNames[NullHW::LayerNum] = {"DDI", "HAL", "MOS"};
+
+//!
+//! \brief  Charge the cost since the last transition of the calling thread to its current layer
+//!
+static void NullHWChargeLayer(NullHWLayerStack &stack)
+{
+    uint64_t time        = MosUtilities::MosGetCurTime();
+    uint32_t allocations = (uint32_t)MosUtilities::m_mosMemAllocTotalCounter;
+    uint32_t contentions = (uint32_t)MosUtilities::m_mosLockContentionCounter;
+    uint64_t waitTime    = __atomic_load_n(&MosUtilities::m_mosLockWaitTime, __ATOMIC_RELAXED);
+
+    if (!stack.layers.empty())
+    {
+        std::lock_guard<std::mutex> lock(s_costMutex);
+        NullHW::LayerCost &cost = s_layerCost[stack.layers.back()];
+        cost.cpuTime         += time - stack.time;
+        cost.allocations     += allocations - stack.allocations;
+        cost.lockContentions += contentions - stack.contentions;
+        cost.lockWaitTime    += waitTime - stack.waitTime;
+    }
+
+    stack.time        = time;
+    stack.allocations = allocations;
+    stack.contentions = contentions;
+    stack.waitTime    = waitTime;
+}
+
 MOS_STATUS NullHW::Init(
     PMOS_CONTEXT osContext)
 {
@@ -52,6 +104,17 @@ MOS_STATUS NullHW::Init(
 
         if (m_enabled)
         {
+            MediaUserSetting::Value reportPath;
+            ReadUserSettingForDebug(
+                userSettingPtr,
+                reportPath,
+                __MEDIA_USER_FEATURE_VALUE_NULLHW_CPU_REPORT,
+                MediaUserSetting::Group::Device);
+            s_reportPath = reportPath.ConstString();
+
+            // Allocation and contended lock counters cost atomics on hot paths, only kept in NULL HW mode
+            MosUtilities::m_mosCostAccounting = true;
+
             eStatus = MosMockAdaptor::Init(osContext);
         }
         else
@@ -135,4 +198,131 @@ void NullHW::StatusReport(uint32_t &status, uint32_t &streamSize)
 
     status = 0;
     streamSize = 1024;
-}
\ No newline at end of file
+}
+
+void NullHW::EnterLayer(Layer layer)
+{
+    if (!m_enabled || layer >= LayerNum)
+    {
+        return;
+    }
+
+    NullHWLayerStack &stack = s_layerStack;
+    NullHWChargeLayer(stack);
+
+    if (stack.layers.empty() || stack.layers.back() != layer)
+    {
+        std::lock_guard<std::mutex> lock(s_costMutex);
+        s_layerCost[layer].calls++;
+    }
+    stack.layers.push_back(layer);
+}
+
+void NullHW::ExitLayer()
+{
+    if (!m_enabled)
+    {
+        return;
+    }
+
+    NullHWLayerStack &stack = s_layerStack;
+    if (stack.layers.empty())
+    {
+        return;
+    }
+
+    NullHWChargeLayer(stack);
+    stack.layers.pop_back();
+}
+
+void NullHW::FrameEnd()
+{
+    if (!m_enabled)
+    {
+        return;
+    }
+
+    // Charge the layer still open on this thread, so its cost lands in this frame
+    NullHWChargeLayer(s_layerStack);
+
+    std::lock_guard<std::mutex> lock(s_costMutex);
+    uint64_t frameTime = 0;
+    for (uint32_t i = 0; i < LayerNum; i++)
+    {
+        LayerCost &cost  = s_layerCost[i];
+        LayerCost &start = s_frameStartCost[i];
+        frameTime += cost.cpuTime - start.cpuTime;
+
+        MOS_OS_VERBOSEMESSAGE("NullHW frame %u %s: cpu %llu us, calls %llu, allocations %llu, lock contentions %llu, lock wait %llu us",
+            s_frameCount,
+            s_layerNames[i],
+            (unsigned long long)(cost.cpuTime - start.cpuTime),
+            (unsigned long long)(cost.calls - start.calls),
+            (unsigned long long)(cost.allocations - start.allocations),
+            (unsigned long long)(cost.lockContentions - start.lockContentions),
+            (unsigned long long)(cost.lockWaitTime - start.lockWaitTime));
+
+        start = cost;
+    }
+
+    s_maxFrameTime = MOS_MAX(s_maxFrameTime, frameTime);
+    s_frameCount++;
+}
+
+MOS_STATUS NullHW::GetLayerCost(Layer layer, LayerCost &cost)
+{
+    if (layer >= LayerNum)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    std::lock_guard<std::mutex> lock(s_costMutex);
+    cost = s_layerCost[layer];
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS NullHW::ReportCost()
+{
+    if (!m_enabled)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    std::string report;
+    char        line[256];
+    {
+        std::lock_guard<std::mutex> lock(s_costMutex);
+        uint32_t frames = MOS_MAX(s_frameCount, 1);
+
+        MOS_SecureStringPrint(line, sizeof(line), sizeof(line),
+            "frames %u, max frame cpu %llu us\n",
+            s_frameCount, (unsigned long long)s_maxFrameTime);
+        report += line;
+        MOS_SecureStringPrint(line, sizeof(line), sizeof(line),
+            "layer, cpu us, cpu us/frame, calls/frame, allocations/frame, lock contentions/frame, lock wait us/frame\n");
+        report += line;
+
+        for (uint32_t i = 0; i < LayerNum; i++)
+        {
+            LayerCost &cost = s_layerCost[i];
+            MOS_SecureStringPrint(line, sizeof(line), sizeof(line),
+                "%s, %llu, %.2f, %.2f, %.2f, %.2f, %.2f\n",
+                s_layerNames[i],
+                (unsigned long long)cost.cpuTime,
+                (double)cost.cpuTime / frames,
+                (double)cost.calls / frames,
+                (double)cost.allocations / frames,
+                (double)cost.lockContentions / frames,
+                (double)cost.lockWaitTime / frames);
+            report += line;
+        }
+    }
+
+    if (s_reportPath.empty())
+    {
+        MOS_OS_NORMALMESSAGE("NullHW CPU cost:\n%s", report.c_str());
+        return MOS_STATUS_SUCCESS;
+    }
+
+    return MosUtilities::MosWriteFileFromPtr(s_reportPath.c_str(), (void *)report.c_str(), (uint32_t)report.size());
+}
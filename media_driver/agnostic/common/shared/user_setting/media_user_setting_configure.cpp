@@ -130,15 +130,14 @@ MOS_STATUS Configure::Read(Value &value,
     bool useCustomValue,
     uint32_t option)
 {
-    int32_t ret = 0;
-
     auto &defs = GetDefinitions(group);
 
-    auto def = defs[MakeHash(valueName)];
-    if (def == nullptr)
+    auto it = defs.find(MakeHash(valueName));
+    if (it == defs.end() || it->second == nullptr)
     {
         return MOS_STATUS_INVALID_HANDLE;
     }
+    auto &def = it->second;
 
     if (def->IsDebugOnly() && !m_isDebugMode)
     {
@@ -146,8 +145,47 @@ MOS_STATUS Configure::Read(Value &value,
         return MOS_STATUS_SUCCESS;
     }
 
-    std::string path = GetReadPath(def, option);
+    MOS_STATUS status = MOS_STATUS_UNKNOWN;
+
+    // Internal items are resolved once, then read from the snapshot without lock.
+    // Debug only items may be changed at runtime for debugging, they are read every time.
+    if (option == MEDIA_USER_SETTING_INTERNAL && !def->IsDebugOnly())
+    {
+        Definition::SnapshotPtr snapshot = def->GetSnapshot();
+        if (snapshot == nullptr)
+        {
+            snapshot = ResolveSnapshot(def, valueName);
+        }
+
+        if (snapshot == nullptr)
+        {
+            status = ReadFromSource(value, valueName, GetReadPath(def, option));
+        }
+        else
+        {
+            status = snapshot->status;
+            if (status == MOS_STATUS_SUCCESS)
+            {
+                value = snapshot->value;
+            }
+        }
+
+        if (status != MOS_STATUS_SUCCESS)
+        {
+            value = useCustomValue ? customValue : def->DefaultValue();
+        }
+
+        return status;
+    }
+
+    return ReadFromSource(value, valueName, GetReadPath(def, option));
+}
 
+MOS_STATUS Configure::ReadFromSource(
+    Value &value,
+    const std::string &valueName,
+    const std::string &path)
+{
     UFKEY_NEXT  key      = {};
     std::string strValue = "";
     uint32_t    size     = MOS_USER_CONTROL_MAX_DATA_SIZE;
@@ -156,7 +194,7 @@ MOS_STATUS Configure::Read(Value &value,
     // read env variable first, if env value is set, return
     // else read the reg keys
     MOS_STATUS status = MosUtilities::MosReadEnvVariable(key, valueName, &type, strValue, &size);
- 
+
     if (status == MOS_STATUS_SUCCESS)
     {
         value = strValue;
@@ -164,7 +202,7 @@ MOS_STATUS Configure::Read(Value &value,
     }
 
     status = MosUtilities::MosOpenRegKey(m_rootKey, path, KEY_READ, &key, m_regBufferMap);
-    
+
     if (status == MOS_STATUS_SUCCESS)
     {
         strValue = "";
@@ -182,12 +220,27 @@ MOS_STATUS Configure::Read(Value &value,
         MosUtilities::MosCloseRegKey(key);
     }
 
-    if (status != MOS_STATUS_SUCCESS && option == MEDIA_USER_SETTING_INTERNAL)
+    return status;
+}
+
+Definition::SnapshotPtr Configure::ResolveSnapshot(
+    const std::shared_ptr<Definition> &def,
+    const std::string &valueName)
+{
+    m_snapshotLock.Lock();
+
+    // another thread may have resolved it while waiting for the lock
+    Definition::SnapshotPtr snapshot = def->GetSnapshot();
+    if (snapshot == nullptr)
     {
-        value = useCustomValue ? customValue : def->DefaultValue();
+        Value      value;
+        MOS_STATUS status = ReadFromSource(value, valueName, GetReadPath(def, MEDIA_USER_SETTING_INTERNAL));
+        snapshot          = def->PublishSnapshot(status, value);
     }
 
-    return status;
+    m_snapshotLock.Unlock();
+
+    return snapshot;
 }
 
 MOS_STATUS Configure::Write(
@@ -199,11 +252,12 @@ MOS_STATUS Configure::Write(
 {
     auto &defs = GetDefinitions(group);
 
-    auto def = defs[MakeHash(valueName)];
-    if (def == nullptr)
+    auto it = defs.find(MakeHash(valueName));
+    if (it == defs.end() || it->second == nullptr)
     {
         return MOS_STATUS_INVALID_HANDLE;
     }
+    auto &def = it->second;
 
     if (def->IsDebugOnly() && !m_isDebugMode)
     {
@@ -256,6 +310,14 @@ MOS_STATUS Configure::Write(
     }
     m_mutexLock.Unlock();
 
+    if (!isForReport && option == MEDIA_USER_SETTING_INTERNAL && GetReadPath(def, option) == path)
+    {
+        // the modified value is visible to the next read only if it is written to the read path
+        m_snapshotLock.Lock();
+        def->InvalidateSnapshot();
+        m_snapshotLock.Unlock();
+    }
+
     if (status != MOS_STATUS_SUCCESS)
     {
         // When any fail happen, just print out a critical message, but not return error to break normal call sequence.
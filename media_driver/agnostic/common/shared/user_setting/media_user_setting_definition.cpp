@@ -24,6 +24,7 @@
 //! \brief    User setting definition
 //!
 
+#include <new>
 #include "media_user_setting_definition.h"
 
 namespace MediaUserSetting {
@@ -67,6 +68,21 @@ inline Definition& Definition::operator=(const Definition& def)
     return *this;
 }
 
+Definition::SnapshotPtr Definition::PublishSnapshot(MOS_STATUS status, const Value &value)
+{
+    std::shared_ptr<Snapshot> snapshot(new (std::nothrow) Snapshot);
+    if (snapshot == nullptr)
+    {
+        return nullptr;
+    }
+    snapshot->status = status;
+    snapshot->value  = value;
+
+    std::atomic_store(&m_snapshot, SnapshotPtr(snapshot));
+
+    return snapshot;
+}
+
 inline void Definition::SetData(const Definition& def)
 {
     m_itemName = def.m_itemName;
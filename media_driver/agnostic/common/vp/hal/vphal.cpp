@@ -625,6 +625,7 @@ MOS_STATUS VphalState::Render(
 {
     MOS_STATUS          eStatus;
     VPHAL_RENDER_PARAMS RenderParams;
+    NULLHW_LAYER_SCOPE(NullHW::LayerHal);
 
     VPHAL_PUBLIC_CHK_NULL(pcRenderParams);
     RenderParams    = *pcRenderParams;
@@ -83,10 +83,10 @@ CM_RT_API int32_t CmEventRT::WaitForTaskFinished(uint32_t timeOutMs)
     if( m_status == CM_STATUS_FINISHED )
         goto finish;
 
-    //Make sure task flushed
+    //Make sure task flushed, blocking on the oldest flushed task if the flushed queue is full
     while ( m_status == CM_STATUS_QUEUED )
     {
-        m_queue->FlushTaskWithoutSync();  //Flush none if 1st task NOT finished yet
+        m_queue->FlushTaskWithoutSync(true);
     }
 
     CM_ASSERT(m_osData != nullptr);
@@ -117,6 +117,59 @@ finish:
     return result;
 }
 
+//*-----------------------------------------------------------------------------
+//! Block until the flushed task is signaled by KMD.
+//! Unlike WaitForTaskFinished, the queue is not flushed and no queue lock is
+//! needed. The status is not updated here, since the task may be destroyed by
+//! another thread meanwhile; callers query the flushed tasks afterwards.
+//! INPUT:
+//!     Timeout in Milliseconds
+//! OUTPUT:
+//!     CM_SUCCESS:  if the task is signaled or not in flight
+//!     CM_EXCEED_MAX_TIMEOUT:  if timeout in synchoinization system call.
+//*-----------------------------------------------------------------------------
+int32_t CmEventRT::WaitForFlushedTask(uint32_t timeOutMs)
+{
+    MOS_LINUX_BO *buffer_object = nullptr;
+
+    // Query unreferences the bo once the task finishes, so reference it under the same lock
+    m_criticalSectionQuery.Acquire();
+    if ((m_status == CM_STATUS_FLUSHED || m_status == CM_STATUS_STARTED) && !m_osSignalTriggered)
+    {
+        buffer_object = reinterpret_cast<MOS_LINUX_BO*>(m_osData);
+        if (buffer_object != nullptr)
+        {
+            mos_bo_reference(buffer_object);
+        }
+        else
+        {
+            m_criticalSectionQuery.Release();
+            CM_ASSERTMESSAGE("Error: Flushed task has no batch buffer to wait on.");
+            return CM_NULL_POINTER;
+        }
+    }
+    m_criticalSectionQuery.Release();
+
+    if (buffer_object == nullptr)
+    {
+        return CM_SUCCESS;
+    }
+
+    int result = mos_gem_bo_wait(buffer_object, 1000000LL*timeOutMs);
+    mos_gem_bo_clear_relocs(buffer_object, 0);
+    mos_bo_unreference(buffer_object);
+    if (result != 0)
+    {
+        return CM_EXCEED_MAX_TIMEOUT;
+    }
+
+    m_criticalSectionQuery.Acquire();
+    m_osSignalTriggered = true;
+    m_criticalSectionQuery.Release();
+
+    return CM_SUCCESS;
+}
+
 //*-----------------------------------------------------------------------------
 //! Unreference the bo in linux.
 //! INPUT:
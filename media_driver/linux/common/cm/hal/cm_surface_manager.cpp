@@ -159,7 +159,7 @@ CmSurfaceManager::~CmSurfaceManager() {}
         return result;
     }
 
-    m_surfaceArray[ index ] = surface;
+    SetSurfaceArrayElement(index, surface);
     UpdateProfileFor2DSurface(index, width, height, format);
 
     return CM_SUCCESS;
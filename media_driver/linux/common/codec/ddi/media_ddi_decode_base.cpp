@@ -118,6 +118,8 @@ VAStatus DdiMediaDecode::ParseProcessingBuffer(
 
         DDI_CHK_NULL(surface, "Null surface in Processing buffer", VA_STATUS_ERROR_INVALID_PARAMETER)
 
+        m_ddiDecodeCtx->pDecProcOutputRT = surface;
+
         DdiMedia_MediaSurfaceToMosResource(surface, &(decProcessingSurface->OsResource));
 
         decProcessingSurface->dwWidth  = decProcessingSurface->OsResource.iWidth;
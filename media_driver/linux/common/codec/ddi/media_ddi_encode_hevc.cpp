@@ -232,6 +232,8 @@ VAStatus DdiEncodeHevc::RenderPicture(VADriverContextP ctx, VAContextID context,
             continue;
         }
         uint32_t dataSize = buf->iSize;
+        // Write sequence number before the map below, which counts as a write too
+        uint32_t writeSeq = buf->uiWriteSeq;
         // can use internal function instead of DdiMedia_MapBuffer here?
         void *data = nullptr;
         DdiMedia_MapBuffer(ctx, buffers[i], &data);
@@ -278,6 +280,9 @@ VAStatus DdiEncodeHevc::RenderPicture(VADriverContextP ctx, VAContextID context,
         case VAEncQPBufferType:
             DdiMedia_MediaBufferToMosResource(buf, &m_encodeCtx->resMBQpBuffer);
             m_encodeCtx->bMBQpEnable = true;
+            // The app has to create or map the QP buffer to update it, either gives it a new write sequence number
+            m_encodeCtx->bMBQpUnchanged = writeSeq != 0 && writeSeq == m_encodeCtx->uiMBQpWriteSeq;
+            m_encodeCtx->uiMBQpWriteSeq = buf->uiWriteSeq;
             break;
 
         default:
@@ -348,6 +353,7 @@ VAStatus DdiEncodeHevc::EncodeInCodecHal(uint32_t numSlices)
 
         encodeParams.psMbQpDataSurface = &mbQpSurface;
         encodeParams.bMbQpDataEnabled  = true;
+        encodeParams.bMbQpDataUnchanged = m_encodeCtx->bMBQpUnchanged;
     }
 
     PCODEC_HEVC_ENCODE_SEQUENCE_PARAMS hevcSeqParams = (PCODEC_HEVC_ENCODE_SEQUENCE_PARAMS)((uint8_t *)m_encodeCtx->pSeqParams);
@@ -29,6 +29,7 @@
 #include <sys/mman.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
+#include <vector>
 
 #include "media_libva_decoder.h"
 #include "media_libva_util.h"
@@ -898,27 +899,29 @@ VAStatus DdiDecode_EndPicture (
     PDDI_DECODE_CONTEXT decCtx     = (PDDI_DECODE_CONTEXT)DdiMedia_GetContextFromContextID(ctx, context, &ctxType);
     DDI_CHK_NULL(decCtx,            "nullptr decCtx",            VA_STATUS_ERROR_INVALID_CONTEXT);
 
+    VAStatus va = VA_STATUS_ERROR_UNIMPLEMENTED;
     if (decCtx->pCpDdiInterface)
     {
         DDI_CHK_RET(decCtx->pCpDdiInterface->IsAttachedSessionAlive(), "Session not alive!");
-
-        if (decCtx->pCpDdiInterface->IsCencProcessing())
-        {
-            VAStatus va = decCtx->pCpDdiInterface->EndPicture(ctx, context);
-            DDI_FUNCTION_EXIT(va);
-            return va;
-        }
     }
 
-    if (decCtx->m_ddiDecode)
+    if (decCtx->pCpDdiInterface && decCtx->pCpDdiInterface->IsCencProcessing())
     {
-        VAStatus va = decCtx->m_ddiDecode->EndPicture(ctx, context);
-        DDI_FUNCTION_EXIT(va);
-        return va;
+        va = decCtx->pCpDdiInterface->EndPicture(ctx, context);
+    }
+    else if (decCtx->m_ddiDecode)
+    {
+        va = decCtx->m_ddiDecode->EndPicture(ctx, context);
     }
 
-    DDI_FUNCTION_EXIT(VA_STATUS_ERROR_UNIMPLEMENTED);
-    return VA_STATUS_ERROR_UNIMPLEMENTED;
+    // Render targets may hold compressed data after the write is submitted
+    PDDI_MEDIA_CONTEXT mediaCtx = DdiMedia_GetMediaContext(ctx);
+    DdiMediaUtil_InvalidateDecompState(mediaCtx, decCtx->RTtbl.pCurrentRT);
+    DdiMediaUtil_InvalidateDecompState(mediaCtx, decCtx->pDecProcOutputRT);
+    decCtx->pDecProcOutputRT = nullptr;
+
+    DDI_FUNCTION_EXIT(va);
+    return va;
 }
 
 /*
@@ -1109,12 +1112,20 @@ VAStatus DdiDecode_StatusReport(PDDI_MEDIA_CONTEXT mediaCtx, DecodePipelineAdapt
         DDI_CHK_CONDITION((uNumCompletedReport == 0),
             "No report available at all", VA_STATUS_ERROR_OPERATION_FAILED);
 
+        // Get all completed reports in one pass instead of one call per report
+        std::vector<decode::DecodeStatusReportData> newReports(uNumCompletedReport);
+        MOS_STATUS eStatus = decoder->GetCompletedReports(newReports.data(), uNumCompletedReport, uNumCompletedReport);
+
+        // the reports are consumed already, even on failure, so go through all of them before reporting failure
+        VAStatus vaStatus = VA_STATUS_SUCCESS;
+        if (eStatus != MOS_STATUS_SUCCESS)
+        {
+            DDI_ASSERTMESSAGE("Get status report fail");
+            vaStatus = VA_STATUS_ERROR_OPERATION_FAILED;
+        }
         for (uint32_t i = 0; i < uNumCompletedReport; i++)
         {
-            decode::DecodeStatusReportData tempNewReport;
-            MOS_ZeroMemory(&tempNewReport, sizeof(CodechalDecodeStatusReport));
-            MOS_STATUS eStatus = decoder->GetStatusReport(&tempNewReport, 1);
-            DDI_CHK_CONDITION(MOS_STATUS_SUCCESS != eStatus, "Get status report fail", VA_STATUS_ERROR_OPERATION_FAILED);
+            decode::DecodeStatusReportData &tempNewReport = newReports[i];
 
             MOS_LINUX_BO *bo = tempNewReport.currDecodedPicRes.bo;
 
@@ -1139,15 +1150,20 @@ VAStatus DdiDecode_StatusReport(PDDI_MEDIA_CONTEXT mediaCtx, DecodePipelineAdapt
 
                 if (j == mediaCtx->pSurfaceHeap->uiAllocatedHeapElements)
                 {
-                    return VA_STATUS_ERROR_OPERATION_FAILED;
+                    vaStatus = VA_STATUS_ERROR_OPERATION_FAILED;
                 }
             }
             else
             {
                 // return failed if queried INCOMPLETE or UNAVAILABLE report.
-                return VA_STATUS_ERROR_OPERATION_FAILED;
+                vaStatus = VA_STATUS_ERROR_OPERATION_FAILED;
             }
         }
+
+        if (vaStatus != VA_STATUS_SUCCESS)
+        {
+            return vaStatus;
+        }
     }
 
     // check the report ptr of current surface.
@@ -621,6 +621,7 @@ struct DDI_DECODE_CONTEXT
     uint32_t                        dwSliceParamBufNum;
     uint32_t                        dwSliceCtrlBufNum;
     uint32_t                        uiDecProcessingType;
+    DDI_MEDIA_SURFACE               *pDecProcOutputRT;      // Decode processing output written by the current frame
 };
 
 typedef struct DDI_DECODE_CONTEXT *PDDI_DECODE_CONTEXT;
@@ -167,6 +167,8 @@ typedef struct _DDI_ENCODE_CONTEXT
     bool                              EnableSliceLevelRateCtrl;
     //Per-MB Qp control
     bool                              bMBQpEnable;
+    bool                              bMBQpUnchanged;
+    uint32_t                          uiMBQpWriteSeq;        // write sequence number of the MB QP buffer used by previous frame
 
     DDI_CODEC_RENDER_TARGET_TABLE     RTtbl;
     DDI_CODEC_COM_BUFFER_MGR          BufMgr;
@@ -54,6 +54,7 @@
 #include "mediamemdecomp.h"
 #include "mos_solo_generic.h"
 #include "media_libva_caps.h"
+#include "media_libva_gmm_cache.h"
 #include "media_interfaces_mmd.h"
 #include "media_interfaces_mcpy.h"
 #include "media_user_settings_mgr.h"
@@ -916,6 +917,13 @@ static void DdiMedia_FreeContextHeapElements(VADriverContextP    ctx)
         DdiMedia_FreeContextHeap(ctx, mfeContextHeap, DDI_MEDIA_VACONTEXTID_OFFSET_MFE, mfeCtxNums);
 
     // Free media memory decompression data structure
+    if (mediaCtx->pMemDecompCpInterface)
+    {
+        Delete_DdiCpInterface(mediaCtx->pMemDecompCpInterface);
+        mediaCtx->pMemDecompCpInterface = nullptr;
+    }
+    MOS_Delete(mediaCtx->pMemDecompMosCtx);
+
     if (!mediaCtx->m_apoMosEnabled && mediaCtx->pMediaMemDecompState)
     {
         MediaMemDecompBaseState *mediaMemCompState =
@@ -1260,8 +1268,64 @@ VAStatus DdiMedia_MediaMemoryTileConvertInternal(
 }
 #endif
 
+#ifdef _MMC_SUPPORTED
+//!
+//! \brief  Get the mos context of memory decompression, which is created on first use
+//! \details MemDecompMutex must be held by caller.
+//!
+//! \param  [in]     mediaCtx
+//!     Pointer to ddi media context
+//!
+//! \return     PMOS_CONTEXT
+//!     Pointer to mos context, nullptr if failed
+//!
+static PMOS_CONTEXT DdiMedia_GetMemDecompMosContext(PDDI_MEDIA_CONTEXT mediaCtx)
+{
+    if (mediaCtx->pMemDecompMosCtx)
+    {
+        return mediaCtx->pMemDecompMosCtx;
+    }
+
+    PMOS_CONTEXT mosCtx = MOS_New(MOS_CONTEXT);
+    DDI_CHK_NULL(mosCtx, "nullptr mosCtx", nullptr);
+
+    mosCtx->bufmgr          = mediaCtx->pDrmBufMgr;
+    mosCtx->m_gpuContextMgr = mediaCtx->m_gpuContextMgr;
+    mosCtx->m_cmdBufMgr     = mediaCtx->m_cmdBufMgr;
+    mosCtx->fd              = mediaCtx->fd;
+    mosCtx->iDeviceId       = mediaCtx->iDeviceId;
+    mosCtx->SkuTable        = mediaCtx->SkuTable;
+    mosCtx->WaTable         = mediaCtx->WaTable;
+    mosCtx->gtSystemInfo    = *mediaCtx->pGtSystemInfo;
+    mosCtx->platform        = mediaCtx->platform;
+
+    mosCtx->ppMediaMemDecompState = &mediaCtx->pMediaMemDecompState;
+    mosCtx->pfnMemoryDecompress   = mediaCtx->pfnMemoryDecompress;
+    mosCtx->pfnMediaMemoryCopy    = mediaCtx->pfnMediaMemoryCopy;
+    mosCtx->pfnMediaMemoryCopy2D  = mediaCtx->pfnMediaMemoryCopy2D;
+    mosCtx->m_auxTableMgr         = mediaCtx->m_auxTableMgr;
+    mosCtx->pGmmClientContext     = mediaCtx->pGmmClientContext;
+
+    mosCtx->m_osDeviceContext     = mediaCtx->m_osDeviceContext;
+    mosCtx->m_apoMosEnabled       = mediaCtx->m_apoMosEnabled;
+
+    mediaCtx->pMemDecompCpInterface = Create_DdiCpInterface(*mosCtx);
+    if (nullptr == mediaCtx->pMemDecompCpInterface)
+    {
+        MOS_Delete(mosCtx);
+        return nullptr;
+    }
+
+    mediaCtx->pMemDecompMosCtx = mosCtx;
+    return mosCtx;
+}
+#endif
+
 //!
 //! \brief  Decompress a compressed surface.
+//! \details Surfaces decompressed and not written by GPU since are skipped. The
+//!          decompression is submitted without waiting for GPU, CPU access to
+//!          the surface waits for it when mapping the bo.
 //! 
 //! \param  [in]     mediaCtx
 //!     Pointer to ddi media context
@@ -1289,57 +1353,54 @@ VAStatus DdiMedia_MediaMemoryDecompress(PDDI_MEDIA_CONTEXT mediaCtx, DDI_MEDIA_S
           mediaSurface->pGmmResourceInfo->IsMediaMemoryCompressed(0))
     {
 #ifdef _MMC_SUPPORTED
-        MOS_CONTEXT  mosCtx;
         MOS_RESOURCE surface;
-        DdiCpInterface *pCpDdiInterface;
-        
-        MOS_ZeroMemory(&mosCtx, sizeof(mosCtx));
         MOS_ZeroMemory(&surface, sizeof(surface));
 
-        mosCtx.bufmgr          = mediaCtx->pDrmBufMgr;
-        mosCtx.m_gpuContextMgr = mediaCtx->m_gpuContextMgr;
-        mosCtx.m_cmdBufMgr     = mediaCtx->m_cmdBufMgr;
-        mosCtx.fd              = mediaCtx->fd;
-        mosCtx.iDeviceId       = mediaCtx->iDeviceId;
-        mosCtx.SkuTable        = mediaCtx->SkuTable;
-        mosCtx.WaTable         = mediaCtx->WaTable;
-        mosCtx.gtSystemInfo    = *mediaCtx->pGtSystemInfo;
-        mosCtx.platform        = mediaCtx->platform;
-
-        mosCtx.ppMediaMemDecompState = &mediaCtx->pMediaMemDecompState;
-        mosCtx.pfnMemoryDecompress   = mediaCtx->pfnMemoryDecompress;
-        mosCtx.pfnMediaMemoryCopy    = mediaCtx->pfnMediaMemoryCopy;
-        mosCtx.pfnMediaMemoryCopy2D  = mediaCtx->pfnMediaMemoryCopy2D;
-        mosCtx.gtSystemInfo          = *mediaCtx->pGtSystemInfo;
-        mosCtx.m_auxTableMgr         = mediaCtx->m_auxTableMgr;
-        mosCtx.pGmmClientContext     = mediaCtx->pGmmClientContext;
-
-        mosCtx.m_osDeviceContext     = mediaCtx->m_osDeviceContext;
-        mosCtx.m_apoMosEnabled       = mediaCtx->m_apoMosEnabled;
-
-        pCpDdiInterface = Create_DdiCpInterface(mosCtx);
+        // Submissions are serialized, so a surface is never seen in pending state here
+        DdiMediaUtil_LockMutex(&mediaCtx->MemDecompMutex);
 
-        if (nullptr == pCpDdiInterface)
+        DdiMediaUtil_LockMutex(&mediaCtx->SurfaceMutex);
+        // Imported surfaces and surfaces CM kernels may access are written out of sight
+        if (mediaSurface->pSurfDesc != nullptr || mediaCtx->uiNumCMs > 0)
         {
-            vaStatus = VA_STATUS_ERROR_ALLOCATION_FAILED;
+            mediaSurface->decompState = DDI_MEDIA_DECOMP_STATE_UNTRACKED;
         }
-        else
+        bool skip = mediaSurface->decompState == DDI_MEDIA_DECOMP_STATE_DONE &&
+                    mediaSurface->uiDecompEpoch == mediaCtx->uiDecompEpoch;
+        if (!skip && mediaSurface->decompState != DDI_MEDIA_DECOMP_STATE_UNTRACKED)
+        {
+            mediaSurface->decompState   = DDI_MEDIA_DECOMP_STATE_PENDING;
+            mediaSurface->uiDecompEpoch = mediaCtx->uiDecompEpoch;
+        }
+        if (!skip)
         {
-            DdiMediaUtil_LockMutex(&mediaCtx->SurfaceMutex);
-            DdiMediaUtil_LockMutex(&mediaCtx->MemDecompMutex);
-
             DdiMedia_MediaSurfaceToMosResource(mediaSurface, &surface);
-            DdiMedia_MediaMemoryDecompressInternal(&mosCtx, &surface);
+        }
+        DdiMediaUtil_UnLockMutex(&mediaCtx->SurfaceMutex);
 
-            DdiMediaUtil_UnLockMutex(&mediaCtx->MemDecompMutex);
-            DdiMediaUtil_UnLockMutex(&mediaCtx->SurfaceMutex);
+        if (!skip)
+        {
+            PMOS_CONTEXT mosCtx = DdiMedia_GetMemDecompMosContext(mediaCtx);
+            if (nullptr == mosCtx)
+            {
+                vaStatus = VA_STATUS_ERROR_ALLOCATION_FAILED;
+            }
+            else
+            {
+                DdiMedia_MediaMemoryDecompressInternal(mosCtx, &surface);
+            }
 
-            if (pCpDdiInterface)
+            // A write submitted meanwhile has reset the state
+            DdiMediaUtil_LockMutex(&mediaCtx->SurfaceMutex);
+            if (mediaSurface->decompState == DDI_MEDIA_DECOMP_STATE_PENDING)
             {
-                Delete_DdiCpInterface(pCpDdiInterface);
-                pCpDdiInterface = NULL;
+                mediaSurface->decompState = (VA_STATUS_SUCCESS == vaStatus) ?
+                    DDI_MEDIA_DECOMP_STATE_DONE : DDI_MEDIA_DECOMP_STATE_UNKNOWN;
             }
+            DdiMediaUtil_UnLockMutex(&mediaCtx->SurfaceMutex);
         }
+
+        DdiMediaUtil_UnLockMutex(&mediaCtx->MemDecompMutex);
 #else
         vaStatus = VA_STATUS_ERROR_INVALID_SURFACE;
         DDI_ASSERTMESSAGE("MMC unsupported! [%d].", vaStatus);
@@ -1718,6 +1779,57 @@ VAStatus DdiMedia__Initialize (
     return status;
 }
 
+//!
+//! \brief  Phases of vaInitialize timed for the startup report
+//!
+enum DDI_MEDIA_STARTUP_PHASE
+{
+    DDI_MEDIA_STARTUP_HWINFO = 0,
+    DDI_MEDIA_STARTUP_USER_SETTING,
+    DDI_MEDIA_STARTUP_GMM,
+    DDI_MEDIA_STARTUP_MEDIA_CONTEXT,
+    DDI_MEDIA_STARTUP_CAPS,
+    DDI_MEDIA_STARTUP_PHASE_NUM
+};
+
+//!
+//! \class  DdiMediaStartupTimer
+//! \brief  Accumulate the time spent in each vaInitialize phase and report it,
+//!         so that regressions of the driver startup latency are visible
+//!
+class DdiMediaStartupTimer
+{
+public:
+    void Begin(DDI_MEDIA_STARTUP_PHASE phase)
+    {
+        m_startTime[phase] = MosUtilities::MosGetTime();
+    }
+
+    void End(DDI_MEDIA_STARTUP_PHASE phase)
+    {
+        m_phaseTime[phase] += MosUtilities::MosGetTime() - m_startTime[phase];
+    }
+
+    void Report(const PLATFORM &platform)
+    {
+        double total = MosUtilities::MosGetTime() - m_initTime;
+        DDI_NORMALMESSAGE("vaInitialize startup report (product %d): total %.1f us, hwinfo %.1f us, user settings %.1f us, "
+                          "gmm %.1f us, media context %.1f us, caps %.1f us",
+            platform.eProductFamily,
+            total,
+            m_phaseTime[DDI_MEDIA_STARTUP_HWINFO],
+            m_phaseTime[DDI_MEDIA_STARTUP_USER_SETTING],
+            m_phaseTime[DDI_MEDIA_STARTUP_GMM],
+            m_phaseTime[DDI_MEDIA_STARTUP_MEDIA_CONTEXT],
+            m_phaseTime[DDI_MEDIA_STARTUP_CAPS]);
+    }
+
+private:
+    double m_initTime = MosUtilities::MosGetTime();            //!< Time when vaInitialize starts
+    double m_startTime[DDI_MEDIA_STARTUP_PHASE_NUM] = {};     //!< Start time of the running phase
+    double m_phaseTime[DDI_MEDIA_STARTUP_PHASE_NUM] = {};     //!< Accumulated time of each phase in us
+};
+
 VAStatus DdiMedia_InitMediaContext (
     VADriverContextP ctx,
     int32_t          devicefd,
@@ -1736,6 +1848,8 @@ VAStatus DdiMedia_InitMediaContext (
         *minor_version = VA_MINOR_VERSION;
     }
 
+    DdiMediaStartupTimer startupTimer;
+
     DdiMediaUtil_LockMutex(&GlobalMutex);
     // media context is already created, return directly to support multiple entry
     PDDI_MEDIA_CONTEXT mediaCtx = DdiMedia_GetMediaContext(ctx);
@@ -1781,12 +1895,15 @@ VAStatus DdiMedia_InitMediaContext (
             return VA_STATUS_ERROR_ALLOCATION_FAILED;
         }
 
+        // os device context covers hwinfo, gmm and the gpu context manager of apo mos
+        startupTimer.Begin(DDI_MEDIA_STARTUP_MEDIA_CONTEXT);
         if (MosInterface::CreateOsDeviceContext(&mosCtx, &mediaCtx->m_osDeviceContext) != MOS_STATUS_SUCCESS)
         {
             DDI_ASSERTMESSAGE("Unable to create MOS device context.");
             FreeForMediaContext(mediaCtx);
             return VA_STATUS_ERROR_OPERATION_FAILED;
         }
+        startupTimer.End(DDI_MEDIA_STARTUP_MEDIA_CONTEXT);
         mediaCtx->pDrmBufMgr                = mosCtx.bufmgr;
         mediaCtx->iDeviceId                 = mosCtx.iDeviceId;
         mediaCtx->SkuTable                  = mosCtx.SkuTable;
@@ -1800,7 +1917,9 @@ VAStatus DdiMedia_InitMediaContext (
         mediaCtx->bIsAtomSOC                = mosCtx.bIsAtomSOC;
         mediaCtx->perfData                  = mosCtx.pPerfData;
 
+        startupTimer.Begin(DDI_MEDIA_STARTUP_USER_SETTING);
         MediaUserSettingsMgr::MediaUserSettingsInit(mediaCtx->platform.eProductFamily);
+        startupTimer.End(DDI_MEDIA_STARTUP_USER_SETTING);
 
 #ifdef _MMC_SUPPORTED
         if (mosCtx.ppMediaMemDecompState == nullptr)
@@ -1843,6 +1962,7 @@ VAStatus DdiMedia_InitMediaContext (
             FreeForMediaContext(mediaCtx);
             return VA_STATUS_ERROR_ALLOCATION_FAILED;
         }
+        startupTimer.Begin(DDI_MEDIA_STARTUP_HWINFO);
         MOS_STATUS eStatus = HWInfo_GetGfxInfo(mediaCtx->fd, mediaCtx->pDrmBufMgr, &platform, skuTable, waTable, mediaCtx->pGtSystemInfo);
         if (MOS_STATUS_SUCCESS != eStatus)
         {
@@ -1850,6 +1970,7 @@ VAStatus DdiMedia_InitMediaContext (
             FreeForMediaContext(mediaCtx);
             return VA_STATUS_ERROR_OPERATION_FAILED;
         }
+        startupTimer.End(DDI_MEDIA_STARTUP_HWINFO);
         mediaCtx->platform = platform;
 
         MosUtilities::MosTraceSetupInfo(
@@ -1863,7 +1984,9 @@ VAStatus DdiMedia_InitMediaContext (
         {
             MEDIA_WR_WA(waTable, WaHucStreamoutOnlyDisable, 0);
         }
+        startupTimer.Begin(DDI_MEDIA_STARTUP_USER_SETTING);
         MediaUserSettingsMgr::MediaUserSettingsInit(platform.eProductFamily);
+        startupTimer.End(DDI_MEDIA_STARTUP_USER_SETTING);
 
         GMM_SKU_FEATURE_TABLE gmmSkuTable;
         memset(&gmmSkuTable, 0, sizeof(gmmSkuTable));
@@ -1877,6 +2000,7 @@ VAStatus DdiMedia_InitMediaContext (
         GMM_ADAPTER_BDF gmmAdapterBDF;
         memset(&gmmAdapterBDF, 0, sizeof(gmmAdapterBDF));
 
+        startupTimer.Begin(DDI_MEDIA_STARTUP_GMM);
         eStatus = HWInfo_GetGmmInfo(mediaCtx->fd, &gmmSkuTable, &gmmWaTable, &gmmGtInfo);
         if (MOS_STATUS_SUCCESS != eStatus)
         {
@@ -1945,6 +2069,7 @@ VAStatus DdiMedia_InitMediaContext (
 
         // Create GMM page table manager
         mediaCtx->m_auxTableMgr = AuxTableMgr::CreateAuxTableMgr(mediaCtx->pDrmBufMgr, &mediaCtx->SkuTable, mediaCtx->pGmmClientContext);
+        startupTimer.End(DDI_MEDIA_STARTUP_GMM);
 
         bool bSimulationEnable = false;
 #if (_DEBUG || _RELEASE_INTERNAL)
@@ -1958,6 +2083,7 @@ VAStatus DdiMedia_InitMediaContext (
         mediaCtx->m_useSwSwizzling = bSimulationEnable || MEDIA_IS_SKU(&mediaCtx->SkuTable, FtrUseSwSwizzling);
         mediaCtx->m_tileYFlag      = MEDIA_IS_SKU(&mediaCtx->SkuTable, FtrTileY);
 
+        startupTimer.Begin(DDI_MEDIA_STARTUP_MEDIA_CONTEXT);
         mediaCtx->m_osContext = OsContext::GetOsContextObject();
         if (mediaCtx->m_osContext == nullptr)
         {
@@ -2002,6 +2128,7 @@ VAStatus DdiMedia_InitMediaContext (
             FreeForMediaContext(mediaCtx);
             return VA_STATUS_ERROR_OPERATION_FAILED;
         }
+        startupTimer.End(DDI_MEDIA_STARTUP_MEDIA_CONTEXT);
     }
     else
     {
@@ -2018,6 +2145,8 @@ VAStatus DdiMedia_InitMediaContext (
     }
 
     //Caps need platform and sku table, especially in MediaLibvaCapsCp::IsDecEncryptionSupported
+    //Profile/entrypoint tables are built on the first caps query, not here
+    startupTimer.Begin(DDI_MEDIA_STARTUP_CAPS);
     mediaCtx->m_caps = MediaLibvaCaps::CreateMediaLibvaCaps(mediaCtx);
     if (!mediaCtx->m_caps)
     {
@@ -2036,6 +2165,7 @@ VAStatus DdiMedia_InitMediaContext (
         return VA_STATUS_ERROR_ALLOCATION_FAILED;
     }
     ctx->max_image_formats = mediaCtx->m_caps->GetImageFormatsMaxNum();
+    startupTimer.End(DDI_MEDIA_STARTUP_CAPS);
 
 #ifdef _MANUAL_SOFTLET_
     apoDdiEnabled = MediaLibvaApoDecision::InitDdiApoState(devicefd);
@@ -2068,6 +2198,20 @@ VAStatus DdiMedia_InitMediaContext (
 
     DdiMediaUtil_SetMediaResetEnableFlag(mediaCtx);
 
+    // Repeated surface and buffer allocations copy the GMM layout computed for the first one
+    bool gmmResInfoCacheEnable = false;
+    ReadUserSetting(
+        nullptr,
+        gmmResInfoCacheEnable,
+        __MEDIA_USER_FEATURE_VALUE_ENABLE_GMM_RESINFO_CACHE,
+        MediaUserSetting::Group::Device);
+    if (gmmResInfoCacheEnable)
+    {
+        mediaCtx->m_gmmResInfoCache = MOS_New(MediaLibvaGmmResInfoCache, mediaCtx->pGmmClientContext);
+    }
+
+    startupTimer.Report(mediaCtx->platform);
+
     DdiMediaUtil_UnLockMutex(&GlobalMutex);
 
     return VA_STATUS_SUCCESS;
@@ -2250,6 +2394,9 @@ VAStatus DdiMedia_Terminate (
     DdiMedia_HeapDestroy(mediaCtx);
     DdiMediaProtected::FreeInstances();
 
+    // Templates are destroyed before the GMM client context
+    MOS_Delete(mediaCtx->m_gmmResInfoCache);
+
     if (mediaCtx->m_apoMosEnabled)
     {
         MosInterface::DestroyOsDeviceContext(mediaCtx->m_osDeviceContext);
@@ -3365,6 +3512,11 @@ VAStatus DdiMedia_MapBufferInternal (
     DDI_MEDIA_BUFFER   *buf     = DdiMedia_GetBufferFromVABufferID(mediaCtx, buf_id);
     DDI_CHK_NULL(buf, "nullptr buf", VA_STATUS_ERROR_INVALID_BUFFER);
 
+    if (flag & MOS_LOCKFLAG_WRITEONLY)
+    {
+        DdiMediaUtil_MarkBufferWritten(buf);
+    }
+
     // The context is nullptr when the buffer is created from DdiMedia_DeriveImage
     // So doesn't need to check the context for all cases
     // Only check the context in dec/enc mode
@@ -3927,6 +4079,7 @@ VAStatus DdiMedia_BeginPicture (
 )
 {
     DDI_FUNCTION_ENTER();
+    NULLHW_LAYER_SCOPE(NullHW::LayerDdi);
 
     DDI_CHK_NULL(ctx, "nullptr ctx", VA_STATUS_ERROR_INVALID_CONTEXT);
 
@@ -3976,6 +4129,7 @@ VAStatus DdiMedia_RenderPicture (
 {
 
     DDI_FUNCTION_ENTER();
+    NULLHW_LAYER_SCOPE(NullHW::LayerDdi);
 
     DDI_CHK_NULL(  ctx,            "nullptr ctx",                   VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(  buffers,        "nullptr buffers",               VA_STATUS_ERROR_INVALID_PARAMETER);
@@ -4016,9 +4170,13 @@ VAStatus DdiMedia_EndPicture (
 )
 {
     DDI_FUNCTION_ENTER();
+    NULLHW_LAYER_SCOPE(NullHW::LayerDdi);
 
     DDI_CHK_NULL(ctx, "nullptr ctx", VA_STATUS_ERROR_INVALID_CONTEXT);
 
+    PDDI_MEDIA_CONTEXT mediaCtx = DdiMedia_GetMediaContext(ctx);
+    DDI_CHK_NULL(mediaCtx, "nullptr mediaCtx", VA_STATUS_ERROR_INVALID_CONTEXT);
+
     uint32_t ctxType = DDI_MEDIA_CONTEXT_TYPE_NONE;
     void     *ctxPtr = DdiMedia_GetContextFromContextID(ctx, context, &ctxType);
     VAStatus  vaStatus = VA_STATUS_SUCCESS;
@@ -4029,6 +4187,10 @@ VAStatus DdiMedia_EndPicture (
             break;
         case DDI_MEDIA_CONTEXT_TYPE_ENCODER:
             vaStatus = DdiEncode_EndPicture(ctx, context);
+            // Encoder reconstructed surfaces are not known here, invalidate decompression of all surfaces
+            DdiMediaUtil_LockMutex(&mediaCtx->SurfaceMutex);
+            mediaCtx->uiDecompEpoch++;
+            DdiMediaUtil_UnLockMutex(&mediaCtx->SurfaceMutex);
             break;
         case DDI_MEDIA_CONTEXT_TYPE_VP:
             vaStatus = DdiVp_EndPicture(ctx, context);
@@ -4040,6 +4202,10 @@ VAStatus DdiMedia_EndPicture (
 
     MOS_TraceEventExt(EVENT_VA_PICTURE, EVENT_TYPE_END, &context, sizeof(context), &vaStatus, sizeof(vaStatus));
     PERF_UTILITY_STOP_ONCE("First Frame Time", PERF_MOS, PERF_LEVEL_DDI);
+    if (NullHW::IsEnabled())
+    {
+        NullHW::FrameEnd();
+    }
 
     return vaStatus;
 }
@@ -6295,6 +6461,7 @@ DdiMedia_Copy(
     }
 
     vaStatus = DdiMedia_CopyInternal(&mosCtx, &src, &dst, option.bits.va_copy_mode);
+    DdiMediaUtil_InvalidateDecompState(mediaCtx, dst_surface);
 
     if ((option.bits.va_copy_sync == VA_EXEC_SYNC) && dst_surface)
     {
@@ -7196,6 +7363,14 @@ VAStatus DdiMedia_ExportSurfaceHandle(
         return VA_STATUS_ERROR_OPERATION_FAILED;
     }
 
+    if (flags & VA_EXPORT_SURFACE_WRITE_ONLY)
+    {
+        // Importers may write compressed data without the driver knowing
+        DdiMediaUtil_LockMutex(&mediaCtx->SurfaceMutex);
+        mediaSurface->decompState = DDI_MEDIA_DECOMP_STATE_UNTRACKED;
+        DdiMediaUtil_UnLockMutex(&mediaCtx->SurfaceMutex);
+    }
+
     VADRMPRIMESurfaceDescriptor *desc = (VADRMPRIMESurfaceDescriptor *)descriptor;
     desc->fourcc = DdiMedia_MediaFormatToOsFormat(mediaSurface->format);
     if(desc->fourcc == VA_STATUS_ERROR_UNSUPPORTED_RT_FORMAT)
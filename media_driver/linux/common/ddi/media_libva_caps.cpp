@@ -1957,12 +1957,33 @@ VAStatus MediaLibvaCaps::LoadNoneProfileEntrypoints()
     return status;
 }
 
+VAStatus MediaLibvaCaps::LoadProfileEntrypointsOnce()
+{
+    if (m_profileEntryLoaded.load(std::memory_order_acquire))
+    {
+        return m_profileEntryStatus;
+    }
+
+    std::lock_guard<std::mutex> lock(m_profileEntryMutex);
+    if (!m_profileEntryLoaded.load(std::memory_order_relaxed))
+    {
+        double startTime     = MosUtilities::MosGetTime();
+        m_profileEntryStatus = LoadProfileEntrypoints();
+        DDI_NORMALMESSAGE("Caps: %d profile/entrypoint entries loaded in %.1f us, status %d",
+            m_profileEntryCount, MosUtilities::MosGetTime() - startTime, m_profileEntryStatus);
+        m_profileEntryLoaded.store(true, std::memory_order_release);
+    }
+
+    return m_profileEntryStatus;
+}
+
 VAStatus MediaLibvaCaps::GetConfigAttributes(VAProfile profile,
         VAEntrypoint entrypoint,
         VAConfigAttrib *attribList,
         int32_t numAttribs)
 {
     DDI_CHK_NULL(attribList, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CHK_RET(LoadProfileEntrypointsOnce(), "Failed to initialize Caps!");
     int32_t i = GetProfileTableIdx(profile, entrypoint);
 
     switch(i)
@@ -2283,6 +2304,7 @@ VAStatus MediaLibvaCaps::CreateConfig(
 {
 
     DDI_CHK_NULL(configId, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CHK_RET(LoadProfileEntrypointsOnce(), "Failed to initialize Caps!");
 
     DDI_CHK_RET(CheckProfile(profile),"Failed to check config!");
 
@@ -2335,6 +2357,7 @@ VAStatus MediaLibvaCaps::QueryConfigProfiles(
 {
     DDI_CHK_NULL(profileList, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
     DDI_CHK_NULL(numProfiles, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CHK_RET(LoadProfileEntrypointsOnce(), "Failed to initialize Caps!");
     std::set<int32_t> profiles;
     int32_t i;
     for (i = 0; i < m_profileEntryCount; i++)
@@ -2362,6 +2385,7 @@ VAStatus MediaLibvaCaps::QueryConfigEntrypoints(
 {
     DDI_CHK_NULL(entrypointList, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
     DDI_CHK_NULL(numEntrypoints, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CHK_RET(LoadProfileEntrypointsOnce(), "Failed to initialize Caps!");
     int32_t j = 0;
     for (int32_t i = 0; i < m_profileEntryCount; i++)
     {
@@ -31,6 +31,8 @@
 
 #include <vector>
 #include <map>
+#include <mutex>
+#include <atomic>
 
 #ifndef CONTEXT_PRIORITY_MAX
 #define CONTEXT_PRIORITY_MAX 1024
@@ -901,6 +903,10 @@ protected:
     ProfileEntrypoint m_profileEntryTbl[m_maxProfileEntries];
     uint16_t m_profileEntryCount = 0; //!< Count valid entries in m_profileEntryTbl
 
+    std::atomic<bool> m_profileEntryLoaded{false};          //!< Whether m_profileEntryTbl has been built
+    VAStatus          m_profileEntryStatus = VA_STATUS_SUCCESS; //!< Status of building m_profileEntryTbl
+    std::mutex        m_profileEntryMutex;                 //!< Serialize building of m_profileEntryTbl
+
     //!
     //! \brief  Store attribute list pointers
     //!
@@ -1266,6 +1272,20 @@ protected:
     //!
     virtual VAStatus LoadProfileEntrypoints() = 0;
 
+    //!
+    //! \brief    Initialize profiles, entrypoints and attributes on first use
+    //! \details  The tables are not needed by vaInitialize, so they are built
+    //!           by the first query which looks them up instead of at Init.
+    //!           All codec families are built together: config ids index
+    //!           m_decConfigs, m_encConfigs and m_vpConfigs without lock, and
+    //!           loading a family later would grow these vectors under readers
+    //!           of configs already created.
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if success, else the status of LoadProfileEntrypoints
+    //!
+    VAStatus LoadProfileEntrypointsOnce();
+
     //!
     //! \brief    Create decode config by given attributes
     //!
@@ -152,6 +152,8 @@ typedef sem_t MEDIA_SEM_T, *PMEDIA_SEM_T;
 
 class MediaLibvaCaps;
 class MediaLibvaCapsNext;
+class MediaLibvaGmmResInfoCache;
+class DdiCpInterface;
 
 typedef enum _DDI_MEDIA_FORMAT
 {
@@ -222,6 +224,17 @@ typedef enum _DDI_MEDIA_STATUS_REPORT_QUERY_STATE
     DDI_MEDIA_STATUS_REPORT_QUERY_STATE_RELEASED
 } DDI_MEDIA_STATUS_REPORT_QUERY_STATE;
 
+//!
+//! \brief Compression state of surface tracked by memory decompression
+//!
+typedef enum _DDI_MEDIA_DECOMP_STATE
+{
+    DDI_MEDIA_DECOMP_STATE_UNKNOWN,     // may hold compressed data
+    DDI_MEDIA_DECOMP_STATE_PENDING,     // decompression is being submitted
+    DDI_MEDIA_DECOMP_STATE_DONE,        // decompression submitted and no GPU write to the surface since
+    DDI_MEDIA_DECOMP_STATE_UNTRACKED    // may be written outside of the driver, always decompressed
+} DDI_MEDIA_DECOMP_STATE;
+
 //!
 //! \brief Surface descriptor for external DRM buffer
 //!
@@ -326,6 +339,9 @@ typedef struct _DDI_MEDIA_SURFACE
 
     uint32_t                uiVariantFlag;
     int                     memType;
+
+    DDI_MEDIA_DECOMP_STATE  decompState;              // compression state, protected by SurfaceMutex
+    uint32_t                uiDecompEpoch;            // uiDecompEpoch of media context when decompression was submitted
 } DDI_MEDIA_SURFACE, *PDDI_MEDIA_SURFACE;
 
 typedef struct _DDI_MEDIA_BUFFER
@@ -345,6 +361,7 @@ typedef struct _DDI_MEDIA_BUFFER
     uint32_t               TileType          = 0;
     uint8_t               *pData             = nullptr;
     uint32_t               bMapped           = 0;
+    uint32_t               uiWriteSeq        = 0;       // set by DdiMediaUtil_MarkBufferWritten when created or mapped for write
     MOS_LINUX_BO          *bo                = nullptr;
     uint32_t               name              = 0;
     uint32_t               uiMemtype         = 0;
@@ -488,6 +505,13 @@ struct DDI_MEDIA_CONTEXT
     // Media memory decompression data structure
     void               *pMediaMemDecompState;
 
+    // Setup of media memory decompression kept across calls, protected by MemDecompMutex
+    PMOS_CONTEXT        pMemDecompMosCtx;
+    DdiCpInterface     *pMemDecompCpInterface;
+
+    // Bumped by GPU writes to surfaces not tracked one by one, outdates all decompressed surfaces
+    uint32_t            uiDecompEpoch;
+
     // Media copy data structure
     void               *pMediaCopyState;
 
@@ -545,6 +569,9 @@ struct DDI_MEDIA_CONTEXT
 
     GMM_CLIENT_CONTEXT  *pGmmClientContext;
 
+    // Templates of GMM resource info for repeated allocations, null if disabled
+    MediaLibvaGmmResInfoCache *m_gmmResInfoCache;
+
     // Aux Table Manager
     AuxTableMgr         *m_auxTableMgr;
 
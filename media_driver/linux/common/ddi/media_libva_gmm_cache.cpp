@@ -0,0 +1,248 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_gmm_cache.cpp
+//! \brief    Cache of GMM resource info templates for repeated allocations
+//!
+
+#include <string.h>
+#include "media_libva_gmm_cache.h"
+#include "mos_util_debug.h"
+
+MediaLibvaGmmResInfoCache::MediaLibvaGmmResInfoCache(GMM_CLIENT_CONTEXT *gmmClientContext) :
+    m_gmmClientContext(gmmClientContext)
+{
+    m_entries.reserve(m_maxEntries);
+}
+
+MediaLibvaGmmResInfoCache::~MediaLibvaGmmResInfoCache()
+{
+    Clear();
+
+    MOS_NORMALMESSAGE(MOS_COMPONENT_DDI, MOS_DDI_SUBCOMP_SELF,
+        "GMM resource info cache hits %llu, misses %llu, evicted %llu.",
+        (unsigned long long)m_stats.hits,
+        (unsigned long long)m_stats.misses,
+        (unsigned long long)m_stats.evicted);
+}
+
+void MediaLibvaGmmResInfoCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto &entry : m_entries)
+    {
+        GmmDestroyResInfo(entry.resInfo);
+    }
+    m_entries.clear();
+    m_stats.entries = 0;
+}
+
+bool MediaLibvaGmmResInfoCache::MakeKey(const GMM_RESCREATE_PARAMS *params, Key &key)
+{
+    // Layout of a wrapped system memory depends on its address
+    if (params->pExistingSysMem || params->ExistingSysMemSize)
+    {
+        return false;
+    }
+
+    key.type          = params->Type;
+    key.format        = params->Format;
+    key.flags         = params->Flags;
+    key.usage         = params->Usage;
+    key.baseWidth     = params->BaseWidth;
+    key.baseHeight    = params->BaseHeight;
+    key.depth         = params->Depth;
+    key.arraySize     = params->ArraySize;
+    key.maxLod        = params->MaxLod;
+    key.baseAlignment = params->BaseAlignment;
+    key.overridePitch = params->OverridePitch;
+    key.cpTag         = params->CpTag;
+    key.numSamples    = params->MSAA.NumSamples;
+    return true;
+}
+
+bool MediaLibvaGmmResInfoCache::IsSameKey(const Key &key1, const Key &key2)
+{
+    return key1.type          == key2.type          &&
+           key1.format        == key2.format        &&
+           key1.usage         == key2.usage         &&
+           key1.baseWidth     == key2.baseWidth     &&
+           key1.baseHeight    == key2.baseHeight    &&
+           key1.depth         == key2.depth         &&
+           key1.arraySize     == key2.arraySize     &&
+           key1.maxLod        == key2.maxLod        &&
+           key1.baseAlignment == key2.baseAlignment &&
+           key1.overridePitch == key2.overridePitch &&
+           key1.cpTag         == key2.cpTag         &&
+           key1.numSamples    == key2.numSamples    &&
+           memcmp(&key1.flags, &key2.flags, sizeof(GMM_RESOURCE_FLAG)) == 0;
+}
+
+static inline uint64_t HashValue(uint64_t hash, uint64_t value)
+{
+    // FNV-1a over the 8 bytes of the value
+    for (uint32_t i = 0; i < sizeof(value); i++)
+    {
+        hash ^= (value >> (i * 8)) & 0xff;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+uint64_t MediaLibvaGmmResInfoCache::Hash(const Key &key)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    hash = HashValue(hash, key.type);
+    hash = HashValue(hash, key.format);
+    hash = HashValue(hash, key.usage);
+    hash = HashValue(hash, key.baseWidth);
+    hash = HashValue(hash, ((uint64_t)key.baseHeight << 32) | key.depth);
+    hash = HashValue(hash, ((uint64_t)key.arraySize << 32) | key.maxLod);
+    hash = HashValue(hash, ((uint64_t)key.baseAlignment << 32) | key.overridePitch);
+    hash = HashValue(hash, ((uint64_t)key.cpTag << 32) | key.numSamples);
+
+    const uint8_t *flags = (const uint8_t *)&key.flags;
+    for (size_t i = 0; i < sizeof(GMM_RESOURCE_FLAG); i++)
+    {
+        hash ^= flags[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+GMM_RESOURCE_INFO *MediaLibvaGmmResInfoCache::GmmCreateResInfo(GMM_RESCREATE_PARAMS *params)
+{
+    return m_gmmClientContext->CreateResInfoObject(params);
+}
+
+GMM_RESOURCE_INFO *MediaLibvaGmmResInfoCache::GmmCopyResInfo(GMM_RESOURCE_INFO *resInfo)
+{
+    return m_gmmClientContext->CopyResInfoObject(resInfo);
+}
+
+void MediaLibvaGmmResInfoCache::GmmDestroyResInfo(GMM_RESOURCE_INFO *resInfo)
+{
+    m_gmmClientContext->DestroyResInfoObject(resInfo);
+}
+
+GMM_RESOURCE_INFO *MediaLibvaGmmResInfoCache::CreateResInfoObject(GMM_RESCREATE_PARAMS *params)
+{
+    if (params == nullptr)
+    {
+        MOS_ASSERTMESSAGE(MOS_COMPONENT_DDI, MOS_DDI_SUBCOMP_SELF, "nullptr params");
+        return nullptr;
+    }
+
+    // GMM may update the parameters, so the key is taken before creation
+    Key key;
+    if (!MakeKey(params, key))
+    {
+        return GmmCreateResInfo(params);
+    }
+    uint64_t hash = Hash(key);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_useCount++;
+        for (auto &entry : m_entries)
+        {
+            if (entry.hash == hash && IsSameKey(entry.key, key))
+            {
+                entry.lastUse = m_useCount;
+                m_stats.hits++;
+                // Copied under the lock so the template is not evicted meanwhile
+                return GmmCopyResInfo(entry.resInfo);
+            }
+        }
+        m_stats.misses++;
+    }
+
+    GMM_RESOURCE_INFO *resInfo = GmmCreateResInfo(params);
+    if (resInfo == nullptr)
+    {
+        return nullptr;
+    }
+
+    // Caller may override the size, pitch or MMC state of its object, so the template is a separate copy
+    GMM_RESOURCE_INFO *resInfoTemplate = GmmCopyResInfo(resInfo);
+    if (resInfoTemplate == nullptr)
+    {
+        return resInfo;
+    }
+
+    GMM_RESOURCE_INFO *unused = Insert(key, hash, resInfoTemplate);
+    if (unused)
+    {
+        GmmDestroyResInfo(unused);
+    }
+
+    return resInfo;
+}
+
+GMM_RESOURCE_INFO *MediaLibvaGmmResInfoCache::Insert(const Key &key, uint64_t hash, GMM_RESOURCE_INFO *resInfo)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto &entry : m_entries)
+    {
+        if (entry.hash == hash && IsSameKey(entry.key, key))
+        {
+            return resInfo;
+        }
+    }
+
+    Entry entry;
+    entry.key     = key;
+    entry.hash    = hash;
+    entry.lastUse = ++m_useCount;
+    entry.resInfo = resInfo;
+
+    GMM_RESOURCE_INFO *evicted = nullptr;
+    if (m_entries.size() < m_maxEntries)
+    {
+        m_entries.push_back(entry);
+    }
+    else
+    {
+        auto lru = m_entries.begin();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if (it->lastUse < lru->lastUse)
+            {
+                lru = it;
+            }
+        }
+        evicted = lru->resInfo;
+        *lru    = entry;
+        m_stats.evicted++;
+    }
+    m_stats.entries = (uint32_t)m_entries.size();
+
+    return evicted;
+}
+
+MediaLibvaGmmResInfoCache::Statistics MediaLibvaGmmResInfoCache::GetStatistics()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
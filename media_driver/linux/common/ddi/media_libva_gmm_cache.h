@@ -0,0 +1,165 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_gmm_cache.h
+//! \brief    Cache of GMM resource info templates for repeated allocations
+//! \details  Streams allocate many surfaces and buffers with the same format, size,
+//!           tiling and usage. The resource info created for a set of creation
+//!           parameters is kept as template, and later allocations with the same
+//!           parameters get a copy of it instead of computing the layout again.
+//!
+
+#ifndef __MEDIA_LIBVA_GMM_CACHE_H__
+#define __MEDIA_LIBVA_GMM_CACHE_H__
+
+#include <stdint.h>
+#include <mutex>
+#include <vector>
+#include "GmmLib.h"
+
+//!
+//! \class  MediaLibvaGmmResInfoCache
+//! \brief  Media libva GMM resource info cache
+//!
+class MediaLibvaGmmResInfoCache
+{
+public:
+    //!
+    //! \brief  Counters of the cache
+    //!
+    struct Statistics
+    {
+        uint64_t hits     = 0;  //!< Resource info copied from a template
+        uint64_t misses   = 0;  //!< Resource info created by GMM
+        uint64_t evicted  = 0;  //!< Templates replaced by newer parameters
+        uint32_t entries  = 0;  //!< Templates in cache
+    };
+
+    //!
+    //! \brief    Constructor
+    //! \param    [in] gmmClientContext
+    //!           GMM client context creating the resource info
+    //!
+    MediaLibvaGmmResInfoCache(GMM_CLIENT_CONTEXT *gmmClientContext);
+
+    //!
+    //! \brief    Destructor, destroys the templates
+    //!
+    virtual ~MediaLibvaGmmResInfoCache();
+
+    //!
+    //! \brief    Create resource info, copied from the template of same parameters if cached
+    //! \details  The returned object is owned by caller and destroyed by
+    //!           DestroyResInfoObject() of the GMM client context as usual. GMM
+    //!           creates the layout outside the cache lock, so concurrent misses
+    //!           of the same parameters each create one and only the first is kept.
+    //! \param    [in] params
+    //!           GMM creation parameters, must be zero initialized before filled
+    //! \return   GMM_RESOURCE_INFO *
+    //!           Resource info, nullptr if failed
+    //!
+    GMM_RESOURCE_INFO *CreateResInfoObject(GMM_RESCREATE_PARAMS *params);
+
+    //!
+    //! \brief    Get counters of the cache
+    //! \return   Statistics
+    //!
+    Statistics GetStatistics();
+
+    static const uint32_t m_maxEntries = 64;  //!< Templates kept, least recently used is replaced
+
+protected:
+    //!
+    //! \brief  Creation parameters the layout is computed from
+    //! \details Built field by field, so padding and pointer members never take part
+    //!          in the comparison. Flags are bit fields only and compared as a whole.
+    //!
+    struct Key
+    {
+        GMM_RESOURCE_TYPE       type          = RESOURCE_INVALID;
+        GMM_RESOURCE_FORMAT     format        = GMM_FORMAT_INVALID;
+        GMM_RESOURCE_FLAG       flags         = {};
+        GMM_RESOURCE_USAGE_TYPE usage         = GMM_RESOURCE_USAGE_UNKNOWN;
+        uint64_t                baseWidth     = 0;
+        uint32_t                baseHeight    = 0;
+        uint32_t                depth         = 0;
+        uint32_t                arraySize     = 0;
+        uint32_t                maxLod        = 0;
+        uint32_t                baseAlignment = 0;
+        uint32_t                overridePitch = 0;
+        uint32_t                cpTag         = 0;
+        uint32_t                numSamples    = 0;
+    };
+
+    struct Entry
+    {
+        Key                 key;
+        uint64_t            hash     = 0;
+        uint64_t            lastUse  = 0;
+        GMM_RESOURCE_INFO  *resInfo  = nullptr;  //!< Template, never handed out
+    };
+
+    //!
+    //! \brief    Build the cache key of creation parameters
+    //! \return   bool
+    //!           false if the parameters are not cacheable, e.g. wrap existing system memory
+    //!
+    static bool MakeKey(const GMM_RESCREATE_PARAMS *params, Key &key);
+
+    //!
+    //! \brief    Compare two keys field by field
+    //!
+    static bool IsSameKey(const Key &key1, const Key &key2);
+
+    //!
+    //! \brief    Hash the fields of a key
+    //!
+    static uint64_t Hash(const Key &key);
+
+    //!
+    //! \brief    Insert a template created for the key
+    //! \return   GMM_RESOURCE_INFO *
+    //!           Template to destroy, either the evicted one or the given one if
+    //!           another thread cached the same key meanwhile; nullptr if none
+    //!
+    GMM_RESOURCE_INFO *Insert(const Key &key, uint64_t hash, GMM_RESOURCE_INFO *resInfo);
+
+    //!
+    //! \brief    Destroy all templates
+    //!
+    void Clear();
+
+    //!
+    //! \brief    GMM resource info operations, called without the cache lock except copying a template
+    //!
+    virtual GMM_RESOURCE_INFO *GmmCreateResInfo(GMM_RESCREATE_PARAMS *params);
+    virtual GMM_RESOURCE_INFO *GmmCopyResInfo(GMM_RESOURCE_INFO *resInfo);
+    virtual void GmmDestroyResInfo(GMM_RESOURCE_INFO *resInfo);
+
+    GMM_CLIENT_CONTEXT *m_gmmClientContext = nullptr;
+    std::vector<Entry>  m_entries;
+    std::mutex          m_mutex;
+    uint64_t            m_useCount = 0;
+    Statistics          m_stats    = {};
+};
+
+#endif  // __MEDIA_LIBVA_GMM_CACHE_H__
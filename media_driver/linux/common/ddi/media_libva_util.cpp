@@ -45,6 +45,7 @@
 #include "media_libva_decoder.h"
 #include "media_libva_encoder.h"
 #include "media_libva_caps.h"
+#include "media_libva_gmm_cache.h"
 #include "memory_policy_manager.h"
 #include "drm_fourcc.h"
 
@@ -145,6 +146,57 @@ bool DdiMediaUtil_IsExternalSurface(PDDI_MEDIA_SURFACE surface)
     }
 }
 
+//!
+//! \brief  Create GMM resource info, from the cached template of same parameters if enabled
+//!
+static GMM_RESOURCE_INFO *DdiMediaUtil_CreateResInfoObject(
+    PDDI_MEDIA_CONTEXT          mediaCtx,
+    GMM_RESCREATE_PARAMS       *gmmParams)
+{
+    if (mediaCtx->m_gmmResInfoCache)
+    {
+        return mediaCtx->m_gmmResInfoCache->CreateResInfoObject(gmmParams);
+    }
+    return mediaCtx->pGmmClientContext->CreateResInfoObject(gmmParams);
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    //!
+    //! \brief    Get counters of the GMM resource info cache, for ULT
+    //! \param    [in] ctx
+    //!           Pointer to VA driver context
+    //! \param    [out] hits
+    //!           Resource info copied from a template, 0 if cache is disabled
+    //! \param    [out] misses
+    //!           Resource info created by GMM, 0 if cache is disabled
+    //!
+    MOS_FUNC_EXPORT void DdiMedia_GetGmmResInfoCacheStats(VADriverContextP ctx, uint64_t *hits, uint64_t *misses)
+    {
+        MediaLibvaGmmResInfoCache::Statistics stats;
+
+        PDDI_MEDIA_CONTEXT mediaCtx = ctx ? DdiMedia_GetMediaContext(ctx) : nullptr;
+        if (mediaCtx && mediaCtx->m_gmmResInfoCache)
+        {
+            stats = mediaCtx->m_gmmResInfoCache->GetStatistics();
+        }
+
+        if (hits)
+        {
+            *hits = stats.hits;
+        }
+        if (misses)
+        {
+            *misses = stats.misses;
+        }
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
 //!
 //! \brief  Allocate surface
 //!
@@ -705,7 +757,7 @@ VAStatus DdiMediaUtil_AllocateSurface(
         gmmParams.Flags.Gpu.Video = true;
         gmmParams.Flags.Info.LocalOnly = MEDIA_IS_SKU(&mediaDrvCtx->SkuTable, FtrLocalMemory);
 
-        mediaSurface->pGmmResourceInfo = gmmResourceInfo = mediaDrvCtx->pGmmClientContext->CreateResInfoObject(&gmmParams);
+        mediaSurface->pGmmResourceInfo = gmmResourceInfo = DdiMediaUtil_CreateResInfoObject(mediaDrvCtx, &gmmParams);
 
         if(nullptr == gmmResourceInfo)
         {
@@ -838,7 +890,7 @@ VAStatus DdiMediaUtil_AllocateBuffer(
     DDI_CHK_NULL(mediaBuffer->pMediaCtx, "MediaCtx is null", VA_STATUS_ERROR_INVALID_BUFFER);
     gmmParams.Flags.Info.LocalOnly = MEDIA_IS_SKU(&mediaBuffer->pMediaCtx->SkuTable, FtrLocalMemory);
 
-    mediaBuffer->pGmmResourceInfo = mediaBuffer->pMediaCtx->pGmmClientContext->CreateResInfoObject(&gmmParams);
+    mediaBuffer->pGmmResourceInfo = DdiMediaUtil_CreateResInfoObject(mediaBuffer->pMediaCtx, &gmmParams);
 
     DDI_CHK_NULL(mediaBuffer->pGmmResourceInfo, "pGmmResourceInfo is nullptr", VA_STATUS_ERROR_INVALID_BUFFER);
     mediaBuffer->pGmmResourceInfo->OverrideSize(mediaBuffer->iSize);
@@ -931,7 +983,7 @@ VAStatus DdiMediaUtil_Allocate2DBuffer(
     DDI_CHK_NULL(mediaBuffer->pMediaCtx, "MediaCtx is null", VA_STATUS_ERROR_INVALID_BUFFER);
     gmmParams.Flags.Info.LocalOnly = MEDIA_IS_SKU(&mediaBuffer->pMediaCtx->SkuTable, FtrLocalMemory);
     GMM_RESOURCE_INFO          *gmmResourceInfo;
-    mediaBuffer->pGmmResourceInfo = gmmResourceInfo = mediaBuffer->pMediaCtx->pGmmClientContext->CreateResInfoObject(&gmmParams);
+    mediaBuffer->pGmmResourceInfo = gmmResourceInfo = DdiMediaUtil_CreateResInfoObject(mediaBuffer->pMediaCtx, &gmmParams);
 
     if(nullptr == gmmResourceInfo)
     {
@@ -1002,9 +1054,28 @@ VAStatus DdiMediaUtil_CreateSurface(DDI_MEDIA_SURFACE  *surface, PDDI_MEDIA_CONT
     if (VA_STATUS_SUCCESS == hr && nullptr != surface->bo)
         surface->base = surface->name;
 
+    // Surface copied from a former one gets new memory
+    surface->decompState   = DDI_MEDIA_DECOMP_STATE_UNKNOWN;
+    surface->uiDecompEpoch = 0;
+
     return hr;
 }
 
+void DdiMediaUtil_InvalidateDecompState(PDDI_MEDIA_CONTEXT mediaCtx, DDI_MEDIA_SURFACE *surface)
+{
+    if (nullptr == mediaCtx || nullptr == surface)
+    {
+        return;
+    }
+
+    DdiMediaUtil_LockMutex(&mediaCtx->SurfaceMutex);
+    if (surface->decompState != DDI_MEDIA_DECOMP_STATE_UNTRACKED)
+    {
+        surface->decompState = DDI_MEDIA_DECOMP_STATE_UNKNOWN;
+    }
+    DdiMediaUtil_UnLockMutex(&mediaCtx->SurfaceMutex);
+}
+
 VAStatus DdiMediaUtil_CreateBuffer(DDI_MEDIA_BUFFER *buffer, MOS_BUFMGR *bufmgr)
 {
     VAStatus hr = VA_STATUS_SUCCESS;
@@ -1573,7 +1644,13 @@ void DdiMediaUtil_DestroyMutex(PMEDIA_MUTEX_T  mutex)
 
 void DdiMediaUtil_LockMutex(PMEDIA_MUTEX_T  mutex)
 {
-    int32_t ret = pthread_mutex_lock(mutex);
+    int32_t ret = MosUtilities::m_mosCostAccounting ? pthread_mutex_trylock(mutex) : pthread_mutex_lock(mutex);
+    if (ret == EBUSY)
+    {
+        uint64_t start = MosUtilities::MosGetCurTime();
+        ret            = pthread_mutex_lock(mutex);
+        MosUtilities::MosLockContended(MosUtilities::MosGetCurTime() - start);
+    }
     if(ret != 0)
     {
         DDI_NORMALMESSAGE("can't lock the mutex!\n");
@@ -1821,6 +1898,16 @@ void DdiMediaUtil_UnRefBufObjInMediaBuffer(PDDI_MEDIA_BUFFER buf)
     mos_bo_unreference(buf->bo);
 }
 
+void DdiMediaUtil_MarkBufferWritten(PDDI_MEDIA_BUFFER buf)
+{
+    static int32_t writeSeq = 0;
+
+    if (buf != nullptr)
+    {
+        buf->uiWriteSeq = (uint32_t)MosUtilities::MosAtomicIncrement(&writeSeq);
+    }
+}
+
 // Open Intel's Graphics Device to get the file descriptor
 int32_t DdiMediaUtil_OpenGraphicsAdaptor(char *devName)
 {
@@ -134,6 +134,16 @@ void     DdiMediaUtil_UnlockBuffer(DDI_MEDIA_BUFFER *buf);
 //!
 void     DdiMediaUtil_FreeSurface(DDI_MEDIA_SURFACE *surface);
 
+//!
+//! \brief  Mark surface as possibly compressed after a GPU write is submitted to it
+//!
+//! \param  [in] mediaCtx
+//!         Pointer to ddi media context
+//! \param  [in] surface
+//!         Ddi media surface written, may be nullptr
+//!
+void     DdiMediaUtil_InvalidateDecompState(PDDI_MEDIA_CONTEXT mediaCtx, DDI_MEDIA_SURFACE *surface);
+
 //!
 //! \brief  Free buffer
 //! 
@@ -354,6 +364,16 @@ void     DdiMediaUtil_ReleasePVAContextFromHeap(PDDI_MEDIA_HEAP vaContextHeap, u
 //!
 void     DdiMediaUtil_UnRefBufObjInMediaBuffer(PDDI_MEDIA_BUFFER buf);
 
+//!
+//! \brief  Mark the contents of media buffer as written
+//! \details Gives the buffer a new write sequence number, unique in process, so that
+//!          consumers of the buffer can tell whether it changed since they last used it
+//! 
+//! \param  [in] buf
+//!         Pointer to ddi media buffer
+//!
+void     DdiMediaUtil_MarkBufferWritten(PDDI_MEDIA_BUFFER buf);
+
 //!
 //! \brief  Open Intel's Graphics Device to get the file descriptor
 //! 
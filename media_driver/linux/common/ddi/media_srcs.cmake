@@ -24,6 +24,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_caps.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_common.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_util.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/media_libva_gmm_cache.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_apo_decision.cpp
 )
 
@@ -36,6 +37,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_caps_factory.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_common.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_util.h
+    ${CMAKE_CURRENT_LIST_DIR}/media_libva_gmm_cache.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_apo_decision.h
 )
 
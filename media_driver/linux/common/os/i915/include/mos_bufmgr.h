@@ -231,6 +231,7 @@ struct mos_linux_bo *mos_bo_gem_create_from_name(struct mos_bufmgr *bufmgr,
 void mos_bufmgr_gem_enable_reuse(struct mos_bufmgr *bufmgr);
 void mos_bufmgr_gem_enable_fenced_relocs(struct mos_bufmgr *bufmgr);
 void mos_bufmgr_gem_enable_softpin(struct mos_bufmgr *bufmgr, bool va1m_align);
+void mos_bufmgr_gem_enable_indexed_vma_heap(struct mos_bufmgr *bufmgr);
 void mos_bufmgr_gem_set_vma_cache_size(struct mos_bufmgr *bufmgr,
                          int limit);
 int mos_bufmgr_gem_get_memory_info(struct mos_bufmgr *bufmgr, char *info, uint32_t length);
@@ -242,6 +243,7 @@ int mos_gem_bo_unmap_wc(struct mos_linux_bo *bo);
 
 int mos_gem_bo_get_fake_offset(struct mos_linux_bo *bo);
 int mos_gem_bo_get_reloc_count(struct mos_linux_bo *bo);
+int mos_gem_bo_get_softpin_target_count(struct mos_linux_bo *bo);
 void mos_gem_bo_start_gtt_access(struct mos_linux_bo *bo, int write_enable);
 
 void
@@ -42,6 +42,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/memory_policy_manager_specific.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_os_mock_adaptor_specific.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_vma.c
+    ${CMAKE_CURRENT_LIST_DIR}/mos_vma_indexed.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_oca_specific.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_decompression.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_mediacopy.cpp
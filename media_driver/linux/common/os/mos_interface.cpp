@@ -944,6 +944,7 @@ MOS_STATUS MosInterface::SubmitCommandBuffer(
     bool                  nullRendering)
 {
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
+    NULLHW_LAYER_SCOPE(NullHW::LayerMos);
 
     MOS_OS_CHK_NULL_RETURN(streamState);
 
@@ -1625,6 +1626,7 @@ MOS_STATUS MosInterface::AllocateResource(
 {
     MOS_STATUS estatus = MOS_STATUS_SUCCESS;
     MOS_OS_FUNCTION_ENTER;
+    NULLHW_LAYER_SCOPE(NullHW::LayerMos);
 
     MOS_OS_CHK_NULL_RETURN(resource);
     MOS_OS_CHK_NULL_RETURN(streamState);
@@ -1692,6 +1694,7 @@ MOS_STATUS MosInterface::FreeResource(
 )
 {
     MOS_OS_FUNCTION_ENTER;
+    NULLHW_LAYER_SCOPE(NullHW::LayerMos);
 
     MOS_OS_CHK_NULL_RETURN(resource);
     MOS_OS_CHK_NULL_RETURN(streamState);
@@ -1888,6 +1891,7 @@ void *MosInterface::LockMosResource(
     PMOS_LOCK_PARAMS    flags)
 {
     MOS_OS_FUNCTION_ENTER;
+    NULLHW_LAYER_SCOPE(NullHW::LayerMos);
 
     void *pData    = nullptr;
 
@@ -2939,6 +2943,8 @@ int32_t MosInterface::IsGPUHung(
         streamState->gpuActiveBatch   = activeBatch;
         streamState->gpuPendingBatch  = pendingBatch;
         result                        = true;
+
+        MosOcaSubmissionHistory::GetInstance().OnGpuReset(resetCount, activeBatch, pendingBatch);
     }
     else
     {
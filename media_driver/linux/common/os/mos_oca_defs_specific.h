@@ -28,8 +28,15 @@
 #define __MOS_OCA_DEFS_SPECIFIC_H__
 
 #include "mos_oca_defs.h"
+#include <atomic>
 #include <cstdint>
 
+#define MOS_OCA_SUBMISSION_HISTORY_DEPTH        32      //!< Submissions kept for each gpu context.
+#define MOS_OCA_SUBMISSION_HISTORY_RING_COUNT   32      //!< Gpu contexts recorded at the same time.
+#define MOS_OCA_SUBMISSION_MAX_RES_COUNT        8       //!< Resource addresses kept for each submission.
+#define MOS_OCA_SUBMISSION_MAX_SUB_BB_COUNT     4       //!< Secondary batch buffer addresses kept for each submission.
+#define MOS_OCA_INVALID_HISTORY_RING            -1
+
 typedef struct _MOS_OCA_BUFFER_CONFIG
 {
     uint32_t            maxResInfoCount = 0;                                                                //!< Max resource info count.
@@ -91,4 +98,39 @@ struct MOS_OCA_BUF_CONTEXT
            
 };
 
+/****************************************************************************************************/
+/*                                   SUBMISSION HISTORY                                             */
+/****************************************************************************************************/
+typedef struct _MOS_OCA_SUBMISSION_RECORD
+{
+    uint64_t                    sequence;                                           //!< Submission count of the gpu context, 0 for empty record.
+    uint64_t                    timestamp;                                          //!< CPU time of submission in us.
+    uint64_t                    batchBufferGfxAddress;                              //!< Gfx address of 1st level batch buffer.
+    uint64_t                    subBBGfxAddress[MOS_OCA_SUBMISSION_MAX_SUB_BB_COUNT];   //!< Gfx address of secondary batch buffers in scalability mode.
+    uint64_t                    resGfxAddress[MOS_OCA_SUBMISSION_MAX_RES_COUNT];        //!< Gfx address of resources, written ones first.
+    uint32_t                    batchBufferSize;                                    //!< Bytes of commands in 1st level batch buffer.
+    uint32_t                    gpuContextHandle;
+    uint32_t                    gpuNode;
+    uint32_t                    component;                                          //!< MOS_COMPONENT of the stream.
+    uint32_t                    perfTag;                                            //!< Perf tag, which identifies pipeline and feature.
+    uint32_t                    fence;                                              //!< Gpu status tag of submission.
+    uint32_t                    submissionType;
+    uint32_t                    subBBCount;
+    uint32_t                    resCount;                                           //!< Resource count of submission, may exceed MOS_OCA_SUBMISSION_MAX_RES_COUNT.
+    int32_t                     result;                                             //!< Return value of exec ioctl.
+}MOS_OCA_SUBMISSION_RECORD, *PMOS_OCA_SUBMISSION_RECORD;
+
+struct MOS_OCA_SUBMISSION_RING
+{
+    struct SLOT
+    {
+        std::atomic<uint64_t>           sequence;                                   //!< Sequence of record, 0 while being written.
+        MOS_OCA_SUBMISSION_RECORD       record;
+    };
+
+    std::atomic<bool>                   inUse;
+    std::atomic<uint64_t>               writeCount;
+    SLOT                                slots[MOS_OCA_SUBMISSION_HISTORY_DEPTH];
+};
+
 #endif // #ifndef __MOS_OCA_DEFS_SPECIFIC_H__
\ No newline at end of file
@@ -27,6 +27,7 @@
 #ifndef __MOS_OCA_INTERFACE_SPECIFIC_H__
 #define __MOS_OCA_INTERFACE_SPECIFIC_H__
 
+#include <mutex>
 #include "mos_oca_interface.h"
 #include "mos_interface.h"
 #include "mos_oca_defs_specific.h"
@@ -316,4 +317,82 @@ private:
     static bool                     s_bOcaStatusExistInReg;         //!< ture if "Oca Status" already being added to reg.
     static int32_t                  s_refCount;
 };
+
+//!
+//! \class  MosOcaSubmissionHistory
+//! \brief  Keeps the last submissions of each gpu context for gpu hang analysis.
+//! \details Records are written into preallocated rings without any lock, which keeps it cheap
+//!          enough to be always on. They are dumped as trace events on demand or when gpu reset
+//!          is detected.
+//!
+class MosOcaSubmissionHistory
+{
+public:
+    static MosOcaSubmissionHistory &GetInstance();
+
+    //!
+    //! \brief  Get a free ring for gpu context.
+    //! \return int32_t
+    //!         Ring index, MOS_OCA_INVALID_HISTORY_RING if all rings are in use.
+    //!
+    int32_t AcquireRing();
+
+    //!
+    //! \brief  Give the ring back when gpu context is destroyed.
+    //! \details Records are kept until the ring is acquired again, since the hang may be
+    //!          detected after the gpu context is gone.
+    //! \param  [in] ring
+    //!         Ring index returned by AcquireRing.
+    //!
+    void ReleaseRing(int32_t ring);
+
+    //!
+    //! \brief  Add submission to ring, overwriting the oldest one.
+    //! \param  [in] ring
+    //!         Ring index returned by AcquireRing.
+    //! \param  [in, out] record
+    //!         Submission info, sequence and timestamp are filled here.
+    //!
+    void Record(int32_t ring, MOS_OCA_SUBMISSION_RECORD &record);
+
+    //!
+    //! \brief  Copy the records of ring, oldest first.
+    //! \param  [in] ring
+    //!         Ring index.
+    //! \param  [out] records
+    //!         Array to receive records.
+    //! \param  [in] maxCount
+    //!         Size of records.
+    //! \return uint32_t
+    //!         Count of records copied.
+    //!
+    uint32_t GetRecords(int32_t ring, MOS_OCA_SUBMISSION_RECORD *records, uint32_t maxCount);
+
+    //!
+    //! \brief  Dump records of all rings as EVENT_OCA_SUBMISSION_HISTORY trace events.
+    //! \param  [in] reason
+    //!         Why the records are dumped.
+    //!
+    void Dump(const char *reason);
+
+    //!
+    //! \brief  Dump records after gpu reset detected, at most once per second.
+    //! \param  [in] resetCount
+    //!         Reset count reported by kernel.
+    //! \param  [in] activeBatch
+    //!         Count of batches of context active during reset.
+    //! \param  [in] pendingBatch
+    //!         Count of batches of context pending during reset.
+    //!
+    void OnGpuReset(uint32_t resetCount, uint32_t activeBatch, uint32_t pendingBatch);
+
+private:
+    MosOcaSubmissionHistory();
+    MosOcaSubmissionHistory(MosOcaSubmissionHistory &) = delete;
+    MosOcaSubmissionHistory &operator=(MosOcaSubmissionHistory &) = delete;
+
+    MOS_OCA_SUBMISSION_RING         m_rings[MOS_OCA_SUBMISSION_HISTORY_RING_COUNT];
+    std::atomic<uint64_t>           m_lastResetDumpTime;                            //!< Time of last dump for gpu reset in us.
+    std::mutex                      m_dumpMutex;
+};
 #endif  // __MOS_OCA_INTERFACE_SPECIFIC_H__
\ No newline at end of file
@@ -221,7 +221,19 @@ MOS_STATUS MosOcaInterfaceSpecific::On1stLevelBBEnd(MOS_OCA_BUFFER_HANDLE ocaBuf
 //!
 MOS_STATUS MosOcaInterfaceSpecific::OnSubLevelBBStart(MOS_OCA_BUFFER_HANDLE ocaBufHandle, PMOS_CONTEXT pMosContext, void *pMosResource, uint32_t offsetOfSubLevelBB, bool bUseSizeOfResource, uint32_t sizeOfSubLevelBB)
 {
-    return MOS_STATUS_UNIMPLEMENTED;
+    if (!m_isOcaEnabled)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+    if (ocaBufHandle >= MAX_NUM_OF_OCA_BUF_CONTEXT || ocaBufHandle < 0)
+    {
+        MosOcaInterfaceSpecific::OnOcaError(pMosContext, MOS_STATUS_INVALID_PARAMETER, __FUNCTION__, __LINE__);
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+    MOS_OCA_CHK_NULL_RETURN(pMosContext, pMosResource, __FUNCTION__, __LINE__);
+
+    // Sub level BB is not copied to log section, its address is recorded with other resources.
+    return AddResourceToDumpList(ocaBufHandle, pMosContext, *(PMOS_RESOURCE)pMosResource, MOS_MI_BATCH_BUFFER_START, 0, offsetOfSubLevelBB);
 }
 
 //!
@@ -243,7 +255,19 @@ MOS_STATUS MosOcaInterfaceSpecific::OnSubLevelBBStart(MOS_OCA_BUFFER_HANDLE ocaB
 //!
 MOS_STATUS MosOcaInterfaceSpecific::OnIndirectState(MOS_OCA_BUFFER_HANDLE ocaBufHandle, PMOS_CONTEXT pMosContext, void *pMosResource, uint32_t offsetOfIndirectState, bool bUseSizeOfResource, uint32_t sizeOfIndirectState)
 {
-    return MOS_STATUS_UNIMPLEMENTED;
+    if (!m_isOcaEnabled)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+    if (ocaBufHandle >= MAX_NUM_OF_OCA_BUF_CONTEXT || ocaBufHandle < 0)
+    {
+        MosOcaInterfaceSpecific::OnOcaError(pMosContext, MOS_STATUS_INVALID_PARAMETER, __FUNCTION__, __LINE__);
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+    MOS_OCA_CHK_NULL_RETURN(pMosContext, pMosResource, __FUNCTION__, __LINE__);
+
+    // The heap is recorded with the largest offset used, which tells how much of it is valid.
+    return AddResourceToDumpList(ocaBufHandle, pMosContext, *(PMOS_RESOURCE)pMosResource, MOS_STATE_BASE_ADDR, 0, offsetOfIndirectState);
 }
 
 //!
@@ -263,7 +287,18 @@ MOS_STATUS MosOcaInterfaceSpecific::OnIndirectState(MOS_OCA_BUFFER_HANDLE ocaBuf
 //!
 MOS_STATUS MosOcaInterfaceSpecific::OnDispatch(uint32_t &offsetInIndirectStateHeap, MOS_OCA_BUFFER_HANDLE ocaBufHandle, PMOS_CONTEXT mosCtx)
 {
-    return MOS_STATUS_UNIMPLEMENTED;
+    // No oca heap on linux. Dispatch states are found by the indirect states in resource info.
+    offsetInIndirectStateHeap = OCA_HEAP_INVALID_OFFSET;
+    if (!m_isOcaEnabled)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+    if (ocaBufHandle >= MAX_NUM_OF_OCA_BUF_CONTEXT || ocaBufHandle < 0)
+    {
+        MosOcaInterfaceSpecific::OnOcaError(mosCtx, MOS_STATUS_INVALID_PARAMETER, __FUNCTION__, __LINE__);
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+    return MOS_STATUS_SUCCESS;
 }
 
 //!
@@ -758,3 +793,150 @@ void MosOcaInterfaceSpecific::UninitInterface()
     return;
 }
 
+/****************************************************************************************************/
+/*                                     MosOcaSubmissionHistory                                      */
+/****************************************************************************************************/
+
+MosOcaSubmissionHistory &MosOcaSubmissionHistory::GetInstance()
+{
+    static MosOcaSubmissionHistory instance;
+    return instance;
+}
+
+MosOcaSubmissionHistory::MosOcaSubmissionHistory()
+{
+    for (auto &ring : m_rings)
+    {
+        ring.inUse.store(false);
+        ring.writeCount.store(0);
+        for (auto &slot : ring.slots)
+        {
+            slot.sequence.store(0);
+            MosUtilities::MosZeroMemory(&slot.record, sizeof(slot.record));
+        }
+    }
+    m_lastResetDumpTime.store(0);
+}
+
+int32_t MosOcaSubmissionHistory::AcquireRing()
+{
+    for (int32_t i = 0; i < MOS_OCA_SUBMISSION_HISTORY_RING_COUNT; ++i)
+    {
+        bool expected = false;
+        if (!m_rings[i].inUse.load(std::memory_order_relaxed) &&
+            m_rings[i].inUse.compare_exchange_strong(expected, true))
+        {
+            // Drop the records of former owner.
+            for (auto &slot : m_rings[i].slots)
+            {
+                slot.sequence.store(0, std::memory_order_relaxed);
+            }
+            m_rings[i].writeCount.store(0, std::memory_order_release);
+            return i;
+        }
+    }
+    MOS_OS_NORMALMESSAGE("No free submission history ring, submissions of the gpu context are not recorded.");
+    return MOS_OCA_INVALID_HISTORY_RING;
+}
+
+void MosOcaSubmissionHistory::ReleaseRing(int32_t ring)
+{
+    if (ring < 0 || ring >= MOS_OCA_SUBMISSION_HISTORY_RING_COUNT)
+    {
+        return;
+    }
+    m_rings[ring].inUse.store(false, std::memory_order_release);
+}
+
+void MosOcaSubmissionHistory::Record(int32_t ring, MOS_OCA_SUBMISSION_RECORD &record)
+{
+    if (ring < 0 || ring >= MOS_OCA_SUBMISSION_HISTORY_RING_COUNT)
+    {
+        return;
+    }
+
+    // Each writer owns the slot of its sequence. The slot sequence is cleared while writing,
+    // so that a reader copying at the same time drops the record instead of reading a torn one.
+    uint64_t sequence = m_rings[ring].writeCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    auto    &slot     = m_rings[ring].slots[(sequence - 1) % MOS_OCA_SUBMISSION_HISTORY_DEPTH];
+
+    record.sequence  = sequence;
+    record.timestamp = MosUtilities::MosGetCurTime();
+
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.record = record;
+    slot.sequence.store(sequence, std::memory_order_release);
+}
+
+uint32_t MosOcaSubmissionHistory::GetRecords(int32_t ring, MOS_OCA_SUBMISSION_RECORD *records, uint32_t maxCount)
+{
+    if (ring < 0 || ring >= MOS_OCA_SUBMISSION_HISTORY_RING_COUNT || nullptr == records)
+    {
+        return 0;
+    }
+
+    uint64_t writeCount = m_rings[ring].writeCount.load(std::memory_order_acquire);
+    uint64_t first      = writeCount > MOS_OCA_SUBMISSION_HISTORY_DEPTH ? writeCount - MOS_OCA_SUBMISSION_HISTORY_DEPTH + 1 : 1;
+    uint32_t count      = 0;
+
+    for (uint64_t sequence = first; sequence <= writeCount && count < maxCount; ++sequence)
+    {
+        auto &slot = m_rings[ring].slots[(sequence - 1) % MOS_OCA_SUBMISSION_HISTORY_DEPTH];
+        if (slot.sequence.load(std::memory_order_acquire) != sequence)
+        {
+            // Being written, or already overwritten by a newer submission.
+            continue;
+        }
+        records[count] = slot.record;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void MosOcaSubmissionHistory::Dump(const char *reason)
+{
+    std::lock_guard<std::mutex> lock(m_dumpMutex);
+    MOS_OCA_SUBMISSION_RECORD   records[MOS_OCA_SUBMISSION_HISTORY_DEPTH];
+
+    uint32_t reasonLen = reason ? strnlen(reason, MOS_OCA_MAX_STRING_LEN) : 0;
+    MOS_TraceEventExt(EVENT_OCA_SUBMISSION_HISTORY, EVENT_TYPE_START, reason, reasonLen, nullptr, 0);
+    MOS_OS_NORMALMESSAGE("Dump submission history: %s", reason ? reason : "on demand");
+
+    for (int32_t ring = 0; ring < MOS_OCA_SUBMISSION_HISTORY_RING_COUNT; ++ring)
+    {
+        uint32_t count = GetRecords(ring, records, MOS_OCA_SUBMISSION_HISTORY_DEPTH);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            MOS_OCA_SUBMISSION_RECORD &record = records[i];
+            MOS_TraceEventExt(EVENT_OCA_SUBMISSION_HISTORY, EVENT_TYPE_INFO, &ring, sizeof(ring), &record, sizeof(record));
+            MOS_OS_NORMALMESSAGE("ring %d seq %llu: ctx %u node %u component %u perfTag 0x%x fence %u bb 0x%llx size %u subBB %u res %u result %d",
+                ring, (unsigned long long)record.sequence, record.gpuContextHandle, record.gpuNode, record.component,
+                record.perfTag, record.fence, (unsigned long long)record.batchBufferGfxAddress, record.batchBufferSize,
+                record.subBBCount, record.resCount, record.result);
+        }
+    }
+
+    MOS_TraceEventExt(EVENT_OCA_SUBMISSION_HISTORY, EVENT_TYPE_END, nullptr, 0, nullptr, 0);
+}
+
+void MosOcaSubmissionHistory::OnGpuReset(uint32_t resetCount, uint32_t activeBatch, uint32_t pendingBatch)
+{
+    // Every stream on the device sees the same reset, dump for the first one only.
+    uint64_t now  = MosUtilities::MosGetCurTime();
+    uint64_t last = m_lastResetDumpTime.load(std::memory_order_relaxed);
+    if ((last != 0 && now - last < 1000000) ||
+        !m_lastResetDumpTime.compare_exchange_strong(last, now))
+    {
+        return;
+    }
+
+    char reason[128] = {};
+    MosUtilities::MosSecureStringPrint(reason, sizeof(reason), sizeof(reason) - 1,
+        "gpu reset: reset count %u, active batch %u, pending batch %u", resetCount, activeBatch, pendingBatch);
+    Dump(reason);
+}
@@ -65,6 +65,7 @@
 #include "memory_policy_manager.h"
 #include "mos_oca_interface_specific.h"
 #include "mos_os_next.h"
+#include "mos_vdbox_scheduler_specific.h"
 
 //!
 //! \brief DRM VMAP patch
@@ -6355,6 +6356,7 @@ MOS_STATUS Mos_Specific_CreateVideoNodeAssociation(
     PMOS_OS_CONTEXT         pOsContext;
     PVDBOX_WORKLOAD         pVDBoxWorkLoad = nullptr;
     MOS_STATUS              eStatus = MOS_STATUS_SUCCESS;
+    bool                    bDisableLoadAware = false;
 
     MOS_OS_FUNCTION_ENTER;
 
@@ -6363,6 +6365,14 @@ MOS_STATUS Mos_Specific_CreateVideoNodeAssociation(
 
     pOsContext = pOsInterface->pOsContext;
 
+    // Load aware scheduling can be turned off to fall back to session count ping-pong
+    ReadUserSetting(
+        pOsInterface->pfnGetUserSettingInstance(pOsInterface),
+        bDisableLoadAware,
+        __MEDIA_USER_FEATURE_VALUE_DISABLE_VDBOX_LOAD_AWARE_SCHEDULING,
+        MediaUserSetting::Group::Device);
+    pOsContext->bVdboxLoadAware = !bDisableLoadAware;
+
     if (false == pOsContext->bKMDHasVCS2)
     {
         *pVideoNodeOrdinal = MOS_GPU_NODE_VIDEO;
@@ -6421,6 +6431,24 @@ MOS_STATUS Mos_Specific_CreateVideoNodeAssociation(
         {
             MOS_OS_ASSERTMESSAGE("VDBoxWorkLoad not set.");
         }
+        if (pOsContext->bVdboxLoadAware)
+        {
+            MosVdboxScheduler::Instance().AddSession(*pVideoNodeOrdinal);
+        }
+    }
+    else if (pOsContext->bVdboxLoadAware)
+    {
+        // Place the session on the VDBox with least work in flight, session counts
+        // of all processes are used when the loads are equal, e.g. no work yet.
+        *pVideoNodeOrdinal = MosVdboxScheduler::Instance().SelectSessionNode(pVDBoxWorkLoad->uiVDBoxCount);
+        if (*pVideoNodeOrdinal == MOS_GPU_NODE_VIDEO)
+        {
+            pVDBoxWorkLoad->uiVDBoxCount[0]++;
+        }
+        else
+        {
+            pVDBoxWorkLoad->uiVDBoxCount[1]++;
+        }
     }
     else
     {
@@ -6508,6 +6536,12 @@ MOS_STATUS Mos_Specific_DestroyVideoNodeAssociation(
 
     UnLockSemaphore(pOsContext->semid);
 
+    if (pOsContext->bVdboxLoadAware)
+    {
+        MosVdboxScheduler::Instance().RemoveSession(VideoNodeOrdinal);
+        MosVdboxScheduler::Instance().ReportEngineStats();
+    }
+
     return MOS_STATUS_SUCCESS;
 }
 #endif
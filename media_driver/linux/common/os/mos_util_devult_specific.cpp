@@ -26,5 +26,40 @@
 //!
 
 #include "mos_util_devult_specific.h"
+#include "mos_os.h"
 
 MOS_DATA_EXPORT void (*pfnUltGetCmdBuf)(PMOS_COMMAND_BUFFER pCmdBuffer) = nullptr;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    MOS_FUNC_EXPORT void MOS_GetCmdBufPatchCount(PMOS_COMMAND_BUFFER pCmdBuffer, uint32_t *relocCount, uint32_t *softpinCount)
+    {
+        if (relocCount)
+        {
+            *relocCount = 0;
+        }
+        if (softpinCount)
+        {
+            *softpinCount = 0;
+        }
+        if (pCmdBuffer == nullptr || pCmdBuffer->OsResource.bo == nullptr)
+        {
+            return;
+        }
+
+        // Patches are still in the bo when pfnUltGetCmdBuf is called, they are cleared after submission.
+        if (relocCount)
+        {
+            *relocCount = (uint32_t)mos_gem_bo_get_reloc_count(pCmdBuffer->OsResource.bo);
+        }
+        if (softpinCount)
+        {
+            *softpinCount = (uint32_t)mos_gem_bo_get_softpin_target_count(pCmdBuffer->OsResource.bo);
+        }
+    }
+
+#ifdef __cplusplus
+}
+#endif
@@ -24,6 +24,7 @@
 //! \brief    interface for virtual memory address allocation
 //!
 
+#include <string.h>
 #include "mos_vma.h"
 
 void
@@ -31,16 +32,45 @@ mos_vma_heap_init(mos_vma_heap *heap, uint64_t start, uint64_t size)
 {
     assert(heap);
     list_inithead(&heap->holes);
+    heap->index = nullptr;
     mos_vma_heap_free(heap, start, size);
+    heap->alloc_count = 0;
+    heap->free_count = 0;
+    heap->failed_count = 0;
 
     /* Default to using high addresses */
     heap->alloc_high = true;
 }
 
+void
+mos_vma_heap_init_indexed(mos_vma_heap *heap, uint64_t start, uint64_t size)
+{
+    assert(heap);
+    list_inithead(&heap->holes);
+    heap->index = mos_vma_index_create(start, size);
+    heap->alloc_high = true;
+    heap->alloc_count = 0;
+    heap->free_count = 0;
+    heap->failed_count = 0;
+
+    if (heap->index == nullptr)
+    {
+        /* Fall back to the hole list */
+        mos_vma_heap_init(heap, start, size);
+    }
+}
+
 void
 mos_vma_heap_finish(mos_vma_heap *heap)
 {
     assert(heap);
+    if (heap->index)
+    {
+        mos_vma_index_destroy(heap->index);
+        heap->index = nullptr;
+        return;
+    }
+
     list_for_each_entry_safe(mos_vma_hole, hole, &heap->holes, link)
     {
         free(hole);
@@ -145,6 +175,16 @@ mos_vma_heap_alloc(mos_vma_heap *heap, uint64_t size, uint64_t alignment)
     assert(size > 0);
     assert(alignment > 0);
 
+    if (heap->index)
+    {
+        uint64_t addr = mos_vma_index_alloc(heap->index, size, alignment, heap->alloc_high);
+        if (addr)
+            heap->alloc_count++;
+        else
+            heap->failed_count++;
+        return addr;
+    }
+
     mos_vma_heap_validate(heap);
 
     if (heap->alloc_high) {
@@ -171,6 +211,7 @@ mos_vma_heap_alloc(mos_vma_heap *heap, uint64_t size, uint64_t alignment)
 
             mos_vma_hole_alloc(hole, offset, size);
             mos_vma_heap_validate(heap);
+            heap->alloc_count++;
             return offset;
         }
     } else {
@@ -192,11 +233,13 @@ mos_vma_heap_alloc(mos_vma_heap *heap, uint64_t size, uint64_t alignment)
 
             mos_vma_hole_alloc(hole, offset, size);
             mos_vma_heap_validate(heap);
+            heap->alloc_count++;
             return offset;
         }
     }
 
     /* Failed to allocate */
+    heap->failed_count++;
     return 0;
 }
 
@@ -217,6 +260,9 @@ mos_vma_heap_alloc_addr(mos_vma_heap *heap, uint64_t offset, uint64_t size)
     */
     assert(offset + size == 0 || offset + size > offset);
 
+    if (heap->index)
+        return mos_vma_index_alloc_addr(heap->index, offset, size);
+
     /* Find the hole if one exists. */
     list_for_each_entry_safe(mos_vma_hole, hole, &heap->holes, link)
     {
@@ -256,6 +302,13 @@ mos_vma_heap_free(mos_vma_heap *heap, uint64_t offset, uint64_t size)
     */
     assert(offset + size == 0 || offset + size > offset);
 
+    heap->free_count++;
+    if (heap->index)
+    {
+        mos_vma_index_free(heap->index, offset, size);
+        return;
+    }
+
     mos_vma_heap_validate(heap);
 
     /* Find immediately higher and lower holes if they exist. */
@@ -313,3 +366,32 @@ mos_vma_heap_free(mos_vma_heap *heap, uint64_t offset, uint64_t size)
 
     mos_vma_heap_validate(heap);
 }
+
+void
+mos_vma_heap_get_stats(mos_vma_heap *heap, mos_vma_heap_stats *stats)
+{
+    assert(heap);
+    assert(stats);
+    memset(stats, 0, sizeof(*stats));
+
+    if (heap->index)
+    {
+        mos_vma_index_get_stats(heap->index, stats);
+    }
+    else
+    {
+        list_for_each_entry(mos_vma_hole, hole, &heap->holes, link)
+        {
+            stats->free_size += hole->size;
+            stats->hole_count++;
+            if (hole->size > stats->largest_hole)
+                stats->largest_hole = hole->size;
+        }
+    }
+
+    if (stats->free_size)
+        stats->fragmentation = (uint32_t)(100 - stats->largest_hole * 100 / stats->free_size);
+    stats->alloc_count = heap->alloc_count;
+    stats->free_count = heap->free_count;
+    stats->failed_count = heap->failed_count;
+}
@@ -37,6 +37,8 @@
 extern "C" {
 #endif
 
+struct _mos_vma_index;
+
 typedef struct _mos_vma_heap {
    struct list_head holes;
 
@@ -45,8 +47,27 @@ typedef struct _mos_vma_heap {
     * Default is true.
     */
    bool alloc_high;
+
+   /** Holes indexed by size and by address, replacing the hole list
+    *  if the heap is initialized by mos_vma_heap_init_indexed.
+    */
+   struct _mos_vma_index *index;
+
+   uint64_t alloc_count;
+   uint64_t free_count;
+   uint64_t failed_count;
 } mos_vma_heap;
 
+typedef struct _mos_vma_heap_stats {
+   uint64_t free_size;        //!< Total size of holes
+   uint64_t hole_count;       //!< Number of holes
+   uint64_t largest_hole;     //!< Size of largest hole
+   uint32_t fragmentation;    //!< Percentage of free size outside largest hole
+   uint64_t alloc_count;      //!< Successful allocations
+   uint64_t free_count;       //!< Frees
+   uint64_t failed_count;     //!< Failed allocations
+} mos_vma_heap_stats;
+
 typedef struct _mos_vma_hole {
    struct list_head link;
    uint64_t offset;
@@ -67,6 +88,23 @@ typedef struct _mos_vma_hole {
 //!
 void mos_vma_heap_init(mos_vma_heap *heap, uint64_t start, uint64_t size);
 
+//!
+//! \brief  Initialize vma heap with holes indexed by size and by address
+//! \details Allocation takes the best fit hole and free coalesces with neighbor
+//!          holes in logarithmic time of hole count, instead of walking the
+//!          hole list, which grows with fragmentation.
+//!
+//! \param  [in] heap
+//!         Pointer to vma heap which will be initialzed
+//! \param  [in] start
+//!         Start address of the heap
+//! \param  [in] size
+//!         Size of the heap
+//!
+//! \return void
+//!
+void mos_vma_heap_init_indexed(mos_vma_heap *heap, uint64_t start, uint64_t size);
+
 //!
 //! \brief  Destroy vma heap
 //!
@@ -120,6 +158,29 @@ bool mos_vma_heap_alloc_addr(mos_vma_heap *heap, uint64_t addr, uint64_t size);
 //!
 void mos_vma_heap_free(mos_vma_heap *heap, uint64_t offset, uint64_t size);
 
+//!
+//! \brief  Get fragmentation statistics of vma heap
+//!
+//! \param  [in] heap
+//!         Pointer to vma heap
+//! \param  [out] stats
+//!         Statistics of the heap
+//!
+//! \return void
+//!
+void mos_vma_heap_get_stats(mos_vma_heap *heap, mos_vma_heap_stats *stats);
+
+//!
+//! \brief  Functions of indexed vma heap, called by mos_vma_heap_* for heap initialized
+//!         by mos_vma_heap_init_indexed
+//!
+struct _mos_vma_index *mos_vma_index_create(uint64_t start, uint64_t size);
+void mos_vma_index_destroy(struct _mos_vma_index *index);
+uint64_t mos_vma_index_alloc(struct _mos_vma_index *index, uint64_t size, uint64_t alignment, bool alloc_high);
+bool mos_vma_index_alloc_addr(struct _mos_vma_index *index, uint64_t offset, uint64_t size);
+void mos_vma_index_free(struct _mos_vma_index *index, uint64_t offset, uint64_t size);
+void mos_vma_index_get_stats(struct _mos_vma_index *index, mos_vma_heap_stats *stats);
+
 #ifdef __cplusplus
 } /* extern C */
 #endif
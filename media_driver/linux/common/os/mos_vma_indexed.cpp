@@ -0,0 +1,207 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_vma_indexed.cpp
+//! \brief    virtual memory address allocation with holes indexed by size and by address
+//!
+
+#include <map>
+#include <set>
+#include <new>
+#include "mos_vma.h"
+
+struct _mos_vma_index
+{
+    //! Holes by offset, value is hole size. Used to coalesce neighbor holes on free.
+    std::map<uint64_t, uint64_t> holes_by_offset;
+    //! Holes by (size, offset). Used to find the best fit hole on allocation.
+    std::set<std::pair<uint64_t, uint64_t>> holes_by_size;
+};
+
+static void
+mos_vma_index_add_hole(_mos_vma_index *index, uint64_t offset, uint64_t size)
+{
+    index->holes_by_offset[offset] = size;
+    index->holes_by_size.insert(std::make_pair(size, offset));
+}
+
+static void
+mos_vma_index_remove_hole(_mos_vma_index *index, std::map<uint64_t, uint64_t>::iterator hole)
+{
+    index->holes_by_size.erase(std::make_pair(hole->second, hole->first));
+    index->holes_by_offset.erase(hole);
+}
+
+//!
+//! \brief  Take [offset, offset + size) out of the hole, leaving the space below and above as holes
+//!
+static void
+mos_vma_index_hole_alloc(_mos_vma_index *index, std::map<uint64_t, uint64_t>::iterator hole, uint64_t offset, uint64_t size)
+{
+    uint64_t hole_offset = hole->first;
+    uint64_t hole_size   = hole->second;
+
+    assert(hole_offset <= offset);
+    assert(hole_size >= offset - hole_offset + size);
+
+    mos_vma_index_remove_hole(index, hole);
+
+    uint64_t low_size  = offset - hole_offset;
+    uint64_t high_size = hole_size - size - low_size;
+    if (low_size)
+        mos_vma_index_add_hole(index, hole_offset, low_size);
+    if (high_size)
+        mos_vma_index_add_hole(index, offset + size, high_size);
+}
+
+struct _mos_vma_index *
+mos_vma_index_create(uint64_t start, uint64_t size)
+{
+    assert(start > 0);
+    assert(size > 0);
+
+    _mos_vma_index *index = new (std::nothrow) _mos_vma_index;
+    if (index == nullptr)
+        return nullptr;
+
+    mos_vma_index_add_hole(index, start, size);
+    return index;
+}
+
+void
+mos_vma_index_destroy(struct _mos_vma_index *index)
+{
+    delete index;
+}
+
+uint64_t
+mos_vma_index_alloc(struct _mos_vma_index *index, uint64_t size, uint64_t alignment, bool alloc_high)
+{
+    assert(index);
+    assert(size > 0);
+    assert(alignment > 0);
+
+    /* Smallest holes first, so the first one fitting with alignment is the best fit.
+    * Holes skipped for alignment are at most the ones whose size is below
+    * size + alignment, which are few for page aligned allocations.
+    */
+    for (auto it = index->holes_by_size.lower_bound(std::make_pair(size, (uint64_t)0));
+         it != index->holes_by_size.end(); ++it)
+    {
+        uint64_t hole_size   = it->first;
+        uint64_t hole_offset = it->second;
+        uint64_t offset      = 0;
+
+        if (alloc_high)
+        {
+            /* Align down from the top of the hole */
+            offset = ((hole_size - size) + hole_offset) / alignment * alignment;
+            if (offset < hole_offset)
+                continue;
+        }
+        else
+        {
+            offset = hole_offset;
+            uint64_t misalign = offset % alignment;
+            if (misalign)
+            {
+                uint64_t pad = alignment - misalign;
+                if (pad > hole_size - size)
+                    continue;
+                offset += pad;
+            }
+        }
+
+        mos_vma_index_hole_alloc(index, index->holes_by_offset.find(hole_offset), offset, size);
+        return offset;
+    }
+
+    /* Failed to allocate */
+    return 0;
+}
+
+bool
+mos_vma_index_alloc_addr(struct _mos_vma_index *index, uint64_t offset, uint64_t size)
+{
+    assert(index);
+
+    /* The hole containing offset is the last one starting at or below it */
+    auto hole = index->holes_by_offset.upper_bound(offset);
+    if (hole == index->holes_by_offset.begin())
+        return false;
+    --hole;
+
+    if (hole->second < offset - hole->first + size)
+        return false;
+
+    mos_vma_index_hole_alloc(index, hole, offset, size);
+    return true;
+}
+
+void
+mos_vma_index_free(struct _mos_vma_index *index, uint64_t offset, uint64_t size)
+{
+    assert(index);
+
+    auto high_hole = index->holes_by_offset.lower_bound(offset);
+    if (high_hole != index->holes_by_offset.end())
+    {
+        assert(offset + size <= high_hole->first);
+        if (offset + size == high_hole->first)
+        {
+            /* Merge the high hole */
+            size += high_hole->second;
+            mos_vma_index_remove_hole(index, high_hole);
+        }
+    }
+
+    auto low_hole = index->holes_by_offset.lower_bound(offset);
+    if (low_hole != index->holes_by_offset.begin())
+    {
+        --low_hole;
+        assert(low_hole->first + low_hole->second <= offset);
+        if (low_hole->first + low_hole->second == offset)
+        {
+            /* Merge into the low hole */
+            offset = low_hole->first;
+            size += low_hole->second;
+            mos_vma_index_remove_hole(index, low_hole);
+        }
+    }
+
+    mos_vma_index_add_hole(index, offset, size);
+}
+
+void
+mos_vma_index_get_stats(struct _mos_vma_index *index, mos_vma_heap_stats *stats)
+{
+    assert(index);
+    assert(stats);
+
+    for (auto &hole : index->holes_by_offset)
+    {
+        stats->free_size += hole.second;
+    }
+    stats->hole_count = index->holes_by_offset.size();
+    if (!index->holes_by_size.empty())
+        stats->largest_hole = index->holes_by_size.rbegin()->first;
+}
@@ -1603,6 +1603,8 @@ VAStatus VpSetOsResource(
 
     Mos_Solo_SetOsResource(pboRt->pGmmResourceInfo, pOsResource);
 
+    pVpCtx->pTargetSurfs[targetIndex] = pboRt;
+
     return VA_STATUS_SUCCESS;
 }
 
@@ -3760,6 +3762,13 @@ VAStatus DdiVp_EndPicture (
 
     VpReportFeatureMode(pVpCtx);
 
+    // Render targets may hold compressed data after the write is submitted
+    for (uint32_t i = 0; i < pVpCtx->pVpHalRenderParams->uDstCount && i < VPHAL_MAX_TARGETS; i++)
+    {
+        DdiMediaUtil_InvalidateDecompState(DdiMedia_GetMediaContext(pVaDrvCtx), pVpCtx->pTargetSurfs[i]);
+        pVpCtx->pTargetSurfs[i] = nullptr;
+    }
+
     // Reset primary surface count for next render call
     pVpCtx->iPriSurfs = 0;
 
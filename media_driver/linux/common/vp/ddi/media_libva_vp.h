@@ -91,6 +91,9 @@ typedef struct DDI_VP_CONTEXT
     // target surface id
     VASurfaceID                               TargetSurfID        = 0;
 
+    // media surfaces bound as render targets, written by the next render call
+    PDDI_MEDIA_SURFACE                        pTargetSurfs[VPHAL_MAX_TARGETS] = {};
+
     // Primary surface number
     int32_t                                   iPriSurfs           = 0;
 
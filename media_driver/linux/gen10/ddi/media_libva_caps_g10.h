@@ -44,12 +44,6 @@ public:
         return;
     }
 
-    virtual VAStatus Init()
-    {
-        LoadProfileEntrypoints();
-        return VA_STATUS_SUCCESS;
-    }
-
     virtual VAStatus QueryImageFormats(VAImageFormat *formatList, int32_t *num_formats);
 
     virtual uint32_t GetImageFormatsMaxNum();
@@ -61,12 +61,6 @@ public:
         return;
     }
 
-    //!
-    virtual VAStatus Init() override
-    {
-        return LoadProfileEntrypoints();
-    }
-
     virtual VAStatus QueryImageFormats(VAImageFormat *formatList, int32_t *num_formats) override;
 
     virtual uint32_t GetImageFormatsMaxNum() override;
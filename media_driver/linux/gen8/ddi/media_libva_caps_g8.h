@@ -41,7 +41,6 @@ public:
     //!
     MediaLibvaCapsG8(DDI_MEDIA_CONTEXT *mediaCtx) : MediaLibvaCaps(mediaCtx)
     {
-        LoadProfileEntrypoints();
         return;
     }
 
@@ -3222,6 +3222,34 @@ mos_bufmgr_gem_enable_reuse(struct mos_bufmgr *bufmgr)
     bufmgr_gem->bo_reuse = true;
 }
 
+static void
+mos_gem_vma_heap_reinit_indexed(mos_vma_heap *heap, uint64_t start, uint64_t size)
+{
+    /* Addresses already handed out from the hole list stay there */
+    if (heap->index || heap->alloc_count || heap->free_count)
+        return;
+
+    mos_vma_heap_finish(heap);
+    mos_vma_heap_init_indexed(heap, start, size);
+}
+
+/**
+ * Switches the softpin address heaps to holes indexed by size and address.
+ *
+ * Takes effect only on heaps no address has been allocated from yet, the
+ * others keep the hole list. A heap whose index cannot be created falls
+ * back to the hole list as well.
+ */
+void mos_bufmgr_gem_enable_indexed_vma_heap(struct mos_bufmgr *bufmgr)
+{
+    struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *)bufmgr;
+
+    pthread_mutex_lock(&bufmgr_gem->lock);
+    mos_gem_vma_heap_reinit_indexed(&bufmgr_gem->vma_heap[MEMZONE_SYS], MEMZONE_SYS_START, MEMZONE_SYS_SIZE);
+    mos_gem_vma_heap_reinit_indexed(&bufmgr_gem->vma_heap[MEMZONE_DEVICE], MEMZONE_DEVICE_START, MEMZONE_DEVICE_SIZE);
+    pthread_mutex_unlock(&bufmgr_gem->lock);
+}
+
 /**
  * Enable use of fenced reloc type.
  *
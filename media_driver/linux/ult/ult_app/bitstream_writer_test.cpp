@@ -0,0 +1,477 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     bitstream_writer_test.cpp
+//! \brief    Bit exactness and speed of the encode BitstreamWriter.
+//! \details  The reference writer is the byte at a time writer the accumulator
+//!           based one replaced, kept here to check the output is unchanged.
+//!
+
+#include <chrono>
+#include <functional>
+#include <string.h>
+#include <iostream>
+#include <vector>
+#include "gtest/gtest.h"
+#include "bitstream_writer.h"
+
+class ReferenceBitstreamWriter
+{
+public:
+    ReferenceBitstreamWriter(mfxU8 *bs, mfxU8 bitOffset = 0)
+        : m_bsStart(bs), m_bs(bs), m_bitStart(bitOffset), m_bitOffset(bitOffset)
+    {
+        *m_bs &= 0xFF << (8 - m_bitOffset);
+    }
+
+    mfxU32 GetOffset() { return mfxU32(m_bs - m_bsStart) * 8 + m_bitOffset - m_bitStart; }
+
+    void PutBits(mfxU32 n, mfxU32 b)
+    {
+        while (n > 24)
+        {
+            n -= 16;
+            PutBits(16, (b >> n));
+        }
+
+        b <<= (32 - n);
+
+        if (!m_bitOffset)
+        {
+            m_bs[0] = (mfxU8)(b >> 24);
+            m_bs[1] = (mfxU8)(b >> 16);
+        }
+        else
+        {
+            b >>= m_bitOffset;
+            n += m_bitOffset;
+
+            m_bs[0] |= (mfxU8)(b >> 24);
+            m_bs[1] = (mfxU8)(b >> 16);
+        }
+
+        if (n > 16)
+        {
+            m_bs[2] = (mfxU8)(b >> 8);
+            m_bs[3] = (mfxU8)b;
+        }
+
+        m_bs += (n >> 3);
+        m_bitOffset = (n & 7);
+    }
+
+    void PutBit(mfxU32 b)
+    {
+        switch (m_bitOffset)
+        {
+        case 0:
+            m_bs[0]     = (mfxU8)(b << 7);
+            m_bitOffset = 1;
+            break;
+        case 7:
+            m_bs[0] |= (mfxU8)(b & 1);
+            m_bs++;
+            m_bitOffset = 0;
+            break;
+        default:
+            if (b & 1)
+                m_bs[0] |= (mfxU8)(1 << (7 - m_bitOffset));
+            m_bitOffset++;
+            break;
+        }
+    }
+
+    void PutGolomb(mfxU32 b)
+    {
+        if (!b)
+        {
+            PutBit(1);
+        }
+        else
+        {
+            mfxU32 n = 1;
+            b++;
+            while (b >> n)
+                n++;
+            PutBits(n - 1, 0);
+            PutBits(n, b);
+        }
+    }
+
+    void PutUE(mfxU32 b) { PutGolomb(b); }
+    void PutSE(mfxI32 b) { (b > 0) ? PutGolomb((b << 1) - 1) : PutGolomb((-b) << 1); }
+
+    void PutTrailingBits(bool bCheckAligened = false)
+    {
+        if ((!bCheckAligened) || m_bitOffset)
+            PutBit(1);
+
+        if (m_bitOffset)
+        {
+            *(++m_bs)   = 0;
+            m_bitOffset = 0;
+        }
+    }
+
+    void PutBitC(mfxU32 B)
+    {
+        if (m_firstBitFlag)
+            m_firstBitFlag = false;
+        else
+            PutBit(B);
+
+        while (m_bitsOutstanding > 0)
+        {
+            PutBit(1 - B);
+            m_bitsOutstanding--;
+        }
+    }
+
+    void RenormE()
+    {
+        while (m_codIRange < 256)
+        {
+            if (m_codILow < 256)
+            {
+                PutBitC(0);
+            }
+            else if (m_codILow >= 512)
+            {
+                m_codILow -= 512;
+                PutBitC(1);
+            }
+            else
+            {
+                m_codILow -= 256;
+                m_bitsOutstanding++;
+            }
+            m_codIRange <<= 1;
+            m_codILow <<= 1;
+        }
+    }
+
+    void EncodeBin(mfxU8 &ctx, mfxU8 binVal)
+    {
+        mfxU8  pStateIdx     = (ctx >> 1);
+        mfxU8  valMPS        = (ctx & 1);
+        mfxU32 qCodIRangeIdx = (m_codIRange >> 6) & 3;
+        mfxU32 codIRangeLPS  = tab_cabacRangeTabLps[pStateIdx][qCodIRangeIdx];
+
+        m_codIRange -= codIRangeLPS;
+
+        if (binVal != valMPS)
+        {
+            m_codILow += m_codIRange;
+            m_codIRange = codIRangeLPS;
+            if (pStateIdx == 0)
+                valMPS = 1 - valMPS;
+            pStateIdx = tab_cabacTransTbl[1][pStateIdx];
+        }
+        else
+        {
+            pStateIdx = tab_cabacTransTbl[0][pStateIdx];
+        }
+
+        ctx = (pStateIdx << 1) | valMPS;
+        RenormE();
+    }
+
+    void EncodeBinEP(mfxU8 binVal)
+    {
+        m_codILow += m_codILow + m_codIRange * (binVal == 1);
+        RenormE();
+    }
+
+    void SliceFinish()
+    {
+        m_codIRange -= 2;
+        m_codILow += m_codIRange;
+        m_codIRange = 2;
+
+        RenormE();
+        PutBitC((m_codILow >> 9) & 1);
+        PutBit(m_codILow >> 8);
+        PutTrailingBits();
+    }
+
+private:
+    mfxU8 *m_bsStart;
+    mfxU8 *m_bs;
+    mfxU8  m_bitStart;
+    mfxU8  m_bitOffset;
+
+    mfxU32 m_codILow         = 0;
+    mfxU32 m_codIRange       = 510;
+    mfxU32 m_bitsOutstanding = 0;
+    bool   m_firstBitFlag    = true;
+};
+
+class BitstreamWriterTest : public testing::Test
+{
+protected:
+    enum OpType
+    {
+        OpBits = 0,
+        OpBit,
+        OpUE,
+        OpSE,
+        OpTrailing,
+        OpBin,
+        OpBinEP,
+        OpNum
+    };
+
+    struct Op
+    {
+        OpType type;
+        mfxU32 n;
+        mfxU32 value;
+    };
+
+    static const mfxU32 m_bufferSize = 1 << 20;
+
+    mfxU32 Rand()
+    {
+        m_seed = m_seed * 1103515245 + 12345;
+        return m_seed >> 8;
+    }
+
+    //!
+    //! \brief  Ops like a header packer would issue: short fields and small Exp-Golomb values dominate
+    //!
+    std::vector<Op> GenerateHeaderOps(mfxU32 count)
+    {
+        std::vector<Op> ops;
+        for (mfxU32 i = 0; i < count; i++)
+        {
+            Op op    = {};
+            op.type  = (OpType)(Rand() % OpTrailing);
+            op.n     = (Rand() % 32) + 1;
+            op.value = (Rand() << 8) ^ Rand();
+            if (op.type == OpUE || op.type == OpSE)
+            {
+                // Mostly small values, some up to 30 bits, beyond which the reference writer shifts by 32
+                op.value >>= (Rand() % 4 == 0) ? (2 + Rand() % 8) : (16 + Rand() % 16);
+                if (op.type == OpSE)
+                {
+                    op.value = (mfxU32)((mfxI32)(op.value >> 1) * ((Rand() & 1) ? 1 : -1));
+                }
+            }
+            ops.push_back(op);
+        }
+        return ops;
+    }
+
+    std::vector<Op> GenerateCabacOps(mfxU32 count)
+    {
+        std::vector<Op> ops;
+        for (mfxU32 i = 0; i < count; i++)
+        {
+            Op op    = {};
+            op.type  = (Rand() % 4) ? OpBin : OpBinEP;
+            op.n     = Rand() % 8;            // context index
+            op.value = (Rand() % 5) ? 0 : 1;  // skewed bins, so contexts adapt
+            ops.push_back(op);
+        }
+        return ops;
+    }
+
+    template <class Writer>
+    void Apply(Writer &bs, const std::vector<Op> &ops, bool cabac)
+    {
+        mfxU8 ctx[8] = {};
+        for (auto &op : ops)
+        {
+            switch (op.type)
+            {
+            case OpBits:     bs.PutBits(op.n, op.value); break;
+            case OpBit:      bs.PutBit(op.value & 1); break;
+            case OpUE:       bs.PutUE(op.value); break;
+            case OpSE:       bs.PutSE((mfxI32)op.value); break;
+            case OpTrailing: bs.PutTrailingBits(op.value & 1); break;
+            case OpBin:      bs.EncodeBin(ctx[op.n], (mfxU8)op.value); break;
+            case OpBinEP:    bs.EncodeBinEP((mfxU8)op.value); break;
+            default:         break;
+            }
+        }
+        if (cabac)
+        {
+            bs.SliceFinish();
+        }
+    }
+
+    void ExpectBitExact(const std::vector<Op> &ops, bool cabac, mfxU8 bitOffset)
+    {
+        std::vector<mfxU8> ref(m_bufferSize, 0xa5);
+        std::vector<mfxU8> out(m_bufferSize, 0xa5);
+
+        ReferenceBitstreamWriter refBs(ref.data(), bitOffset);
+        BitstreamWriter          bs(out.data(), m_bufferSize, bitOffset);
+        if (cabac)
+        {
+            bs.cabacInit();
+        }
+
+        Apply(refBs, ops, cabac);
+        Apply(bs, ops, cabac);
+        bs.Flush();
+
+        mfxU32 bits = refBs.GetOffset();
+        ASSERT_EQ(bs.GetOffset(), bits);
+
+        mfxU32 bytes = (bitOffset + bits) >> 3;
+        EXPECT_EQ(0, memcmp(ref.data(), out.data(), bytes));
+        mfxU32 tail = (bitOffset + bits) & 7;
+        if (tail)
+        {
+            mfxU8 mask = (mfxU8)(0xff << (8 - tail));
+            EXPECT_EQ(ref[bytes] & mask, out[bytes] & mask);
+        }
+    }
+
+    mfxU32 m_seed = 0x2545f491;
+};
+
+const mfxU32 BitstreamWriterTest::m_bufferSize;
+
+TEST_F(BitstreamWriterTest, HeaderBitExact)
+{
+    for (mfxU8 bitOffset = 0; bitOffset < 8; bitOffset++)
+    {
+        for (mfxU32 i = 0; i < 64; i++)
+        {
+            ExpectBitExact(GenerateHeaderOps(1 + Rand() % 2000), false, bitOffset);
+        }
+    }
+}
+
+TEST_F(BitstreamWriterTest, GolombBoundaries)
+{
+    std::vector<Op> ops;
+    for (mfxU32 n = 0; n < 30; n++)
+    {
+        mfxU32 edge = (1u << n) - 1;
+        ops.push_back({OpUE, 0, edge});
+        ops.push_back({OpUE, 0, edge + 1});
+        ops.push_back({OpUE, 0, edge ? edge - 1 : 0});
+        ops.push_back({OpSE, 0, (mfxU32)(mfxI32)(edge >> 1)});
+        ops.push_back({OpSE, 0, (mfxU32)-(mfxI32)(edge >> 1)});
+    }
+    ExpectBitExact(ops, false, 0);
+    ExpectBitExact(ops, false, 5);
+}
+
+TEST_F(BitstreamWriterTest, CabacBitExact)
+{
+    for (mfxU32 i = 0; i < 64; i++)
+    {
+        ExpectBitExact(GenerateCabacOps(1 + Rand() % 20000), true, 0);
+    }
+}
+
+TEST_F(BitstreamWriterTest, PutBitsBuffer)
+{
+    std::vector<mfxU8> src(4096);
+    for (auto &b : src)
+    {
+        b = (mfxU8)Rand();
+    }
+
+    for (mfxU32 i = 0; i < 256; i++)
+    {
+        mfxU32 prefix = Rand() % 20;
+        mfxU32 offset = Rand() % 64;
+        mfxU32 n      = Rand() % (8 * 1024);
+
+        std::vector<mfxU8> ref(m_bufferSize, 0);
+        std::vector<mfxU8> out(m_bufferSize, 0);
+
+        ReferenceBitstreamWriter refBs(ref.data());
+        BitstreamWriter          bs(out.data(), m_bufferSize);
+
+        refBs.PutBits(prefix, 0x5a5a5);
+        bs.PutBits(prefix, 0x5a5a5);
+        for (mfxU32 bit = offset; bit < offset + n; bit++)
+        {
+            refBs.PutBit(src[bit >> 3] >> (7 - (bit & 7)));
+        }
+        bs.PutBitsBuffer(n, src.data(), offset);
+        bs.PutTrailingBits();
+        refBs.PutTrailingBits();
+        bs.Flush();
+
+        ASSERT_EQ(bs.GetOffset(), refBs.GetOffset());
+        EXPECT_EQ(0, memcmp(ref.data(), out.data(), refBs.GetOffset() >> 3));
+    }
+}
+
+TEST_F(BitstreamWriterTest, Reset)
+{
+    std::vector<mfxU8> ref(m_bufferSize, 0);
+    std::vector<mfxU8> out(m_bufferSize, 0);
+    auto               ops = GenerateHeaderOps(300);
+
+    // Slices written back to back with Reset, as the HEVC slice header packer does
+    BitstreamWriter bs(out.data(), m_bufferSize);
+    mfxU8          *begin = out.data();
+    mfxU8          *refBegin = ref.data();
+    for (mfxU32 i = 0; i < 8; i++)
+    {
+        bs.Reset(begin, m_bufferSize - mfxU32(begin - out.data()));
+        ReferenceBitstreamWriter refBs(refBegin);
+        Apply(bs, ops, false);
+        Apply(refBs, ops, false);
+        ASSERT_EQ(bs.GetOffset(), refBs.GetOffset());
+        begin += (bs.GetOffset() + 7) >> 3;
+        refBegin += (refBs.GetOffset() + 7) >> 3;
+    }
+    bs.Flush();
+
+    // Bits past the end of the last slice are not compared
+    mfxU32 size = mfxU32(refBegin - ref.data()) - 1;
+    EXPECT_EQ(0, memcmp(ref.data(), out.data(), size));
+}
+
+// Timing only, so it is not part of the regular run. Run it with --gtest_also_run_disabled_tests.
+TEST_F(BitstreamWriterTest, DISABLED_Benchmark)
+{
+    auto headerOps = GenerateHeaderOps(200000);
+    auto cabacOps  = GenerateCabacOps(200000);
+
+    std::vector<mfxU8> buffer(m_bufferSize * 4);
+    auto               time = [&](std::function<void()> run) {
+        auto start = std::chrono::steady_clock::now();
+        for (mfxU32 i = 0; i < 10; i++)
+        {
+            run();
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    auto refHeader = time([&]() { ReferenceBitstreamWriter bs(buffer.data()); Apply(bs, headerOps, false); });
+    auto newHeader = time([&]() { BitstreamWriter bs(buffer.data(), (mfxU32)buffer.size()); Apply(bs, headerOps, false); bs.Flush(); });
+    auto refCabac  = time([&]() { ReferenceBitstreamWriter bs(buffer.data()); Apply(bs, cabacOps, true); });
+    auto newCabac  = time([&]() { BitstreamWriter bs(buffer.data(), (mfxU32)buffer.size()); bs.cabacInit(); Apply(bs, cabacOps, true); bs.Flush(); });
+
+    std::cout << "header ops: reference " << refHeader << " us, accumulator " << newHeader << " us" << std::endl;
+    std::cout << "cabac bins: reference " << refCabac << " us, accumulator " << newCabac << " us" << std::endl;
+}
@@ -0,0 +1,122 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     cm_surface_slot_bitmap_test.cpp
+//! \brief    Free entry bookkeeping of the CM surface array.
+//!
+
+#include "gtest/gtest.h"
+#include "cm_surface_slot_bitmap.h"
+
+using namespace CMRT_UMD;
+
+// More than 64 * 64 entries, so that the summary has more than one word
+static const uint32_t SLOT_COUNT = 64 * 64 + 100;
+static const uint32_t FIRST_SLOT = 3;
+
+TEST(CmSurfaceSlotBitmapTest, ReservedEntriesNotHandedOut)
+{
+    CmSurfaceSlotBitmap slots;
+    slots.Initialize(SLOT_COUNT, FIRST_SLOT);
+
+    uint32_t index = 0;
+    ASSERT_TRUE(slots.FindFirstFree(index));
+    EXPECT_EQ(FIRST_SLOT, index);
+    EXPECT_EQ(SLOT_COUNT - FIRST_SLOT, slots.GetTotalCount());
+    EXPECT_EQ(SLOT_COUNT - FIRST_SLOT, slots.GetFreeCount());
+
+    // Reserved entries are ignored
+    slots.Occupy(0);
+    slots.Release(1);
+    EXPECT_FALSE(slots.IsFree(0));
+    EXPECT_FALSE(slots.IsFree(1));
+    EXPECT_EQ(0u, slots.GetOccupiedCount());
+}
+
+TEST(CmSurfaceSlotBitmapTest, LowestFreeEntryAcrossWords)
+{
+    CmSurfaceSlotBitmap slots;
+    slots.Initialize(SLOT_COUNT, FIRST_SLOT);
+
+    // Fill the pool in allocation order
+    for (uint32_t expected = FIRST_SLOT; expected < SLOT_COUNT; expected++)
+    {
+        uint32_t index = 0;
+        ASSERT_TRUE(slots.FindFirstFree(index));
+        ASSERT_EQ(expected, index);
+        slots.Occupy(index);
+    }
+
+    uint32_t index = 0;
+    EXPECT_FALSE(slots.FindFirstFree(index));
+    EXPECT_EQ(0u, slots.GetFreeCount());
+    EXPECT_EQ(slots.GetTotalCount(), slots.GetPeakOccupiedCount());
+
+    // Entry in a later summary word, after its bitmap word was cleared from the summary
+    slots.Release(64 * 64 + 70);
+    ASSERT_TRUE(slots.FindFirstFree(index));
+    EXPECT_EQ(64 * 64 + 70u, index);
+
+    // Lower entry in an earlier word wins
+    slots.Release(130);
+    ASSERT_TRUE(slots.FindFirstFree(index));
+    EXPECT_EQ(130u, index);
+
+    // Word boundary entries
+    slots.Release(127);
+    slots.Release(64);
+    ASSERT_TRUE(slots.FindFirstFree(index));
+    EXPECT_EQ(64u, index);
+    slots.Occupy(64);
+    ASSERT_TRUE(slots.FindFirstFree(index));
+    EXPECT_EQ(127u, index);
+    slots.Occupy(127);
+    slots.Occupy(130);
+    ASSERT_TRUE(slots.FindFirstFree(index));
+    EXPECT_EQ(64 * 64 + 70u, index);
+    slots.Occupy(index);
+    EXPECT_FALSE(slots.FindFirstFree(index));
+}
+
+TEST(CmSurfaceSlotBitmapTest, OccupancyCounters)
+{
+    CmSurfaceSlotBitmap slots;
+    slots.Initialize(SLOT_COUNT, FIRST_SLOT);
+
+    slots.Occupy(10);
+    slots.Occupy(11);
+    slots.Occupy(11);  // already occupied, not counted again
+    EXPECT_EQ(2u, slots.GetOccupiedCount());
+    EXPECT_EQ(2u, slots.GetPeakOccupiedCount());
+
+    slots.Release(10);
+    slots.Release(10);  // already free, not counted again
+    EXPECT_EQ(1u, slots.GetOccupiedCount());
+    EXPECT_EQ(2u, slots.GetPeakOccupiedCount());
+    EXPECT_EQ(slots.GetTotalCount() - 1, slots.GetFreeCount());
+    EXPECT_TRUE(slots.IsFree(10));
+    EXPECT_FALSE(slots.IsFree(11));
+
+    // Out of range entries are ignored
+    slots.Occupy(SLOT_COUNT);
+    EXPECT_EQ(1u, slots.GetOccupiedCount());
+}
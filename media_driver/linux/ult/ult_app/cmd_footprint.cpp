@@ -0,0 +1,336 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdlib.h>
+#include "cmd_footprint.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+static const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+static const uint64_t FNV_PRIME        = 0x100000001b3ull;
+
+static uint64_t HashDword(uint64_t hash, uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        hash ^= (value >> (i * 8)) & 0xff;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+CmdFootprint *CmdFootprint::m_instance = nullptr;
+
+CmdFootprint *CmdFootprint::GetInstance()
+{
+    if (m_instance == nullptr)
+    {
+        m_instance = new CmdFootprint();
+    }
+
+    return m_instance;
+}
+
+uint32_t CmdFootprint::GetCmdLength(uint32_t header)
+{
+    switch (header >> 29)
+    {
+    case 0:
+        // MI commands with opcode below 0x10, e.g. MI_NOOP and MI_BATCH_BUFFER_END, have no length field.
+        return ((header >> 23) & 0x3f) < 0x10 ? 1 : (header & 0xff) + 2;
+    case 2:
+        return (header & 0xff) + 2;
+    case 3:
+        if (((header >> 27) & 0x3) == 2)
+        {
+            // Media pipeline, which MFX, HCP, HUC and VDENC commands belong to.
+            return (header & 0xfff) + 2;
+        }
+        if (((header >> 27) & 0x3) == 1 && ((header >> 24) & 0x7) == 1)
+        {
+            // Single dword commands, e.g. PIPELINE_SELECT.
+            return 1;
+        }
+        return (header & 0xff) + 2;
+    default:
+        return 0;
+    }
+}
+
+uint32_t CmdFootprint::GetCmdKey(uint32_t header)
+{
+    switch (header >> 29)
+    {
+    case 0:
+        return header & 0xff800000;
+    case 2:
+        return header & 0xffc00000;
+    case 3:
+        return header & 0xffff0000;
+    default:
+        return header;
+    }
+}
+
+void CmdFootprint::BeginCase(const string &caseName, Platform_t platform)
+{
+    m_recording = true;
+    m_caseName  = caseName;
+    m_platform  = platform;
+    m_frames.assign(1, FrameFootprint());
+    m_frames.back().hash = FNV_OFFSET_BASIS;
+}
+
+void CmdFootprint::EndFrame()
+{
+    if (!m_recording)
+    {
+        return;
+    }
+    m_frames.push_back(FrameFootprint());
+    m_frames.back().hash = FNV_OFFSET_BASIS;
+}
+
+void CmdFootprint::Record(const PMOS_COMMAND_BUFFER pCmdBuffer)
+{
+    if (!m_recording || pCmdBuffer == nullptr || pCmdBuffer->pCmdBase == nullptr)
+    {
+        return;
+    }
+
+    FrameFootprint &frame = m_frames.back();
+    uint32_t       *end   = pCmdBuffer->pCmdPtr;
+
+    frame.submissions++;
+    frame.batchBytes += (uint32_t)((end - pCmdBuffer->pCmdBase) * sizeof(uint32_t));
+
+    for (uint32_t *p = pCmdBuffer->pCmdBase; p < end;)
+    {
+        uint32_t length = GetCmdLength(*p);
+        if (length == 0 || p + length > end)
+        {
+            // Cannot walk further, record the header so that the hash still changes with it.
+            frame.opcodeCounts[*p]++;
+            frame.hash = HashDword(frame.hash, *p);
+            break;
+        }
+
+        uint32_t key = GetCmdKey(*p);
+        frame.opcodeCounts[key]++;
+        frame.commands++;
+        frame.hash = HashDword(HashDword(frame.hash, key), length);
+        p += length;
+    }
+
+    if (m_getPatchCount)
+    {
+        uint32_t relocs   = 0;
+        uint32_t softpins = 0;
+        m_getPatchCount(pCmdBuffer, &relocs, &softpins);
+        frame.relocs   += relocs;
+        frame.softpins += softpins;
+    }
+}
+
+string CmdFootprint::GetFrameKey(const string &caseName, const char *platform, uint32_t frame)
+{
+    return caseName + "/" + platform + "/" + to_string(frame);
+}
+
+bool CmdFootprint::LoadBaseline(const string &path, Baseline &baseline)
+{
+    ifstream file(path);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    string line;
+    while (getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        istringstream  ss(line);
+        string         key;
+        FrameFootprint frame;
+        ss >> key >> frame.submissions >> frame.batchBytes >> frame.commands
+           >> frame.relocs >> frame.softpins >> hex >> frame.hash;
+
+        string opcode;
+        while (ss >> opcode)
+        {
+            size_t colon = opcode.find(':');
+            if (colon != string::npos)
+            {
+                frame.opcodeCounts[(uint32_t)stoul(opcode.substr(0, colon), nullptr, 16)] =
+                    (uint32_t)stoul(opcode.substr(colon + 1));
+            }
+        }
+        if (!key.empty())
+        {
+            baseline[key] = frame;
+        }
+    }
+    return true;
+}
+
+bool CmdFootprint::SaveBaseline(const string &path, const Baseline &baseline)
+{
+    ofstream file(path, ios::trunc);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    file << "# Command stream footprint baseline of devult, generated with ULT_FOOTPRINT_UPDATE=1." << endl;
+    file << "# Regenerate with the UpdateFootprintBaseline target, review and commit the diff with the change causing it." << endl;
+    file << "# case/platform/frame submissions batchBytes commands relocs softpins hash cmdHeader:count ..." << endl;
+    for (const auto &e : baseline)
+    {
+        const FrameFootprint &frame = e.second;
+        file << e.first << " " << dec << frame.submissions << " " << frame.batchBytes << " " << frame.commands
+             << " " << frame.relocs << " " << frame.softpins << " " << hex << setw(16) << setfill('0') << frame.hash;
+        for (const auto &opcode : frame.opcodeCounts)
+        {
+            file << " " << hex << setw(8) << setfill('0') << opcode.first << ":" << dec << opcode.second;
+        }
+        file << endl;
+    }
+    return true;
+}
+
+void CmdFootprint::Compare(const string &frameKey, const FrameFootprint &expected, const FrameFootprint &actual) const
+{
+    const char *env       = getenv("ULT_FOOTPRINT_THRESHOLD");
+    uint32_t    threshold = env ? (uint32_t)atoi(env) : 5;
+
+    auto grown = [threshold](uint32_t before, uint32_t after) {
+        return after > before && (uint64_t)(after - before) * 100 > (uint64_t)before * threshold;
+    };
+
+    EXPECT_FALSE(grown(expected.submissions, actual.submissions)) << frameKey << ": submissions "
+        << expected.submissions << " -> " << actual.submissions << endl;
+    EXPECT_FALSE(grown(expected.batchBytes, actual.batchBytes)) << frameKey << ": batch bytes "
+        << expected.batchBytes << " -> " << actual.batchBytes << endl;
+    EXPECT_FALSE(grown(expected.commands, actual.commands)) << frameKey << ": commands "
+        << expected.commands << " -> " << actual.commands << endl;
+    EXPECT_FALSE(grown(expected.relocs, actual.relocs)) << frameKey << ": relocations "
+        << expected.relocs << " -> " << actual.relocs << endl;
+    EXPECT_FALSE(grown(expected.softpins, actual.softpins)) << frameKey << ": softpin targets "
+        << expected.softpins << " -> " << actual.softpins << endl;
+
+    // Per opcode check catches redundant flushes and re-emitted states hidden by savings elsewhere.
+    for (const auto &opcode : actual.opcodeCounts)
+    {
+        auto     it    = expected.opcodeCounts.find(opcode.first);
+        uint32_t count = it == expected.opcodeCounts.end() ? 0 : it->second;
+        EXPECT_FALSE(grown(count, opcode.second)) << frameKey << ": command 0x" << hex << opcode.first
+            << dec << " count " << count << " -> " << opcode.second << endl;
+    }
+
+    if (expected.hash != actual.hash)
+    {
+        cout << "[ FOOTPRINT] " << frameKey << ": command stream changed within threshold, "
+             << "update baseline with ULT_FOOTPRINT_UPDATE=1 if it is expected" << endl;
+    }
+}
+
+void CmdFootprint::EndCase()
+{
+    if (!m_recording)
+    {
+        return;
+    }
+    m_recording = false;
+
+    if (m_frames.back().submissions == 0)
+    {
+        m_frames.pop_back();
+    }
+
+    const char *path = getenv("ULT_FOOTPRINT_BASELINE");
+#ifdef ULT_FOOTPRINT_BASELINE_FILE
+    if (path == nullptr)
+    {
+        path = ULT_FOOTPRINT_BASELINE_FILE;
+    }
+#endif
+    if (path == nullptr)
+    {
+        return;
+    }
+    if (m_getPatchCount == nullptr)
+    {
+        // Relocs and softpins are unknown, neither compare nor update the baseline with them
+        cout << "[ FOOTPRINT] driver does not export MOS_GetCmdBufPatchCount, footprint is not checked" << endl;
+        return;
+    }
+
+    Baseline    baseline;
+    const char *update   = getenv("ULT_FOOTPRINT_UPDATE");
+    const char *platform = g_platformName[m_platform];
+    bool        loaded   = LoadBaseline(path, baseline);
+
+    if (update && atoi(update) == 1)
+    {
+        // Frames of former run may be more than current one, drop all of them.
+        string prefix = m_caseName + "/" + platform + "/";
+        for (auto it = baseline.lower_bound(prefix); it != baseline.end() && it->first.compare(0, prefix.size(), prefix) == 0;)
+        {
+            it = baseline.erase(it);
+        }
+        for (uint32_t i = 0; i < m_frames.size(); i++)
+        {
+            baseline[GetFrameKey(m_caseName, platform, i)] = m_frames[i];
+        }
+        EXPECT_TRUE(SaveBaseline(path, baseline)) << "Failed to write footprint baseline " << path << endl;
+        return;
+    }
+
+    if (!loaded || baseline.empty())
+    {
+        cout << "[ FOOTPRINT] baseline " << path << " not found or empty, footprint is not checked, "
+             << "generate it with ULT_FOOTPRINT_UPDATE=1" << endl;
+        return;
+    }
+
+    // Once baseline is populated, a new case, platform or frame is a failure so that it cannot grow unchecked.
+    for (uint32_t i = 0; i < m_frames.size(); i++)
+    {
+        string frameKey = GetFrameKey(m_caseName, platform, i);
+        auto   it       = baseline.find(frameKey);
+        if (it == baseline.end())
+        {
+            ADD_FAILURE() << frameKey << " has no footprint baseline, "
+                          << "update baseline with ULT_FOOTPRINT_UPDATE=1 if it is expected" << endl;
+            continue;
+        }
+        Compare(frameKey, it->second, m_frames[i]);
+    }
+}
@@ -0,0 +1,115 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     cmd_footprint.h
+//! \brief    Records the command stream footprint of ULT test cases and compares it with baselines.
+//! \details  For each frame of a test case the command counts by opcode, batch bytes, relocation and
+//!           softpin counts and a hash of the command headers are recorded from the command buffers
+//!           passed to UltGetCmdBuf. The footprint is compared with footprint_baseline.txt at the end
+//!           of the test case, and growth beyond the threshold fails the test. A frame missing from
+//!           a populated baseline fails the test as well, an empty baseline is not checked.
+//!
+//!           Environment variables:
+//!           ULT_FOOTPRINT_BASELINE   baseline file, default is the one in source tree.
+//!           ULT_FOOTPRINT_UPDATE     if 1, write the recorded footprints to baseline file instead of comparing.
+//!           ULT_FOOTPRINT_THRESHOLD  growth allowed in percent, default 5.
+//!
+
+#ifndef __CMD_FOOTPRINT_H__
+#define __CMD_FOOTPRINT_H__
+
+#include <map>
+#include <string>
+#include <vector>
+#include "driver_loader.h"
+
+class CmdFootprint
+{
+public:
+
+    struct FrameFootprint
+    {
+        uint32_t                     submissions  = 0;
+        uint32_t                     batchBytes   = 0;
+        uint32_t                     commands     = 0;
+        uint32_t                     relocs       = 0;
+        uint32_t                     softpins     = 0;
+        uint64_t                     hash         = 0;  //!< Hash of command headers, payload is not included as it has gfx addresses
+        std::map<uint32_t, uint32_t> opcodeCounts;      //!< Command count by normalized command header
+    };
+
+    static CmdFootprint *GetInstance();
+
+    void SetPatchCountFunc(MOS_GetCmdBufPatchCountFunc func) { m_getPatchCount = func; }
+
+    //!
+    //! \brief  Start recording a test case on platform
+    //!
+    void BeginCase(const std::string &caseName, Platform_t platform);
+
+    //!
+    //! \brief  Close the footprint of current frame, later submissions go to the next frame
+    //!
+    void EndFrame();
+
+    //!
+    //! \brief  Stop recording, then compare the footprints with baseline or update baseline
+    //!
+    void EndCase();
+
+    //!
+    //! \brief  Add command buffer of a submission to current frame
+    //!
+    void Record(const PMOS_COMMAND_BUFFER pCmdBuffer);
+
+    //!
+    //! \brief  Get dword count of command, 0 if the header is unknown
+    //!
+    static uint32_t GetCmdLength(uint32_t header);
+
+    //!
+    //! \brief  Keep the fields of header identifying command, i.e. command type, opcode and sub opcode
+    //!
+    static uint32_t GetCmdKey(uint32_t header);
+
+private:
+
+    using Baseline = std::map<std::string, FrameFootprint>;
+
+    static std::string GetFrameKey(const std::string &caseName, const char *platform, uint32_t frame);
+
+    static bool LoadBaseline(const std::string &path, Baseline &baseline);
+
+    static bool SaveBaseline(const std::string &path, const Baseline &baseline);
+
+    void Compare(const std::string &frameKey, const FrameFootprint &expected, const FrameFootprint &actual) const;
+
+    static CmdFootprint *m_instance;
+
+    MOS_GetCmdBufPatchCountFunc m_getPatchCount = nullptr;
+    bool                        m_recording     = false;
+    std::string                 m_caseName;
+    Platform_t                  m_platform      = igfx_MAX;
+    std::vector<FrameFootprint> m_frames;
+};
+
+#endif // __CMD_FOOTPRINT_H__
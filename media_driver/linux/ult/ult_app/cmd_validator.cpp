@@ -19,6 +19,7 @@
 * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
 * OTHER DEALINGS IN THE SOFTWARE.
 */
+#include "cmd_footprint.h"
 #include "cmd_validator.h"
 
 using namespace std;
@@ -27,6 +28,7 @@ void UltGetCmdBuf(PMOS_COMMAND_BUFFER pCmdBuffer)
 {
     auto cmdValidator = CmdValidator::GetInstance();
     cmdValidator->Validate(pCmdBuffer);
+    CmdFootprint::GetInstance()->Record(pCmdBuffer);
 }
 
 CmdValidator *CmdValidator::m_instance = nullptr;
@@ -0,0 +1,229 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     ddi_test_alloc.cpp
+//! \brief    Check the GMM resource info cache on repeated surface and image allocations.
+//!
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include "driver_loader.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+struct AllocLayout
+{
+    uint32_t dataSize;
+    uint32_t numPlanes;
+    uint32_t pitches[3];
+    uint32_t offsets[3];
+};
+
+class MediaAllocDdiTest : public testing::Test
+{
+protected:
+    static const uint32_t m_width     = 1920;
+    static const uint32_t m_height    = 1080;
+    static const uint32_t m_batchSize = 16;
+    static const uint32_t m_batches   = 32;
+
+    static void GetLayout(const VAImage &image, AllocLayout &layout)
+    {
+        layout.dataSize  = image.data_size;
+        layout.numPlanes = image.num_planes;
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            layout.pitches[i] = image.pitches[i];
+            layout.offsets[i] = image.offsets[i];
+        }
+    }
+
+    static void ExpectSameLayout(const AllocLayout &expected, const AllocLayout &actual, const char *name)
+    {
+        EXPECT_EQ(expected.dataSize, actual.dataSize) << name;
+        EXPECT_EQ(expected.numPlanes, actual.numPlanes) << name;
+        for (uint32_t i = 0; i < expected.numPlanes && i < 3; i++)
+        {
+            EXPECT_EQ(expected.pitches[i], actual.pitches[i]) << name << " plane " << i;
+            EXPECT_EQ(expected.offsets[i], actual.offsets[i]) << name << " plane " << i;
+        }
+    }
+
+    void GetSurfaceLayout(VASurfaceID surface, AllocLayout &layout)
+    {
+        VADriverContextP ctx     = &m_driverLoader.m_ctx;
+        VAImage          derived = {};
+        EXPECT_EQ(VA_STATUS_SUCCESS, ctx->vtable->vaDeriveImage(ctx, surface, &derived));
+        GetLayout(derived, layout);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ctx->vtable->vaDestroyImage(ctx, derived.image_id));
+    }
+
+    void GetCacheStats(uint64_t &hits, uint64_t &misses)
+    {
+        m_driverLoader.m_drvSyms.DdiMedia_GetGmmResInfoCacheStats(&m_driverLoader.m_ctx, &hits, &misses);
+    }
+
+    //!
+    //! \brief  Create a batch of same sized surfaces and images
+    //!
+    VAStatus CreateBatch(vector<VASurfaceID> &surfaces, vector<VAImage> &images)
+    {
+        VADriverContextP ctx    = &m_driverLoader.m_ctx;
+        VAImageFormat    format = {};
+        format.fourcc           = VA_FOURCC_NV12;
+        format.byte_order       = VA_LSB_FIRST;
+        format.bits_per_pixel   = 12;
+
+        VAStatus ret = ctx->vtable->vaCreateSurfaces2(ctx, VA_RT_FORMAT_YUV420, m_width, m_height, surfaces.data(), m_batchSize, nullptr, 0);
+        for (uint32_t j = 0; j < m_batchSize && ret == VA_STATUS_SUCCESS; j++)
+        {
+            ret = ctx->vtable->vaCreateImage(ctx, &format, m_width, m_height, &images[j]);
+        }
+        return ret;
+    }
+
+    void DestroyBatch(vector<VASurfaceID> &surfaces, vector<VAImage> &images)
+    {
+        VADriverContextP ctx = &m_driverLoader.m_ctx;
+        for (uint32_t j = 0; j < m_batchSize; j++)
+        {
+            EXPECT_EQ(VA_STATUS_SUCCESS, ctx->vtable->vaDestroyImage(ctx, images[j].image_id));
+        }
+        EXPECT_EQ(VA_STATUS_SUCCESS, ctx->vtable->vaDestroySurfaces(ctx, surfaces.data(), m_batchSize));
+    }
+
+    DriverDllLoader m_driverLoader;
+};
+
+//!
+//! \brief  Resource info copied from the cache has the layout of the one created by GMM
+//! \details Runs when the driver enables the cache by "Enable GMM Resource Info Cache".
+//!
+TEST_F(MediaAllocDdiTest, GmmResInfoCacheCopiesLayout)
+{
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    if (m_driverLoader.GetPlatformNum() == 0)
+    {
+        return;
+    }
+
+    // One platform is enough, the cache is platform agnostic
+    Platform_t platform = platforms[0];
+    int ret = m_driverLoader.InitDriver(platform);
+    ASSERT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.InitDriver" << endl;
+    if (m_driverLoader.m_drvSyms.DdiMedia_GetGmmResInfoCacheStats == nullptr)
+    {
+        EXPECT_EQ(VA_STATUS_SUCCESS, m_driverLoader.CloseDriver());
+        return;
+    }
+
+    vector<VASurfaceID> surfaces(m_batchSize);
+    vector<VAImage>     images(m_batchSize);
+
+    for (uint32_t i = 0; i < m_batches; i++)
+    {
+        uint64_t hits = 0, misses = 0;
+        GetCacheStats(hits, misses);
+
+        ret = CreateBatch(surfaces, images);
+        ASSERT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = vaCreateSurfaces2/vaCreateImage" << endl;
+
+        uint64_t batchHits = 0, batchMisses = 0;
+        GetCacheStats(batchHits, batchMisses);
+        batchHits   -= hits;
+        batchMisses -= misses;
+
+        if (i == 0 && batchHits == 0 && batchMisses == 0)
+        {
+            // Cache disabled by the user setting
+            DestroyBatch(surfaces, images);
+            break;
+        }
+
+        // Every surface and image resource info goes through the cache, all hit once it is warm
+        EXPECT_EQ(2 * m_batchSize, batchHits + batchMisses) << "batch " << i;
+        if (i > 0)
+        {
+            EXPECT_EQ(0u, batchMisses) << "batch " << i;
+        }
+        else
+        {
+            // The first of each kind is created by GMM, the last one copied from its template
+            AllocLayout created = {}, copied = {};
+            GetSurfaceLayout(surfaces[0], created);
+            GetSurfaceLayout(surfaces[m_batchSize - 1], copied);
+            ExpectSameLayout(created, copied, "surface");
+
+            GetLayout(images[0], created);
+            GetLayout(images[m_batchSize - 1], copied);
+            ExpectSameLayout(created, copied, "image");
+        }
+
+        DestroyBatch(surfaces, images);
+    }
+
+    ret = m_driverLoader.CloseDriver();
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.CloseDriver" << endl;
+}
+
+//!
+//! \brief  Surface and image allocation latency, run with the cache setting on and off to compare
+//!
+TEST_F(MediaAllocDdiTest, DISABLED_GmmResInfoCacheBenchmark)
+{
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    if (m_driverLoader.GetPlatformNum() == 0)
+    {
+        return;
+    }
+
+    Platform_t platform = platforms[0];
+    ASSERT_EQ(VA_STATUS_SUCCESS, m_driverLoader.InitDriver(platform));
+
+    vector<VASurfaceID> surfaces(m_batchSize);
+    vector<VAImage>     images(m_batchSize);
+    uint64_t            elapsed = 0;
+
+    for (uint32_t i = 0; i < m_batches; i++)
+    {
+        auto start = chrono::steady_clock::now();
+        ASSERT_EQ(VA_STATUS_SUCCESS, CreateBatch(surfaces, images));
+        elapsed += chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+        DestroyBatch(surfaces, images);
+    }
+
+    uint64_t hits = 0, misses = 0;
+    if (m_driverLoader.m_drvSyms.DdiMedia_GetGmmResInfoCacheStats)
+    {
+        GetCacheStats(hits, misses);
+    }
+    EXPECT_EQ(VA_STATUS_SUCCESS, m_driverLoader.CloseDriver());
+
+    cout << "allocation latency on " << g_platformName[platform] << ": "
+         << (double)elapsed / (2 * m_batchSize * m_batches) << " us, cache "
+         << hits << " hits, " << misses << " misses" << endl;
+}
@@ -19,6 +19,7 @@
 * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
 * OTHER DEALINGS IN THE SOFTWARE.
 */
+#include "cmd_footprint.h"
 #include "ddi_test_encode.h"
 
 using namespace std;
@@ -48,7 +49,10 @@ void MediaEncodeDdiTest::ExectueEncodeTest(EncTestData *pEncData)
             pEncData->GetFeatureID()))
         {
             CmdValidator::GpuCmdsValidationInit(m_GpuCmdFactory, platforms[i]);
+            CmdFootprint::GetInstance()->BeginCase(
+                ::testing::UnitTest::GetInstance()->current_test_info()->name(), platforms[i]);
             EncodeExecute(pEncData, platforms[i]);
+            CmdFootprint::GetInstance()->EndCase();
         }
     }
 }
@@ -125,6 +129,7 @@ void MediaEncodeDdiTest::EncodeExecute(EncTestData *pEncData, Platform_t platfor
             ret = m_driverLoader.m_ctx.vtable->vaQuerySurfaceStatus(&m_driverLoader.m_ctx,
                 resources[0], &surface_status);
         } while (surface_status != VASurfaceReady);
+        CmdFootprint::GetInstance()->EndFrame();
 
         for (int j = 0; j < compBufs[i].size(); j++)
         {
@@ -0,0 +1,241 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     decode_aux_buffer_pool_test.cpp
+//! \brief    Leases, returns, limits and device release of the decode aux buffer pool.
+//!
+
+#include <set>
+#include <string.h>
+#include "gtest/gtest.h"
+#include "decode_aux_buffer_pool.h"
+#include "mos_context_next.h"
+
+using namespace decode;
+
+class TestOsDeviceContext : public OsContextNext
+{
+public:
+    MOS_STATUS Init(DDI_DEVICE_CONTEXT osDriverContext) override { return MOS_STATUS_SUCCESS; }
+
+    //! \brief  Run the release callbacks, as cleaning up the device does
+    void Release() { RunReleaseCallbacks(); }
+
+protected:
+    void Destroy() override {}
+};
+
+class TestDecodeAuxBufferPool : public DecodeAuxBufferPool
+{
+public:
+    TestDecodeAuxBufferPool() = default;
+
+    uint64_t                        m_now = 0;
+    std::set<const MOS_BUFFER *>    m_freed;
+
+protected:
+    void FreeBuffer(OsDeviceContext *device, MOS_BUFFER *buffer) override
+    {
+        m_freed.insert(buffer);
+        MOS_Delete(buffer);
+    }
+
+    uint64_t GetCurTime() override { return m_now; }
+};
+
+class DecodeAuxBufferPoolTest : public testing::Test
+{
+protected:
+    //! \brief  Session of a device
+    struct Session
+    {
+        MosStreamState streamState;
+        MOS_INTERFACE  osInterface;
+    };
+
+    static MOS_STATUS AllocateResource(
+        PMOS_INTERFACE           osInterface,
+        PMOS_ALLOC_GFXRES_PARAMS params,
+#if MOS_MESSAGES_ENABLED
+        const char              *functionName,
+        const char              *filename,
+        int32_t                  line,
+#endif
+        PMOS_RESOURCE            resource)
+    {
+        m_allocations++;
+        m_allocatedBytes = params->dwBytes;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    static void InitSession(Session &session, OsDeviceContext &device)
+    {
+        memset(&session.osInterface, 0, sizeof(session.osInterface));
+        session.streamState.osDeviceContext     = &device;
+        session.osInterface.apoMosEnabled       = true;
+        session.osInterface.osStreamState       = &session.streamState;
+        session.osInterface.pfnAllocateResource = AllocateResource;
+    }
+
+    static MOS_ALLOC_GFXRES_PARAMS BufferParams(uint32_t size)
+    {
+        MOS_ALLOC_GFXRES_PARAMS params;
+        memset(&params, 0, sizeof(params));
+        params.Type               = MOS_GFXRES_BUFFER;
+        params.TileType           = MOS_TILE_LINEAR;
+        params.Format             = Format_Buffer;
+        params.dwBytes            = size;
+        params.Flags.bNotLockable = true;
+        return params;
+    }
+
+    MOS_BUFFER *Lease(Session &session, const MOS_ALLOC_GFXRES_PARAMS &params, bool expectReused)
+    {
+        bool        reused = !expectReused;
+        uint64_t    costUs = 0;
+        MOS_BUFFER *buffer = m_pool.Lease(&session.osInterface, params, reused, costUs);
+        EXPECT_NE(nullptr, buffer);
+        EXPECT_EQ(expectReused, reused);
+        return buffer;
+    }
+
+    void SetUp() override
+    {
+        m_allocations    = 0;
+        m_allocatedBytes = 0;
+        InitSession(m_session, m_device);
+        ASSERT_EQ(MOS_STATUS_SUCCESS, m_pool.Configure(&m_session.osInterface, 1024 * 1024, 1000));
+    }
+
+    void TearDown() override
+    {
+        m_device.Release();
+        m_otherDevice.Release();
+    }
+
+    static uint32_t m_allocations;
+    static uint32_t m_allocatedBytes;
+
+    TestOsDeviceContext     m_device;
+    TestOsDeviceContext     m_otherDevice;
+    Session                 m_session;
+    TestDecodeAuxBufferPool m_pool;
+};
+
+uint32_t DecodeAuxBufferPoolTest::m_allocations    = 0;
+uint32_t DecodeAuxBufferPoolTest::m_allocatedBytes = 0;
+
+TEST_F(DecodeAuxBufferPoolTest, ReturnedBufferLeasedAgain)
+{
+    MOS_ALLOC_GFXRES_PARAMS params = BufferParams(100000);
+
+    MOS_BUFFER *buffer = Lease(m_session, params, false);
+    EXPECT_EQ(1u, m_allocations);
+    // The whole bucket is allocated, without changing the parameters of caller
+    EXPECT_EQ(106496u, m_allocatedBytes);
+    EXPECT_EQ(100000u, params.dwBytes);
+    EXPECT_EQ(MOS_STATUS_SUCCESS, m_pool.Return(buffer));
+
+    // A close size shares the bucket
+    MOS_ALLOC_GFXRES_PARAMS closeParams = BufferParams(104000);
+    EXPECT_EQ(buffer, Lease(m_session, closeParams, true));
+    EXPECT_EQ(1u, m_allocations);
+    EXPECT_EQ(MOS_STATUS_SUCCESS, m_pool.Return(buffer));
+
+    DecodeAuxBufferPool::Statistics stats = m_pool.GetStatistics();
+    EXPECT_EQ(2u, stats.leases);
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(106496u, stats.bytesPooled);
+}
+
+TEST_F(DecodeAuxBufferPoolTest, ProtectedAndUnprotectedNotShared)
+{
+    MOS_ALLOC_GFXRES_PARAMS params = BufferParams(65536);
+    MOS_BUFFER *buffer = Lease(m_session, params, false);
+    EXPECT_EQ(MOS_STATUS_SUCCESS, m_pool.Return(buffer));
+
+    MOS_ALLOC_GFXRES_PARAMS protectedParams = BufferParams(65536);
+    protectedParams.hardwareProtected       = true;
+    MOS_BUFFER *protectedBuffer = Lease(m_session, protectedParams, false);
+    EXPECT_NE(buffer, protectedBuffer);
+    EXPECT_EQ(MOS_STATUS_SUCCESS, m_pool.Discard(protectedBuffer));
+    EXPECT_EQ(1u, m_pool.m_freed.count(protectedBuffer));
+}
+
+TEST_F(DecodeAuxBufferPoolTest, ConfiguredOncePerDevice)
+{
+    // A later session of the device does not change the limits
+    Session second;
+    InitSession(second, m_device);
+    EXPECT_EQ(MOS_STATUS_SUCCESS, m_pool.Configure(&second.osInterface, 0, 0));
+    EXPECT_TRUE(m_pool.IsEnabled(&second.osInterface));
+
+    // Another device has its own limits
+    Session other;
+    InitSession(other, m_otherDevice);
+    EXPECT_FALSE(m_pool.IsEnabled(&other.osInterface));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, m_pool.Configure(&other.osInterface, 0, 0));
+    EXPECT_FALSE(m_pool.IsEnabled(&other.osInterface));
+    bool     reused = false;
+    uint64_t costUs = 0;
+    EXPECT_EQ(nullptr, m_pool.Lease(&other.osInterface, BufferParams(4096), reused, costUs));
+    EXPECT_EQ(0u, m_allocations);
+}
+
+TEST_F(DecodeAuxBufferPoolTest, IdleAndCapEvicted)
+{
+    MOS_BUFFER *idle = Lease(m_session, BufferParams(4096), false);
+    EXPECT_EQ(MOS_STATUS_SUCCESS, m_pool.Return(idle));
+
+    // Idle for the timeout of 1000 ms
+    m_pool.m_now = 1000 * 1000;
+    MOS_BUFFER *buffer = Lease(m_session, BufferParams(8192), false);
+    EXPECT_EQ(1u, m_pool.m_freed.count(idle));
+
+    // Cap of 1MB, the oldest returned goes first
+    MOS_BUFFER *large = Lease(m_session, BufferParams(1024 * 1024), false);
+    EXPECT_EQ(MOS_STATUS_SUCCESS, m_pool.Return(buffer));
+    m_pool.m_now++;
+    EXPECT_EQ(MOS_STATUS_SUCCESS, m_pool.Return(large));
+    EXPECT_EQ(1u, m_pool.m_freed.count(buffer));
+    EXPECT_EQ(0u, m_pool.m_freed.count(large));
+
+    DecodeAuxBufferPool::Statistics stats = m_pool.GetStatistics();
+    EXPECT_EQ(2u, stats.evictions);
+    EXPECT_EQ(1024u * 1024, stats.bytesPooled);
+}
+
+TEST_F(DecodeAuxBufferPoolTest, DeviceReleaseFreesPooledBuffers)
+{
+    MOS_BUFFER *buffer = Lease(m_session, BufferParams(4096), false);
+    EXPECT_EQ(MOS_STATUS_SUCCESS, m_pool.Return(buffer));
+
+    m_device.Release();
+    EXPECT_EQ(1u, m_pool.m_freed.count(buffer));
+    EXPECT_EQ(0u, m_pool.GetStatistics().bytesPooled);
+    EXPECT_FALSE(m_pool.IsEnabled(&m_session.osInterface));
+
+    // A new device at the same address is configured again
+    EXPECT_EQ(MOS_STATUS_SUCCESS, m_pool.Configure(&m_session.osInterface, 0, 0));
+    EXPECT_FALSE(m_pool.IsEnabled(&m_session.osInterface));
+}
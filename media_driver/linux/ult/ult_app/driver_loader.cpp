@@ -24,6 +24,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include "cmd_footprint.h"
 #include "driver_loader.h"
 #include "mos_util_debug.h"
 #include "memory_leak_detector.h"
@@ -131,6 +132,7 @@ VAStatus DriverDllLoader::InitDriver(Platform_t platform_id)
     }
     m_drvSyms.MOS_SetUltFlag(1);
     *m_drvSyms.ppfnUltGetCmdBuf = UltGetCmdBuf;
+    CmdFootprint::GetInstance()->SetPatchCountFunc(m_drvSyms.MOS_GetCmdBufPatchCount);
     return m_drvSyms.__vaDriverInit_(&m_ctx);
 }
 
@@ -161,6 +163,8 @@ VAStatus DriverDllLoader::LoadDriverSymbols()
             m_drvSyms.MOS_SetUltFlag            = (MOS_SetUltFlagFunc)dlsym(m_umdhandle, "MOS_SetUltFlag");
             m_drvSyms.MOS_GetMemNinjaCounter    = (MOS_GetMemNinjaCounterFunc)dlsym(m_umdhandle, "MOS_GetMemNinjaCounter");
             m_drvSyms.MOS_GetMemNinjaCounterGfx = (MOS_GetMemNinjaCounterFunc)dlsym(m_umdhandle, "MOS_GetMemNinjaCounterGfx");
+            m_drvSyms.MOS_GetCmdBufPatchCount   = (MOS_GetCmdBufPatchCountFunc)dlsym(m_umdhandle, "MOS_GetCmdBufPatchCount");
+            m_drvSyms.DdiMedia_GetGmmResInfoCacheStats = (DdiMedia_GetGmmResInfoCacheStatsFunc)dlsym(m_umdhandle, "DdiMedia_GetGmmResInfoCacheStats");
             m_drvSyms.ppfnUltGetCmdBuf          = (UltGetCmdBufFunc *)dlsym(m_umdhandle, "pfnUltGetCmdBuf");
             break;
         }
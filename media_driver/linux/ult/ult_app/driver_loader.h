@@ -80,6 +80,10 @@ typedef int32_t (*MOS_GetMemNinjaCounterFunc)();
 
 typedef void (*UltGetCmdBufFunc)(PMOS_COMMAND_BUFFER pCmdBuffer);
 
+typedef void (*MOS_GetCmdBufPatchCountFunc)(PMOS_COMMAND_BUFFER pCmdBuffer, uint32_t *relocCount, uint32_t *softpinCount);
+
+typedef void (*DdiMedia_GetGmmResInfoCacheStatsFunc)(VADriverContextP ctx, uint64_t *hits, uint64_t *misses);
+
 struct DriverSymbols
 {
     bool Initialized() const
@@ -102,6 +106,9 @@ struct DriverSymbols
     MOS_SetUltFlagFunc          MOS_SetUltFlag;
     MOS_GetMemNinjaCounterFunc  MOS_GetMemNinjaCounter;
     MOS_GetMemNinjaCounterFunc  MOS_GetMemNinjaCounterGfx;
+    // Optional, drivers not exporting them skip footprint and GMM cache checks only
+    MOS_GetCmdBufPatchCountFunc MOS_GetCmdBufPatchCount;
+    DdiMedia_GetGmmResInfoCacheStatsFunc DdiMedia_GetGmmResInfoCacheStats;
 
     // Data
     UltGetCmdBufFunc            *ppfnUltGetCmdBuf;
@@ -0,0 +1,95 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     encode_streamin_hash_test.cpp
+//! \brief    Inputs deciding whether HEVC VDEnc streamin data can be reused.
+//!
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "encode_hevc_vdenc_roi_streamin_inputs.h"
+
+using namespace encode;
+
+TEST(EncodeStreaminHashTest, HucFlagChangesHash)
+{
+    HevcVdencStreaminInputs inputs;
+    inputs.frameWidth  = 1920;
+    inputs.frameHeight = 1080;
+    inputs.numRoi      = 2;
+    inputs.roiEnabled  = 1;
+
+    uint64_t hash = inputs.Hash();
+    EXPECT_EQ(hash, inputs.Hash());
+
+    inputs.vdencHucUsed = 1;
+    EXPECT_NE(hash, inputs.Hash());
+}
+
+TEST(EncodeStreaminHashTest, QpMapRehashedOnlyWhenChanged)
+{
+    std::vector<uint8_t> qpMap(64 * 32, 10);
+    const void          *identity = &qpMap;
+    EncodeCachedHash     cachedHash;
+    uint64_t             hash1    = 0;
+    uint64_t             hash2    = 0;
+
+    auto hashFunc = [&](uint64_t &hash) {
+        hash = EncodeHashData(qpMap.data(), (uint32_t)qpMap.size());
+        return MOS_STATUS_SUCCESS;
+    };
+
+    // First use always hashes, even if the framework says unchanged
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cachedHash.Get(identity, false, hashFunc, hash1));
+    EXPECT_EQ(1u, cachedHash.GetHashCount());
+
+    // Unchanged map is not read again
+    qpMap[0] = 20;
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cachedHash.Get(identity, false, hashFunc, hash2));
+    EXPECT_EQ(1u, cachedHash.GetHashCount());
+    EXPECT_EQ(hash1, hash2);
+
+    // Changed map is rehashed
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cachedHash.Get(identity, true, hashFunc, hash2));
+    EXPECT_EQ(2u, cachedHash.GetHashCount());
+    EXPECT_NE(hash1, hash2);
+
+    // Another QP map resource is rehashed
+    std::vector<uint8_t> otherMap(qpMap);
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cachedHash.Get(&otherMap, false, hashFunc, hash2));
+    EXPECT_EQ(3u, cachedHash.GetHashCount());
+}
+
+TEST(EncodeStreaminHashTest, FailedHashIsNotCached)
+{
+    EncodeCachedHash cachedHash;
+    uint64_t         hash = 0;
+    int              key  = 0;
+
+    auto failFunc = [](uint64_t &hash) { return MOS_STATUS_NULL_POINTER; };
+    auto okFunc   = [](uint64_t &hash) { hash = 1; return MOS_STATUS_SUCCESS; };
+
+    EXPECT_EQ(MOS_STATUS_NULL_POINTER, cachedHash.Get(&key, true, failFunc, hash));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cachedHash.Get(&key, false, okFunc, hash));
+    EXPECT_EQ(1u, hash);
+    EXPECT_EQ(1u, cachedHash.GetHashCount());
+}
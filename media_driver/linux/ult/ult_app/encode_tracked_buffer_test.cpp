@@ -0,0 +1,128 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     encode_tracked_buffer_test.cpp
+//! \brief    Resolution change bookkeeping of the encode tracked buffers.
+//!
+
+#include "gtest/gtest.h"
+#include "encode_allocator.h"
+#include "encode_tracked_buffer.h"
+
+using namespace encode;
+
+// no resource is allocated with a null allocator, only the resource
+// destruction entries are referenced by the buffer queues
+MOS_RESOURCE *EncodeAllocator::AllocateResource(MOS_ALLOC_GFXRES_PARAMS &param, bool zeroOnAllocate, MOS_HW_RESOURCE_DEF resUsageType)
+{
+    return nullptr;
+}
+
+MOS_STATUS EncodeAllocator::DestroyResource(MOS_RESOURCE *resource)
+{
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS EncodeAllocator::DestroySurface(MOS_SURFACE *surface)
+{
+    return MOS_STATUS_SUCCESS;
+}
+
+class TestTrackedBuffer : public TrackedBuffer
+{
+public:
+    TestTrackedBuffer() : TrackedBuffer(nullptr, 2, 2) {}
+
+    using TrackedBuffer::GetBufferQueue;
+};
+
+static MOS_ALLOC_GFXRES_PARAMS BufferParam(uint32_t size)
+{
+    MOS_ALLOC_GFXRES_PARAMS param;
+    MOS_ZeroMemory(&param, sizeof(param));
+    param.Type     = MOS_GFXRES_BUFFER;
+    param.TileType = MOS_TILE_LINEAR;
+    param.Format   = Format_Buffer;
+    param.dwBytes  = size;
+    return param;
+}
+
+TEST(EncodeTrackedBufferTest, FirstSizeIsNotSizeChange)
+{
+    TestTrackedBuffer trackedBuf;
+
+    // first frame, no buffer queue yet
+    EXPECT_EQ(MOS_STATUS_SUCCESS, trackedBuf.OnSizeChange());
+    EXPECT_EQ(0u, trackedBuf.GetSizeChangeStats().sizeChanges);
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, trackedBuf.RegisterParam(BufferType::mbCodedBuffer, BufferParam(0x10000)));
+    auto queue = trackedBuf.GetBufferQueue(BufferType::mbCodedBuffer);
+    ASSERT_NE(nullptr, queue);
+
+    // buffer is allocated at the registered size, without headroom
+    EXPECT_TRUE(queue->Fits(BufferParam(0x10000)));
+    EXPECT_FALSE(queue->Fits(BufferParam(0x10000 + 1)));
+
+    auto stats = trackedBuf.GetSizeChangeStats();
+    EXPECT_EQ(0u, stats.sizeChanges);
+    EXPECT_EQ(0u, stats.newQueues);
+}
+
+TEST(EncodeTrackedBufferTest, SizeChangeAddsHeadroom)
+{
+    TestTrackedBuffer trackedBuf;
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, trackedBuf.RegisterParam(BufferType::mbCodedBuffer, BufferParam(0x10000)));
+    ASSERT_NE(nullptr, trackedBuf.GetBufferQueue(BufferType::mbCodedBuffer));
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, trackedBuf.OnSizeChange());
+    EXPECT_EQ(1u, trackedBuf.GetSizeChangeStats().sizeChanges);
+
+    // larger size does not fit the old queue, new one has 1/4 headroom
+    EXPECT_EQ(MOS_STATUS_SUCCESS, trackedBuf.RegisterParam(BufferType::mbCodedBuffer, BufferParam(0x20000)));
+    auto queue = trackedBuf.GetBufferQueue(BufferType::mbCodedBuffer);
+    ASSERT_NE(nullptr, queue);
+    EXPECT_TRUE(queue->Fits(BufferParam(0x20000 + 0x8000)));
+    EXPECT_FALSE(queue->Fits(BufferParam(0x20000 + 0x8000 + 1)));
+
+    auto stats = trackedBuf.GetSizeChangeStats();
+    EXPECT_EQ(1u, stats.sizeChanges);
+    EXPECT_EQ(1u, stats.newQueues);
+    EXPECT_EQ(0u, stats.reusedQueues);
+}
+
+TEST(EncodeTrackedBufferTest, SmallerSizeReusesQueue)
+{
+    TestTrackedBuffer trackedBuf;
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, trackedBuf.RegisterParam(BufferType::mbCodedBuffer, BufferParam(0x10000)));
+    auto queue = trackedBuf.GetBufferQueue(BufferType::mbCodedBuffer);
+    ASSERT_NE(nullptr, queue);
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, trackedBuf.OnSizeChange());
+    EXPECT_EQ(MOS_STATUS_SUCCESS, trackedBuf.RegisterParam(BufferType::mbCodedBuffer, BufferParam(0x8000)));
+    EXPECT_EQ(queue, trackedBuf.GetBufferQueue(BufferType::mbCodedBuffer));
+
+    auto stats = trackedBuf.GetSizeChangeStats();
+    EXPECT_EQ(1u, stats.reusedQueues);
+    EXPECT_EQ(0u, stats.newQueues);
+}
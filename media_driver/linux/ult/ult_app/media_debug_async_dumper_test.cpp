@@ -0,0 +1,293 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_debug_async_dumper_test.cpp
+//! \brief    Threading, lock deferral and drop policy of the async dumper.
+//!
+
+#include "gtest/gtest.h"
+#include "media_debug_interface.h"
+#if USE_MEDIA_DEBUG_TOOL
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include "media_debug_async_dumper.h"
+
+// Fake os interface keeping the content of each resource in memory
+struct FakeOs
+{
+    std::map<PMOS_RESOURCE, std::vector<uint8_t>> data;
+    std::set<std::thread::id>                     mosThreads;
+    uint32_t                                      allocations = 0;
+    uint32_t                                      locks       = 0;
+    uint32_t                                      unlocks     = 0;
+    bool                                          failLock    = false;
+
+    void Called() { mosThreads.insert(std::this_thread::get_id()); }
+};
+
+static FakeOs g_fakeOs;
+
+static MOS_STATUS FakeAllocateResource(
+    PMOS_INTERFACE           osInterface,
+    PMOS_ALLOC_GFXRES_PARAMS params,
+#if MOS_MESSAGES_ENABLED
+    const char              *functionName,
+    const char              *filename,
+    int32_t                  line,
+#endif
+    PMOS_RESOURCE            resource)
+{
+    g_fakeOs.Called();
+    g_fakeOs.allocations++;
+    g_fakeOs.data[resource].assign(params->dwBytes, 0);
+    return MOS_STATUS_SUCCESS;
+}
+
+static void FakeFreeResource(
+    PMOS_INTERFACE osInterface,
+#if MOS_MESSAGES_ENABLED
+    const char    *functionName,
+    const char    *filename,
+    int32_t        line,
+#endif
+    PMOS_RESOURCE  resource)
+{
+    g_fakeOs.Called();
+    g_fakeOs.data.erase(resource);
+}
+
+static MOS_STATUS FakeSkipResourceSync(PMOS_RESOURCE resource)
+{
+    g_fakeOs.Called();
+    return MOS_STATUS_SUCCESS;
+}
+
+static MOS_STATUS FakeGetResourceInfo(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource, PMOS_SURFACE details)
+{
+    g_fakeOs.Called();
+    return MOS_STATUS_SUCCESS;
+}
+
+static MOS_STATUS FakeDoubleBufferCopyResource(
+    PMOS_INTERFACE osInterface,
+    PMOS_RESOURCE  input,
+    PMOS_RESOURCE  output,
+    bool           outputCompressed)
+{
+    g_fakeOs.Called();
+    std::vector<uint8_t> &src = g_fakeOs.data[input];
+    std::vector<uint8_t> &dst = g_fakeOs.data[output];
+    std::copy(src.begin(), src.begin() + std::min(src.size(), dst.size()), dst.begin());
+    return MOS_STATUS_SUCCESS;
+}
+
+static void *FakeLockResource(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource, PMOS_LOCK_PARAMS flags)
+{
+    g_fakeOs.Called();
+    if (g_fakeOs.failLock)
+    {
+        return nullptr;
+    }
+    g_fakeOs.locks++;
+    return g_fakeOs.data[resource].data();
+}
+
+static MOS_STATUS FakeUnlockResource(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource)
+{
+    g_fakeOs.Called();
+    g_fakeOs.unlocks++;
+    return MOS_STATUS_SUCCESS;
+}
+
+class TestAsyncDumper : public MediaDebugAsyncDumper
+{
+public:
+    TestAsyncDumper(PMOS_INTERFACE osInterface) : MediaDebugAsyncDumper(osInterface) {}
+
+    MOS_STATUS SubmitData(PMOS_RESOURCE source, uint32_t size, WriteFunc write)
+    {
+        MOS_ALLOC_GFXRES_PARAMS allocParams;
+        MOS_ZeroMemory(&allocParams, sizeof(MOS_ALLOC_GFXRES_PARAMS));
+        allocParams.Type     = MOS_GFXRES_BUFFER;
+        allocParams.Format   = Format_Buffer;
+        allocParams.dwBytes  = size;
+        allocParams.dwWidth  = size;
+        allocParams.dwHeight = 1;
+        return Submit(source, allocParams, size, write);
+    }
+};
+
+class MediaDebugAsyncDumperTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        g_fakeOs = FakeOs();
+
+        m_osInterface.pfnAllocateResource         = FakeAllocateResource;
+        m_osInterface.pfnFreeResource             = FakeFreeResource;
+        m_osInterface.pfnSkipResourceSync         = FakeSkipResourceSync;
+        m_osInterface.pfnGetResourceInfo          = FakeGetResourceInfo;
+        m_osInterface.pfnDoubleBufferCopyResource = FakeDoubleBufferCopyResource;
+        m_osInterface.pfnLockResource             = FakeLockResource;
+        m_osInterface.pfnUnlockResource           = FakeUnlockResource;
+
+        for (uint32_t i = 0; i < m_sourceNum; i++)
+        {
+            g_fakeOs.data[&m_sources[i]].assign(m_size, (uint8_t)(i + 1));
+        }
+    }
+
+    //!
+    //! \brief  Write function recording the first byte of data and the thread it ran on
+    //!
+    MediaDebugAsyncDumper::WriteFunc Recorder()
+    {
+        return [this](uint8_t *data, const MOS_SURFACE &staging) {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            m_writtenData.push_back(data[0]);
+            m_writeThreads.insert(std::this_thread::get_id());
+            return MOS_STATUS_SUCCESS;
+        };
+    }
+
+    static const uint32_t m_sourceNum = 4;
+    static const uint32_t m_size      = 4096;
+
+    MOS_INTERFACE             m_osInterface = {};
+    MOS_RESOURCE              m_sources[m_sourceNum] = {};
+    std::mutex                m_writeMutex;
+    std::vector<uint8_t>      m_writtenData;
+    std::set<std::thread::id> m_writeThreads;
+};
+
+TEST_F(MediaDebugAsyncDumperTest, MosCallsStayOnSubmittingThread)
+{
+    {
+        TestAsyncDumper dumper(&m_osInterface);
+        ASSERT_EQ(MOS_STATUS_SUCCESS, dumper.Init());
+
+        for (auto &source : m_sources)
+        {
+            EXPECT_EQ(MOS_STATUS_SUCCESS, dumper.SubmitData(&source, m_size, Recorder()));
+        }
+        EXPECT_EQ(MOS_STATUS_SUCCESS, dumper.Flush());
+
+        auto stats = dumper.GetStatistics();
+        EXPECT_EQ((uint64_t)m_sourceNum, stats.submitted);
+        EXPECT_EQ((uint64_t)m_sourceNum, stats.written);
+        EXPECT_EQ(0u, stats.dropped);
+        EXPECT_EQ(g_fakeOs.locks, g_fakeOs.unlocks);
+    }
+
+    // Requests are written in order with the data copied from each source
+    EXPECT_EQ(std::vector<uint8_t>({1, 2, 3, 4}), m_writtenData);
+
+    std::set<std::thread::id> submittingThread = {std::this_thread::get_id()};
+    EXPECT_EQ(submittingThread, g_fakeOs.mosThreads);
+    ASSERT_EQ(1u, m_writeThreads.size());
+    EXPECT_NE(std::this_thread::get_id(), *m_writeThreads.begin());
+}
+
+TEST_F(MediaDebugAsyncDumperTest, LockDeferredUntilLaterCopies)
+{
+    TestAsyncDumper dumper(&m_osInterface);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, dumper.Init());
+
+    for (uint32_t i = 0; i < MediaDebugAsyncDumper::m_lockLag; i++)
+    {
+        EXPECT_EQ(MOS_STATUS_SUCCESS, dumper.SubmitData(&m_sources[i], m_size, Recorder()));
+    }
+    EXPECT_EQ(0u, g_fakeOs.locks);
+
+    // The oldest copy is locked once more than m_lockLag copies are in flight
+    EXPECT_EQ(MOS_STATUS_SUCCESS, dumper.SubmitData(&m_sources[MediaDebugAsyncDumper::m_lockLag], m_size, Recorder()));
+    EXPECT_EQ(1u, g_fakeOs.locks);
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, dumper.Flush());
+    EXPECT_EQ(MediaDebugAsyncDumper::m_lockLag + 1, g_fakeOs.locks);
+    EXPECT_EQ(g_fakeOs.locks, g_fakeOs.unlocks);
+}
+
+TEST_F(MediaDebugAsyncDumperTest, DropsOverQueueDepth)
+{
+    TestAsyncDumper dumper(&m_osInterface);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, dumper.Init(MediaDebugAsyncDumper::m_defaultBudget, 1));
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, dumper.SubmitData(&m_sources[0], m_size, Recorder()));
+    EXPECT_EQ(MOS_STATUS_NO_SPACE, dumper.SubmitData(&m_sources[1], m_size, Recorder()));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, dumper.Flush());
+
+    auto stats = dumper.GetStatistics();
+    EXPECT_EQ(1u, stats.written);
+    EXPECT_EQ(1u, stats.dropped);
+    EXPECT_EQ(std::vector<uint8_t>({1}), m_writtenData);
+}
+
+TEST_F(MediaDebugAsyncDumperTest, DropsOverBudgetAndReusesIdleStaging)
+{
+    TestAsyncDumper dumper(&m_osInterface);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, dumper.Init(m_size));
+
+    // Staging of the first request is busy until written and unlocked
+    EXPECT_EQ(MOS_STATUS_SUCCESS, dumper.SubmitData(&m_sources[0], m_size, Recorder()));
+    EXPECT_EQ(MOS_STATUS_NO_SPACE, dumper.SubmitData(&m_sources[1], m_size, Recorder()));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, dumper.Flush());
+
+    // then reused for the same size
+    EXPECT_EQ(MOS_STATUS_SUCCESS, dumper.SubmitData(&m_sources[2], m_size, Recorder()));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, dumper.Flush());
+    EXPECT_EQ(1u, g_fakeOs.allocations);
+
+    // and freed to fit a staging of another size
+    EXPECT_EQ(MOS_STATUS_SUCCESS, dumper.SubmitData(&m_sources[3], m_size / 2, Recorder()));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, dumper.Flush());
+    EXPECT_EQ(2u, g_fakeOs.allocations);
+
+    auto stats = dumper.GetStatistics();
+    EXPECT_EQ(3u, stats.written);
+    EXPECT_EQ(1u, stats.dropped);
+    EXPECT_EQ(m_size / 2, stats.stagingSize);
+    EXPECT_EQ((uint64_t)m_size, stats.peakStagingSize);
+    EXPECT_EQ(std::vector<uint8_t>({1, 3, 4}), m_writtenData);
+}
+
+TEST_F(MediaDebugAsyncDumperTest, FailedLockIsCounted)
+{
+    TestAsyncDumper dumper(&m_osInterface);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, dumper.Init());
+
+    g_fakeOs.failLock = true;
+    EXPECT_EQ(MOS_STATUS_SUCCESS, dumper.SubmitData(&m_sources[0], m_size, Recorder()));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, dumper.Flush());
+
+    auto stats = dumper.GetStatistics();
+    EXPECT_EQ(0u, stats.written);
+    EXPECT_EQ(1u, stats.failed);
+    EXPECT_TRUE(m_writtenData.empty());
+}
+
+#endif  // USE_MEDIA_DEBUG_TOOL
@@ -0,0 +1,234 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_gmm_cache_test.cpp
+//! \brief    Hits, misses, keys and eviction of the GMM resource info cache.
+//!
+
+#include <set>
+#include <string.h>
+#include "gtest/gtest.h"
+#include "media_libva_gmm_cache.h"
+
+// Resource info objects are only compared by address, the live ones are listed here
+class TestGmmResInfoCache : public MediaLibvaGmmResInfoCache
+{
+public:
+    TestGmmResInfoCache() : MediaLibvaGmmResInfoCache(nullptr) {}
+
+    ~TestGmmResInfoCache() { Clear(); }
+
+    //! \brief  Destroy an object handed out by CreateResInfoObject, as the GMM client context does
+    void Destroy(GMM_RESOURCE_INFO *resInfo) { EXPECT_EQ(1u, m_live.erase(resInfo)); }
+
+    uint32_t m_created = 0;
+    std::set<GMM_RESOURCE_INFO *> m_live;
+    GMM_RESCREATE_PARAMS *m_reenterParams = nullptr;   //!< Created again from within the first creation
+    GMM_RESOURCE_INFO    *m_reentered     = nullptr;
+
+protected:
+    GMM_RESOURCE_INFO *NewObject()
+    {
+        GMM_RESOURCE_INFO *resInfo = reinterpret_cast<GMM_RESOURCE_INFO *>((uintptr_t)(++m_nextId) << 4);
+        m_live.insert(resInfo);
+        return resInfo;
+    }
+
+    GMM_RESOURCE_INFO *GmmCreateResInfo(GMM_RESCREATE_PARAMS *params) override
+    {
+        m_created++;
+        if (m_reenterParams)
+        {
+            // Another thread missing on the same parameters while GMM creates the first one
+            GMM_RESCREATE_PARAMS *reenterParams = m_reenterParams;
+            m_reenterParams = nullptr;
+            m_reentered     = CreateResInfoObject(reenterParams);
+        }
+        return NewObject();
+    }
+
+    GMM_RESOURCE_INFO *GmmCopyResInfo(GMM_RESOURCE_INFO *resInfo) override
+    {
+        EXPECT_EQ(1u, m_live.count(resInfo));
+        return NewObject();
+    }
+
+    void GmmDestroyResInfo(GMM_RESOURCE_INFO *resInfo) override
+    {
+        EXPECT_EQ(1u, m_live.erase(resInfo));
+    }
+
+    uintptr_t m_nextId = 0;
+};
+
+class MediaLibvaGmmResInfoCacheTest : public testing::Test
+{
+protected:
+    static GMM_RESCREATE_PARAMS SurfaceParams(uint32_t width)
+    {
+        GMM_RESCREATE_PARAMS params;
+        memset(&params, 0, sizeof(params));
+        params.Type              = RESOURCE_2D;
+        params.Format            = GMM_FORMAT_NV12;
+        params.BaseWidth         = width;
+        params.BaseHeight        = 1080;
+        params.ArraySize         = 1;
+        params.Flags.Gpu.Video   = true;
+        params.Flags.Info.TiledY = true;
+        return params;
+    }
+
+    void ExpectStats(uint64_t hits, uint64_t misses, uint64_t evicted, uint32_t entries)
+    {
+        MediaLibvaGmmResInfoCache::Statistics stats = m_cache.GetStatistics();
+        EXPECT_EQ(hits, stats.hits);
+        EXPECT_EQ(misses, stats.misses);
+        EXPECT_EQ(evicted, stats.evicted);
+        EXPECT_EQ(entries, stats.entries);
+    }
+
+    TestGmmResInfoCache m_cache;
+};
+
+TEST_F(MediaLibvaGmmResInfoCacheTest, SameParametersHit)
+{
+    GMM_RESCREATE_PARAMS params = SurfaceParams(1920);
+
+    GMM_RESOURCE_INFO *first  = m_cache.CreateResInfoObject(&params);
+    GMM_RESOURCE_INFO *second = m_cache.CreateResInfoObject(&params);
+    ASSERT_NE(nullptr, first);
+    ASSERT_NE(nullptr, second);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(1u, m_cache.m_created);
+    ExpectStats(1, 1, 0, 1);
+
+    // Objects handed out and the template are separate
+    m_cache.Destroy(first);
+    m_cache.Destroy(second);
+    EXPECT_EQ(1u, m_cache.m_live.size());
+}
+
+TEST_F(MediaLibvaGmmResInfoCacheTest, KeyIgnoresPointersAndPadding)
+{
+    GMM_RESCREATE_PARAMS params = SurfaceParams(1920);
+    m_cache.Destroy(m_cache.CreateResInfoObject(&params));
+
+    // Same layout fields, every other byte differs
+    GMM_RESCREATE_PARAMS noisy;
+    memset(&noisy, 0x5a, sizeof(noisy));
+    noisy.Type               = params.Type;
+    noisy.Format             = params.Format;
+    noisy.Flags              = params.Flags;
+    noisy.Usage              = params.Usage;
+    noisy.BaseWidth          = params.BaseWidth;
+    noisy.BaseHeight         = params.BaseHeight;
+    noisy.Depth              = params.Depth;
+    noisy.ArraySize          = params.ArraySize;
+    noisy.MaxLod             = params.MaxLod;
+    noisy.BaseAlignment      = params.BaseAlignment;
+    noisy.OverridePitch      = params.OverridePitch;
+    noisy.CpTag              = params.CpTag;
+    noisy.MSAA.NumSamples    = params.MSAA.NumSamples;
+    noisy.pExistingSysMem    = 0;
+    noisy.ExistingSysMemSize = 0;
+
+    m_cache.Destroy(m_cache.CreateResInfoObject(&noisy));
+    EXPECT_EQ(1u, m_cache.m_created);
+    ExpectStats(1, 1, 0, 1);
+}
+
+TEST_F(MediaLibvaGmmResInfoCacheTest, DifferentLayoutFieldsMiss)
+{
+    GMM_RESCREATE_PARAMS params = SurfaceParams(1920);
+    m_cache.Destroy(m_cache.CreateResInfoObject(&params));
+
+    GMM_RESCREATE_PARAMS linear = params;
+    linear.Flags.Info.TiledY = false;
+    linear.Flags.Info.Linear = true;
+    m_cache.Destroy(m_cache.CreateResInfoObject(&linear));
+
+    GMM_RESCREATE_PARAMS wider = params;
+    wider.BaseWidth = 3840;
+    m_cache.Destroy(m_cache.CreateResInfoObject(&wider));
+
+    EXPECT_EQ(3u, m_cache.m_created);
+    ExpectStats(0, 3, 0, 3);
+}
+
+TEST_F(MediaLibvaGmmResInfoCacheTest, ExistingSysMemNotCached)
+{
+    uint8_t              sysMem[64] = {};
+    GMM_RESCREATE_PARAMS params     = SurfaceParams(16);
+    params.pExistingSysMem          = (GMM_VOIDPTR64)(uintptr_t)sysMem;
+    params.ExistingSysMemSize       = sizeof(sysMem);
+
+    m_cache.Destroy(m_cache.CreateResInfoObject(&params));
+    m_cache.Destroy(m_cache.CreateResInfoObject(&params));
+
+    EXPECT_EQ(2u, m_cache.m_created);
+    ExpectStats(0, 0, 0, 0);
+    EXPECT_EQ(0u, m_cache.m_live.size());
+}
+
+TEST_F(MediaLibvaGmmResInfoCacheTest, LeastRecentlyUsedEvicted)
+{
+    const uint32_t maxEntries = MediaLibvaGmmResInfoCache::m_maxEntries;
+
+    for (uint32_t i = 0; i <= maxEntries; i++)
+    {
+        GMM_RESCREATE_PARAMS params = SurfaceParams(64 + i);
+        m_cache.Destroy(m_cache.CreateResInfoObject(&params));
+    }
+    ExpectStats(0, maxEntries + 1, 1, maxEntries);
+
+    // The newest is still cached, the oldest was replaced
+    GMM_RESCREATE_PARAMS newest = SurfaceParams(64 + maxEntries);
+    m_cache.Destroy(m_cache.CreateResInfoObject(&newest));
+    GMM_RESCREATE_PARAMS oldest = SurfaceParams(64);
+    m_cache.Destroy(m_cache.CreateResInfoObject(&oldest));
+    ExpectStats(1, maxEntries + 2, 2, maxEntries);
+
+    EXPECT_EQ(maxEntries, m_cache.m_live.size());
+}
+
+TEST_F(MediaLibvaGmmResInfoCacheTest, ConcurrentMissKeepsOneTemplate)
+{
+    GMM_RESCREATE_PARAMS params  = SurfaceParams(1920);
+    GMM_RESCREATE_PARAMS params2 = params;
+
+    // GMM creation runs without the cache lock, so it can be entered again meanwhile
+    m_cache.m_reenterParams    = &params2;
+    GMM_RESOURCE_INFO *resInfo = m_cache.CreateResInfoObject(&params);
+    ASSERT_NE(nullptr, resInfo);
+    ASSERT_NE(nullptr, m_cache.m_reentered);
+
+    EXPECT_EQ(2u, m_cache.m_created);
+    ExpectStats(0, 2, 0, 1);
+
+    // The template of the later insertion is dropped
+    m_cache.Destroy(resInfo);
+    m_cache.Destroy(m_cache.m_reentered);
+    EXPECT_EQ(1u, m_cache.m_live.size());
+
+    m_cache.Destroy(m_cache.CreateResInfoObject(&params));
+    ExpectStats(1, 2, 0, 1);
+}
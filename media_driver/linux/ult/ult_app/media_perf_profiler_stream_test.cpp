@@ -0,0 +1,135 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_perf_profiler_stream_test.cpp
+//! \brief    Export and drop accounting of the perf profiler stream.
+//!
+
+#include <set>
+#include "gtest/gtest.h"
+#include "media_perf_profiler_stream.h"
+
+class TestPerfProfilerStream : public MediaPerfProfilerStream
+{
+public:
+    TestPerfProfilerStream() { m_timerBase = 12000000; }
+
+    using MediaPerfProfilerStream::Drain;
+};
+
+class PerfProfilerStreamTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_source.read = [this](uint32_t sequence, Record &record) {
+            if (m_completed.count(sequence) == 0)
+            {
+                return false;
+            }
+            record.gpuBegin = sequence * 100;
+            record.gpuEnd   = sequence * 100 + 50;
+            return true;
+        };
+    }
+
+    void Complete(uint32_t first, uint32_t last)
+    {
+        for (uint32_t sequence = first; sequence < last; sequence++)
+        {
+            m_completed.insert(sequence);
+        }
+    }
+
+    using Record = MediaPerfProfilerStream::Record;
+
+    TestPerfProfilerStream           m_stream;
+    MediaPerfProfilerStream::Source  m_source;
+    std::set<uint32_t>               m_completed;
+};
+
+TEST_F(PerfProfilerStreamTest, ExportsCompletedInOrder)
+{
+    m_source.capacity = 16;
+    MediaPerfProfilerStream::Submit(&m_source, 4);
+    Complete(0, 3);
+
+    m_stream.Drain(&m_source, false);
+    EXPECT_EQ(3u, m_stream.GetStatistics().exported);
+    EXPECT_EQ(3u, m_source.next);
+
+    // pending record is exported once completed, not exported twice
+    Complete(3, 4);
+    m_stream.Drain(&m_source, false);
+    EXPECT_EQ(4u, m_stream.GetStatistics().exported);
+    EXPECT_EQ(0u, m_stream.GetStatistics().dropped);
+    EXPECT_EQ(4u, m_source.next);
+    EXPECT_TRUE(m_source.exported.empty());
+}
+
+TEST_F(PerfProfilerStreamTest, OutOfOrderCompletion)
+{
+    m_source.capacity = 16;
+    MediaPerfProfilerStream::Submit(&m_source, 3);
+    Complete(1, 3);
+
+    m_stream.Drain(&m_source, false);
+    EXPECT_EQ(2u, m_stream.GetStatistics().exported);
+    EXPECT_EQ(0u, m_source.next);
+    EXPECT_EQ(2u, m_source.exported.size());
+
+    // final drain gives up the record never completed
+    m_stream.Drain(&m_source, true);
+    EXPECT_EQ(2u, m_stream.GetStatistics().exported);
+    EXPECT_EQ(1u, m_stream.GetStatistics().dropped);
+    EXPECT_EQ(3u, m_source.next);
+    EXPECT_TRUE(m_source.exported.empty());
+}
+
+TEST_F(PerfProfilerStreamTest, OverwrittenRecordsDropped)
+{
+    // sequences 0 to 5 were overwritten by 4 to 9 in the ring
+    m_source.capacity = 4;
+    MediaPerfProfilerStream::Submit(&m_source, 10);
+    Complete(0, 10);
+
+    m_stream.Drain(&m_source, false);
+    EXPECT_EQ(4u, m_stream.GetStatistics().exported);
+    EXPECT_EQ(6u, m_stream.GetStatistics().dropped);
+    EXPECT_EQ(10u, m_source.next);
+}
+
+TEST_F(PerfProfilerStreamTest, StuckRecordGivenUp)
+{
+    const uint32_t window = MediaPerfProfilerStream::m_scanWindow;
+
+    // the oldest record never completes, half a window after it does
+    m_source.capacity = 4 * window;
+    MediaPerfProfilerStream::Submit(&m_source, window / 2 + 1);
+    Complete(1, window / 2 + 1);
+
+    m_stream.Drain(&m_source, false);
+    EXPECT_EQ(window / 2, m_stream.GetStatistics().exported);
+    EXPECT_EQ(1u, m_stream.GetStatistics().dropped);
+    EXPECT_EQ(window / 2 + 1, m_source.next);
+    EXPECT_TRUE(m_source.exported.empty());
+}
@@ -0,0 +1,120 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_status_report_test.cpp
+//! \brief    Batched retrieval of completed status reports.
+//!
+
+#include "gtest/gtest.h"
+#include "media_status_report.h"
+
+enum
+{
+    reportParsed     = 1,
+    reportIncomplete = 2,
+};
+
+struct TestReport
+{
+    uint32_t index;
+    uint32_t status;
+};
+
+class TestStatusReport : public MediaStatusReport
+{
+public:
+    TestStatusReport()
+    {
+        m_completedCount = &m_completed;
+        m_sizeOfReport   = sizeof(TestReport);
+    }
+
+    MOS_STATUS Create() override { return MOS_STATUS_SUCCESS; }
+    MOS_STATUS Init(void *inputPar) override { return MOS_STATUS_SUCCESS; }
+    MOS_STATUS Reset() override { return MOS_STATUS_SUCCESS; }
+
+    uint32_t m_completed  = 0;
+    uint32_t m_failIndex  = 0xffffffff;
+
+protected:
+    MOS_STATUS ParseStatus(void *report, uint32_t index) override
+    {
+        if (index == m_failIndex)
+        {
+            return MOS_STATUS_UNKNOWN;
+        }
+        ((TestReport *)report)->index  = index;
+        ((TestReport *)report)->status = reportParsed;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_STATUS SetStatus(void *report, uint32_t index, bool outOfRange) override
+    {
+        ((TestReport *)report)->index  = index;
+        ((TestReport *)report)->status = reportIncomplete;
+        return MOS_STATUS_SUCCESS;
+    }
+};
+
+TEST(MediaStatusReportTest, GetCompletedReportsInOrder)
+{
+    TestStatusReport statusReport;
+    TestReport       reports[4] = {};
+    uint32_t         numReports = 0;
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, statusReport.GetCompletedReports(reports, 4, numReports));
+    EXPECT_EQ(0u, numReports);
+
+    statusReport.m_completed = 3;
+    EXPECT_EQ(MOS_STATUS_SUCCESS, statusReport.GetCompletedReports(reports, 2, numReports));
+    EXPECT_EQ(2u, numReports);
+    EXPECT_EQ(0u, reports[0].index);
+    EXPECT_EQ(1u, reports[1].index);
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, statusReport.GetCompletedReports(reports, 4, numReports));
+    EXPECT_EQ(1u, numReports);
+    EXPECT_EQ(2u, reports[0].index);
+    EXPECT_EQ(3u, statusReport.GetReportedCount());
+}
+
+TEST(MediaStatusReportTest, ParseFailureKeepsOtherReports)
+{
+    TestStatusReport statusReport;
+    TestReport       reports[4] = {};
+    uint32_t         numReports = 0;
+
+    statusReport.m_completed = 3;
+    statusReport.m_failIndex = 1;
+    EXPECT_NE(MOS_STATUS_SUCCESS, statusReport.GetCompletedReports(reports, 4, numReports));
+
+    // all completed reports are returned, the failed one as incomplete
+    ASSERT_EQ(3u, numReports);
+    EXPECT_EQ(reportParsed, reports[0].status);
+    EXPECT_EQ(1u, reports[1].index);
+    EXPECT_EQ(reportIncomplete, reports[1].status);
+    EXPECT_EQ(reportParsed, reports[2].status);
+
+    // consumed reports are not returned again
+    EXPECT_EQ(3u, statusReport.GetReportedCount());
+    EXPECT_EQ(MOS_STATUS_SUCCESS, statusReport.GetCompletedReports(reports, 4, numReports));
+    EXPECT_EQ(0u, numReports);
+}
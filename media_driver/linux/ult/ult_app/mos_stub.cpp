@@ -19,8 +19,17 @@
 * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
 * OTHER DEALINGS IN THE SOFTWARE.
 */
+#include <cstdarg>
+#include <cstdio>
 #include <cstring>
+#include <new>
+#include <pthread.h>
+#include <semaphore.h>
+#include <time.h>
+#include <unistd.h>
 #include "mos_utilities.h"
+#include "mos_util_debug.h"
+#include "mos_interface.h"
 using namespace std;
 
 void MosUtilities::MosZeroMemory(void *pDestination, size_t stLength)
@@ -31,3 +40,219 @@ void MosUtilities::MosZeroMemory(void *pDestination, size_t stLength)
     }
 }
 
+
+MOS_STATUS MosUtilities::MosSecureMemcpy(void *pDestination, size_t dstLength, PCVOID pSource, size_t srcLength)
+{
+    if (pDestination == nullptr || pSource == nullptr || dstLength < srcLength)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+    if (pDestination != pSource)
+    {
+        memcpy(pDestination, pSource, srcLength);
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
+void MosUtilities::MosTraceEvent(
+    uint16_t         usId,
+    uint8_t          ucType,
+    const void       *pArg1,
+    uint32_t         dwSize1,
+    const void       *pArg2,
+    uint32_t         dwSize2)
+{
+}
+
+#if MOS_ASSERT_ENABLED
+void MosUtilDebug::MosAssert(
+    MOS_COMPONENT_ID compID,
+    uint8_t          subCompID)
+{
+}
+#endif
+
+int32_t MosUtilities::MosSecureStringPrint(char *buffer, size_t bufSize, size_t length, const char * const format, ...)
+{
+    if (buffer == nullptr || format == nullptr || bufSize < length)
+    {
+        return -1;
+    }
+
+    va_list var_args;
+    va_start(var_args, format);
+    int32_t iRet = vsnprintf(buffer, length, format, var_args);
+    va_end(var_args);
+    return iRet;
+}
+
+MOS_STATUS MosUtilities::MosSecureFileOpen(FILE **ppFile, const char *filename, const char *mode)
+{
+    if (ppFile == nullptr || filename == nullptr || mode == nullptr)
+    {
+        return MOS_STATUS_NULL_POINTER;
+    }
+    *ppFile = fopen(filename, mode);
+    return *ppFile ? MOS_STATUS_SUCCESS : MOS_STATUS_FILE_OPEN_FAILED;
+}
+
+int32_t MosUtilities::MosGetPid()
+{
+    return (int32_t)getpid();
+}
+
+void MosUtilities::MosSleep(uint32_t mSec)
+{
+    usleep(1000 * mSec);
+}
+
+MOS_THREADHANDLE MosUtilities::MosCreateThread(void *ThreadFunction, void *ThreadData)
+{
+    MOS_THREADHANDLE thread;
+    if (pthread_create(&thread, nullptr, (void *(*)(void *))ThreadFunction, ThreadData))
+    {
+        thread = 0;
+    }
+    return thread;
+}
+
+MOS_STATUS MosUtilities::MosWaitThread(MOS_THREADHANDLE hThread)
+{
+    if (hThread == 0 || pthread_join(hThread, nullptr))
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
+int32_t MosUtilities::m_mosMemAllocCounter      = 0;
+int32_t MosUtilities::m_mosMemAllocTotalCounter = 0;
+bool    MosUtilities::m_mosCostAccounting       = false;
+
+uint64_t MosUtilities::MosGetCurTime()
+{
+    struct timespec ts = {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+PMOS_MUTEX MosUtilities::MosCreateMutex(uint32_t spinCount)
+{
+    PMOS_MUTEX pMutex = new (nothrow) pthread_mutex_t;
+    if (pMutex != nullptr && pthread_mutex_init(pMutex, nullptr))
+    {
+        delete pMutex;
+        pMutex = nullptr;
+    }
+    return pMutex;
+}
+
+MOS_STATUS MosUtilities::MosDestroyMutex(PMOS_MUTEX pMutex)
+{
+    if (pMutex != nullptr)
+    {
+        pthread_mutex_destroy(pMutex);
+        delete pMutex;
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MosUtilities::MosLockMutex(PMOS_MUTEX pMutex)
+{
+    if (pMutex == nullptr || pthread_mutex_lock(pMutex))
+    {
+        return MOS_STATUS_INVALID_HANDLE;
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MosUtilities::MosUnlockMutex(PMOS_MUTEX pMutex)
+{
+    if (pMutex == nullptr || pthread_mutex_unlock(pMutex))
+    {
+        return MOS_STATUS_INVALID_HANDLE;
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
+PMOS_SEMAPHORE MosUtilities::MosCreateSemaphore(uint32_t uiInitialCount, uint32_t uiMaximumCount)
+{
+    PMOS_SEMAPHORE pSemaphore = new (nothrow) sem_t;
+    if (pSemaphore != nullptr && sem_init(pSemaphore, 0, uiInitialCount))
+    {
+        delete pSemaphore;
+        pSemaphore = nullptr;
+    }
+    return pSemaphore;
+}
+
+MOS_STATUS MosUtilities::MosDestroySemaphore(PMOS_SEMAPHORE pSemaphore)
+{
+    if (pSemaphore != nullptr)
+    {
+        sem_destroy(pSemaphore);
+        delete pSemaphore;
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MosUtilities::MosWaitSemaphore(PMOS_SEMAPHORE pSemaphore, uint32_t uiMilliseconds)
+{
+    if (pSemaphore == nullptr || sem_wait(pSemaphore))
+    {
+        return MOS_STATUS_UNKNOWN;
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MosUtilities::MosPostSemaphore(PMOS_SEMAPHORE pSemaphore, uint32_t uiPostCount)
+{
+    for (uint32_t i = 0; pSemaphore != nullptr && i < uiPostCount; i++)
+    {
+        sem_post(pSemaphore);
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
+int32_t MosUtilities::MosAtomicIncrement(int32_t *pValue)
+{
+    return __sync_add_and_fetch(pValue, 1);
+}
+
+int32_t MosUtilities::MosAtomicDecrement(int32_t *pValue)
+{
+    return __sync_sub_and_fetch(pValue, 1);
+}
+
+double MosUtilities::MosGetTime()
+{
+    return (double)MosGetCurTime();
+}
+
+#if (_DEBUG || _RELEASE_INTERNAL)
+bool MosUtilities::MosSimulateAllocMemoryFail(
+    size_t      size,
+    size_t      alignment,
+    const char *functionName,
+    const char *filename,
+    int32_t     line)
+{
+    return false;
+}
+#endif
+
+// Device level resources are only freed through test doubles
+MOS_STATUS MosInterface::FreeResource(
+    MOS_STREAM_HANDLE   streamState,
+    MOS_RESOURCE_HANDLE resource,
+    uint32_t            flag
+#if MOS_MESSAGES_ENABLED
+    ,
+    const char *functionName,
+    const char *filename,
+    int32_t     line
+#endif
+)
+{
+    return MOS_STATUS_UNIMPLEMENTED;
+}
@@ -0,0 +1,171 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_vdbox_scheduler_test.cpp
+//! \brief    Load accounting and engine selection of the VDBox scheduler.
+//!
+
+#include <set>
+#include "gtest/gtest.h"
+#include "mos_vdbox_scheduler_specific.h"
+
+// Command buffer bos are only compared by address, busy ones are listed here
+static std::set<MOS_LINUX_BO *> g_busyBos;
+
+int mos_bo_busy(struct mos_linux_bo *bo)
+{
+    return g_busyBos.count(bo) ? 1 : 0;
+}
+
+void mos_bo_reference(struct mos_linux_bo *bo)
+{
+}
+
+void mos_bo_unreference(struct mos_linux_bo *bo)
+{
+}
+
+class TestVdboxScheduler : public MosVdboxScheduler
+{
+public:
+    ~TestVdboxScheduler() { g_busyBos.clear(); }
+
+    void Submit(MOS_VDBOX_NODE_IND node, MOS_LINUX_BO *bo)
+    {
+        g_busyBos.insert(bo);
+        OnSubmit(this, node, bo);
+    }
+
+    void Complete(MOS_LINUX_BO *bo) { g_busyBos.erase(bo); }
+
+    uint64_t m_now = 0;
+
+protected:
+    uint64_t GetCurTime() override { return m_now; }
+};
+
+TEST(MosVdboxSchedulerTest, BatchesRetiredTogetherShareInterval)
+{
+    TestVdboxScheduler scheduler;
+    MOS_LINUX_BO       bos[3] = {};
+
+    for (auto &bo : bos)
+    {
+        scheduler.Submit(MOS_VDBOX_NODE_1, &bo);
+    }
+    for (auto &bo : bos)
+    {
+        scheduler.Complete(&bo);
+    }
+
+    // All three completed by the poll 300 us later, 100 us is charged to each
+    scheduler.m_now = 300;
+    MosVdboxScheduler::EngineStats stats;
+    EXPECT_EQ(MOS_STATUS_SUCCESS, scheduler.GetEngineStats(MOS_VDBOX_NODE_1, stats));
+    EXPECT_EQ(0u, stats.inFlight);
+    EXPECT_EQ(3u, stats.submissions);
+    EXPECT_EQ(300u, stats.busyTime);
+
+    uint64_t avgBatchTime = 1000;
+    for (int i = 0; i < 3; i++)
+    {
+        avgBatchTime = (avgBatchTime * 7 + 100) / 8;
+    }
+    EXPECT_EQ(avgBatchTime, stats.avgBatchTime);
+}
+
+TEST(MosVdboxSchedulerTest, OnlyCompletedPrefixIsRetired)
+{
+    TestVdboxScheduler scheduler;
+    MOS_LINUX_BO       bos[3] = {};
+
+    for (auto &bo : bos)
+    {
+        scheduler.Submit(MOS_VDBOX_NODE_2, &bo);
+    }
+
+    // The ring executes in order, a later bo is not retired before an earlier busy one
+    scheduler.Complete(&bos[0]);
+    scheduler.Complete(&bos[2]);
+    scheduler.m_now = 200;
+
+    MosVdboxScheduler::EngineStats stats;
+    EXPECT_EQ(MOS_STATUS_SUCCESS, scheduler.GetEngineStats(MOS_VDBOX_NODE_2, stats));
+    EXPECT_EQ(2u, stats.inFlight);
+    EXPECT_EQ(200u, stats.busyTime);
+
+    // The remaining two run from the previous completion
+    scheduler.Complete(&bos[1]);
+    scheduler.m_now = 500;
+    EXPECT_EQ(MOS_STATUS_SUCCESS, scheduler.GetEngineStats(MOS_VDBOX_NODE_2, stats));
+    EXPECT_EQ(0u, stats.inFlight);
+    EXPECT_EQ(500u, stats.busyTime);
+    EXPECT_EQ(100u, stats.utilization);
+}
+
+TEST(MosVdboxSchedulerTest, SelectsLeastLoadedEngine)
+{
+    TestVdboxScheduler scheduler;
+    MOS_LINUX_BO       bos[2] = {};
+
+    scheduler.Submit(MOS_VDBOX_NODE_1, &bos[0]);
+    scheduler.Submit(MOS_VDBOX_NODE_1, &bos[1]);
+    EXPECT_EQ(MOS_VDBOX_NODE_2, scheduler.SelectCmdBufferNode());
+
+    // Session counts of all processes do not override a load difference of one session
+    uint32_t sessionCount[MosVdboxScheduler::m_maxVdboxNum] = {1, 2};
+    EXPECT_EQ(MOS_GPU_NODE_VIDEO2, scheduler.SelectSessionNode(sessionCount));
+
+    // but override when the difference is larger
+    sessionCount[1] = 3;
+    EXPECT_EQ(MOS_GPU_NODE_VIDEO, scheduler.SelectSessionNode(sessionCount));
+
+    // Once the load is drained, sessions of this process break the tie
+    scheduler.Complete(&bos[0]);
+    scheduler.Complete(&bos[1]);
+    scheduler.m_now = 100;
+    scheduler.AddSession(MOS_GPU_NODE_VIDEO);
+    EXPECT_EQ(MOS_VDBOX_NODE_2, scheduler.SelectCmdBufferNode());
+}
+
+TEST(MosVdboxSchedulerTest, EqualLoadsAlternate)
+{
+    TestVdboxScheduler scheduler;
+
+    MOS_VDBOX_NODE_IND first  = scheduler.SelectCmdBufferNode();
+    MOS_VDBOX_NODE_IND second = scheduler.SelectCmdBufferNode();
+    EXPECT_NE(first, second);
+}
+
+TEST(MosVdboxSchedulerTest, RemoveOwnerDropsSubmissions)
+{
+    TestVdboxScheduler scheduler;
+    MOS_LINUX_BO       bo = {};
+
+    scheduler.Submit(MOS_VDBOX_NODE_1, &bo);
+    scheduler.RemoveOwner(&scheduler);
+
+    MosVdboxScheduler::EngineStats stats;
+    EXPECT_EQ(MOS_STATUS_SUCCESS, scheduler.GetEngineStats(MOS_VDBOX_NODE_1, stats));
+    EXPECT_EQ(0u, stats.inFlight);
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, scheduler.GetEngineStats(MOS_VDBOX_NODE_INVALID, stats));
+}
@@ -0,0 +1,266 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_vma_test.cpp
+//! \brief    Replay alloc/free traces against the list and the indexed vma heap.
+//! \details  A trace recorded from a workload can be replayed by setting MOS_VMA_TRACE
+//!           to a text file with one operation per line:
+//!             a <id> <size> <alignment>
+//!             f <id>
+//!           Without it, a synthetic trace churning buffers of a transcoder is used.
+//!
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_vma.h"
+
+class MosVmaTest : public testing::Test
+{
+public:
+    struct Op
+    {
+        bool     alloc;
+        uint32_t id;
+        uint64_t size;
+        uint64_t alignment;
+    };
+
+    static const uint64_t m_heapStart = 0x100000000ull;
+    static const uint64_t m_heapSize  = 0x10000000000ull;   // 1TB, size of the sys memory zone
+    static const uint64_t m_pageSize  = 0x1000;
+
+protected:
+    void SetUp() override
+    {
+        const char *path = getenv("MOS_VMA_TRACE");
+        if (path == nullptr || !LoadTrace(path))
+        {
+            GenerateTrace(4096, 50000);
+        }
+    }
+
+    bool LoadTrace(const char *path)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        char type = 0;
+        while (file >> type)
+        {
+            Op op = {};
+            op.alloc = (type == 'a');
+            file >> op.id;
+            if (op.alloc)
+            {
+                file >> op.size >> op.alignment;
+            }
+            m_trace.push_back(op);
+        }
+        return !m_trace.empty();
+    }
+
+    //!
+    //! \brief  Generate a trace keeping about liveCount buffers of mixed sizes, where
+    //!         long lived buffers stay while short lived ones churn, which fragments the heap
+    //!
+    void GenerateTrace(uint32_t liveCount, uint32_t opCount)
+    {
+        const uint64_t sizes[] = {m_pageSize, 4 * m_pageSize, 16 * m_pageSize, 64 * m_pageSize,
+                                  0x200000, 0x800000, 0x1800000, 0x4000000};
+        uint32_t seed = 0x12345678;
+        auto rand = [&seed]() {
+            seed = seed * 1103515245 + 12345;
+            return seed >> 8;
+        };
+
+        std::vector<uint32_t> live;
+        uint32_t nextId = 0;
+        for (uint32_t i = 0; i < opCount; i++)
+        {
+            if (live.size() < liveCount / 2 || (live.size() < liveCount && rand() % 2))
+            {
+                Op op        = {};
+                op.alloc     = true;
+                op.id        = nextId++;
+                op.size      = sizes[rand() % (sizeof(sizes) / sizeof(sizes[0]))] + (rand() % 16) * m_pageSize;
+                op.alignment = (rand() % 4 == 0) ? 0x200000 : m_pageSize;
+                m_trace.push_back(op);
+                live.push_back(op.id);
+            }
+            else
+            {
+                uint32_t index = rand() % live.size();
+                Op op          = {};
+                op.id          = live[index];
+                m_trace.push_back(op);
+                live[index] = live.back();
+                live.pop_back();
+            }
+        }
+        for (auto id : live)
+        {
+            Op op = {};
+            op.id = id;
+            m_trace.push_back(op);
+        }
+    }
+
+    //!
+    //! \brief  Replay the trace, check allocations do not overlap and return time in us
+    //!
+    uint64_t Replay(bool indexed, mos_vma_heap_stats &peakStats)
+    {
+        mos_vma_heap heap = {};
+        if (indexed)
+        {
+            mos_vma_heap_init_indexed(&heap, m_heapStart, m_heapSize);
+        }
+        else
+        {
+            mos_vma_heap_init(&heap, m_heapStart, m_heapSize);
+        }
+
+        std::map<uint32_t, std::pair<uint64_t, uint64_t>> allocations;  // id -> offset, size
+        std::map<uint64_t, uint64_t>                      ranges;       // offset -> end
+        uint64_t                                          elapsed = 0;
+        peakStats = {};
+
+        for (auto &op : m_trace)
+        {
+            auto start = std::chrono::steady_clock::now();
+            uint64_t offset = 0;
+            if (op.alloc)
+            {
+                offset = mos_vma_heap_alloc(&heap, op.size, op.alignment);
+            }
+            else if (allocations.count(op.id))
+            {
+                mos_vma_heap_free(&heap, allocations[op.id].first, allocations[op.id].second);
+            }
+            elapsed += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+            if (op.alloc)
+            {
+                EXPECT_NE(offset, 0u);
+                if (offset == 0)
+                {
+                    continue;
+                }
+                EXPECT_EQ(offset % op.alignment, 0u);
+                EXPECT_GE(offset, m_heapStart);
+                EXPECT_LE(offset + op.size, m_heapStart + m_heapSize);
+
+                auto next = ranges.lower_bound(offset);
+                if (next != ranges.end())
+                {
+                    EXPECT_LE(offset + op.size, next->first);
+                }
+                if (next != ranges.begin())
+                {
+                    EXPECT_LE((--next)->second, offset);
+                }
+                ranges[offset]     = offset + op.size;
+                allocations[op.id]     = std::make_pair(offset, op.size);
+            }
+            else if (allocations.count(op.id))
+            {
+                ranges.erase(allocations[op.id].first);
+                allocations.erase(op.id);
+            }
+
+            if ((op.id & 0x3ff) == 0)
+            {
+                mos_vma_heap_stats stats = {};
+                mos_vma_heap_get_stats(&heap, &stats);
+                if (stats.hole_count > peakStats.hole_count)
+                {
+                    peakStats = stats;
+                }
+            }
+        }
+
+        for (auto &allocation : allocations)
+        {
+            mos_vma_heap_free(&heap, allocation.second.first, allocation.second.second);
+        }
+
+        // All freed space is coalesced back to one hole
+        mos_vma_heap_stats stats = {};
+        mos_vma_heap_get_stats(&heap, &stats);
+        EXPECT_EQ(stats.hole_count, 1u);
+        EXPECT_EQ(stats.free_size, m_heapSize);
+        EXPECT_EQ(stats.fragmentation, 0u);
+        EXPECT_EQ(stats.failed_count, 0u);
+
+        mos_vma_heap_finish(&heap);
+        return elapsed;
+    }
+
+    std::vector<Op> m_trace;
+};
+
+const uint64_t MosVmaTest::m_heapStart;
+const uint64_t MosVmaTest::m_heapSize;
+const uint64_t MosVmaTest::m_pageSize;
+
+TEST_F(MosVmaTest, ReplayTrace)
+{
+    mos_vma_heap_stats listStats    = {};
+    mos_vma_heap_stats indexedStats = {};
+
+    uint64_t listTime    = Replay(false, listStats);
+    uint64_t indexedTime = Replay(true, indexedStats);
+
+    std::cout << "vma trace of " << m_trace.size() << " operations" << std::endl;
+    std::cout << "list heap:    " << listTime << " us, peak holes " << listStats.hole_count
+              << ", fragmentation " << listStats.fragmentation << "%" << std::endl;
+    std::cout << "indexed heap: " << indexedTime << " us, peak holes " << indexedStats.hole_count
+              << ", fragmentation " << indexedStats.fragmentation << "%" << std::endl;
+}
+
+TEST_F(MosVmaTest, AllocAddr)
+{
+    mos_vma_heap heap = {};
+    mos_vma_heap_init_indexed(&heap, m_heapStart, m_heapSize);
+
+    EXPECT_TRUE(mos_vma_heap_alloc_addr(&heap, m_heapStart + m_pageSize, m_pageSize));
+    EXPECT_FALSE(mos_vma_heap_alloc_addr(&heap, m_heapStart + m_pageSize, m_pageSize));
+    EXPECT_FALSE(mos_vma_heap_alloc_addr(&heap, m_heapStart + m_heapSize - m_pageSize, 2 * m_pageSize));
+
+    mos_vma_heap_stats stats = {};
+    mos_vma_heap_get_stats(&heap, &stats);
+    EXPECT_EQ(stats.hole_count, 2u);
+    EXPECT_EQ(stats.free_size, m_heapSize - m_pageSize);
+
+    mos_vma_heap_free(&heap, m_heapStart + m_pageSize, m_pageSize);
+    mos_vma_heap_get_stats(&heap, &stats);
+    EXPECT_EQ(stats.hole_count, 1u);
+
+    mos_vma_heap_finish(&heap);
+}
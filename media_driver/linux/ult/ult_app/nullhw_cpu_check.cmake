@@ -0,0 +1,145 @@
+# Copyright (c) 2024, Intel Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+# OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+# ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+# OTHER DEALINGS IN THE SOFTWARE.
+
+# Checks the per layer CPU cost reported by a devult run in NULL HW mode
+# against nullhw_cpu_budget.txt, and fails if any layer is over its budget.
+#
+# usage: cmake -DREPORT=<NULL HW CPU Report file> [-DBUDGET=<budget file>] -P nullhw_cpu_check.cmake
+#
+# With -DUPDATE=ON the budget file is regenerated from the report instead,
+# each budget being the measured cost rounded up plus MARGIN percent:
+#        cmake -DREPORT=<report> -DUPDATE=ON [-DMARGIN=<percent>] -P nullhw_cpu_check.cmake
+
+cmake_minimum_required(VERSION 3.1)
+
+if (NOT DEFINED BUDGET)
+    set(BUDGET "${CMAKE_CURRENT_LIST_DIR}/nullhw_cpu_budget.txt")
+endif ()
+if (NOT DEFINED MARGIN)
+    set(MARGIN 25)
+endif ()
+set(layers DDI HAL MOS)
+
+if (NOT DEFINED REPORT OR NOT EXISTS "${REPORT}")
+    message(FATAL_ERROR "NULL HW CPU report \"${REPORT}\" not found, is devult run with NULL HW Enable=1?")
+endif ()
+
+file(STRINGS "${REPORT}" reportLines)
+foreach (line ${reportLines})
+    message("${line}")
+endforeach ()
+
+list(GET reportLines 0 summary)
+if (NOT summary MATCHES "^frames ([0-9]+),")
+    message(FATAL_ERROR "Bad NULL HW CPU report: ${summary}")
+endif ()
+if (CMAKE_MATCH_1 EQUAL 0)
+    message(FATAL_ERROR "No frame is submitted in NULL HW mode")
+endif ()
+
+# Rounds the measured per frame value up and adds the margin
+function (budget_from_measured measured result)
+    string(REGEX REPLACE "\\..*" "" value "${measured}")
+    math(EXPR value "((${value} + 1) * (100 + ${MARGIN}) + 99) / 100")
+    set(${result} ${value} PARENT_SCOPE)
+endfunction ()
+
+if (UPDATE)
+    string(TIMESTAMP today "%Y-%m-%d")
+    set(content "# Per frame CPU cost budget of devult in NULL HW mode, checked by nullhw_cpu_check.cmake.\n")
+    set(content "${content}# Generated on ${today} from \"${summary}\" with a ${MARGIN}% margin by\n")
+    set(content "${content}#   cmake -DREPORT=<NULL HW CPU Report file> -DUPDATE=ON -DMARGIN=${MARGIN} -P nullhw_cpu_check.cmake\n")
+    set(content "${content}# layer cpu-us/frame allocations/frame lock-contentions/frame\n")
+    foreach (layer ${layers})
+        set(found FALSE)
+        foreach (line ${reportLines})
+            if (line MATCHES "^${layer}, [0-9]+, ([0-9.]+), [0-9.]+, ([0-9.]+), ([0-9.]+),")
+                set(found TRUE)
+                budget_from_measured(${CMAKE_MATCH_1} cpu)
+                budget_from_measured(${CMAKE_MATCH_2} allocations)
+                budget_from_measured(${CMAKE_MATCH_3} contentions)
+            endif ()
+        endforeach ()
+        if (NOT found)
+            message(FATAL_ERROR "${layer}: not found in NULL HW CPU report")
+        endif ()
+        set(content "${content}${layer} ${cpu} ${allocations} ${contentions}\n")
+    endforeach ()
+    file(WRITE "${BUDGET}" "${content}")
+    message("NULL HW CPU budget written to ${BUDGET}")
+    return()
+endif ()
+
+file(STRINGS "${BUDGET}" budgetLines REGEX "^[^#]")
+list(LENGTH budgetLines budgetCount)
+list(LENGTH layers layerCount)
+if (NOT budgetCount EQUAL layerCount)
+    message(FATAL_ERROR "${BUDGET} does not have a measured budget for every layer, regenerate it from the report above with -DUPDATE=ON")
+endif ()
+
+# report: layer, cpu us, cpu us/frame, calls/frame, allocations/frame, lock contentions/frame, lock wait us/frame
+# budget: layer cpu us/frame allocations/frame lock contentions/frame
+set(failed FALSE)
+foreach (budget ${budgetLines})
+    string(REGEX REPLACE "[ \t]+" ";" budget "${budget}")
+    list(GET budget 0 layer)
+    list(GET budget 1 maxCpu)
+    list(GET budget 2 maxAllocations)
+    list(GET budget 3 maxContentions)
+
+    set(found FALSE)
+    foreach (line ${reportLines})
+        if (line MATCHES "^${layer}, [0-9]+, ([0-9.]+), [0-9.]+, ([0-9.]+), ([0-9.]+),")
+            set(found TRUE)
+            set(cpu ${CMAKE_MATCH_1})
+            set(allocations ${CMAKE_MATCH_2})
+            set(contentions ${CMAKE_MATCH_3})
+        endif ()
+    endforeach ()
+
+    if (NOT found)
+        message(SEND_ERROR "${layer}: not found in NULL HW CPU report")
+        set(failed TRUE)
+        continue()
+    endif ()
+
+    # if() compares integers only, drop the fraction which is under the budget granularity
+    string(REGEX REPLACE "\\..*" "" cpu "${cpu}")
+    string(REGEX REPLACE "\\..*" "" allocations "${allocations}")
+    string(REGEX REPLACE "\\..*" "" contentions "${contentions}")
+
+    if (cpu GREATER maxCpu)
+        message(SEND_ERROR "${layer}: cpu ${cpu} us/frame over budget ${maxCpu}")
+        set(failed TRUE)
+    endif ()
+    if (allocations GREATER maxAllocations)
+        message(SEND_ERROR "${layer}: ${allocations} allocations/frame over budget ${maxAllocations}")
+        set(failed TRUE)
+    endif ()
+    if (contentions GREATER maxContentions)
+        message(SEND_ERROR "${layer}: ${contentions} lock contentions/frame over budget ${maxContentions}")
+        set(failed TRUE)
+    endif ()
+endforeach ()
+
+if (failed)
+    message(FATAL_ERROR "NULL HW CPU cost over budget, update ${BUDGET} if it is expected")
+endif ()
+message("NULL HW CPU cost within budget")
@@ -0,0 +1,127 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_3dlut_cache_test.cpp
+//! \brief    Hits, misses, validation and LRU eviction of the VP 3DLut cache.
+//!
+
+#include "gtest/gtest.h"
+#include "vp_3dlut_cache.h"
+
+using namespace vp;
+
+static VP_3DLUT_CACHE_KEY Make3DLutKey(uint32_t maxDisplayLum)
+{
+    VP_3DLUT_CACHE_KEY key = {};
+    key.maxDisplayLum      = maxDisplayLum;
+    key.maxContentLevelLum = 4000;
+    key.hdrMode            = VPHAL_HDR_MODE_TONE_MAPPING;
+    key.srcColorSpace      = CSpace_BT2020_RGB;
+    key.dstColorSpace      = CSpace_sRGB;
+    return key;
+}
+
+TEST(Vp3DLutCacheTest, HitOnlyAfterCalculationSubmitted)
+{
+    Vp3DLutCache cache;
+
+    EXPECT_FALSE(cache.Select(Make3DLutKey(1000)));
+    EXPECT_FALSE(cache.IsValid(cache.GetCurrentIndex()));
+
+    // Calculation of the miss not submitted in the frame, the table stays invalid
+    cache.DropPending();
+    cache.ValidatePending();
+    EXPECT_FALSE(cache.Select(Make3DLutKey(1000)));
+    uint32_t index = cache.GetCurrentIndex();
+
+    cache.ValidatePending();
+    EXPECT_TRUE(cache.IsValid(index));
+    EXPECT_TRUE(cache.Select(Make3DLutKey(1000)));
+    EXPECT_EQ(index, cache.GetCurrentIndex());
+
+    auto &stats = cache.GetStatistics();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(2u, stats.misses);
+    EXPECT_EQ(0u, stats.evictions);
+}
+
+TEST(Vp3DLutCacheTest, KeyFieldsDistinguishTables)
+{
+    Vp3DLutCache cache;
+
+    VP_3DLUT_CACHE_KEY key = Make3DLutKey(1000);
+    EXPECT_FALSE(cache.Select(key));
+    cache.ValidatePending();
+
+    key.dstColorSpace = CSpace_BT2020_RGB;
+    EXPECT_FALSE(cache.Select(key));
+    cache.ValidatePending();
+    EXPECT_TRUE(cache.Select(key));
+
+    key.hdrMode = VPHAL_HDR_MODE_H2H;
+    EXPECT_FALSE(cache.Select(key));
+}
+
+TEST(Vp3DLutCacheTest, EvictsLeastRecentlyUsed)
+{
+    Vp3DLutCache cache;
+    uint32_t     index[VP_NUM_3DLUT_CACHE_ENTRIES] = {};
+
+    for (uint32_t i = 0; i < VP_NUM_3DLUT_CACHE_ENTRIES; i++)
+    {
+        EXPECT_FALSE(cache.Select(Make3DLutKey(i)));
+        cache.ValidatePending();
+        index[i] = cache.GetCurrentIndex();
+    }
+    EXPECT_EQ(0u, cache.GetStatistics().evictions);
+
+    // Table 0 is used again, so table 1 is the least recently used one
+    EXPECT_TRUE(cache.Select(Make3DLutKey(0)));
+    EXPECT_FALSE(cache.Select(Make3DLutKey(100)));
+    EXPECT_EQ(index[1], cache.GetCurrentIndex());
+    EXPECT_EQ(1u, cache.GetStatistics().evictions);
+    cache.ValidatePending();
+
+    EXPECT_FALSE(cache.Select(Make3DLutKey(1)));
+    EXPECT_EQ(index[2], cache.GetCurrentIndex());
+    EXPECT_TRUE(cache.Select(Make3DLutKey(0)));
+    EXPECT_TRUE(cache.Select(Make3DLutKey(100)));
+}
+
+TEST(Vp3DLutCacheTest, InvalidEntryTakenBeforeEviction)
+{
+    Vp3DLutCache cache;
+
+    for (uint32_t i = 0; i < VP_NUM_3DLUT_CACHE_ENTRIES; i++)
+    {
+        cache.Select(Make3DLutKey(i));
+        cache.ValidatePending();
+    }
+
+    // Surface of table 2 reallocated, its entry is reused by next miss without eviction
+    EXPECT_TRUE(cache.Select(Make3DLutKey(2)));
+    uint32_t index = cache.GetCurrentIndex();
+    cache.InvalidateCurrent();
+    EXPECT_FALSE(cache.Select(Make3DLutKey(2)));
+    EXPECT_EQ(index, cache.GetCurrentIndex());
+    EXPECT_EQ(0u, cache.GetStatistics().evictions);
+}
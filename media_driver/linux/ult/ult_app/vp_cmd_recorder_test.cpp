@@ -0,0 +1,276 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_cmd_recorder_test.cpp
+//! \brief    Record and replay of vebox command segments against a fake os interface.
+//!
+
+#include <map>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "vp_cmd_recorder.h"
+
+using namespace vp;
+
+class VpCmdRecorderTest : public testing::Test
+{
+public:
+    static const uint32_t m_cmdHeader = 0x78000000;
+
+protected:
+    void SetUp() override
+    {
+        m_instance = this;
+
+        MOS_ZeroMemory(&m_osInterface, sizeof(m_osInterface));
+        m_osInterface.bUsesGfxAddress               = true;
+        m_osInterface.pfnRegisterResource           = RegisterResource;
+        m_osInterface.pfnSetPatchEntry              = SetPatchEntry;
+        m_osInterface.pfnGetResourceGfxAddress      = GetResourceGfxAddress;
+        m_osInterface.pfnGetResourceAllocationIndex = GetResourceAllocationIndex;
+
+        for (uint32_t i = 0; i < sizeof(m_resources) / sizeof(m_resources[0]); i++)
+        {
+            MOS_ZeroMemory(&m_resources[i], sizeof(m_resources[i]));
+            m_gfxAddress[&m_resources[i]] = 0x100000000ull * (i + 1);
+        }
+    }
+
+    void TearDown() override
+    {
+        m_instance = nullptr;
+    }
+
+    void InitCmdBuffer(MOS_COMMAND_BUFFER &cmdBuffer, std::vector<uint32_t> &cmds)
+    {
+        MOS_ZeroMemory(&cmdBuffer, sizeof(cmdBuffer));
+        cmds.assign(256, 0);
+        cmdBuffer.pCmdBase   = cmds.data();
+        cmdBuffer.pCmdPtr    = cmds.data();
+        cmdBuffer.iRemaining = (int32_t)(cmds.size() * sizeof(uint32_t));
+    }
+
+    //!
+    //! \brief Add a command with one address field, the way MHW does
+    //!
+    void AddCmd(MOS_COMMAND_BUFFER &cmdBuffer, PMOS_RESOURCE resource, uint32_t offset, bool write)
+    {
+        uint64_t gfxAddress = m_osInterface.pfnGetResourceGfxAddress(&m_osInterface, resource) + offset;
+        uint32_t patchOffset = (uint32_t)cmdBuffer.iOffset + sizeof(uint32_t);
+
+        cmdBuffer.pCmdPtr[0] = m_cmdHeader | 1;
+        cmdBuffer.pCmdPtr[1] = (uint32_t)gfxAddress;
+        cmdBuffer.pCmdPtr[2] = (uint32_t)(gfxAddress >> 32);
+        cmdBuffer.pCmdPtr    += 3;
+        cmdBuffer.iOffset    += 3 * sizeof(uint32_t);
+        cmdBuffer.iRemaining -= 3 * sizeof(uint32_t);
+
+        EXPECT_EQ(MOS_STATUS_SUCCESS, m_osInterface.pfnRegisterResource(&m_osInterface, resource, write, write));
+
+        MOS_PATCH_ENTRY_PARAMS params;
+        MOS_ZeroMemory(&params, sizeof(params));
+        params.presResource     = resource;
+        params.uiResourceOffset = offset;
+        params.uiPatchOffset    = patchOffset;
+        params.bWrite           = write;
+        params.patchType        = MOS_PATCH_TYPE_BASE_ADDRESS;
+        EXPECT_EQ(MOS_STATUS_SUCCESS, m_osInterface.pfnSetPatchEntry(&m_osInterface, &params));
+    }
+
+    static uint64_t ReadAddress(const std::vector<uint32_t> &cmds, uint32_t dword)
+    {
+        return ((uint64_t)cmds[dword + 1] << 32) | cmds[dword];
+    }
+
+    static MOS_STATUS RegisterResource(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource, int32_t write, int32_t syncTag)
+    {
+        m_instance->m_registered.push_back(resource);
+        return MOS_STATUS_SUCCESS;
+    }
+
+    static MOS_STATUS SetPatchEntry(PMOS_INTERFACE osInterface, PMOS_PATCH_ENTRY_PARAMS params)
+    {
+        m_instance->m_patches.push_back(*params);
+        return MOS_STATUS_SUCCESS;
+    }
+
+    static uint64_t GetResourceGfxAddress(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource)
+    {
+        return m_instance->m_gfxAddress[resource];
+    }
+
+    static int32_t GetResourceAllocationIndex(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource)
+    {
+        return 0;
+    }
+
+    static VpCmdRecorderTest            *m_instance;
+    MOS_INTERFACE                       m_osInterface;
+    MOS_RESOURCE                        m_resources[4];
+    std::map<PMOS_RESOURCE, uint64_t>   m_gfxAddress;
+    std::vector<PMOS_RESOURCE>          m_registered;
+    std::vector<MOS_PATCH_ENTRY_PARAMS> m_patches;
+};
+
+VpCmdRecorderTest *VpCmdRecorderTest::m_instance = nullptr;
+
+TEST_F(VpCmdRecorderTest, RecordAndReplay)
+{
+    PMOS_RESOURCE      input  = &m_resources[0];
+    PMOS_RESOURCE      output = &m_resources[1];
+    PMOS_RESOURCE      heap   = &m_resources[2];
+    VpCmdRecorder      recorder(&m_osInterface);
+    MOS_COMMAND_BUFFER cmdBuffer;
+    std::vector<uint32_t> cmds;
+
+    // Frame 0 uses the first instance of the heap.
+    VP_CMD_RECORD_RESOURCES resources(2);
+    resources[0].resource  = input;
+    resources[1].resource  = heap;
+    resources[1].rangeBase = 0;
+    resources[1].rangeSize = 0x1000;
+
+    InitCmdBuffer(cmdBuffer, cmds);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, recorder.BeginSegment(&cmdBuffer, resources));
+    AddCmd(cmdBuffer, input, 0x40, false);
+    AddCmd(cmdBuffer, heap, 0x80, false);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, recorder.EndSegment(&cmdBuffer));
+    recorder.Complete(resources);
+
+    // Callbacks are restored after recording.
+    EXPECT_EQ(SetPatchEntry, m_osInterface.pfnSetPatchEntry);
+    EXPECT_EQ(RegisterResource, m_osInterface.pfnRegisterResource);
+
+    // Frame 1 uses another input and the second heap instance.
+    resources[0].resource  = output;
+    resources[1].rangeBase = 0x1000;
+    ASSERT_TRUE(recorder.IsReplayable(resources));
+
+    m_registered.clear();
+    m_patches.clear();
+    InitCmdBuffer(cmdBuffer, cmds);
+    cmdBuffer.pCmdPtr    += 2;
+    cmdBuffer.iOffset    += 2 * sizeof(uint32_t);
+    cmdBuffer.iRemaining -= 2 * sizeof(uint32_t);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, recorder.ReplaySegment(&cmdBuffer, 0, resources));
+
+    EXPECT_EQ(8 * sizeof(uint32_t), (uint32_t)cmdBuffer.iOffset);
+    EXPECT_EQ(m_cmdHeader | 1, cmds[2]);
+    EXPECT_EQ(m_gfxAddress[output] + 0x40, ReadAddress(cmds, 3));
+    EXPECT_EQ(m_cmdHeader | 1, cmds[5]);
+    EXPECT_EQ(m_gfxAddress[heap] + 0x1080, ReadAddress(cmds, 6));
+
+    ASSERT_EQ(2u, m_registered.size());
+    EXPECT_EQ(output, m_registered[0]);
+    EXPECT_EQ(heap, m_registered[1]);
+
+    ASSERT_EQ(2u, m_patches.size());
+    EXPECT_EQ(output, m_patches[0].presResource);
+    EXPECT_EQ(0x40u, m_patches[0].uiResourceOffset);
+    EXPECT_EQ(3 * sizeof(uint32_t), m_patches[0].uiPatchOffset);
+    EXPECT_EQ(heap, m_patches[1].presResource);
+    EXPECT_EQ(0x1080u, m_patches[1].uiResourceOffset);
+    EXPECT_EQ(6 * sizeof(uint32_t), m_patches[1].uiPatchOffset);
+
+    // Role aliasing differs from the recording.
+    resources[0].resource = heap;
+    EXPECT_FALSE(recorder.IsReplayable(resources));
+}
+
+TEST_F(VpCmdRecorderTest, OtherThreadNotRecorded)
+{
+    PMOS_RESOURCE      input = &m_resources[0];
+    PMOS_RESOURCE      other = &m_resources[3];
+    VpCmdRecorder      recorder(&m_osInterface);
+    MOS_COMMAND_BUFFER cmdBuffer;
+    std::vector<uint32_t> cmds;
+
+    VP_CMD_RECORD_RESOURCES resources(1);
+    resources[0].resource = input;
+
+    InitCmdBuffer(cmdBuffer, cmds);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, recorder.BeginSegment(&cmdBuffer, resources));
+    AddCmd(cmdBuffer, input, 0, true);
+
+    // Another thread sharing the os interface goes to the original callbacks.
+    MOS_STATUS registerStatus = MOS_STATUS_UNKNOWN;
+    MOS_STATUS patchStatus    = MOS_STATUS_UNKNOWN;
+    std::thread thread([&]() {
+        MOS_PATCH_ENTRY_PARAMS params;
+        MOS_ZeroMemory(&params, sizeof(params));
+        params.presResource = other;
+        params.patchType    = MOS_PATCH_TYPE_BASE_ADDRESS;
+        registerStatus      = m_osInterface.pfnRegisterResource(&m_osInterface, other, 0, 0);
+        patchStatus         = m_osInterface.pfnSetPatchEntry(&m_osInterface, &params);
+    });
+    thread.join();
+    EXPECT_EQ(MOS_STATUS_SUCCESS, registerStatus);
+    EXPECT_EQ(MOS_STATUS_SUCCESS, patchStatus);
+    EXPECT_EQ(2u, m_patches.size());
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, recorder.EndSegment(&cmdBuffer));
+    recorder.Complete(resources);
+    ASSERT_TRUE(recorder.IsReplayable(resources));
+
+    // Only the patch of recording thread is replayed.
+    m_registered.clear();
+    m_patches.clear();
+    InitCmdBuffer(cmdBuffer, cmds);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, recorder.ReplaySegment(&cmdBuffer, 0, resources));
+    ASSERT_EQ(1u, m_patches.size());
+    EXPECT_EQ(input, m_patches[0].presResource);
+    ASSERT_EQ(1u, m_registered.size());
+    EXPECT_EQ(input, m_registered[0]);
+}
+
+TEST_F(VpCmdRecorderTest, InterfaceTakenByAnotherRecorder)
+{
+    PMOS_RESOURCE      input = &m_resources[0];
+    VpCmdRecorder      recorder(&m_osInterface);
+    VpCmdRecorder      recorder2(&m_osInterface);
+    MOS_COMMAND_BUFFER cmdBuffer;
+    MOS_COMMAND_BUFFER cmdBuffer2;
+    std::vector<uint32_t> cmds;
+    std::vector<uint32_t> cmds2;
+
+    VP_CMD_RECORD_RESOURCES resources(1);
+    resources[0].resource = input;
+
+    InitCmdBuffer(cmdBuffer, cmds);
+    InitCmdBuffer(cmdBuffer2, cmds2);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, recorder.BeginSegment(&cmdBuffer, resources));
+
+    // Second recorder still lets the commands be sent, but drops its recording.
+    ASSERT_EQ(MOS_STATUS_SUCCESS, recorder2.BeginSegment(&cmdBuffer2, resources));
+    AddCmd(cmdBuffer2, input, 0, false);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, recorder2.EndSegment(&cmdBuffer2));
+    recorder2.Complete(resources);
+    EXPECT_FALSE(recorder2.IsReplayable(resources));
+
+    // First recorder keeps the hook until its segment ends.
+    AddCmd(cmdBuffer, input, 0, false);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, recorder.EndSegment(&cmdBuffer));
+    recorder.Complete(resources);
+    EXPECT_TRUE(recorder.IsReplayable(resources));
+    EXPECT_EQ(SetPatchEntry, m_osInterface.pfnSetPatchEntry);
+}
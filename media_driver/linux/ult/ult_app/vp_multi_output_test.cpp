@@ -0,0 +1,112 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_multi_output_test.cpp
+//! \brief    Decision between one execution and per-target execution of 1:N VP outputs.
+//!
+
+#include "gtest/gtest.h"
+#include "vp_pipeline_common.h"
+
+class VpMultiOutputTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_params.uSrcCount = 1;
+        m_params.pSrc[0]   = &m_source;
+        m_params.uDstCount = VPHAL_MAX_TARGETS;
+
+        for (uint32_t i = 0; i < VPHAL_MAX_TARGETS; ++i)
+        {
+            m_targets[i].Format          = Format_NV12;
+            m_targets[i].TileType        = MOS_TILE_Y;
+            m_targets[i].dwWidth         = 1920;
+            m_targets[i].dwHeight        = 1080;
+            m_targets[i].bCompressible   = true;
+            m_targets[i].bIsCompressed   = true;
+            m_targets[i].CompressionMode = MOS_MMC_MC;
+            // Each output has its own scaling ratio.
+            m_targets[i].rcSrc = {0, 0, (int32_t)(1920 >> i), (int32_t)(1080 >> i)};
+            m_params.pTarget[i] = &m_targets[i];
+        }
+    }
+
+    VPHAL_RENDER_PARAMS m_params = {};
+    VPHAL_SURFACE       m_source;
+    VPHAL_SURFACE       m_targets[VPHAL_MAX_TARGETS];
+};
+
+TEST_F(VpMultiOutputTest, UniformTargets)
+{
+    EXPECT_TRUE(IsMultiOutputUniform(&m_params));
+
+    m_params.uDstCount = 1;
+    EXPECT_TRUE(IsMultiOutputUniform(&m_params));
+}
+
+TEST_F(VpMultiOutputTest, LastTargetDiffers)
+{
+    VPHAL_SURFACE &last = m_targets[VPHAL_MAX_TARGETS - 1];
+
+    last.Format = Format_P010;
+    EXPECT_FALSE(IsMultiOutputUniform(&m_params));
+    last.Format = Format_NV12;
+
+    last.dwWidth = 1280;
+    EXPECT_FALSE(IsMultiOutputUniform(&m_params));
+    last.dwWidth = 1920;
+
+    last.TileType = MOS_TILE_LINEAR;
+    EXPECT_FALSE(IsMultiOutputUniform(&m_params));
+    last.TileType = MOS_TILE_Y;
+
+    last.CompressionMode = MOS_MMC_RC;
+    EXPECT_FALSE(IsMultiOutputUniform(&m_params));
+    last.CompressionMode = MOS_MMC_MC;
+
+    last.bIsCompressed = false;
+    EXPECT_FALSE(IsMultiOutputUniform(&m_params));
+    last.bIsCompressed = true;
+
+    EXPECT_TRUE(IsMultiOutputUniform(&m_params));
+}
+
+TEST_F(VpMultiOutputTest, TargetsBeyondCountIgnored)
+{
+    m_params.uDstCount = 2;
+    m_targets[2].Format = Format_A8R8G8B8;
+    m_params.pTarget[3] = nullptr;
+    EXPECT_TRUE(IsMultiOutputUniform(&m_params));
+
+    m_params.uDstCount = 4;
+    EXPECT_FALSE(IsMultiOutputUniform(&m_params));
+}
+
+TEST_F(VpMultiOutputTest, MissingTarget)
+{
+    m_params.pTarget[1] = nullptr;
+    EXPECT_FALSE(IsMultiOutputUniform(&m_params));
+
+    m_params.pTarget[0] = nullptr;
+    EXPECT_FALSE(IsMultiOutputUniform(&m_params));
+}
@@ -0,0 +1,264 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_policy_plan_cache_test.cpp
+//! \brief    Keys, hits, misses, invalidation and eviction of the VP policy plan cache.
+//!
+
+#include <new>
+#include <string.h>
+#include "gtest/gtest.h"
+#include "vp_policy_plan_cache.h"
+
+using namespace vp;
+
+static VpPolicyPlanCache::KEY MakePlanKey(uint32_t context, const FeatureParamScaling &scaling)
+{
+    VpPolicyPlanCache::KEY key = {};
+    key.context                = context;
+    VpPolicyPlanCache::AppendKey(scaling, key.values);
+    return key;
+}
+
+static FeatureParamScaling MakeScalingParams(uint32_t width)
+{
+    FeatureParamScaling params = {};
+    params.type                = FeatureTypeScaling;
+    params.formatInput         = Format_NV12;
+    params.formatOutput        = Format_A8R8G8B8;
+    params.input.dwWidth       = width;
+    params.input.dwHeight      = 1080;
+    params.output.dwWidth      = 1280;
+    params.output.dwHeight     = 720;
+    return params;
+}
+
+static VpPolicyPlanCache::PLAN MakePlan(VPHAL_SCALING_PREFERENCE scalingPreference)
+{
+    VpPolicyPlanCache::FEATURE_PLAN feature = {};
+    feature.type                 = FeatureTypeScaling;
+    feature.engineCaps.bEnabled  = 1;
+    feature.engineCaps.SfcNeeded = 1;
+    feature.scalingPreference    = scalingPreference;
+    return VpPolicyPlanCache::PLAN(1, feature);
+}
+
+TEST(VpPolicyPlanCacheTest, KeyIgnoresAddressesAndPadding)
+{
+    // Parameters constructed over different garbage, so that padding differs
+    alignas(FeatureParamScaling) uint8_t buffer[2][sizeof(FeatureParamScaling)];
+    memset(buffer[0], 0x00, sizeof(buffer[0]));
+    memset(buffer[1], 0x5a, sizeof(buffer[1]));
+    FeatureParamScaling *params[2] = {};
+    VPHAL_ALPHA_PARAMS   alpha[2]  = {};
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        params[i]             = new (buffer[i]) FeatureParamScaling(MakeScalingParams(1920));
+        alpha[i].fAlpha       = 0.5f;
+        alpha[i].AlphaMode    = VPHAL_ALPHA_FILL_MODE_BACKGROUND;
+        params[i]->pCompAlpha = &alpha[i];
+    }
+
+    VpPolicyPlanCache::KEY key[2] = {MakePlanKey(0, *params[0]), MakePlanKey(0, *params[1])};
+    EXPECT_EQ(key[0].values, key[1].values);
+
+    // The structures pointed to are part of the key
+    alpha[1].AlphaMode = VPHAL_ALPHA_FILL_MODE_OPAQUE;
+    EXPECT_NE(key[0].values, MakePlanKey(0, *params[1]).values);
+
+    // Absent and zeroed structures differ
+    VPHAL_ALPHA_PARAMS zero = {};
+    params[0]->pCompAlpha   = &zero;
+    params[1]->pCompAlpha   = nullptr;
+    EXPECT_NE(MakePlanKey(0, *params[0]).values, MakePlanKey(0, *params[1]).values);
+
+    params[0]->~FeatureParamScaling();
+    params[1]->~FeatureParamScaling();
+}
+
+TEST(VpPolicyPlanCacheTest, KeyCoversDenoiseInputsOnly)
+{
+    FeatureParamDenoise params[2];
+    for (auto &denoise : params)
+    {
+        denoise.type                      = FeatureTypeDn;
+        denoise.formatInput               = Format_NV12;
+        denoise.heightInput               = 1080;
+        denoise.denoiseParams.bEnableLuma = true;
+    }
+
+    // Per frame HVS values and the alignment units written by evaluation are not in key
+    params[1].denoiseParams.HVSDenoise.QP               = 30;
+    params[1].denoiseParams.HVSDenoise.PrevNslvTemporal = 7;
+    params[1].widthAlignUnitInput                       = 4;
+    std::vector<uint32_t> key[2];
+    VpPolicyPlanCache::AppendKey(params[0], key[0]);
+    VpPolicyPlanCache::AppendKey(params[1], key[1]);
+    EXPECT_EQ(key[0], key[1]);
+
+    params[1].denoiseParams.fDenoiseFactor = 32.0f;
+    key[1].clear();
+    VpPolicyPlanCache::AppendKey(params[1], key[1]);
+    EXPECT_NE(key[0], key[1]);
+}
+
+TEST(VpPolicyPlanCacheTest, MissThenHit)
+{
+    VpPolicyPlanCache cache(false);
+
+    VpPolicyPlanCache::KEY key = MakePlanKey(0, MakeScalingParams(1920));
+    EXPECT_EQ(nullptr, cache.Lookup(key));
+    EXPECT_TRUE(cache.IsPending());
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cache.Update(MakePlan(VPHAL_SCALING_PREFER_SFC)));
+    EXPECT_FALSE(cache.IsPending());
+
+    key = MakePlanKey(0, MakeScalingParams(1920));
+    const VpPolicyPlanCache::PLAN *plan = cache.Lookup(key);
+    ASSERT_NE(nullptr, plan);
+    ASSERT_EQ(1u, plan->size());
+    EXPECT_EQ(FeatureTypeScaling, (*plan)[0].type);
+    EXPECT_EQ(1u, (uint32_t)(*plan)[0].engineCaps.SfcNeeded);
+    EXPECT_FALSE(cache.IsPending());
+
+    VpPolicyPlanCache::Statistics stats = cache.GetStatistics();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(1u, stats.entries);
+}
+
+TEST(VpPolicyPlanCacheTest, DifferentParamsOrContextMiss)
+{
+    VpPolicyPlanCache cache(false);
+
+    VpPolicyPlanCache::KEY key = MakePlanKey(0, MakeScalingParams(1920));
+    EXPECT_EQ(nullptr, cache.Lookup(key));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cache.Update(MakePlan(VPHAL_SCALING_PREFER_SFC)));
+
+    key = MakePlanKey(0, MakeScalingParams(3840));
+    EXPECT_EQ(nullptr, cache.Lookup(key));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cache.Update(MakePlan(VPHAL_SCALING_PREFER_SFC)));
+
+    // Sfc disabled
+    key = MakePlanKey(1, MakeScalingParams(1920));
+    EXPECT_EQ(nullptr, cache.Lookup(key));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cache.Update(MakePlan(VPHAL_SCALING_PREFER_COMP)));
+
+    VpPolicyPlanCache::Statistics stats = cache.GetStatistics();
+    EXPECT_EQ(0u, stats.hits);
+    EXPECT_EQ(3u, stats.misses);
+    EXPECT_EQ(3u, stats.entries);
+}
+
+TEST(VpPolicyPlanCacheTest, InvalidateDropsPlans)
+{
+    VpPolicyPlanCache cache(false);
+
+    VpPolicyPlanCache::KEY key = MakePlanKey(0, MakeScalingParams(1920));
+    EXPECT_EQ(nullptr, cache.Lookup(key));
+
+    // Invalidated between Lookup and Update, the evaluation may be based on old state
+    cache.Invalidate();
+    EXPECT_FALSE(cache.IsPending());
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cache.Update(MakePlan(VPHAL_SCALING_PREFER_SFC)));
+    EXPECT_EQ(0u, cache.GetStatistics().entries);
+
+    key = MakePlanKey(0, MakeScalingParams(1920));
+    EXPECT_EQ(nullptr, cache.Lookup(key));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cache.Update(MakePlan(VPHAL_SCALING_PREFER_SFC)));
+    cache.Invalidate();
+
+    key = MakePlanKey(0, MakeScalingParams(1920));
+    EXPECT_EQ(nullptr, cache.Lookup(key));
+
+    VpPolicyPlanCache::Statistics stats = cache.GetStatistics();
+    EXPECT_EQ(0u, stats.hits);
+    EXPECT_EQ(1u, stats.invalidations);
+    EXPECT_EQ(0u, stats.entries);
+}
+
+TEST(VpPolicyPlanCacheTest, BypassClearsPending)
+{
+    VpPolicyPlanCache cache(false);
+
+    VpPolicyPlanCache::KEY key = MakePlanKey(0, MakeScalingParams(1920));
+    EXPECT_EQ(nullptr, cache.Lookup(key));
+    cache.Bypass();
+    EXPECT_FALSE(cache.IsPending());
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cache.Update(MakePlan(VPHAL_SCALING_PREFER_SFC)));
+
+    VpPolicyPlanCache::Statistics stats = cache.GetStatistics();
+    EXPECT_EQ(1u, stats.bypassed);
+    EXPECT_EQ(0u, stats.misses);
+    EXPECT_EQ(0u, stats.entries);
+}
+
+TEST(VpPolicyPlanCacheTest, LeastRecentlyUsedEvicted)
+{
+    VpPolicyPlanCache cache(false);
+    const uint32_t    maxEntries = VpPolicyPlanCache::m_maxEntries;
+
+    for (uint32_t i = 0; i <= maxEntries; i++)
+    {
+        // Keep the first one used
+        VpPolicyPlanCache::KEY key = MakePlanKey(0, MakeScalingParams(64));
+        if (i > 0)
+        {
+            EXPECT_NE(nullptr, cache.Lookup(key));
+        }
+        key = MakePlanKey(0, MakeScalingParams(64 + i));
+        if (nullptr == cache.Lookup(key))
+        {
+            EXPECT_EQ(MOS_STATUS_SUCCESS, cache.Update(MakePlan(VPHAL_SCALING_PREFER_SFC)));
+        }
+    }
+    EXPECT_EQ(maxEntries, cache.GetStatistics().entries);
+
+    VpPolicyPlanCache::KEY key = MakePlanKey(0, MakeScalingParams(64));
+    EXPECT_NE(nullptr, cache.Lookup(key));
+    key = MakePlanKey(0, MakeScalingParams(65));
+    EXPECT_EQ(nullptr, cache.Lookup(key));
+}
+
+TEST(VpPolicyPlanCacheTest, CrossCheckCountsMismatch)
+{
+    VpPolicyPlanCache cache(true);
+
+    VpPolicyPlanCache::KEY key = MakePlanKey(0, MakeScalingParams(1920));
+    EXPECT_EQ(nullptr, cache.Lookup(key));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cache.Update(MakePlan(VPHAL_SCALING_PREFER_SFC)));
+
+    // Hit is evaluated again and compared
+    key = MakePlanKey(0, MakeScalingParams(1920));
+    EXPECT_EQ(nullptr, cache.Lookup(key));
+    EXPECT_TRUE(cache.IsPending());
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cache.Update(MakePlan(VPHAL_SCALING_PREFER_SFC)));
+
+    key = MakePlanKey(0, MakeScalingParams(1920));
+    EXPECT_EQ(nullptr, cache.Lookup(key));
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cache.Update(MakePlan(VPHAL_SCALING_PREFER_COMP)));
+
+    VpPolicyPlanCache::Statistics stats = cache.GetStatistics();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(1u, stats.mismatches);
+    EXPECT_EQ(1u, stats.entries);
+}
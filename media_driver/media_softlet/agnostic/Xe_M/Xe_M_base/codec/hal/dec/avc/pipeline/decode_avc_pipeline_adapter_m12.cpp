@@ -70,6 +70,7 @@ MOS_STATUS DecodeAvcPipelineAdapterM12::Allocate(CodechalSetting *codecHalSettin
 MOS_STATUS DecodeAvcPipelineAdapterM12::Execute(void *params)
 {
     DECODE_FUNC_CALL();
+    NULLHW_LAYER_SCOPE(NullHW::LayerHal);
 
     decode::DecodePipelineParams decodeParams;
     decodeParams.m_params = (CodechalDecodeParams*)params;
@@ -122,6 +123,13 @@ uint32_t DecodeAvcPipelineAdapterM12::GetCompletedReport()
     return m_decoder->GetCompletedReport();
 }
 
+MOS_STATUS DecodeAvcPipelineAdapterM12::GetCompletedReports(void *status, uint32_t maxNum, uint32_t &numReports)
+{
+    DECODE_FUNC_CALL();
+
+    return m_decoder->GetCompletedReports(status, maxNum, numReports);
+}
+
 void DecodeAvcPipelineAdapterM12::Destroy()
 {
     DECODE_FUNC_CALL();
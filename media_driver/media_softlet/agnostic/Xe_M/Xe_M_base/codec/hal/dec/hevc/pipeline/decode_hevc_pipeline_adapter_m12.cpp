@@ -73,6 +73,7 @@ MOS_STATUS DecodeHevcPipelineAdapterM12::Allocate(CodechalSetting *codecHalSetti
 MOS_STATUS DecodeHevcPipelineAdapterM12::Execute(void    *params)
 {
     DECODE_FUNC_CALL();
+    NULLHW_LAYER_SCOPE(NullHW::LayerHal);
 
     decode::DecodePipelineParams decodeParams;
     decodeParams.m_params = (CodechalDecodeParams*)params;
@@ -125,6 +126,13 @@ uint32_t DecodeHevcPipelineAdapterM12::GetCompletedReport()
     return m_decoder->GetCompletedReport();
 }
 
+MOS_STATUS DecodeHevcPipelineAdapterM12::GetCompletedReports(void *status, uint32_t maxNum, uint32_t &numReports)
+{
+    DECODE_FUNC_CALL();
+
+    return m_decoder->GetCompletedReports(status, maxNum, numReports);
+}
+
 void DecodeHevcPipelineAdapterM12::Destroy()
 {
     DECODE_FUNC_CALL();
@@ -65,6 +65,8 @@ public:
     virtual void SetDummyReferenceStatus(CODECHAL_DUMMY_REFERENCE_STATUS status) override;
     virtual uint32_t GetCompletedReport() override;
 
+    virtual MOS_STATUS GetCompletedReports(void *status, uint32_t maxNum, uint32_t &numReports) override;
+
     virtual void Destroy() override;
 
     virtual MOS_GPU_CONTEXT GetDecodeContext() override;
@@ -70,6 +70,7 @@ MOS_STATUS DecodeJpegPipelineAdapterM12::Allocate(CodechalSetting *codecHalSetti
 MOS_STATUS DecodeJpegPipelineAdapterM12::Execute(void *params)
 {
     DECODE_FUNC_CALL();
+    NULLHW_LAYER_SCOPE(NullHW::LayerHal);
 
     decode::DecodePipelineParams decodeParams;
     decodeParams.m_params = (CodechalDecodeParams*)params;
@@ -102,6 +103,13 @@ uint32_t DecodeJpegPipelineAdapterM12::GetCompletedReport()
     return m_decoder->GetCompletedReport();
 }
 
+MOS_STATUS DecodeJpegPipelineAdapterM12::GetCompletedReports(void *status, uint32_t maxNum, uint32_t &numReports)
+{
+    DECODE_FUNC_CALL();
+
+    return m_decoder->GetCompletedReports(status, maxNum, numReports);
+}
+
 void DecodeJpegPipelineAdapterM12::Destroy()
 {
     DECODE_FUNC_CALL();
@@ -70,6 +70,7 @@ MOS_STATUS DecodeMpeg2PipelineAdapterM12::Allocate(CodechalSetting *codecHalSett
 MOS_STATUS DecodeMpeg2PipelineAdapterM12::Execute(void *params)
 {
     DECODE_FUNC_CALL();
+    NULLHW_LAYER_SCOPE(NullHW::LayerHal);
 
     decode::DecodePipelineParams decodeParams;
     decodeParams.m_params = (CodechalDecodeParams*)params;
@@ -115,6 +116,13 @@ uint32_t DecodeMpeg2PipelineAdapterM12::GetCompletedReport()
     return m_decoder->GetCompletedReport();
 }
 
+MOS_STATUS DecodeMpeg2PipelineAdapterM12::GetCompletedReports(void *status, uint32_t maxNum, uint32_t &numReports)
+{
+    DECODE_FUNC_CALL();
+
+    return m_decoder->GetCompletedReports(status, maxNum, numReports);
+}
+
 void DecodeMpeg2PipelineAdapterM12::Destroy()
 {
     DECODE_FUNC_CALL();
@@ -66,6 +66,7 @@ MOS_STATUS DecodeVp9PipelineAdapterG12::Allocate(CodechalSetting *codecHalSettin
 MOS_STATUS DecodeVp9PipelineAdapterG12::Execute(void *params)
 {
     DECODE_FUNC_CALL();
+    NULLHW_LAYER_SCOPE(NullHW::LayerHal);
     decode::DecodePipelineParams decodeParams;
     decodeParams.m_params = (CodechalDecodeParams*)params;
     decodeParams.m_pipeMode = decode::decodePipeModeProcess;
@@ -110,6 +111,13 @@ uint32_t DecodeVp9PipelineAdapterG12::GetCompletedReport()
     return m_decoder->GetCompletedReport();
 }
 
+MOS_STATUS DecodeVp9PipelineAdapterG12::GetCompletedReports(void *status, uint32_t maxNum, uint32_t &numReports)
+{
+    DECODE_FUNC_CALL();
+
+    return m_decoder->GetCompletedReports(status, maxNum, numReports);
+}
+
 void DecodeVp9PipelineAdapterG12::Destroy()
 {
     DECODE_FUNC_CALL();
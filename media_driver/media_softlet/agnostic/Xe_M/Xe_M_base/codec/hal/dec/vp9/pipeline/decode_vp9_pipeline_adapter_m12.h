@@ -52,6 +52,8 @@ public:
 
     virtual uint32_t GetCompletedReport() override;
 
+    virtual MOS_STATUS GetCompletedReports(void *status, uint32_t maxNum, uint32_t &numReports) override;
+
     virtual bool IsIncompletePicture() override;
 
     virtual bool IsIncompleteJpegScan() override
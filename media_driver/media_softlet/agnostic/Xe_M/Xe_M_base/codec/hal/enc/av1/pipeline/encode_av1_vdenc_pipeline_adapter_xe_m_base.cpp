@@ -50,6 +50,7 @@ MOS_STATUS EncodeAv1VdencPipelineAdapterXe_M_Base::Allocate(CodechalSetting *cod
 MOS_STATUS EncodeAv1VdencPipelineAdapterXe_M_Base::Execute(void    *params)
 {
     ENCODE_FUNC_CALL();
+    NULLHW_LAYER_SCOPE(NullHW::LayerHal);
 
     PERF_UTILITY_AUTO(__FUNCTION__, PERF_ENCODE, PERF_LEVEL_HAL);
 
@@ -51,6 +51,7 @@ MOS_STATUS EncodeHevcVdencPipelineAdapterXe_Xpm_Base::Allocate(CodechalSetting *
 MOS_STATUS EncodeHevcVdencPipelineAdapterXe_Xpm_Base::Execute(void    *params)
 {
     ENCODE_FUNC_CALL();
+    NULLHW_LAYER_SCOPE(NullHW::LayerHal);
 
     ENCODE_CHK_STATUS_RETURN(m_encoder->Prepare(params));
     return m_encoder->Execute();
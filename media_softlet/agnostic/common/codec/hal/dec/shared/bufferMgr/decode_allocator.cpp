@@ -27,6 +27,7 @@
 //!
 
 #include "decode_allocator.h"
+#include "decode_aux_buffer_pool.h"
 #include "decode_utils.h"
 #include "External/Common/GmmResourceInfoExt.h"
 #include "External/Common/GmmCachePolicyExt.h"
@@ -46,10 +47,27 @@ DecodeAllocator::DecodeAllocator(PMOS_INTERFACE osInterface, bool limitedLMemBar
 #if (_DEBUG || _RELEASE_INTERNAL)
     m_forceLockable = ReadUserFeature(m_osInterface->pfnGetUserSettingInstance(m_osInterface), "ForceDecodeResourceLockable", MediaUserSetting::Group::Sequence).Get<uint32_t>();
 #endif
+
+    MediaUserSettingSharedPtr userSettingPtr = m_osInterface->pfnGetUserSettingInstance(m_osInterface);
+    uint32_t poolSizeMB = ReadUserFeature(userSettingPtr, "Decode Aux Buffer Pool Size", MediaUserSetting::Group::Sequence).Get<uint32_t>();
+    uint32_t idleTimeout = ReadUserFeature(userSettingPtr, "Decode Aux Buffer Pool Idle Timeout", MediaUserSetting::Group::Sequence).Get<uint32_t>();
+    // Limits are taken from the first session of device
+    DecodeAuxBufferPool::GetInstance().Configure(m_osInterface, (uint64_t)poolSizeMB * 1024 * 1024, idleTimeout);
 }
 
 DecodeAllocator::~DecodeAllocator()
 {
+    for (auto buffer : m_auxBuffers)
+    {
+        ReleaseAuxBuffer(buffer);
+    }
+    m_auxBuffers.clear();
+
+    if (m_auxBufferHits > 0)
+    {
+        DECODE_NORMALMESSAGE("%d aux buffers reused, %llu us allocation saved", m_auxBufferHits, (unsigned long long)m_auxBufferSavedUs);
+    }
+
     MOS_Delete(m_allocator);
 }
 
@@ -72,7 +90,28 @@ MOS_BUFFER* DecodeAllocator::AllocateBuffer(
     allocParams.ResUsageType    = static_cast<MOS_HW_RESOURCE_DEF>(resUsageType);
     SetAccessRequirement(accessReq, allocParams);
 
-    MOS_BUFFER* buffer = m_allocator->AllocateBuffer(allocParams, false, COMPONENT_Decode);
+    MOS_BUFFER* buffer = nullptr;
+    // Buffers neither read by CPU nor initialized are shared with later sessions through aux buffer pool
+    if (accessReq == notLockableVideoMem && !initOnAllocate && !bPersistent)
+    {
+        bool     reused = false;
+        uint64_t costUs = 0;
+        buffer = DecodeAuxBufferPool::GetInstance().Lease(m_osInterface, allocParams, reused, costUs);
+        if (buffer != nullptr)
+        {
+            m_auxBuffers.insert(buffer);
+            if (reused)
+            {
+                m_auxBufferHits++;
+                m_auxBufferSavedUs += costUs;
+            }
+        }
+    }
+
+    if (buffer == nullptr)
+    {
+        buffer = m_allocator->AllocateBuffer(allocParams, false, COMPONENT_Decode);
+    }
     if (buffer == nullptr)
     {
         return nullptr;
@@ -463,6 +502,13 @@ MOS_STATUS DecodeAllocator::Destroy(MOS_BUFFER* & buffer)
         return MOS_STATUS_SUCCESS;
     }
 
+    if (m_auxBuffers.erase(buffer) > 0)
+    {
+        DECODE_CHK_STATUS(ReleaseAuxBuffer(buffer));
+        buffer = nullptr;
+        return MOS_STATUS_SUCCESS;
+    }
+
     DECODE_CHK_STATUS(m_allocator->DestroyBuffer(buffer));
     buffer = nullptr;
     return MOS_STATUS_SUCCESS;
@@ -560,9 +606,26 @@ MOS_STATUS DecodeAllocator::DestroyAllResources()
 {
     DECODE_CHK_NULL(m_allocator);
 
+    for (auto buffer : m_auxBuffers)
+    {
+        ReleaseAuxBuffer(buffer);
+    }
+    m_auxBuffers.clear();
+
     return m_allocator->DestroyAllResources();
 }
 
+MOS_STATUS DecodeAllocator::ReleaseAuxBuffer(MOS_BUFFER *buffer)
+{
+    DECODE_CHK_NULL(buffer);
+
+    if (m_returnAuxBuffers)
+    {
+        return DecodeAuxBufferPool::GetInstance().Return(buffer);
+    }
+    return DecodeAuxBufferPool::GetInstance().Discard(buffer);
+}
+
 MOS_STATUS DecodeAllocator::SyncOnResource(MOS_RESOURCE* resource, bool IsWriteOperation)
 {
     DECODE_CHK_NULL(resource);
@@ -38,6 +38,7 @@
 #include "mos_resource_defs.h"
 #include "External/Common/GmmCachePolicyExt.h"
 #include <stdint.h>
+#include <set>
 #include <vector>
 class Allocator;
 
@@ -443,6 +444,13 @@ public:
 
     MOS_STATUS DestroyAllResources();
 
+    //!
+    //! \brief  Give buffers leased from aux buffer pool back to pool when they are destroyed
+    //! \details Called once GPU finished all work of the session. Before that the leased
+    //!          buffers are freed on destroy, since GPU may still access them.
+    //!
+    void EnableAuxBufferReturn() { m_returnAuxBuffers = true; }
+
     //!
     //! \brief  Sync on resource
     //! \param  [in] resource
@@ -548,10 +556,24 @@ protected:
     //!
     void SetAccessRequirement(ResourceAccessReq accessReq, MOS_ALLOC_GFXRES_PARAMS &allocParams);
 
+    //!
+    //! \brief    Release buffer leased from aux buffer pool
+    //! \param    MOS_BUFFER buffer
+    //!           [in] Leased buffer
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS ReleaseAuxBuffer(MOS_BUFFER *buffer);
+
     PMOS_INTERFACE m_osInterface = nullptr;  //!< PMOS_INTERFACE
     Allocator *m_allocator = nullptr;
     bool m_limitedLMemBar = false; //!< Indicate if running with limited LMem bar config
 
+    std::set<MOS_BUFFER *> m_auxBuffers;          //!< Buffers leased from aux buffer pool
+    bool m_returnAuxBuffers = false;              //!< Give leased buffers back to pool on destroy
+    uint32_t m_auxBufferHits = 0;                 //!< Leases served by pooled buffers in this session
+    uint64_t m_auxBufferSavedUs = 0;              //!< Allocation time saved in this session
+
 #if (_DEBUG || _RELEASE_INTERNAL)
     bool m_forceLockable = false;
 #endif
@@ -0,0 +1,390 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     decode_aux_buffer_pool.cpp
+//! \brief    Implements the process wide pool of decode auxiliary buffers
+//!
+
+#include <tuple>
+#include "decode_aux_buffer_pool.h"
+#include "decode_utils.h"
+#include "mos_context_next.h"
+#include "mos_interface.h"
+#include "mos_os_cp_interface_specific.h"
+#include "mos_utilities.h"
+
+namespace decode
+{
+bool DecodeAuxBufferPool::BUCKET_KEY::operator<(const BUCKET_KEY &other) const
+{
+    return std::tie(device, size, usage, memType, flags.bNotLockable, flags.bOverlay, flags.bFlipChain, flags.bSVM,
+               flags.bCacheable, tileType, compressible, compressionMode, bypassMod, hwProtected) <
+           std::tie(other.device, other.size, other.usage, other.memType, other.flags.bNotLockable, other.flags.bOverlay,
+               other.flags.bFlipChain, other.flags.bSVM, other.flags.bCacheable, other.tileType, other.compressible,
+               other.compressionMode, other.bypassMod, other.hwProtected);
+}
+
+DecodeAuxBufferPool::~DecodeAuxBufferPool()
+{
+    // Device contexts release their buffers when cleaned up, the ones left here cannot be freed any more.
+    DECODE_ASSERT(m_buckets.empty());
+    DECODE_ASSERT(m_leased.empty());
+    DECODE_ASSERT(m_devices.empty());
+}
+
+DecodeAuxBufferPool &DecodeAuxBufferPool::GetInstance()
+{
+    static DecodeAuxBufferPool pool;
+    return pool;
+}
+
+MOS_STATUS DecodeAuxBufferPool::Configure(PMOS_INTERFACE osInterface, uint64_t capBytes, uint32_t idleTimeoutMs)
+{
+    DECODE_CHK_NULL(osInterface);
+
+    // Pooled buffers outlive the session, which is only safe when they are owned by the device context
+    if (!osInterface->apoMosEnabled || osInterface->osStreamState == nullptr ||
+        osInterface->osStreamState->osDeviceContext == nullptr)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+    OsDeviceContext *device = osInterface->osStreamState->osDeviceContext;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_devices.find(device);
+        if (it != m_devices.end())
+        {
+            if (it->second.capBytes != capBytes || it->second.idleTimeoutMs != idleTimeoutMs)
+            {
+                DECODE_NORMALMESSAGE("Aux buffer pool of device already configured, cap %llu, idle timeout %d ms kept",
+                    (unsigned long long)it->second.capBytes, it->second.idleTimeoutMs);
+            }
+            return MOS_STATUS_SUCCESS;
+        }
+
+        DEVICE_STATE &state = m_devices[device];
+        state.capBytes      = capBytes;
+        state.idleTimeoutMs = idleTimeoutMs;
+    }
+
+    device->RegisterReleaseCallback(OnDeviceRelease, this);
+    return MOS_STATUS_SUCCESS;
+}
+
+bool DecodeAuxBufferPool::IsEnabled(PMOS_INTERFACE osInterface)
+{
+    if (osInterface == nullptr || !osInterface->apoMosEnabled ||
+        osInterface->osStreamState == nullptr || osInterface->osStreamState->osDeviceContext == nullptr)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_devices.find(osInterface->osStreamState->osDeviceContext);
+    return it != m_devices.end() && it->second.capBytes > 0;
+}
+
+uint32_t DecodeAuxBufferPool::GetBucketSize(uint32_t size)
+{
+    uint32_t aligned = MOS_ALIGN_CEIL(size, MOS_PAGE_SIZE);
+
+    // Granularity grows with size and stays under 1/16 of it
+    uint32_t granularity = MOS_PAGE_SIZE;
+    while ((granularity << 4) <= aligned && granularity < (1u << 27))
+    {
+        granularity <<= 1;
+    }
+    return MOS_ALIGN_CEIL(aligned, granularity);
+}
+
+MOS_BUFFER *DecodeAuxBufferPool::Lease(
+    PMOS_INTERFACE osInterface, const MOS_ALLOC_GFXRES_PARAMS &allocParams, bool &reused, uint64_t &costUs)
+{
+    reused = false;
+    costUs = 0;
+
+    if (!IsEnabled(osInterface) || allocParams.Type != MOS_GFXRES_BUFFER)
+    {
+        return nullptr;
+    }
+
+    BUCKET_KEY key;
+    key.device          = osInterface->osStreamState->osDeviceContext;
+    key.size            = GetBucketSize(allocParams.dwBytes);
+    key.usage           = allocParams.ResUsageType;
+    key.memType         = allocParams.dwMemType;
+    key.flags           = allocParams.Flags;
+    key.tileType        = allocParams.TileType;
+    key.compressible    = allocParams.bIsCompressible;
+    key.compressionMode = allocParams.CompressionMode;
+    key.bypassMod       = allocParams.bBypassMODImpl;
+
+    // Content of protected session must not reach an unprotected one, and the reverse
+    MosCpInterface *cpInterface = osInterface->osCpInterface;
+    key.hwProtected = allocParams.hardwareProtected ||
+                      (cpInterface != nullptr && (cpInterface->IsCpEnabled() || cpInterface->IsHMEnabled()));
+
+    uint64_t now = GetCurTime();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Trim(key.device, now);
+        m_stats.leases++;
+
+        auto it = m_buckets.find(key);
+        if (it != m_buckets.end() && !it->second.empty())
+        {
+            // Latest returned one is most likely still resident
+            POOL_ENTRY entry = it->second.back();
+            it->second.pop_back();
+            if (it->second.empty())
+            {
+                m_buckets.erase(it);
+            }
+
+            m_stats.hits++;
+            m_stats.bytesPooled -= key.size;
+            auto device = m_devices.find(key.device);
+            if (device != m_devices.end())
+            {
+                device->second.bytesPooled -= key.size;
+            }
+            m_stats.timeSavedUs += entry.costUs;
+            m_leased[entry.buffer] = {key, entry.costUs};
+
+            // Allocation indexes belong to the gpu contexts of former session
+            for (uint32_t i = 0; i < MOS_GPU_CONTEXT_MAX; i++)
+            {
+                entry.buffer->OsResource.iAllocationIndex[i] = MOS_INVALID_ALLOC_INDEX;
+            }
+
+            reused = true;
+            costUs = entry.costUs;
+            return entry.buffer;
+        }
+        m_stats.misses++;
+    }
+
+    MOS_BUFFER *buffer = MOS_New(MOS_BUFFER);
+    if (buffer == nullptr)
+    {
+        return nullptr;
+    }
+    memset(buffer, 0, sizeof(MOS_BUFFER));
+
+    // Whole bucket is allocated, so that any lease from the bucket fits
+    MOS_ALLOC_GFXRES_PARAMS bucketParams = allocParams;
+    bucketParams.dwBytes                 = key.size;
+    MOS_STATUS status = osInterface->pfnAllocateResource(osInterface, &bucketParams, &buffer->OsResource);
+    if (status != MOS_STATUS_SUCCESS)
+    {
+        MOS_Delete(buffer);
+        return nullptr;
+    }
+    costUs = GetCurTime() - now;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_leased[buffer] = {key, costUs};
+    return buffer;
+}
+
+MOS_STATUS DecodeAuxBufferPool::Return(MOS_BUFFER *buffer)
+{
+    DECODE_CHK_NULL(buffer);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_leased.find(buffer);
+    if (it == m_leased.end())
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    BUCKET_KEY key = it->second.key;
+    POOL_ENTRY entry;
+    entry.buffer     = buffer;
+    entry.costUs     = it->second.costUs;
+    entry.returnTime = GetCurTime();
+    m_leased.erase(it);
+
+    // Buffers are only leased for configured devices, which stay until released
+    auto device = m_devices.find(key.device);
+    DECODE_CHK_COND(device == m_devices.end(), "Aux buffer returned after its device was released");
+
+    m_buckets[key].push_back(entry);
+    m_stats.returns++;
+    m_stats.bytesPooled += key.size;
+    m_stats.peakBytes = MOS_MAX(m_stats.peakBytes, m_stats.bytesPooled);
+    device->second.bytesPooled += key.size;
+
+    Trim(key.device, entry.returnTime);
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS DecodeAuxBufferPool::Discard(MOS_BUFFER *buffer)
+{
+    DECODE_CHK_NULL(buffer);
+
+    OsDeviceContext *device = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_leased.find(buffer);
+        if (it == m_leased.end())
+        {
+            return MOS_STATUS_INVALID_PARAMETER;
+        }
+        device = it->second.key.device;
+        m_leased.erase(it);
+    }
+
+    FreeBuffer(device, buffer);
+    return MOS_STATUS_SUCCESS;
+}
+
+void DecodeAuxBufferPool::OnDeviceRelease(OsDeviceContext *deviceContext, void *pool)
+{
+    if (pool != nullptr)
+    {
+        static_cast<DecodeAuxBufferPool *>(pool)->ReleaseDevice(deviceContext);
+    }
+}
+
+void DecodeAuxBufferPool::ReleaseDevice(OsDeviceContext *deviceContext)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Sessions of the device return or discard their buffers before it is cleaned up
+    for (auto &leased : m_leased)
+    {
+        DECODE_ASSERT(leased.second.key.device != deviceContext);
+    }
+
+    for (auto it = m_buckets.begin(); it != m_buckets.end();)
+    {
+        if (it->first.device != deviceContext)
+        {
+            ++it;
+            continue;
+        }
+        for (auto &entry : it->second)
+        {
+            FreeBuffer(deviceContext, entry.buffer);
+            m_stats.bytesPooled -= it->first.size;
+        }
+        it = m_buckets.erase(it);
+    }
+    m_devices.erase(deviceContext);
+
+    DECODE_NORMALMESSAGE("Aux buffer pool: %llu leases, %llu hits, %llu evictions, %llu us allocation saved",
+        (unsigned long long)m_stats.leases, (unsigned long long)m_stats.hits,
+        (unsigned long long)m_stats.evictions, (unsigned long long)m_stats.timeSavedUs);
+}
+
+DecodeAuxBufferPool::Statistics DecodeAuxBufferPool::GetStatistics()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+uint64_t DecodeAuxBufferPool::GetCurTime()
+{
+    return MosUtilities::MosGetCurTime();
+}
+
+void DecodeAuxBufferPool::FreeBuffer(OsDeviceContext *device, MOS_BUFFER *buffer)
+{
+    // The session which allocated buffer may be gone, so free it with the device context only
+    MosStreamState streamState;
+    streamState.osDeviceContext = device;
+
+    MosInterface::FreeResource(
+        &streamState,
+        &buffer->OsResource,
+        0
+#if MOS_MESSAGES_ENABLED
+        ,
+        __FUNCTION__,
+        __FILE__,
+        __LINE__
+#endif
+    );
+    MOS_Delete(buffer);
+}
+
+void DecodeAuxBufferPool::Trim(OsDeviceContext *device, uint64_t now)
+{
+    auto state = m_devices.find(device);
+    if (state == m_devices.end())
+    {
+        return;
+    }
+    uint64_t timeout = (uint64_t)state->second.idleTimeoutMs * 1000;
+
+    // Entries of bucket are in the order of return, so the idle ones are at front
+    for (auto it = m_buckets.begin(); state->second.idleTimeoutMs > 0 && it != m_buckets.end();)
+    {
+        if (it->first.device != device)
+        {
+            ++it;
+            continue;
+        }
+        auto &entries = it->second;
+        uint32_t expired = 0;
+        while (expired < entries.size() && now - entries[expired].returnTime >= timeout)
+        {
+            FreeBuffer(device, entries[expired].buffer);
+            m_stats.bytesPooled -= it->first.size;
+            state->second.bytesPooled -= it->first.size;
+            m_stats.evictions++;
+            expired++;
+        }
+        entries.erase(entries.begin(), entries.begin() + expired);
+        it = entries.empty() ? m_buckets.erase(it) : std::next(it);
+    }
+
+    while (state->second.bytesPooled > state->second.capBytes)
+    {
+        auto oldest = m_buckets.end();
+        for (auto it = m_buckets.begin(); it != m_buckets.end(); ++it)
+        {
+            if (it->first.device == device &&
+                (oldest == m_buckets.end() || it->second.front().returnTime < oldest->second.front().returnTime))
+            {
+                oldest = it;
+            }
+        }
+        if (oldest == m_buckets.end())
+        {
+            break;
+        }
+
+        FreeBuffer(device, oldest->second.front().buffer);
+        m_stats.bytesPooled -= oldest->first.size;
+        state->second.bytesPooled -= oldest->first.size;
+        m_stats.evictions++;
+        oldest->second.erase(oldest->second.begin());
+        if (oldest->second.empty())
+        {
+            m_buckets.erase(oldest);
+        }
+    }
+}
+}  // namespace decode
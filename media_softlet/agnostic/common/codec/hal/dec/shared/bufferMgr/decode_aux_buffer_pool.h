@@ -0,0 +1,220 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     decode_aux_buffer_pool.h
+//! \brief    Defines the process wide pool of decode auxiliary buffers
+//! \details  Decode sessions allocate scratch buffers such as MV temporal buffers
+//!           and row store buffers when they start. The pool keeps the not lockable
+//!           video memory buffers returned by finished sessions in size buckets,
+//!           so that later sessions on the same device lease them instead of
+//!           allocating new ones. Buffers pooled for a device are freed when the
+//!           device context is cleaned up.
+//!
+#ifndef __DECODE_AUX_BUFFER_POOL_H__
+#define __DECODE_AUX_BUFFER_POOL_H__
+
+#include <map>
+#include <mutex>
+#include <vector>
+#include "mos_os.h"
+#include "media_class_trace.h"
+
+namespace decode
+{
+class DecodeAuxBufferPool
+{
+public:
+    //!
+    //! \brief  Counters of the pool
+    //!
+    struct Statistics
+    {
+        uint64_t leases        = 0;
+        uint64_t hits          = 0;  //!< Leases served by pooled buffers
+        uint64_t misses        = 0;  //!< Leases served by new allocations
+        uint64_t returns       = 0;
+        uint64_t evictions     = 0;  //!< Pooled buffers freed for memory cap or idle timeout
+        uint64_t bytesPooled   = 0;  //!< Bytes of buffers waiting in pool
+        uint64_t peakBytes     = 0;
+        uint64_t timeSavedUs   = 0;  //!< Allocation time of the reused buffers
+    };
+
+    //!
+    //! \brief  Get the pool of process
+    //! \return DecodeAuxBufferPool &
+    //!
+    static DecodeAuxBufferPool &GetInstance();
+
+    //!
+    //! \brief  Set the limits of pool for the device owning os interface
+    //! \details Only the first call for a device takes effect, the limits stay until
+    //!          the device context is cleaned up.
+    //! \param  [in] osInterface
+    //!         Os interface of the session
+    //! \param  [in] capBytes
+    //!         Max bytes of buffers of the device waiting in pool, 0 disables pooling
+    //! \param  [in] idleTimeoutMs
+    //!         Pooled buffers not leased for this long are freed, 0 keeps them until device is released
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Configure(PMOS_INTERFACE osInterface, uint64_t capBytes, uint32_t idleTimeoutMs);
+
+    //!
+    //! \brief  Check if pooling is enabled for the os interface
+    //! \return bool
+    //!
+    bool IsEnabled(PMOS_INTERFACE osInterface);
+
+    //!
+    //! \brief  Lease a buffer of the device owning os interface
+    //! \param  [in] osInterface
+    //!         Os interface of the session
+    //! \param  [in] allocParams
+    //!         Allocation parameters, the buffer is allocated with dwBytes rounded up to the bucket size
+    //! \param  [out] reused
+    //!         true if the buffer comes from pool
+    //! \param  [out] costUs
+    //!         Time the allocation of buffer took
+    //! \return MOS_BUFFER*
+    //!         Buffer, nullptr if failed
+    //!
+    MOS_BUFFER *Lease(PMOS_INTERFACE osInterface, const MOS_ALLOC_GFXRES_PARAMS &allocParams, bool &reused, uint64_t &costUs);
+
+    //!
+    //! \brief  Give a leased buffer back to pool
+    //! \details GPU must have finished all work on the buffer.
+    //! \param  [in] buffer
+    //!         Buffer returned by Lease
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Return(MOS_BUFFER *buffer);
+
+    //!
+    //! \brief  Free a leased buffer instead of giving it back
+    //! \details Used when GPU may still access the buffer.
+    //! \param  [in] buffer
+    //!         Buffer returned by Lease
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Discard(MOS_BUFFER *buffer);
+
+    Statistics GetStatistics();
+
+    static const uint64_t m_defaultCapBytes      = 0;  //!< Pooling is off unless enabled by user setting
+    static const uint32_t m_defaultIdleTimeoutMs = 10000;
+
+protected:
+    //!
+    //! \brief  Buffers are only shared by sessions allocating them with the same parameters
+    //!
+    struct BUCKET_KEY
+    {
+        OsDeviceContext      *device          = nullptr;
+        uint32_t              size            = 0;
+        MOS_HW_RESOURCE_DEF   usage           = MOS_HW_RESOURCE_DEF_MAX;
+        int32_t               memType         = MOS_MEMPOOL_VIDEOMEMORY;
+        MOS_GFXRES_FLAGS      flags           = {};
+        MOS_TILE_TYPE         tileType        = MOS_TILE_LINEAR;
+        int32_t               compressible    = 0;
+        MOS_RESOURCE_MMC_MODE compressionMode = MOS_MMC_DISABLED;
+        int32_t               bypassMod       = 0;
+        bool                  hwProtected     = false;  //!< Buffer of protected session
+
+        bool operator<(const BUCKET_KEY &other) const;
+    };
+
+    struct POOL_ENTRY
+    {
+        MOS_BUFFER *buffer     = nullptr;
+        uint64_t    costUs     = 0;  //!< Allocation time
+        uint64_t    returnTime = 0;  //!< Time given back in us
+    };
+
+    struct LEASE_INFO
+    {
+        BUCKET_KEY key;
+        uint64_t   costUs = 0;
+    };
+
+    struct DEVICE_STATE
+    {
+        uint64_t capBytes      = m_defaultCapBytes;
+        uint32_t idleTimeoutMs = m_defaultIdleTimeoutMs;
+        uint64_t bytesPooled   = 0;
+    };
+
+    DecodeAuxBufferPool() = default;
+
+    //!
+    //! \brief  Destructor
+    //! \details All devices must have been released by then, as buffers cannot be
+    //!          freed once their device context is gone.
+    //!
+    virtual ~DecodeAuxBufferPool();
+
+    //!
+    //! \brief  Free all pooled buffers of device, called before the device context is cleaned up
+    //! \param  [in] deviceContext
+    //!         Device context being cleaned up
+    //!
+    void ReleaseDevice(OsDeviceContext *deviceContext);
+
+    //!
+    //! \brief  Release callback registered to device context
+    //!
+    static void OnDeviceRelease(OsDeviceContext *deviceContext, void *pool);
+
+    //!
+    //! \brief  Round buffer size up, so that sessions with close sizes share buckets
+    //! \return uint32_t
+    //!
+    static uint32_t GetBucketSize(uint32_t size);
+
+    //!
+    //! \brief  Free buffer of the device
+    //!
+    virtual void FreeBuffer(OsDeviceContext *device, MOS_BUFFER *buffer);
+
+    //!
+    //! \brief  Get current time in us
+    //!
+    virtual uint64_t GetCurTime();
+
+    //!
+    //! \brief  Free pooled buffers of device idle for too long or exceeding its cap, m_mutex must be held
+    //!
+    void Trim(OsDeviceContext *device, uint64_t now);
+
+    std::mutex                                    m_mutex;
+    std::map<BUCKET_KEY, std::vector<POOL_ENTRY>> m_buckets;
+    std::map<MOS_BUFFER *, LEASE_INFO>            m_leased;
+    std::map<OsDeviceContext *, DEVICE_STATE>     m_devices;
+    Statistics                                    m_stats = {};
+
+MEDIA_CLASS_DEFINE_END(decode__DecodeAuxBufferPool)
+};
+}  // namespace decode
+
+#endif  // __DECODE_AUX_BUFFER_POOL_H__
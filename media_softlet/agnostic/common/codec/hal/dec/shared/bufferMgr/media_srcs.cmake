@@ -20,11 +20,13 @@
 set(TMP_SOURCES_
     ${TMP_SOURCES_}
     ${CMAKE_CURRENT_LIST_DIR}/decode_allocator.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/decode_aux_buffer_pool.cpp
 )
 
 set(TMP_HEADERS_
     ${TMP_HEADERS_}
     ${CMAKE_CURRENT_LIST_DIR}/decode_allocator.h
+    ${CMAKE_CURRENT_LIST_DIR}/decode_aux_buffer_pool.h
     ${CMAKE_CURRENT_LIST_DIR}/decode_resource_array.h
     ${CMAKE_CURRENT_LIST_DIR}/decode_resource_auto_lock.h
     ${CMAKE_CURRENT_LIST_DIR}/decode_reference_associated_buffer.h
@@ -195,6 +195,10 @@ MOS_STATUS DecodePipeline::Uninitialize()
 
     // Wait all cmd completion before delete resource.
     m_osInterface->pfnWaitAllCmdCompletion(m_osInterface);
+    if (m_allocator != nullptr)
+    {
+        m_allocator->EnableAuxBufferReturn();
+    }
 
     Delete_DecodeCpInterface(m_decodecp);
     m_decodecp = nullptr;
@@ -299,6 +303,7 @@ MOS_STATUS DecodePipeline::ExecuteActivePackets()
     }
 
     m_activePacketList.clear();
+    DECODE_CHK_STATUS(SubmitUploadRings());
     MOS_TraceEventExt(EVENT_PIPE_EXE, EVENT_TYPE_END, nullptr, 0, nullptr, 0);
     return MOS_STATUS_SUCCESS;
 }
@@ -63,6 +63,19 @@ public:
     virtual CODECHAL_DUMMY_REFERENCE_STATUS GetDummyReferenceStatus() = 0;
     virtual void SetDummyReferenceStatus(CODECHAL_DUMMY_REFERENCE_STATUS status) = 0;
     virtual uint32_t GetCompletedReport() = 0;
+
+    //!
+    //! \brief  Get all status reports completed since the last call, in submission order
+    //! \param  [out] status
+    //!         The report buffer, with room for maxNum reports
+    //! \param  [in] maxNum
+    //!         The maximum number of reports to get
+    //! \param  [out] numReports
+    //!         The number of reports written to status
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    virtual MOS_STATUS GetCompletedReports(void *status, uint32_t maxNum, uint32_t &numReports) = 0;
     virtual MOS_GPU_CONTEXT GetDecodeContext() = 0;
 
 MEDIA_CLASS_DEFINE_END(DecodePipelineAdapter)
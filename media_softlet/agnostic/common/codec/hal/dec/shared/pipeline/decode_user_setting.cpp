@@ -146,6 +146,18 @@ MOS_STATUS DecodePipeline::InitUserSetting(MediaUserSettingSharedPtr userSetting
         MediaUserSetting::Group::Sequence,
         int32_t(1),
         false);
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "Decode Aux Buffer Pool Size",
+        MediaUserSetting::Group::Sequence,
+        int32_t(0),
+        false);
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "Decode Aux Buffer Pool Idle Timeout",
+        MediaUserSetting::Group::Sequence,
+        int32_t(10000),
+        false);
 #if (_DEBUG || _RELEASE_INTERNAL)
     DeclareUserSettingKeyForDebug(
         userSettingPtr,
@@ -243,7 +243,11 @@ MOS_STATUS Av1BasicFeature::UpdateTrackedBufferParameters()
 {
     ENCODE_FUNC_CALL();
 
-    m_trackedBuf->OnSizeChange();
+    // the first frame sets the initial size, it is not a size change
+    if (m_frameNum > 0)
+    {
+        ENCODE_CHK_STATUS_RETURN(m_trackedBuf->OnSizeChange());
+    }
 
     // The MB code size here, it is from Arch's suggestion
     const uint32_t numOfCU  = MOS_ROUNDUP_DIVIDE(m_frameWidth, 8) * MOS_ROUNDUP_DIVIDE(m_frameHeight, 8);
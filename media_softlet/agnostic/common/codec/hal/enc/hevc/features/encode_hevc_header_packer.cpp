@@ -557,6 +557,7 @@ MOS_STATUS HevcHeaderPacker::SliceHeaderPacker(EncoderParams *encodeParams)
         pSlcData[slcCount].SkipEmulationByteCount = 3 /*+ (pBSBuffer->pCurrent + (BitLenRecorded + 7) / 8 == pBSBuffer->pBase)*/;
         BitLenRecorded                            = BitLenRecorded + BitLen;
     }
+    rbsp.Flush();
 
     MOS_SecureMemcpy(pBSBuffer->pCurrent,
         (BitLenRecorded + 7) / 8,
@@ -225,16 +225,16 @@ namespace encode
             return eStatus;
         }
 
-        MOS_LOCK_PARAMS lockFlags;
-        MOS_ZeroMemory(&lockFlags, sizeof(MOS_LOCK_PARAMS));
-        lockFlags.WriteOnly = true;
-
-        uint8_t *data = (uint8_t *)m_osInterface->pfnLockResource(m_osInterface, m_forceIntraStreamInBuf, &lockFlags);
-        ENCODE_CHK_NULL_RETURN(data);
-
         MHW_VDBOX_VDENC_STREAMIN_STATE_PARAMS streaminDataParams;
         uint32_t streamInWidth  = (MOS_ALIGN_CEIL(m_basicFeature->m_frameWidth, 64) / 32);
         uint32_t streamInHeight = (MOS_ALIGN_CEIL(m_basicFeature->m_frameHeight, 64) / 32);
+        uint32_t streamInNumCUs = streamInWidth * streamInHeight;
+
+        // Every LCU shares the same force intra setting, so build one LCU in
+        // system memory, replicate it and stream the whole buffer out at once
+        // instead of doing read-modify-write per LCU on the locked resource.
+        uint8_t *streamInTemp = (uint8_t *)MOS_AllocAndZeroMemory(streamInNumCUs * 64);
+        ENCODE_CHK_NULL_RETURN(streamInTemp);
 
         // lookahead pass should lower QP by 2 to encode force intra frame.
         MOS_ZeroMemory(&streaminDataParams, sizeof(streaminDataParams));
@@ -243,7 +243,7 @@ namespace encode
         streaminDataParams.forceQp[1] = m_hevcPicParams->QpY - 2;
         streaminDataParams.forceQp[2] = m_hevcPicParams->QpY - 2;
         streaminDataParams.forceQp[3] = m_hevcPicParams->QpY - 2;
-        SetStreaminDataPerRegion(streamInWidth, 0, streamInHeight, 0, streamInWidth, &streaminDataParams, data);
+        SetStreaminDataPerLcu(&streaminDataParams, streamInTemp);
 
         MOS_ZeroMemory(&streaminDataParams, sizeof(streaminDataParams));
         streaminDataParams.puTypeCtrl = 1;  //force intra
@@ -254,14 +254,25 @@ namespace encode
         streaminDataParams.numMergeCandidateCu16x16 = 2;
         streaminDataParams.numMergeCandidateCu8x8 = 0;
         streaminDataParams.numImePredictors = 4;
+        SetStreaminDataPerLcu(&streaminDataParams, streamInTemp);
 
-        uint32_t streamInNumCUs = streamInWidth * streamInHeight;
-        for (uint32_t i = 0; i < streamInNumCUs; i++)
+        EncodeReplicateBlock(streamInTemp, 64, streamInNumCUs);
+
+        MOS_LOCK_PARAMS lockFlags;
+        MOS_ZeroMemory(&lockFlags, sizeof(MOS_LOCK_PARAMS));
+        lockFlags.WriteOnly = true;
+
+        uint8_t *data = (uint8_t *)m_osInterface->pfnLockResource(m_osInterface, m_forceIntraStreamInBuf, &lockFlags);
+        if (data == nullptr)
         {
-            SetStreaminDataPerLcu(&streaminDataParams, data + (i * 64));
+            MOS_FreeMemory(streamInTemp);
+            return MOS_STATUS_NULL_POINTER;
         }
 
+        MOS_SecureMemcpy(data, streamInNumCUs * 64, streamInTemp, streamInNumCUs * 64);
+
         m_osInterface->pfnUnlockResource(m_osInterface, m_forceIntraStreamInBuf);
+        MOS_FreeMemory(streamInTemp);
 
         m_forceIntraSteamInSetupDone = true;
 
@@ -49,18 +49,94 @@ HevcVdencRoi::HevcVdencRoi(
     m_basicFeature = dynamic_cast<EncodeBasicFeature *>(m_featureManager->GetFeature(FeatureIDs::basicFeature));
     ENCODE_CHK_NULL_NO_STATUS_RETURN(m_basicFeature);
 }
+
+HevcVdencRoi::~HevcVdencRoi()
+{
+    MOS_SafeFreeMemory(m_streamInTemp);
+    m_streamInTemp = nullptr;
+}
+
 MOS_STATUS HevcVdencRoi::ClearStreaminBuffer(uint32_t lucNumber)
 {
-    // Clear streamin
+    // Clear streamin in system memory, the whole buffer is copied to the
+    // streamin resource by WriteStreaminData
     ENCODE_CHK_NULL_RETURN(m_streamInTemp);
 
-    uint8_t *data = (uint8_t *)m_allocator->LockResourceForWrite(m_streamIn);
-    ENCODE_CHK_NULL_RETURN(data);
+    MOS_ZeroMemory(m_streamInTemp, MOS_MIN(lucNumber * 64, m_streamInSize));
 
-    MOS_ZeroMemory(m_streamInTemp, lucNumber * 64);
-    MOS_SecureMemcpy(data, m_streamInSize, m_streamInTemp, m_streamInSize);
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS HevcVdencRoi::HashStreaminInputs(
+    SeqParams *hevcSeqParams,
+    PicParams *hevcPicParams,
+    SlcParams *hevcSlcParams,
+    uint64_t  &hash)
+{
+    ENCODE_CHK_NULL_RETURN(hevcSeqParams);
+    ENCODE_CHK_NULL_RETURN(hevcPicParams);
+    ENCODE_CHK_NULL_RETURN(hevcSlcParams);
 
-    ENCODE_CHK_STATUS_RETURN(m_allocator->UnLock(m_streamIn));
+    auto brcFeature = dynamic_cast<HEVCEncodeBRC *>(m_featureManager->GetFeature(HevcFeatureIDs::hevcBrcFeature));
+
+    HevcVdencStreaminInputs inputs;
+    inputs.frameWidth         = m_basicFeature->m_frameWidth;
+    inputs.frameHeight        = m_basicFeature->m_frameHeight;
+    inputs.oriFrameHeight     = m_basicFeature->m_oriFrameHeight;
+    inputs.targetUsage        = hevcSeqParams->TargetUsage;
+    inputs.minCodingBlockSize = hevcSeqParams->log2_min_coding_block_size_minus3;
+    inputs.codingType         = hevcPicParams->CodingType;
+    inputs.qpY                = hevcPicParams->QpY;
+    inputs.sliceQpDelta       = hevcSlcParams->slice_qp_delta;
+    inputs.tilesEnabled       = hevcPicParams->tiles_enabled_flag;
+    inputs.numTileColumns     = hevcPicParams->num_tile_columns_minus1;
+    inputs.numTileRows        = hevcPicParams->num_tile_rows_minus1;
+    inputs.numRoi             = hevcPicParams->NumROI;
+    inputs.numDirtyRects      = m_dirtyRoiEnabled ? hevcPicParams->NumDirtyRects : 0;
+    inputs.roiEnabled         = m_roiEnabled;
+    inputs.dirtyRoiEnabled    = m_dirtyRoiEnabled;
+    inputs.mbQpDataEnabled    = m_mbQpDataEnabled;
+    inputs.vdencHucUsed       = brcFeature != nullptr && brcFeature->IsVdencHucUsed();
+
+    hash = inputs.Hash();
+
+    if (hevcPicParams->tiles_enabled_flag)
+    {
+        hash = EncodeHashData(hevcPicParams->tile_column_width, sizeof(hevcPicParams->tile_column_width), hash);
+        hash = EncodeHashData(hevcPicParams->tile_row_height, sizeof(hevcPicParams->tile_row_height), hash);
+    }
+
+    if (m_roiEnabled && hevcPicParams->NumROI > 0)
+    {
+        uint32_t numRoi = MOS_MIN(hevcPicParams->NumROI, CODECHAL_ENCODE_HEVC_MAX_NUM_ROI);
+        hash = EncodeHashData(hevcPicParams->ROI, numRoi * sizeof(CODEC_ROI), hash);
+        hash = EncodeHashData(hevcPicParams->ROIDistinctDeltaQp, sizeof(hevcPicParams->ROIDistinctDeltaQp), hash);
+    }
+
+    if (m_dirtyRoiEnabled)
+    {
+        ENCODE_CHK_NULL_RETURN(hevcPicParams->pDirtyRect);
+        hash = EncodeHashData(hevcPicParams->pDirtyRect, hevcPicParams->NumDirtyRects * sizeof(CODEC_ROI), hash);
+    }
+
+    if (m_mbQpDataEnabled)
+    {
+        // QP map is only locked and hashed when the app may have updated it
+        PMOS_SURFACE qpSurface = &m_basicFeature->m_mbQpDataSurface;
+        uint64_t     qpMapHash = 0;
+        ENCODE_CHK_STATUS_RETURN(m_qpMapHash.Get(
+            qpSurface->OsResource.pGmmResInfo,
+            !m_basicFeature->m_mbQpDataUnchanged,
+            [&](uint64_t &qpHash) {
+                uint8_t *qpData = (uint8_t *)m_allocator->LockResourceForRead(&qpSurface->OsResource);
+                ENCODE_CHK_NULL_RETURN(qpData);
+                qpHash = EncodeHashData(qpData, qpSurface->dwPitch * qpSurface->dwHeight);
+                m_allocator->UnLock(&qpSurface->OsResource);
+                return MOS_STATUS_SUCCESS;
+            },
+            qpMapHash));
+        hash = EncodeHashData(&qpMapHash, sizeof(qpMapHash), hash);
+    }
 
     return MOS_STATUS_SUCCESS;
 }
@@ -158,14 +234,25 @@ MOS_STATUS HevcVdencRoi::Update(void *params)
 
     if (!m_isArbRoi || (hevcPicParams->CodingType == I_TYPE && !IFrameIsSet) || ((hevcPicParams->CodingType == P_TYPE || hevcPicParams->CodingType == B_TYPE) && !PBFrameIsSet))
     {
-        m_streamInTemp = (uint8_t *)MOS_AllocMemory(m_streamInSize);
-        ENCODE_CHK_NULL_RETURN(m_streamInTemp);
+        if (m_streamInTemp == nullptr)
+        {
+            m_streamInTemp = (uint8_t *)MOS_AllocAndZeroMemory(m_streamInSize);
+            ENCODE_CHK_NULL_RETURN(m_streamInTemp);
+        }
 
         uint32_t lcuNumber = GetLCUNumber();
 
-        ENCODE_CHK_STATUS_RETURN(ClearStreaminBuffer(lcuNumber));
+        // Streamin data is only regenerated when ROI, dirty ROI or QP map
+        // inputs change, ARB streamin alternates between I and P/B settings.
+        uint64_t inputHash = 0;
+        ENCODE_CHK_STATUS_RETURN(HashStreaminInputs(hevcSeqParams, hevcPicParams, hevcSlcParams, inputHash));
+        m_streamInReused = !m_isArbRoi && m_streamInCached && (inputHash == m_streamInHash);
 
-        m_roiOverlap.Update(lcuNumber);
+        if (!m_streamInReused)
+        {
+            ENCODE_CHK_STATUS_RETURN(ClearStreaminBuffer(lcuNumber));
+            m_roiOverlap.Update(lcuNumber);
+        }
 
         ENCODE_CHK_STATUS_RETURN(ExecuteDirtyRoi(hevcSeqParams, hevcPicParams, hevcSlcParams));
 
@@ -185,7 +272,8 @@ MOS_STATUS HevcVdencRoi::Update(void *params)
 
         ENCODE_CHK_STATUS_RETURN(WriteStreaminData());
 
-        MOS_SafeFreeMemory(m_streamInTemp);
+        m_streamInHash   = inputHash;
+        m_streamInCached = !m_isArbRoi;
 
 #if (_DEBUG || _RELEASE_INTERNAL)
         ENCODE_CHK_NULL_RETURN(m_hwInterface);
@@ -218,10 +306,13 @@ MOS_STATUS HevcVdencRoi::WriteStreaminData()
     uint8_t *streaminBuffer = (uint8_t *)m_allocator->LockResourceForWrite(m_streamIn);
     ENCODE_CHK_NULL_RETURN(streaminBuffer);
 
-    m_roiOverlap.WriteStreaminData(
-        m_strategyFactory.GetRoi(), 
-        m_strategyFactory.GetDirtyRoi(),
-        m_streamInTemp);
+    if (!m_streamInReused)
+    {
+        ENCODE_CHK_STATUS_RETURN(m_roiOverlap.WriteStreaminData(
+            m_strategyFactory.GetRoi(),
+            m_strategyFactory.GetDirtyRoi(),
+            m_streamInTemp));
+    }
 
     MOS_SecureMemcpy(streaminBuffer, m_streamInSize, m_streamInTemp, m_streamInSize);
 
@@ -263,7 +354,8 @@ MOS_STATUS HevcVdencRoi::ExecuteRoi(
     ENCODE_CHK_STATUS_RETURN(
         strategy->PrepareParams(hevcSeqParams, hevcPicParams, hevcSlcParams));
 
-    ENCODE_CHK_STATUS_RETURN(strategy->SetupRoi(m_roiOverlap));
+    ENCODE_CHK_STATUS_RETURN(m_streamInReused ?
+        strategy->RefreshRoi() : strategy->SetupRoi(m_roiOverlap));
     return MOS_STATUS_SUCCESS;
 }
 
@@ -288,7 +380,8 @@ MOS_STATUS HevcVdencRoi::ExecuteRoiExt(
     ENCODE_CHK_STATUS_RETURN(
         strategy->PrepareParams(hevcSeqParams, hevcPicParams, hevcSlcParams));
 
-    ENCODE_CHK_STATUS_RETURN(strategy->SetupRoi(m_roiOverlap));
+    ENCODE_CHK_STATUS_RETURN(m_streamInReused ?
+        strategy->RefreshRoi() : strategy->SetupRoi(m_roiOverlap));
     return MOS_STATUS_SUCCESS;
 }
 
@@ -311,7 +404,8 @@ MOS_STATUS HevcVdencRoi::ExecuteDirtyRoi(
     ENCODE_CHK_STATUS_RETURN(
         strategy->PrepareParams(hevcSeqParams, hevcPicParams, hevcSlcParams));
 
-    ENCODE_CHK_STATUS_RETURN(strategy->SetupRoi(m_roiOverlap));
+    ENCODE_CHK_STATUS_RETURN(m_streamInReused ?
+        strategy->RefreshRoi() : strategy->SetupRoi(m_roiOverlap));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -30,6 +30,7 @@
 #include "media_feature.h"
 #include "encode_hevc_vdenc_roi_overlap.h"
 #include "encode_hevc_vdenc_roi_strategy.h"
+#include "encode_hevc_vdenc_roi_streamin_inputs.h"
 #include "encode_hevc_brc.h"
 #include "mhw_vdbox_vdenc_itf.h"
 #include "mhw_vdbox_huc_itf.h"
@@ -60,7 +61,7 @@ public:
         CodechalHwInterface *hwInterface,
         void *constSettings);
 
-    virtual ~HevcVdencRoi() {}
+    virtual ~HevcVdencRoi();
 
     //!
     //! \brief  Init encode parameter
@@ -211,6 +212,29 @@ protected:
     //!
     MOS_STATUS ClearStreaminBuffer(uint32_t lucNumber);
 
+    //!
+    //! \brief    Hash all the inputs which affect the streamin data
+    //!
+    //! \detail   When the hash equals to the one of previous frame, the cached
+    //!           streamin data is copied out directly without regeneration.
+    //!
+    //! \param    [in] hevcSeqParams
+    //!           pointer of sequence parameters
+    //! \param    [in] hevcPicParams
+    //!           pointer of picture parameters
+    //! \param    [in] hevcSlcParams
+    //!           pointer of slice parameters
+    //! \param    [out] hash
+    //!           hash of the streamin inputs
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS HashStreaminInputs(
+        SeqParams *hevcSeqParams,
+        PicParams *hevcPicParams,
+        SlcParams *hevcSlcParams,
+        uint64_t  &hash);
+
     //!
     //! \brief    Get strategy for setting command parameters
     //!
@@ -246,6 +270,10 @@ protected:
     PMOS_RESOURCE      m_streamIn = nullptr; //!< Stream in buffer
     uint8_t *          m_streamInTemp = nullptr;
     uint32_t           m_streamInSize = 0;
+    uint64_t           m_streamInHash = 0;        //!< Hash of the inputs of cached streamin data
+    bool               m_streamInCached = false;  //!< Whether m_streamInTemp holds data of previous frame
+    bool               m_streamInReused = false;  //!< Whether cached streamin data is reused in current frame
+    EncodeCachedHash   m_qpMapHash;               //!< Hash of QP map, rehashed only when it changes
     RoiStrategyFactory m_strategyFactory;    //!< Factory of strategy
     RoiOverlap         m_roiOverlap;         //!< ROI and dirty ROI overlap
 
@@ -58,6 +58,8 @@ protected:
         bool            cu64Align,
         StreamInParams &streaminDataParams) override;
 
+    bool IsStreaminDataPerLcu() const override { return true; }
+
 protected:
     size_t  m_boostCycle = 0;
     size_t  m_boostIdx   = 0;
@@ -57,6 +57,35 @@ MOS_STATUS HucForceQpROI::SetupRoi(RoiOverlap &overlap)
 
     ENCODE_FUNC_CALL();
 
+    ENCODE_CHK_NULL_RETURN(m_basicFeature);
+
+    bool cu64Align = true;
+    ENCODE_CHK_STATUS_RETURN(SetupDeltaQpBuffer(cu64Align));
+
+    uint32_t streamInWidth  = (MOS_ALIGN_CEIL(m_basicFeature->m_frameWidth, 64) / 32);
+    uint32_t streamInHeight = (MOS_ALIGN_CEIL(m_basicFeature->m_frameHeight, 64) / 32);
+    int32_t  streamInNumCUs = streamInWidth * streamInHeight;
+    for (auto i = 0; i < streamInNumCUs; i++)
+    {
+        overlap.MarkLcu(i, cu64Align ? 
+            RoiOverlap::mkRoiBk : RoiOverlap::mkRoiBkNone64Align);
+    }
+
+    return eStatus;
+}
+
+MOS_STATUS HucForceQpROI::RefreshRoi()
+{
+    ENCODE_FUNC_CALL();
+
+    bool cu64Align = true;
+    return SetupDeltaQpBuffer(cu64Align);
+}
+
+MOS_STATUS HucForceQpROI::SetupDeltaQpBuffer(bool &cu64Align)
+{
+    ENCODE_FUNC_CALL();
+
     ENCODE_CHK_NULL_RETURN(m_allocator);
     ENCODE_CHK_NULL_RETURN(m_basicFeature);
     ENCODE_CHK_NULL_RETURN(m_recycle);
@@ -78,10 +107,9 @@ MOS_STATUS HucForceQpROI::SetupRoi(RoiOverlap &overlap)
     MOS_ZeroMemory(deltaQpData, m_deltaQpRoiBufferSize);
 
     uint32_t streamInWidth    = (MOS_ALIGN_CEIL(m_basicFeature->m_frameWidth, 64) / 32);
-    uint32_t streamInHeight   = (MOS_ALIGN_CEIL(m_basicFeature->m_frameHeight, 64) / 32);
     uint32_t deltaQpBufWidth  = (MOS_ALIGN_CEIL(m_basicFeature->m_frameWidth, 32) / 32);
     uint32_t deltaQpBufHeight = (MOS_ALIGN_CEIL(m_basicFeature->m_frameHeight, 32) / 32);
-    bool     cu64Align        = true;
+    cu64Align                 = true;
 
     for (auto i = m_numRoi - 1; i >= 0; i--)
     {
@@ -130,15 +158,7 @@ MOS_STATUS HucForceQpROI::SetupRoi(RoiOverlap &overlap)
 
     ENCODE_CHK_STATUS_RETURN(m_allocator->UnLock(m_deltaQpBuffer));
 
-
-    int32_t streamInNumCUs = streamInWidth * streamInHeight;
-    for (auto i = 0; i < streamInNumCUs; i++)
-    {
-        overlap.MarkLcu(i, cu64Align ? 
-            RoiOverlap::mkRoiBk : RoiOverlap::mkRoiBkNone64Align);
-    }
-
-    return eStatus;
+    return MOS_STATUS_SUCCESS;
 }
 
 }
\ No newline at end of file
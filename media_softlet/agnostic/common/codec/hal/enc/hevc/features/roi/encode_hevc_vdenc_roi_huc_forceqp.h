@@ -52,6 +52,14 @@ public:
     //!
     virtual MOS_STATUS SetupRoi(RoiOverlap &overlap) override;
 
+    //!
+    //! \brief    Refresh the delta QP buffer of current frame
+    //!
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    virtual MOS_STATUS RefreshRoi() override;
+
     //!
     //! \brief    Set VDENC_PIPE_BUF_ADDR parameters
     //!
@@ -90,6 +98,16 @@ public:
     }
 
 private:
+    //!
+    //! \brief    Fill the delta QP buffer of current frame
+    //!
+    //! \param    [out] cu64Align
+    //!           Whether all the ROI regions are aligned to 64CU
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS SetupDeltaQpBuffer(bool &cu64Align);
+
     static constexpr uint32_t m_roiStreamInBufferSize = 
         65536 * CODECHAL_CACHELINE_SIZE; //!< ROI Streamin buffer size (part of BRC Update)
 
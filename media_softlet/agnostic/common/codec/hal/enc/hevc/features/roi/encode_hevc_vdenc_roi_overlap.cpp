@@ -110,25 +110,36 @@ MOS_STATUS RoiOverlap::WriteStreaminData(
     ENCODE_CHK_NULL_RETURN(streaminBuffer);
     ENCODE_CHK_NULL_RETURN(m_overlapMap);
 
-    for (uint32_t i = 0; i < m_lcuNumber; i++)
+    // LCUs sharing the same description are written as one span, so the
+    // strategy is called once per run instead of once per LCU.
+    uint32_t spanStart = 0;
+    while (spanStart < m_lcuNumber)
     {
-        OverlapMarker marker = GetMarker(m_overlapMap[i]);
-        uint32_t      roiRegionIndex = GetRoiRegionIndex(m_overlapMap[i]);
+        uint16_t data    = m_overlapMap[spanStart];
+        uint32_t spanEnd = spanStart + 1;
+        while (spanEnd < m_lcuNumber && m_overlapMap[spanEnd] == data)
+        {
+            spanEnd++;
+        }
+
+        OverlapMarker marker         = GetMarker(data);
+        uint32_t      roiRegionIndex = GetRoiRegionIndex(data);
+        uint32_t      spanLength     = spanEnd - spanStart;
 
         if (IsRoiMarker(marker))
         {
             ENCODE_CHK_NULL_RETURN(roi);
-
-            roi->WriteStreaminData(
-                i, marker, roiRegionIndex, streaminBuffer);
-
+            ENCODE_CHK_STATUS_RETURN(roi->WriteStreaminSpan(
+                spanStart, spanLength, marker, roiRegionIndex, streaminBuffer));
         }
         else if (IsDirtyRoiMarker(marker))
         {
             ENCODE_CHK_NULL_RETURN(dirtyRoi);
-            dirtyRoi->WriteStreaminData(
-                i, marker, roiRegionIndex, streaminBuffer);
+            ENCODE_CHK_STATUS_RETURN(dirtyRoi->WriteStreaminSpan(
+                spanStart, spanLength, marker, roiRegionIndex, streaminBuffer));
         }
+
+        spanStart = spanEnd;
     }
     return MOS_STATUS_SUCCESS;
 }
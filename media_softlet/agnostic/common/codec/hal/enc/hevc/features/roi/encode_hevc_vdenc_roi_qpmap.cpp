@@ -84,14 +84,40 @@ namespace encode
         RoiOverlap::OverlapMarker marker,
         uint32_t                  roiRegionIndex,
         uint8_t *                 rawStreamIn)
+    {
+        return WriteStreaminSpan(lcuIndex, 1, marker, roiRegionIndex, rawStreamIn);
+    }
+
+    MOS_STATUS QPMapROI::WriteStreaminSpan(
+        uint32_t                  lcuIndex,
+        uint32_t                  lcuCount,
+        RoiOverlap::OverlapMarker marker,
+        uint32_t                  roiRegionIndex,
+        uint8_t *                 rawStreamIn)
     {
         ENCODE_CHK_NULL_RETURN(rawStreamIn);
+
+        uint8_t *QpData = (uint8_t *)m_allocator->LockResourceForRead(&(m_basicFeature->m_mbQpDataSurface.OsResource));
+        ENCODE_CHK_NULL_RETURN(QpData);
+
+        for (uint32_t i = lcuIndex; i < lcuIndex + lcuCount; i++)
+        {
+            WriteStreaminDataPerLcu(i, QpData, rawStreamIn);
+        }
+
+        m_allocator->UnLock(&(m_basicFeature->m_mbQpDataSurface.OsResource));
+        return MOS_STATUS_SUCCESS;
+    }
+
+    void QPMapROI::WriteStreaminDataPerLcu(
+        uint32_t lcuIndex,
+        uint8_t *QpData,
+        uint8_t *rawStreamIn)
+    {
         bool cu64Align = false;
 
         StreamInParams streaminDataParams;
         MOS_ZeroMemory(&streaminDataParams, sizeof(streaminDataParams));
-        uint8_t *QpData = (uint8_t *)m_allocator->LockResourceForRead(&(m_basicFeature->m_mbQpDataSurface.OsResource));
-        ENCODE_CHK_NULL_RETURN(QpData);
 
         uint32_t w_in16 = m_basicFeature->m_mbQpDataSurface.dwWidth;
         uint32_t h_in16 = m_basicFeature->m_mbQpDataSurface.dwHeight;
@@ -100,7 +126,6 @@ namespace encode
         SetRoiCtrlMode(lcuIndex, streaminDataParams, w_in16, h_in16, Pitch, QpData);
         SetQpRoiCtrlPerLcu(&streaminDataParams, (HevcVdencStreamInState *)(rawStreamIn + (lcuIndex * 64)));
 
-        m_allocator->UnLock(&(m_basicFeature->m_mbQpDataSurface.OsResource));
         HevcVdencStreamInState *data = (HevcVdencStreamInState *)(rawStreamIn + (lcuIndex * 64));
 
         if (lcuIndex % 4 == 3)
@@ -118,7 +143,6 @@ namespace encode
                 SetStreaminDataPerLcu(&streaminDataParams, rawStreamIn + (lcuIndex-i) * 64);
             }
         }
-        return MOS_STATUS_SUCCESS;
     }
 
 }  // namespace encode
@@ -104,7 +104,46 @@ namespace encode
             uint32_t                  roiRegionIndex,
             uint8_t *                 rawStreamIn) override;
 
+        //!
+        //! \brief    Write the Streamin data for a run of LCUs.
+        //! \detail   The QP map surface is locked once for the whole run.
+        //! \param    [in] lcuIndex
+        //!           Index of the first LCU in the run
+        //! \param    [in] lcuCount
+        //!           Number of LCUs in the run
+        //! \param    [in] marker
+        //!           overlap marker
+        //! \param    [in] roiRegionIndex
+        //!           Index of ROI region
+        //! \param    [out] streamInBuffer
+        //!           Streamin buffer
+        //! \return   MOS_STATUS
+        //!           MOS_STATUS_SUCCESS if success, else fail reason
+        //!
+        virtual MOS_STATUS WriteStreaminSpan(
+            uint32_t                  lcuIndex,
+            uint32_t                  lcuCount,
+            RoiOverlap::OverlapMarker marker,
+            uint32_t                  roiRegionIndex,
+            uint8_t *                 rawStreamIn) override;
+
+        virtual bool IsStreaminDataPerLcu() const override { return true; }
+
     private:
+        //!
+        //! \brief    Write the Streamin data of one LCU from locked QP map data.
+        //! \param    [in] lcuIndex
+        //!           Index of LCU
+        //! \param    [in] QpData
+        //!           Raw data buffer of QpDataSurface
+        //! \param    [out] rawStreamIn
+        //!           Streamin buffer
+        //! \return   void
+        //!
+        void WriteStreaminDataPerLcu(
+            uint32_t       lcuIndex,
+            uint8_t       *QpData,
+            uint8_t       *rawStreamIn);
 
 
     MEDIA_CLASS_DEFINE_END(encode__QPMapROI)
@@ -257,6 +257,33 @@ MOS_STATUS RoiStrategy::WriteStreaminData(
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS RoiStrategy::WriteStreaminSpan(
+    uint32_t lcuIndex,
+    uint32_t lcuCount,
+    RoiOverlap::OverlapMarker marker,
+    uint32_t roiRegionIndex,
+    uint8_t *rawStreamIn)
+{
+    ENCODE_CHK_NULL_RETURN(rawStreamIn);
+
+    if (IsStreaminDataPerLcu())
+    {
+        for (uint32_t i = lcuIndex; i < lcuIndex + lcuCount; i++)
+        {
+            ENCODE_CHK_STATUS_RETURN(WriteStreaminData(
+                i, marker, roiRegionIndex, rawStreamIn));
+        }
+        return MOS_STATUS_SUCCESS;
+    }
+
+    // Build the first LCU in place, then replicate it over the whole run
+    ENCODE_CHK_STATUS_RETURN(WriteStreaminData(
+        lcuIndex, marker, roiRegionIndex, rawStreamIn));
+    EncodeReplicateBlock(rawStreamIn + lcuIndex * 64, 64, lcuCount);
+
+    return MOS_STATUS_SUCCESS;
+}
+
 void RoiStrategy::SetStreaminParamByTU(
     bool cu64Align,
     StreamInParams &streaminDataParams)
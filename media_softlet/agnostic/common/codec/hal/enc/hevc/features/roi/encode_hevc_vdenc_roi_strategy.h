@@ -257,6 +257,18 @@ public:
     //!
     virtual MOS_STATUS SetupRoi(RoiOverlap &overlap);
 
+    //!
+    //! \brief    Refresh the per frame ROI resources
+    //!
+    //! \detail   Called instead of SetupRoi when the stream-in data of the
+    //!           previous frame is reused, for strategies which still need to
+    //!           fill per frame resources.
+    //!
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    virtual MOS_STATUS RefreshRoi() { return MOS_STATUS_SUCCESS; }
+
     //!
     //! \brief    Write the Streamin data according to marker.
     //! \param    [in] lcuIndex
@@ -275,6 +287,27 @@ public:
         uint32_t roiRegionIndex,
         uint8_t *streamInBuffer);
 
+    //!
+    //! \brief    Write the Streamin data for a run of LCUs with same marker.
+    //! \param    [in] lcuIndex
+    //!           Index of the first LCU in the run
+    //! \param    [in] lcuCount
+    //!           Number of LCUs in the run
+    //! \param    [in] marker
+    //!           overlap marker
+    //! \param    [in] roiRegionIndex
+    //!           Index of ROI region
+    //! \param    [out] streamInBuffer
+    //!           Streamin buffer
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    virtual MOS_STATUS WriteStreaminSpan(uint32_t lcuIndex,
+        uint32_t lcuCount,
+        RoiOverlap::OverlapMarker marker,
+        uint32_t roiRegionIndex,
+        uint8_t *streamInBuffer);
+
     //!
     //! \brief    Set VDENC_PIPE_BUF_ADDR parameters
     //!
@@ -488,6 +521,15 @@ protected:
         StreamInParams *streaminParams,
         HevcVdencStreamInState *data) {}
 
+    //!
+    //! \brief    Whether the streamin data depends on the LCU position
+    //!
+    //! \return   bool
+    //!           true if each LCU must be written individually, false if
+    //!           LCUs with same marker and region share the same data
+    //!
+    virtual bool IsStreaminDataPerLcu() const { return false; }
+
     static constexpr uint8_t m_maxNumRoi             = 16;  //!< VDEnc maximum number of ROI supported
     static constexpr uint8_t m_maxNumNativeRoi       = 3;   //!< Number of native ROI supported by VDEnc HW
     static constexpr uint8_t m_imgStateImePredictors = 8;   //!< Number of predictors for IME
@@ -0,0 +1,68 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     encode_hevc_vdenc_roi_streamin_inputs.h
+//! \brief    Defines the frame level inputs of HEVC VDENC streamin generation
+//!
+
+#ifndef __ENCODE_HEVC_VDENC_ROI_STREAMIN_INPUTS_H__
+#define __ENCODE_HEVC_VDENC_ROI_STREAMIN_INPUTS_H__
+
+#include "encode_utils.h"
+
+namespace encode
+{
+
+//!
+//! \brief    Frame level inputs which the streamin data depends on
+//!
+//! \detail   Variable size inputs, i.e. ROI, dirty rects, tiles and QP map,
+//!           are hashed on top of the hash of this structure.
+//!
+struct HevcVdencStreaminInputs
+{
+    uint32_t frameWidth;
+    uint32_t frameHeight;
+    uint32_t oriFrameHeight;
+    uint8_t  targetUsage;
+    uint8_t  minCodingBlockSize;
+    uint8_t  codingType;
+    int8_t   qpY;
+    int8_t   sliceQpDelta;
+    uint8_t  tilesEnabled;
+    uint8_t  numTileColumns;
+    uint8_t  numTileRows;
+    uint8_t  numRoi;
+    uint8_t  numDirtyRects;
+    uint8_t  roiEnabled;
+    uint8_t  dirtyRoiEnabled;
+    uint8_t  mbQpDataEnabled;
+    uint8_t  vdencHucUsed;      //!< Selects HuC based force QP strategy, which writes different streamin
+
+    HevcVdencStreaminInputs() { MOS_ZeroMemory(this, sizeof(*this)); }
+
+    uint64_t Hash() const { return EncodeHashData(this, sizeof(*this)); }
+};
+
+}  // namespace encode
+
+#endif  // __ENCODE_HEVC_VDENC_ROI_STREAMIN_INPUTS_H__
@@ -169,7 +169,15 @@ namespace encode
         params.function      = BRC_UPDATE;
         params.passNum       = static_cast<uint8_t>(m_pipeline->GetPassNum());
         params.currentPass   = static_cast<uint8_t> (m_pipeline->GetCurrentPass());
-        params.hucDataSource = const_cast<PMOS_RESOURCE> (&m_vdencBrcUpdateDmemBuffer[m_pipeline->m_currRecycledBufIdx][m_pipeline->GetCurrentPass()]);
+        if (m_dmemRingAllocation.resource)
+        {
+            params.hucDataSource       = m_dmemRingAllocation.resource;
+            params.hucDataSourceOffset = m_dmemRingAllocation.offset;
+        }
+        else
+        {
+            params.hucDataSource = const_cast<PMOS_RESOURCE> (&m_vdencBrcUpdateDmemBuffer[m_pipeline->m_currRecycledBufIdx][m_pipeline->GetCurrentPass()]);
+        }
         params.dataLength    = MOS_ALIGN_CEIL(m_vdencBrcUpdateDmemBufferSize, CODECHAL_CACHELINE_SIZE);
         params.dmemOffset    = HUC_DMEM_OFFSET_RTOS_GEMS;
 
@@ -514,16 +522,43 @@ namespace encode
         ENCODE_FUNC_CALL();
         MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
 
-        // Program update DMEM
-        auto hucVdencBrcUpdateDmem =
-            (VdencHevcHucBrcUpdateDmem *)m_allocator->LockResourceForWrite(const_cast<MOS_RESOURCE*>(&m_vdencBrcUpdateDmemBuffer[m_pipeline->m_currRecycledBufIdx][m_pipeline->GetCurrentPass()]));
+        HucBrcUpdatePkt *self       = const_cast<HucBrcUpdatePkt *const>(this);
+        PMOS_RESOURCE    dmemBuffer = const_cast<MOS_RESOURCE *>(&m_vdencBrcUpdateDmemBuffer[m_pipeline->m_currRecycledBufIdx][m_pipeline->GetCurrentPass()]);
+        uint32_t         dmemSize   = MOS_ALIGN_CEIL(m_vdencBrcUpdateDmemBufferSize, CODECHAL_CACHELINE_SIZE);
+
+        // Program update DMEM, in the upload ring if it has space, which needs no lock
+        VdencHevcHucBrcUpdateDmem *hucVdencBrcUpdateDmem = nullptr;
+        MediaUploadRing           *uploadRing            = m_pipeline->GetUploadRing();
+        self->m_dmemRingAllocation                       = {};
+        if (uploadRing && uploadRing->Allocate(dmemSize, CODECHAL_CACHELINE_SIZE, self->m_dmemRingAllocation) == MOS_STATUS_SUCCESS)
+        {
+            hucVdencBrcUpdateDmem = (VdencHevcHucBrcUpdateDmem *)m_dmemRingAllocation.data;
+        }
+        else
+        {
+            self->m_dmemRingAllocation = {};
+            hucVdencBrcUpdateDmem      = (VdencHevcHucBrcUpdateDmem *)m_allocator->LockResourceForWrite(dmemBuffer);
+        }
         ENCODE_CHK_NULL_RETURN(hucVdencBrcUpdateDmem);
         MOS_ZeroMemory(hucVdencBrcUpdateDmem, sizeof(VdencHevcHucBrcUpdateDmem));
 
-        const_cast<HucBrcUpdatePkt* const>(this)->SetCommonDmemBuffer(hucVdencBrcUpdateDmem);
+        self->SetCommonDmemBuffer(hucVdencBrcUpdateDmem);
         SetExtDmemBuffer(hucVdencBrcUpdateDmem);
 
-        m_allocator->UnLock(const_cast<MOS_RESOURCE*>(&m_vdencBrcUpdateDmemBuffer[m_pipeline->m_currRecycledBufIdx][m_pipeline->GetCurrentPass()]));
+        if (m_dmemRingAllocation.resource == nullptr)
+        {
+            m_allocator->UnLock(dmemBuffer);
+        }
+#if USE_CODECHAL_DEBUG_TOOL
+        else
+        {
+            // DMEM dump reads the per pass buffer
+            uint8_t *data = (uint8_t *)m_allocator->LockResourceForWrite(dmemBuffer);
+            ENCODE_CHK_NULL_RETURN(data);
+            MOS_SecureMemcpy(data, dmemSize, m_dmemRingAllocation.data, sizeof(VdencHevcHucBrcUpdateDmem));
+            m_allocator->UnLock(dmemBuffer);
+        }
+#endif
 
         return MOS_STATUS_SUCCESS;
     }
@@ -22,9 +22,26 @@
 
 #include "bitstream_writer.h"
 #include <assert.h>
+#include <string.h>
+#include <algorithm>
+
+//!
+//! \brief  Number of significant bits of v, 0 for 0
+//!
+static inline mfxU32 BitLength(mfxU32 v)
+{
+    static const mfxU8 nibbleLength[16] = {0, 1, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+    mfxU32             n                = 0;
+
+    if (v >> 16) { v >>= 16; n += 16; }
+    if (v >> 8)  { v >>= 8;  n += 8; }
+    if (v >> 4)  { v >>= 4;  n += 4; }
+
+    return n + nibbleLength[v];
+}
 
 BitstreamWriter::BitstreamWriter(mfxU8 *bs, mfxU32 size, mfxU8 bitOffset)
-    : m_bsStart(bs), m_bsEnd(bs + size), m_bs(bs), m_bitStart(bitOffset & 7), m_bitOffset(bitOffset & 7), m_codILow(0)  // cabac variables
+    : m_bsStart(bs), m_bsEnd(bs + size), m_bs(bs), m_bitStart(bitOffset & 7), m_codILow(0)  // cabac variables
       ,
       m_codIRange(510),
       m_bitsOutstanding(0),
@@ -32,127 +49,132 @@ BitstreamWriter::BitstreamWriter(mfxU8 *bs, mfxU32 size, mfxU8 bitOffset)
       m_firstBitFlag(true)
 {
     assert(bitOffset < 8);
-    *m_bs &= 0xFF << (8 - m_bitOffset);
+    LoadPartialByte(m_bitStart);
 }
 
 BitstreamWriter::~BitstreamWriter()
 {
 }
 
+void BitstreamWriter::LoadPartialByte(mfxU8 bitOffset)
+{
+    m_accBits = bitOffset;
+    m_acc     = bitOffset ? (m_bs[0] >> (8 - bitOffset)) : 0;
+}
+
+void BitstreamWriter::Flush()
+{
+    if (!m_accBits)
+        return;
+
+    mfxU64 bits = m_acc << (64 - m_accBits);
+    for (mfxU32 i = 0; i < (m_accBits + 7) >> 3; i++)
+    {
+        m_bs[i] = (mfxU8)(bits >> (56 - 8 * i));
+    }
+}
+
 void BitstreamWriter::Reset(mfxU8 *bs, mfxU32 size, mfxU8 bitOffset)
 {
+    Flush();
+
     if (bs)
     {
-        m_bsStart           = bs;
-        m_bsEnd             = bs + size;
-        unsigned char *curr = m_bsStart;
-        /*
-        while (curr<m_bsEnd)//Not Necessary
-        {
-            *curr = 0;
-            curr++;
-        }
-        */
-        m_bs        = bs;
-        m_bitOffset = (bitOffset & 7);
-        m_bitStart  = (bitOffset & 7);
+        m_bsStart = bs;
+        m_bsEnd   = bs + size;
+        m_bs      = bs;
+        m_bitStart = (bitOffset & 7);
     }
     else
     {
-        m_bs        = m_bsStart;
-        m_bitOffset = m_bitStart;
+        m_bs = m_bsStart;
     }
+    LoadPartialByte(m_bitStart);
 }
 
 void BitstreamWriter::PutBitsBuffer(mfxU32 n, void *bb, mfxU32 o)
-{}
-
-void BitstreamWriter::PutBits(mfxU32 n, mfxU32 b)
 {
-    assert(n <= sizeof(b) * 8);
-    while (n > 24)
+    const mfxU8 *b = (const mfxU8 *)bb + (o >> 3);
+    o &= 7;
+
+    // Leading bits up to the source byte boundary
+    if (o)
     {
-        n -= 16;
-        PutBits(16, (b >> n));
+        mfxU32 lead = std::min(8 - o, n);
+        Append(lead, *b >> (8 - o - lead));
+        n -= lead;
+        b++;
     }
 
-    b <<= (32 - n);
-
-    if (!m_bitOffset)
+    // Bulk copy when the writer is byte aligned, stores the accumulated bytes first
+    if ((m_accBits & 7) == 0 && n >= 64)
     {
-        m_bs[0] = (mfxU8)(b >> 24);
-        m_bs[1] = (mfxU8)(b >> 16);
+        for (; m_accBits; m_accBits -= 8)
+            *m_bs++ = (mfxU8)(m_acc >> (m_accBits - 8));
+
+        mfxU32 bytes = n >> 3;
+        memcpy(m_bs, b, bytes);
+        m_bs += bytes;
+        b += bytes;
+        n &= 7;
     }
-    else
+
+    for (; n >= 32; n -= 32, b += 4)
     {
-        b >>= m_bitOffset;
-        n += m_bitOffset;
+        Append(32, ((mfxU32)b[0] << 24) | ((mfxU32)b[1] << 16) | ((mfxU32)b[2] << 8) | b[3]);
+    }
 
-        m_bs[0] |= (mfxU8)(b >> 24);
-        m_bs[1] = (mfxU8)(b >> 16);
+    for (; n >= 8; n -= 8)
+    {
+        Append(8, *b++);
     }
 
-    if (n > 16)
+    if (n)
     {
-        m_bs[2] = (mfxU8)(b >> 8);
-        m_bs[3] = (mfxU8)b;
+        Append(n, *b >> (8 - n));
     }
+}
 
-    m_bs += (n >> 3);
-    m_bitOffset = (n & 7);
+void BitstreamWriter::PutBits(mfxU32 n, mfxU32 b)
+{
+    assert(n <= sizeof(b) * 8);
+    Append(n, b);
 }
 
 void BitstreamWriter::PutBit(mfxU32 b)
 {
-    switch (m_bitOffset)
-    {
-    case 0:
-        m_bs[0]     = (mfxU8)(b << 7);
-        m_bitOffset = 1;
-        break;
-    case 7:
-        m_bs[0] |= (mfxU8)(b & 1);
-        m_bs++;
-        m_bitOffset = 0;
-        break;
-    default:
-        if (b & 1)
-            m_bs[0] |= (mfxU8)(1 << (7 - m_bitOffset));
-        m_bitOffset++;
-        break;
-    }
+    Append(1, b);
 }
 
 void BitstreamWriter::PutGolomb(mfxU32 b)
 {
-    if (!b)
+    // n - 1 leading zeros, then b + 1 in n bits
+    mfxU64 v = (mfxU64)b + 1;
+    mfxU32 n = (v >> 32) ? 33 : BitLength((mfxU32)v);
+
+    if (n <= 16)
     {
-        PutBit(1);
+        Append(2 * n - 1, v);
     }
     else
     {
-        mfxU32 n = 1;
-
-        b++;
-
-        while (b >> n)
-            n++;
-
-        PutBits(n - 1, 0);
-        PutBits(n, b);
+        Append(n - 1, 0);
+        if (n > 32)
+        {
+            Append(1, 1);
+            n--;
+        }
+        Append(n, v);
     }
 }
 
 void BitstreamWriter::PutTrailingBits(bool bCheckAligened)
 {
-    if ((!bCheckAligened) || m_bitOffset)
+    if ((!bCheckAligened) || (m_accBits & 7))
         PutBit(1);
 
-    if (m_bitOffset)
-    {
-        *(++m_bs)   = 0;
-        m_bitOffset = 0;
-    }
+    if (m_accBits & 7)
+        Append(8 - (m_accBits & 7), 0);
 }
 
 void BitstreamWriter::PutBitC(mfxU32 B)
@@ -162,10 +184,13 @@ void BitstreamWriter::PutBitC(mfxU32 B)
     else
         PutBit(B);
 
+    // Outstanding bits are all the inverse of B, written in chunks
+    mfxU32 inverse = B ? 0 : 0xffffffff;
     while (m_bitsOutstanding > 0)
     {
-        PutBit(1 - B);
-        m_bitsOutstanding--;
+        mfxU32 n = std::min(m_bitsOutstanding, 32u);
+        Append(n, inverse);
+        m_bitsOutstanding -= n;
     }
 }
 void BitstreamWriter::RenormE()
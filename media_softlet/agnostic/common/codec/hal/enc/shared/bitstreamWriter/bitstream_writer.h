@@ -40,7 +40,7 @@ typedef unsigned long mfxUL32;
 typedef long          mfxL32;
 typedef float  mfxF32;
 typedef double mfxF64;
-//typedef __UINT64            mfxU64;
+typedef unsigned long long mfxU64;
 //typedef __INT64             mfxI64;
 typedef void * mfxHDL;
 typedef mfxHDL mfxMemId;
@@ -135,6 +135,12 @@ public:
 MEDIA_CLASS_DEFINE_END(IBsWriter)
 };
 
+//!
+//! \brief  Big endian bit writer
+//! \details Bits are gathered in a 64-bit accumulator and stored to the buffer
+//!          32 bits at a time. Up to 31 bits may be pending in the accumulator,
+//!          call Flush() before reading the buffer. Reset() flushes implicitly.
+//!
 class BitstreamWriter
     : public IBsWriter
 {
@@ -153,11 +159,17 @@ public:
 
     mfxU32 GetOffset()
     {
-        return mfxU32(m_bs - m_bsStart) * 8 + m_bitOffset - m_bitStart;
+        return mfxU32(m_bs - m_bsStart) * 8 + m_accBits - m_bitStart;
     }
     mfxU8 *GetStart() { return m_bsStart; }
     mfxU8 *GetEnd() { return m_bsEnd; }
 
+    //!
+    //! \brief  Store the bits pending in the accumulator to the buffer, the last
+    //!         byte padded with zero bits. The write position is not changed.
+    //!
+    void Flush();
+
     void Reset(mfxU8 *bs = 0, mfxU32 size = 0, mfxU8 bitOffset = 0);
     void cabacInit();
     void EncodeBin(mfxU8 &ctx, mfxU8 binVal);
@@ -177,11 +189,37 @@ public:
 
 private:
     void   RenormE();
+
+    //!
+    //! \brief  Append the low n bits of b, n <= 32
+    //!
+    void Append(mfxU32 n, mfxU64 b)
+    {
+        m_acc = (m_acc << n) | (b & ((1ull << n) - 1));
+        m_accBits += n;
+        if (m_accBits >= 32)
+        {
+            m_accBits -= 32;
+            mfxU32 w = (mfxU32)(m_acc >> m_accBits);
+            m_bs[0]  = (mfxU8)(w >> 24);
+            m_bs[1]  = (mfxU8)(w >> 16);
+            m_bs[2]  = (mfxU8)(w >> 8);
+            m_bs[3]  = (mfxU8)w;
+            m_bs += 4;
+        }
+    }
+
+    //!
+    //! \brief  Load the bits before bitOffset in the byte at m_bs into the accumulator
+    //!
+    void LoadPartialByte(mfxU8 bitOffset);
+
     mfxU8 *m_bsStart;
     mfxU8 *m_bsEnd;
-    mfxU8 *m_bs;
+    mfxU8 *m_bs;           //!< Byte the accumulated bits start at
     mfxU8  m_bitStart;
-    mfxU8  m_bitOffset;
+    mfxU64 m_acc     = 0;  //!< Pending bits, right aligned
+    mfxU32 m_accBits = 0;  //!< Number of pending bits, less than 32
 
     mfxU32                    m_codILow;
     mfxU32                    m_codIRange;
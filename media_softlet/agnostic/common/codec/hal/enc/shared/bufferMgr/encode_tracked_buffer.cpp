@@ -50,6 +50,8 @@ TrackedBuffer::TrackedBuffer(EncodeAllocator *allocator, uint8_t maxRefCnt, uint
 
 TrackedBuffer::~TrackedBuffer()
 {
+    ReportSizeChangeCost();
+
     for (auto it = m_bufferSlots.begin(); it != m_bufferSlots.end(); it++)
     {
         (*it)->Reset();
@@ -63,6 +65,25 @@ TrackedBuffer::~TrackedBuffer()
 
 MOS_STATUS TrackedBuffer::RegisterParam(BufferType type, MOS_ALLOC_GFXRES_PARAMS param)
 {
+    AutoLock lock(m_mutex);
+
+    // take back the queue of old resolution if its resources fit the new one
+    if (m_retirePending && m_bufferQueue.find(type) == m_bufferQueue.end())
+    {
+        auto range = m_oldQueue.equal_range(type);
+        for (auto old = range.first; old != range.second; old++)
+        {
+            if (old->second->Fits(param))
+            {
+                old->second->SetRetired(false);
+                m_bufferQueue.insert(std::make_pair(type, old->second));
+                m_oldQueue.erase(old);
+                m_sizeChangeStats.reusedQueues++;
+                break;
+            }
+        }
+    }
+
     auto iter = m_allocParams.find(type);
     if (iter == m_allocParams.end())
     {
@@ -131,6 +152,11 @@ MOS_STATUS TrackedBuffer::Acquire(
     ENCODE_CHK_NULL_RETURN(refList);
     AutoLock lock(m_mutex);
 
+    if (m_retirePending)
+    {
+        RetireOldQueues();
+    }
+
     //if encouter Idr frame, need to clear the reference slots
     if (isIdrFrame)
     {
@@ -199,11 +225,13 @@ MOS_STATUS TrackedBuffer::Release(CODEC_REF_LIST* refList)
         m_condition.Signal();
     }
 
+    // destroy one idle resource of each retired queue per frame, so that the
+    // old resolution is freed gradually instead of at the switch
     if (!m_oldQueue.empty())
     {
         for (auto iter = m_oldQueue.begin(); iter != m_oldQueue.end();)
         {
-            if (iter->second->SafeToDestory())
+            if (iter->second->IsRetired() && iter->second->TrimIdleResource())
             {
                 iter = m_oldQueue.erase(iter);
             }
@@ -219,26 +247,78 @@ MOS_STATUS TrackedBuffer::Release(CODEC_REF_LIST* refList)
 
 MOS_STATUS TrackedBuffer::OnSizeChange()
 {
-    for (auto iter = m_bufferQueue.begin(); iter != m_bufferQueue.end();)
+    AutoLock lock(m_mutex);
+
+    // nothing is allocated at the old size yet, so there is nothing to keep or retire
+    if (m_bufferQueue.empty())
     {
-        if (iter->second->SafeToDestory())
-        {
-            iter = m_bufferQueue.erase(iter);
-        }
-        else
+        return MOS_STATUS_SUCCESS;
+    }
+
+    ReportSizeChangeCost();
+
+    SizeChangeStats stats = {};
+    stats.sizeChanges     = m_sizeChangeStats.sizeChanges + 1;
+    m_sizeChangeStats     = stats;
+
+    // queues of an earlier change not taken back are retired now
+    if (m_retirePending)
+    {
+        RetireOldQueues();
+    }
+
+    // keep the queues until the new parameters are registered, the ones
+    // fitting the new resolution are taken back without reallocation
+    m_oldQueue.insert(std::make_move_iterator(m_bufferQueue.begin()),
+        std::make_move_iterator(m_bufferQueue.end()));
+    m_bufferQueue.clear();
+    m_retirePending = true;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+void TrackedBuffer::RetireOldQueues()
+{
+    for (auto iter = m_oldQueue.begin(); iter != m_oldQueue.end(); iter++)
+    {
+        if (!iter->second->IsRetired())
         {
-            iter++;
+            iter->second->SetRetired(true);
+            m_sizeChangeStats.retiredQueues++;
         }
     }
+    m_retirePending = false;
+}
+
+void TrackedBuffer::OnResourceAllocated(uint64_t allocTime)
+{
+    AutoLock lock(m_mutex);
+
+    m_sizeChangeStats.allocations++;
+    m_sizeChangeStats.allocTime += allocTime;
+}
 
-    if (!m_bufferQueue.empty())
+TrackedBuffer::SizeChangeStats TrackedBuffer::GetSizeChangeStats()
+{
+    AutoLock lock(m_mutex);
+
+    return m_sizeChangeStats;
+}
+
+void TrackedBuffer::ReportSizeChangeCost()
+{
+    if (m_sizeChangeStats.sizeChanges == 0)
     {
-        m_oldQueue.insert(std::make_move_iterator(m_bufferQueue.begin()),
-            std::make_move_iterator(m_bufferQueue.end()));
-        m_bufferQueue.clear();
+        return;
     }
 
-    return MOS_STATUS_SUCCESS;
+    ENCODE_NORMALMESSAGE("Resolution change %d: %d buffer queues reused, %d retired, %d new, %d allocations in %lld us",
+        m_sizeChangeStats.sizeChanges,
+        m_sizeChangeStats.reusedQueues,
+        m_sizeChangeStats.retiredQueues,
+        m_sizeChangeStats.newQueues,
+        m_sizeChangeStats.allocations,
+        (long long)m_sizeChangeStats.allocTime);
 }
 
 MOS_SURFACE *TrackedBuffer::GetSurface(BufferType type, uint32_t index)
@@ -277,7 +357,20 @@ std::shared_ptr<BufferQueue> TrackedBuffer::GetBufferQueue(BufferType type)
 
         ResourceType resType = GetResourceType(type);
 
-        auto alloc = std::make_shared<BufferQueue>(m_allocator, param->second, m_maxSlotCnt);
+        MOS_ALLOC_GFXRES_PARAMS allocParam = param->second;
+        if (m_sizeChangeStats.sizeChanges > 0)
+        {
+            // resolution changed at least once, leave headroom in buffers so that
+            // they keep fitting when the resolution goes up a little
+            if (resType == ResourceType::bufferResource)
+            {
+                allocParam.dwBytes = MOS_ALIGN_CEIL(
+                    allocParam.dwBytes + (allocParam.dwBytes >> m_bufferHeadroomShift), MOS_PAGE_SIZE);
+            }
+            m_sizeChangeStats.newQueues++;
+        }
+
+        auto alloc = std::make_shared<BufferQueue>(m_allocator, allocParam, m_maxSlotCnt);
         alloc->SetResourceType(resType);
         m_bufferQueue.insert(std::make_pair(type, alloc));
         return alloc;
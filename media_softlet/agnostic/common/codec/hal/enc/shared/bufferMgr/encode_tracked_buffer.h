@@ -80,6 +80,19 @@ class BufferSlot;
 class TrackedBuffer
 {
 public:
+    //!
+    //! \brief  Buffer allocation cost since the last resolution change
+    //!
+    struct SizeChangeStats
+    {
+        uint32_t sizeChanges   = 0;  //!< Resolution changes seen
+        uint32_t reusedQueues  = 0;  //!< Buffer queues kept since the resources fit the new size
+        uint32_t retiredQueues = 0;  //!< Buffer queues retired by the change
+        uint32_t newQueues     = 0;  //!< Buffer queues created since the change
+        uint32_t allocations   = 0;  //!< Resources allocated since the change
+        uint64_t allocTime     = 0;  //!< Time in us spent on allocations since the change
+    };
+
     //!
     //! \brief  Constructor
     //! \param  [in] osInterface
@@ -141,13 +154,22 @@ public:
     MOS_STATUS Release(CODEC_REF_LIST *refList);
 
     //!
-    //! \brief  It must be invoked when resolution changes, it will release
-    //!         internal buffers on demand
+    //! \brief  It must be invoked when resolution changes, before the parameters
+    //!         of the new resolution are registered. Buffer queues whose resources
+    //!         fit the new parameters are kept, the others are retired and their
+    //!         resources are destroyed slot by slot as the slots become free.
+    //!         It is not counted as a size change if no buffer queue is created yet.
     //! \return MOS_STATUS
     //!         MOS_STATUS_SUCCESS if success, else fail reason
     //!
     MOS_STATUS OnSizeChange();
 
+    //!
+    //! \brief  Get the buffer allocation cost since the last resolution change
+    //! \return SizeChangeStats
+    //!
+    SizeChangeStats GetSizeChangeStats();
+
     //!
     //! \brief  Get Surface from given slot
     //! \param  [in]type
@@ -208,6 +230,23 @@ protected:
     //!         shared_ptr<BufferQueue> if success, else nullptr
     std::shared_ptr<BufferQueue> GetBufferQueue(BufferType type);
 
+    //!
+    //! \brief  Account a resource allocated by a slot
+    //! \param  [in]allocTime
+    //!         time in us spent on the allocation
+    //! \return void
+    void OnResourceAllocated(uint64_t allocTime);
+
+    //!
+    //! \brief  Retire the old queues not taken back by the new resolution
+    //! \return void
+    void RetireOldQueues();
+
+    //!
+    //! \brief  Print the allocation cost of the last resolution change
+    //! \return void
+    void ReportSizeChangeCost();
+
     static constexpr MapBufferResourceType m_mapBufferResourceType[] =
     {
         {BufferType::mbCodedBuffer,             ResourceType::bufferResource},
@@ -237,6 +276,9 @@ protected:
     uint8_t m_maxRefSlotCnt     = 0;     //!< max reference slot count in the tracked buffer
     uint8_t m_maxNonRefSlotCnt  = 0;     //!< max non-reference slot count int he tracked buffer
     uint8_t m_currSlotIndex     = 0;     //!< current free slot index
+    bool    m_retirePending     = false; //!< old queues wait for the new parameters registered
+
+    static constexpr uint32_t m_bufferHeadroomShift = 2;  //!< buffers allocated after resolution change get 1/4 headroom
 
     PMOS_MUTEX                m_mutex;                //!< mutex
     Condition                 m_condition;            //!< condition
@@ -245,7 +287,8 @@ protected:
 
     std::map<BufferType, MOS_ALLOC_GFXRES_PARAMS>       m_allocParams = {};  //!< allocate parameters
     std::map<BufferType, std::shared_ptr<BufferQueue> > m_bufferQueue = {};  //!< buffer queues
-    std::map<BufferType, std::shared_ptr<BufferQueue> > m_oldQueue = {};     //!< old queues for resolution change
+    std::multimap<BufferType, std::shared_ptr<BufferQueue> > m_oldQueue = {};  //!< old queues for resolution change
+    SizeChangeStats                                     m_sizeChangeStats = {};  //!< allocation cost of resolution change
 
 MEDIA_CLASS_DEFINE_END(encode__TrackedBuffer)
 };
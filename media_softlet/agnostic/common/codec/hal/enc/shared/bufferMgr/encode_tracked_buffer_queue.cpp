@@ -98,6 +98,13 @@ MOS_STATUS BufferQueue::ReleaseResource(void *resource)
             ENCODE_VERBOSEMESSAGE("resource already returned");
             return MOS_STATUS_INVALID_PARAMETER;
         }
+        if (m_retired)
+        {
+            // resource of old resolution, free it when the slot holding it becomes free
+            m_resources.erase(std::find(m_resources.begin(), m_resources.end(), resource));
+            m_allocCount--;
+            return DestoryResource(resource);
+        }
         m_resourcePool.push_back(resource);
     }
     return MOS_STATUS_SUCCESS;
@@ -110,6 +117,52 @@ bool BufferQueue::SafeToDestory()
     return m_resourcePool.size() == m_resources.size();
 }
 
+bool BufferQueue::Fits(const MOS_ALLOC_GFXRES_PARAMS &param)
+{
+    if (param.Type != m_allocParam.Type ||
+        param.Format != m_allocParam.Format ||
+        param.TileType != m_allocParam.TileType ||
+        param.Flags.bNotLockable != m_allocParam.Flags.bNotLockable ||
+        param.bIsCompressible != m_allocParam.bIsCompressible ||
+        param.CompressionMode != m_allocParam.CompressionMode)
+    {
+        return false;
+    }
+
+    if (m_resourceType == ResourceType::bufferResource)
+    {
+        return param.dwBytes <= m_allocParam.dwBytes;
+    }
+
+    return param.dwWidth == m_allocParam.dwWidth &&
+           param.dwHeight == m_allocParam.dwHeight &&
+           param.dwDepth == m_allocParam.dwDepth &&
+           param.dwArraySize == m_allocParam.dwArraySize;
+}
+
+void BufferQueue::SetRetired(bool retired)
+{
+    AutoLock lock(m_mutex);
+
+    m_retired = retired;
+}
+
+bool BufferQueue::TrimIdleResource()
+{
+    AutoLock lock(m_mutex);
+
+    if (!m_resourcePool.empty())
+    {
+        void *resource = m_resourcePool.back();
+        m_resourcePool.pop_back();
+        m_resources.erase(std::find(m_resources.begin(), m_resources.end(), resource));
+        m_allocCount--;
+        DestoryResource(resource);
+    }
+
+    return m_resources.empty();
+}
+
 
 void *BufferQueue::AllocateResource()
 {
@@ -89,6 +89,36 @@ public:
 
     void SetResourceType(ResourceType resType) { m_resourceType = resType; }
 
+    //!
+    //! \brief  Check whether the resources of the queue can serve the allocate parameter
+    //! \details Buffers fit when they are large enough, surfaces only when the
+    //!          dimensions are the same, since the surface layout follows them
+    //! \param  [in] param
+    //!         reference to MOS_ALLOC_GFXRES_PARAMS
+    //! \return bool
+    //!         true if the resources can be used for param, otherwise return false
+    //!
+    bool Fits(const MOS_ALLOC_GFXRES_PARAMS &param);
+
+    //!
+    //! \brief  Retire the queue after resolution change, resources released back
+    //!         are destroyed instead of pooled
+    //! \param  [in] retired
+    //!         true to retire the queue, false to take it back in use
+    //!
+    void SetRetired(bool retired);
+
+    bool IsRetired() { return m_retired; }
+
+    //!
+    //! \brief  Destroy one idle resource of the queue
+    //! \return bool
+    //!         true if no resource is left in the queue, otherwise return false
+    //!
+    bool TrimIdleResource();
+
+    uint32_t GetAllocCount() { return m_allocCount; }
+
 protected:
     //!
     //! \brief  Allocate resource
@@ -117,6 +147,7 @@ protected:
     std::vector<void *>        m_resources    = {};         //!< all allocated resources
 
     ResourceType m_resourceType = ResourceType::bufferResource;
+    bool         m_retired      = false;    //!< resources are destroyed on release
 
 MEDIA_CLASS_DEFINE_END(encode__BufferQueue)
 };
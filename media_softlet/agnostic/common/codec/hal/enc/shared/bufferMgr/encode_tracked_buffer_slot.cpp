@@ -27,6 +27,7 @@
 #include "encode_tracked_buffer_slot.h"
 #include <utility>
 #include "encode_tracked_buffer_queue.h"
+#include "mos_utilities.h"
 
 namespace encode {
 
@@ -81,7 +82,13 @@ void *BufferSlot::GetResource(BufferType type)
         return nullptr;
     }
 
+    uint32_t allocCount = queue->GetAllocCount();
+    uint64_t startTime  = MosUtilities::MosGetCurTime();
     void* resource = queue->AcquireResource();
+    if (queue->GetAllocCount() != allocCount)
+    {
+        m_tracker->OnResourceAllocated(MosUtilities::MosGetCurTime() - startTime);
+    }
     // record the surface acquired, only one surface for each type should be kept in the slot
     m_buffers.insert(std::make_pair(type, resource));
     m_bufferQueues.insert(std::make_pair(type, queue));
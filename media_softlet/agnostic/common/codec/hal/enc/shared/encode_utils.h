@@ -186,6 +186,127 @@ MOS_STATUS EncodeFreeDataList(type **dataList, uint32_t length)
     return MOS_STATUS_SUCCESS;
 }
 
+//!
+//! \brief    Replicate the first block of a buffer to the following blocks
+//!
+//! \detail   The copy size doubles on each step, so a run of N blocks costs
+//!           log2(N) memcpy calls instead of N per-block writes.
+//!
+//! \param    [in,out] data
+//!           Buffer whose first block is already filled
+//! \param    [in] blockSize
+//!           Size of one block in bytes
+//! \param    [in] blockCount
+//!           Number of blocks in the buffer, including the first one
+//!
+//! \return   void
+//!
+inline void EncodeReplicateBlock(uint8_t *data, uint32_t blockSize, uint32_t blockCount)
+{
+    if (data == nullptr || blockCount <= 1)
+    {
+        return;
+    }
+
+    uint32_t totalSize  = blockSize * blockCount;
+    uint32_t filledSize = blockSize;
+    while (filledSize < totalSize)
+    {
+        uint32_t copySize = MOS_MIN(filledSize, totalSize - filledSize);
+        MOS_SecureMemcpy(data + filledSize, copySize, data, copySize);
+        filledSize += copySize;
+    }
+}
+
+//!
+//! \brief    Accumulate data into a 64 bit FNV-1a hash
+//!
+//! \param    [in] data
+//!           Data to be hashed
+//! \param    [in] size
+//!           Size of data in bytes
+//! \param    [in] hash
+//!           Hash of the previous data, or the FNV offset basis to start
+//!
+//! \return   uint64_t
+//!           Updated hash value
+//!
+inline uint64_t EncodeHashData(const void *data, uint32_t size, uint64_t hash = 0xcbf29ce484222325ULL)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    if (bytes == nullptr)
+    {
+        return hash;
+    }
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+//!
+//! \class    EncodeCachedHash
+//!
+//! \brief    Keeps the hash of a large input, such as a QP map, across frames
+//!
+//! \detail   The input is rehashed only when the framework signals it may have
+//!           changed or when a different resource is passed, so that unchanged
+//!           inputs are not locked and read on every frame.
+//!
+class EncodeCachedHash
+{
+public:
+    //!
+    //! \brief    Get hash of the input, rehash it if needed
+    //!
+    //! \param    [in] identity
+    //!           Identity of the input, e.g. its gmm resource info
+    //! \param    [in] changed
+    //!           false only if the input is known to be unchanged since previous call
+    //! \param    [in] hashFunc
+    //!           Callable of MOS_STATUS(uint64_t &hash) hashing the input
+    //! \param    [out] hash
+    //!           Hash of the input
+    //!
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    template <class HashFunc>
+    MOS_STATUS Get(const void *identity, bool changed, HashFunc hashFunc, uint64_t &hash)
+    {
+        if (!m_valid || changed || identity != m_identity)
+        {
+            m_valid           = false;
+            MOS_STATUS status = hashFunc(m_hash);
+            if (status != MOS_STATUS_SUCCESS)
+            {
+                return status;
+            }
+            m_identity = identity;
+            m_valid    = true;
+            m_hashCount++;
+        }
+
+        hash = m_hash;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    void Invalidate() { m_valid = false; }
+
+    uint32_t GetHashCount() const { return m_hashCount; }
+
+protected:
+    const void *m_identity  = nullptr;
+    uint64_t    m_hash      = 0;
+    bool        m_valid     = false;
+    uint32_t    m_hashCount = 0;  //!< Times the input was actually hashed
+
+MEDIA_CLASS_DEFINE_END(encode__EncodeCachedHash)
+};
+
 }
 
 #define ENCODE_FUNC_CALL() encode::Trace trace(__FUNCTION__);
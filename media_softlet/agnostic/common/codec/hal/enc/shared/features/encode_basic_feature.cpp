@@ -163,6 +163,7 @@ MOS_STATUS EncodeBasicFeature::Update(void *params)
 
     m_mbDisableSkipMapEnabled          = encodeParams->bMbDisableSkipMapEnabled;
     m_mbQpDataEnabled                  = encodeParams->bMbQpDataEnabled;
+    m_mbQpDataUnchanged                = encodeParams->bMbQpDataUnchanged;
 
     if (encodeParams->bMbQpDataEnabled && encodeParams->psMbQpDataSurface != nullptr)
     {
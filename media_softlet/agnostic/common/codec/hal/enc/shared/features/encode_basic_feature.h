@@ -160,6 +160,7 @@ public:
 
     uint32_t                    m_bitstreamSize = 0;               //!< Maximum amount of data to be output to presBitstreamBuffer.
     bool                        m_mbQpDataEnabled = false;         //!< [AVC & MPEG2] Indicates that psMbQpDataSurface is present.
+    bool                        m_mbQpDataUnchanged = false;       //!< [HEVC] Mb QP Data is known to be unchanged since previous frame.
     bool                        m_mbDisableSkipMapEnabled = false; //!< [AVC] Indicates that psMbDisableSkipMapSurface is present.
     MOS_SURFACE                 m_mbDisableSkipMapSurface = {};    //!< [AVC] MB disable skip map provided by framework
     MOS_SURFACE                 m_mbQpDataSurface = {};            //!< pointer to surface of Mb QP Data
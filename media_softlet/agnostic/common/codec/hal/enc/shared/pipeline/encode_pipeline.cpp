@@ -327,6 +327,7 @@ MOS_STATUS EncodePipeline::ExecuteActivePackets()
     }
 
     m_activePacketList.clear();
+    ENCODE_CHK_STATUS_RETURN(SubmitUploadRings());
     MOS_TraceEventExt(EVENT_PIPE_EXE, EVENT_TYPE_END, nullptr, 0, nullptr, 0);
     return MOS_STATUS_SUCCESS;
 }
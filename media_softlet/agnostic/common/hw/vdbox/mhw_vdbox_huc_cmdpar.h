@@ -90,6 +90,7 @@ struct _MHW_PAR_T(HUC_DMEM_STATE)
     uint32_t      dataLength    = 0;        // length in bytes of the HUC data. Must be in increments of 64B
     uint32_t      dmemOffset    = 0;        // DMEM offset in the HuC Kernel. This is different for ViperOS vs GEMS.
     PMOS_RESOURCE hucDataSource = nullptr;  // resource for HuC data source
+    uint32_t      hucDataSourceOffset = 0;  // offset of HuC data in the resource. Must be 64B aligned
 };
 
 struct _MHW_PAR_T(HUC_VIRTUAL_ADDR_STATE)
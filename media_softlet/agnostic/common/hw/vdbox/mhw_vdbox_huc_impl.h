@@ -249,7 +249,7 @@ protected:
         if (!Mos_ResourceIsNull(params.hucDataSource))
         {
             resourceParams.presResource    = params.hucDataSource;
-            resourceParams.dwOffset        = 0;
+            resourceParams.dwOffset        = params.hucDataSourceOffset;
             resourceParams.pdwCmd          = (cmd.HucDataSourceBaseAddress.DW0_1.Value);
             resourceParams.dwLocationInCmd = _MHW_CMD_DW_LOCATION(HucDataSourceBaseAddress);
             resourceParams.bIsWritable     = false;
@@ -38,6 +38,9 @@ void OsContextNext::CleanUp()
 {
     MOS_OS_FUNCTION_ENTER;
 
+    // Resources kept for the device are freed while its managers are still alive.
+    RunReleaseCallbacks();
+
 #ifdef _MMC_SUPPORTED
     MOS_Delete(m_mosDecompression);
 #endif
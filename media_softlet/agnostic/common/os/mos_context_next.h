@@ -27,6 +27,8 @@
 #ifndef __MOS_CONTEXT_NEXT_H__
 #define __MOS_CONTEXT_NEXT_H__
 
+#include <mutex>
+#include <vector>
 #include "mos_os.h"
 #include "mos_cmdbufmgr_next.h" 
 #include "mos_gpucontextmgr_next.h"
@@ -190,7 +192,50 @@ public:
     //!
     bool IsAynchronous() { return m_aynchronousDevice; }
 
+    //!
+    //! \brief  Function called before the device is cleaned up
+    //!
+    typedef void (*ReleaseCallback)(OsContextNext *osContext, void *data);
+
+    //!
+    //! \brief  Register a function called before the device is cleaned up
+    //! \details Components keeping resources of the device beyond their sessions free them there.
+    //!          Registering the same function and data again has no effect.
+    //! \param   [in] callback
+    //!          Function to call
+    //! \param   [in] data
+    //!          Data passed to callback
+    //!
+    void RegisterReleaseCallback(ReleaseCallback callback, void *data)
+    {
+        std::lock_guard<std::mutex> lock(m_releaseCallbackMutex);
+        for (auto &registered : m_releaseCallbacks)
+        {
+            if (registered.first == callback && registered.second == data)
+            {
+                return;
+            }
+        }
+        m_releaseCallbacks.push_back(std::make_pair(callback, data));
+    }
+
 protected:
+    //!
+    //! \brief  Call the registered release callbacks, in the reverse order of registration
+    //!
+    void RunReleaseCallbacks()
+    {
+        std::vector<std::pair<ReleaseCallback, void *>> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(m_releaseCallbackMutex);
+            callbacks.swap(m_releaseCallbacks);
+        }
+        for (auto it = callbacks.rbegin(); it != callbacks.rend(); ++it)
+        {
+            it->first(this, it->second);
+        }
+    }
+
     //!
     //! \brief  Destory the OS ContextNext Object, internal function, called by cleanup
     //!
@@ -255,6 +300,10 @@ protected:
 
     //!< Indicate if this device is working in aync mode or normal mode
     bool                            m_aynchronousDevice = false;
+
+    //! \brief  Functions called before the device is cleaned up, with their data
+    std::vector<std::pair<ReleaseCallback, void *>> m_releaseCallbacks;
+    std::mutex                      m_releaseCallbackMutex;
 MEDIA_CLASS_DEFINE_END(OsContextNext)
 };
 #endif // #ifndef __MOS_CONTEXTNext_NEXT_H__
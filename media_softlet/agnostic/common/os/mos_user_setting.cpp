@@ -115,6 +115,20 @@ MOS_STATUS MosUserSetting::InitMosCommonUserSetting(MediaUserSettingSharedPtr us
         0,
         true); //"TRUE for Enabling Vebox Scalability. (Default FALSE: disabled)"
 
+    DeclareUserSettingKey(  //TRUE to place VDBox sessions by session count ping-pong instead of load. (Default FALSE)
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_DISABLE_VDBOX_LOAD_AWARE_SCHEDULING,
+        MediaUserSetting::Group::Device,
+        0,
+        false);
+
+    DeclareUserSettingKey(  //TRUE to copy the GMM layout of repeated surface and buffer allocations. (Default FALSE)
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_ENABLE_GMM_RESINFO_CACHE,
+        MediaUserSetting::Group::Device,
+        0,
+        false);
+
     DeclareUserSettingKey(
         userSettingPtr,
         __MEDIA_USER_FEATURE_VALUE_ENABLE_HCP_SCALABILITY_DECODE,
@@ -701,6 +715,13 @@ MOS_STATUS MosUserSetting::InitUserSettingForDebug(MediaUserSettingSharedPtr use
         0,
         true); // "Enable NULL HW or not"
 
+    DeclareUserSettingKeyForDebug(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_NULLHW_CPU_REPORT,
+        MediaUserSetting::Group::Device,
+        "",
+        true); // "File the per layer CPU cost is reported to in NULL HW mode, log if empty"
+
     DeclareUserSettingKeyForDebug(
         userSettingPtr,
         __MEDIA_USER_FEATURE_VALUE_MOCKADAPTOR_PLATFORM,
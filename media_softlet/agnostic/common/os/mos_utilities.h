@@ -1699,6 +1699,17 @@ public:
     //!
     static MOS_STATUS MosUnlockMutex(PMOS_MUTEX pMutex);
 
+    //!
+    //! \brief    Account a contended mutex lock
+    //! \details  Called when a mutex is found held by another thread on lock, only
+    //!           if m_mosCostAccounting is set.
+    //!           Updates m_mosLockContentionCounter and m_mosLockWaitTime.
+    //! \param    [in] waitTime
+    //!           Time in us blocked on the mutex
+    //! \return   void
+    //!
+    static void MosLockContended(uint64_t waitTime);
+
     //!
     //! \brief    Creates or opens a semaphore object and returns a handle to the object
     //! \details  Creates or opens a semaphore object and returns a handle to the object
@@ -2665,6 +2676,11 @@ public:
     static int32_t                      m_mosMemAllocFakeCounter;
     static int32_t                      m_mosMemAllocCounterGfx;
 
+    static bool                         m_mosCostAccounting;         // count allocations and contended locks, only set in NULL HW mode
+    static int32_t                      m_mosMemAllocTotalCounter;   // allocations made, not decremented on free
+    static int32_t                      m_mosLockContentionCounter;  // contended mutex locks
+    static uint64_t                     m_mosLockWaitTime;           // us blocked on contended mutex locks
+
     static bool                         m_enableAddressDump;
 
     static MOS_USER_FEATURE_VALUE       m_mosUserFeatureDescFields[__MOS_USER_FEATURE_KEY_MAX_ID];
@@ -2761,6 +2777,10 @@ _Ty* MosUtilities::MosNewUtil(_Types&&... _Args)
     if (ptr != nullptr)
     {
         MosAtomicIncrement(&m_mosMemAllocCounter);
+        if (m_mosCostAccounting)
+        {
+            MosAtomicIncrement(&m_mosMemAllocTotalCounter);
+        }
         MOS_MEMNINJA_ALLOC_MESSAGE(ptr, sizeof(_Ty), functionName, filename, line);
     }
     else
@@ -2791,6 +2811,10 @@ _Ty* MosUtilities::MosNewArrayUtil(size_t numElements)
     if (ptr != nullptr)
     {
         MosAtomicIncrement(&m_mosMemAllocCounter);
+        if (m_mosCostAccounting)
+        {
+            MosAtomicIncrement(&m_mosMemAllocTotalCounter);
+        }
         MOS_MEMNINJA_ALLOC_MESSAGE(ptr, numElements*sizeof(_Ty), functionName, filename, line);
     }
     return ptr;
@@ -43,6 +43,11 @@ int32_t MosUtilities::m_mosMemAllocCounter                         = 0;
 int32_t MosUtilities::m_mosMemAllocFakeCounter                     = 0;
 int32_t MosUtilities::m_mosMemAllocCounterGfx                      = 0;
 
+bool MosUtilities::m_mosCostAccounting                             = false;
+int32_t MosUtilities::m_mosMemAllocTotalCounter                    = 0;
+int32_t MosUtilities::m_mosLockContentionCounter                   = 0;
+uint64_t MosUtilities::m_mosLockWaitTime                           = 0;
+
 bool MosUtilities::m_enableAddressDump = false;
 
 MOS_FUNC_EXPORT void MosUtilities::MosSetUltFlag(uint8_t ultFlag)
@@ -291,6 +296,10 @@ void  *MosUtilities::MosAlignedAllocMemory(
     if(ptr != nullptr)
     {
         MosAtomicIncrement(&m_mosMemAllocCounter);
+        if (m_mosCostAccounting)
+        {
+            MosAtomicIncrement(&m_mosMemAllocTotalCounter);
+        }
         MOS_MEMNINJA_ALLOC_MESSAGE(ptr, size, functionName, filename, line);
     }
 
@@ -344,6 +353,10 @@ void *MosUtilities::MosAllocMemory(size_t size)
     if(ptr != nullptr)
     {
         MosAtomicIncrement(&m_mosMemAllocCounter);
+        if (m_mosCostAccounting)
+        {
+            MosAtomicIncrement(&m_mosMemAllocTotalCounter);
+        }
         MOS_MEMNINJA_ALLOC_MESSAGE(ptr, size, functionName, filename, line);
     }
 
@@ -378,6 +391,10 @@ void *MosUtilities::MosAllocAndZeroMemory(size_t size)
         MosZeroMemory(ptr, size);
 
         MosAtomicIncrement(&m_mosMemAllocCounter);
+        if (m_mosCostAccounting)
+        {
+            MosAtomicIncrement(&m_mosMemAllocTotalCounter);
+        }
         MOS_MEMNINJA_ALLOC_MESSAGE(ptr, size, functionName, filename, line);
     }
 
@@ -423,6 +440,10 @@ void *MosUtilities::MosReallocMemory(
         if (newPtr != nullptr)
         {
             MosAtomicIncrement(&m_mosMemAllocCounter);
+            if (m_mosCostAccounting)
+            {
+                MosAtomicIncrement(&m_mosMemAllocTotalCounter);
+            }
             MOS_MEMNINJA_ALLOC_MESSAGE(newPtr, newSize, functionName, filename, line);
         }
     }
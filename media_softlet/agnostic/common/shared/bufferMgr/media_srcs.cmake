@@ -21,11 +21,13 @@
 set(TMP_SOURCES_
     ${TMP_SOURCES_}
     ${CMAKE_CURRENT_LIST_DIR}/media_allocator.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/media_upload_ring.cpp
 )
 
 set(TMP_HEADERS_
     ${TMP_HEADERS_}
     ${CMAKE_CURRENT_LIST_DIR}/media_allocator.h
+    ${CMAKE_CURRENT_LIST_DIR}/media_upload_ring.h
 )
 
 media_add_curr_to_include_path()
@@ -0,0 +1,211 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_upload_ring.cpp
+//! \brief    Defines the ring buffer for per frame inputs written by CPU
+//!
+#include "media_upload_ring.h"
+
+MediaUploadRing::MediaUploadRing(PMOS_INTERFACE osInterface) : m_osInterface(osInterface)
+{
+}
+
+MediaUploadRing::~MediaUploadRing()
+{
+    Destroy();
+}
+
+MOS_STATUS MediaUploadRing::Create(uint32_t size, const char *name)
+{
+    MOS_OS_CHK_NULL_RETURN(m_osInterface);
+
+    if (IsValid())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    if (size == 0)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    MOS_ALLOC_GFXRES_PARAMS param;
+    MOS_ZeroMemory(&param, sizeof(MOS_ALLOC_GFXRES_PARAMS));
+    param.Type     = MOS_GFXRES_BUFFER;
+    param.TileType = MOS_TILE_LINEAR;
+    param.Format   = Format_Buffer;
+    param.dwBytes  = MOS_ALIGN_CEIL(size, MOS_PAGE_SIZE);
+    param.pBufName = name;
+    // keeping ring persistent since it is referenced by all command buffers
+    param.bIsPersistent = true;
+
+    MOS_OS_CHK_STATUS_RETURN(m_osInterface->pfnAllocateResource(m_osInterface, &param, &m_resource));
+
+    // Suballocations are synchronized by frame fence instead of resource sync
+    MOS_STATUS status = m_osInterface->pfnSkipResourceSync(&m_resource);
+    if (status != MOS_STATUS_SUCCESS)
+    {
+        m_osInterface->pfnFreeResource(m_osInterface, &m_resource);
+        return status;
+    }
+
+    MOS_LOCK_PARAMS lockFlags;
+    MOS_ZeroMemory(&lockFlags, sizeof(MOS_LOCK_PARAMS));
+    lockFlags.WriteOnly = 1;
+    lockFlags.Uncached  = 1;
+
+    m_data = (uint8_t *)m_osInterface->pfnLockResource(m_osInterface, &m_resource, &lockFlags);
+    if (m_data == nullptr)
+    {
+        m_osInterface->pfnFreeResource(m_osInterface, &m_resource);
+        return MOS_STATUS_NULL_POINTER;
+    }
+
+    m_size         = param.dwBytes;
+    m_head         = 0;
+    m_used         = 0;
+    m_pendingBytes = 0;
+    m_framesInFlight.clear();
+    m_stats        = {};
+    m_stats.size   = m_size;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MediaUploadRing::Destroy()
+{
+    if (!IsValid())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_OS_CHK_NULL_RETURN(m_osInterface);
+
+    MOS_OS_NORMALMESSAGE("Upload ring size %d, peak used %d, allocations %llu, overflows %llu.",
+        m_stats.size, m_stats.peakUsed, (unsigned long long)m_stats.allocations, (unsigned long long)m_stats.overflows);
+
+    m_osInterface->pfnUnlockResource(m_osInterface, &m_resource);
+    m_osInterface->pfnFreeResource(m_osInterface, &m_resource);
+    m_data = nullptr;
+    m_size = 0;
+    m_framesInFlight.clear();
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MediaUploadRing::Allocate(uint32_t size, uint32_t alignment, Allocation &allocation)
+{
+    MOS_OS_CHK_NULL_RETURN(m_data);
+
+    if (size == 0 || alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    uint32_t offset = MOS_ALIGN_CEIL(m_head, alignment);
+    if ((uint64_t)offset + size > m_size)
+    {
+        // Skip the tail of the ring, which is owned by current frame until recycled
+        offset = 0;
+    }
+
+    uint32_t padding = (offset >= m_head) ? (offset - m_head) : (m_size - m_head);
+    if ((uint64_t)m_used + padding + size > m_size)
+    {
+        m_stats.overflows++;
+        MOS_OS_VERBOSEMESSAGE("Upload ring is full, used %d, requested %d.", m_used, size);
+        return MOS_STATUS_NO_SPACE;
+    }
+
+    m_head = offset + size;
+    if (m_head == m_size)
+    {
+        m_head = 0;
+    }
+    m_used         += padding + size;
+    m_pendingBytes += padding + size;
+
+    allocation.resource = &m_resource;
+    allocation.offset   = offset;
+    allocation.size     = size;
+    allocation.data     = m_data + offset;
+
+    m_stats.allocations++;
+    m_stats.allocatedBytes += size;
+    m_stats.used     = m_used;
+    m_stats.peakUsed = MOS_MAX(m_stats.peakUsed, m_used);
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MediaUploadRing::Submit(uint32_t fence)
+{
+    if (m_pendingBytes == 0)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    if (!m_framesInFlight.empty() && m_framesInFlight.back().fence == fence)
+    {
+        // Several submissions of one frame
+        m_framesInFlight.back().bytes += m_pendingBytes;
+    }
+    else
+    {
+        Frame frame;
+        frame.fence = fence;
+        frame.bytes = m_pendingBytes;
+        m_framesInFlight.push_back(frame);
+    }
+    m_pendingBytes = 0;
+
+    m_stats.framesInFlight = (uint32_t)m_framesInFlight.size();
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MediaUploadRing::Recycle(uint32_t completedFence)
+{
+    while (!m_framesInFlight.empty())
+    {
+        const Frame &frame = m_framesInFlight.front();
+        // Compare in signed distance to handle the wrap around of fence value
+        if ((int32_t)(completedFence - frame.fence) < 0)
+        {
+            break;
+        }
+        m_used -= frame.bytes;
+        m_framesInFlight.pop_front();
+        m_stats.recycledFrames++;
+    }
+
+    if (m_used == 0)
+    {
+        // Restart from the beginning to reduce the padding at wrap around
+        m_head = 0;
+    }
+
+    m_stats.used           = m_used;
+    m_stats.framesInFlight = (uint32_t)m_framesInFlight.size();
+
+    return MOS_STATUS_SUCCESS;
+}
@@ -0,0 +1,166 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_upload_ring.h
+//! \brief    Defines the ring buffer for per frame inputs written by CPU
+//! \details  The ring is a linear buffer which is locked once on creation and kept
+//!           mapped. Per frame inputs are suballocated from it and written through
+//!           the CPU address directly, without lock, unlock or implicit sync. The
+//!           suballocations of a frame are recycled when the fence of the frame
+//!           is completed.
+//!
+
+#ifndef __MEDIA_UPLOAD_RING_H__
+#define __MEDIA_UPLOAD_RING_H__
+
+#include <stdint.h>
+#include <deque>
+#include "mos_defs.h"
+#include "mos_os.h"
+#include "media_class_trace.h"
+
+class MediaUploadRing
+{
+public:
+    //!
+    //! \brief  Suballocation in the ring
+    //!
+    struct Allocation
+    {
+        PMOS_RESOURCE resource = nullptr;  //!< Resource of the ring, to be referenced by commands
+        uint32_t      offset   = 0;        //!< Offset of the suballocation in resource
+        uint32_t      size     = 0;        //!< Size of the suballocation
+        uint8_t       *data    = nullptr;  //!< CPU address of the suballocation
+    };
+
+    //!
+    //! \brief  Occupancy statistics of the ring
+    //!
+    struct Statistics
+    {
+        uint32_t size           = 0;  //!< Size of the ring
+        uint32_t used           = 0;  //!< Bytes in use, including alignment and wrap padding
+        uint32_t peakUsed       = 0;  //!< Peak of used bytes
+        uint32_t framesInFlight = 0;  //!< Submitted frames not completed yet
+        uint64_t allocations    = 0;  //!< Number of successful suballocations
+        uint64_t allocatedBytes = 0;  //!< Total bytes handed out by successful suballocations
+        uint64_t overflows      = 0;  //!< Number of suballocations failed for no space
+        uint64_t recycledFrames = 0;  //!< Number of frames recycled
+    };
+
+    //!
+    //! \brief  Constructor
+    //! \param  [in] osInterface
+    //!         Pointer to MOS_INTERFACE
+    //!
+    MediaUploadRing(PMOS_INTERFACE osInterface);
+
+    //!
+    //! \brief  Destructor
+    //!
+    virtual ~MediaUploadRing();
+
+    //!
+    //! \brief  Allocate the ring buffer and map it persistently
+    //! \param  [in] size
+    //!         Size of the ring in bytes
+    //! \param  [in] name
+    //!         Name of the ring buffer
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Create(uint32_t size, const char *name);
+
+    //!
+    //! \brief  Unmap and free the ring buffer
+    //! \details The caller should make sure GPU does not access the ring any more.
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Destroy();
+
+    //!
+    //! \brief  Suballocate from the ring for current frame
+    //! \param  [in] size
+    //!         Size in bytes
+    //! \param  [in] alignment
+    //!         Alignment of the offset, must be power of 2
+    //! \param  [out] allocation
+    //!         Suballocation, valid until the fence of current frame is completed
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, MOS_STATUS_NO_SPACE if the ring is full,
+    //!         in which case the caller should fall back to its own resource
+    //!
+    MOS_STATUS Allocate(uint32_t size, uint32_t alignment, Allocation &allocation);
+
+    //!
+    //! \brief  Close current frame
+    //! \details Suballocations since last submission are owned by the frame and
+    //!          will be recycled after fence is completed.
+    //! \param  [in] fence
+    //!         Fence value which will be reached when the frame is done on GPU
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Submit(uint32_t fence);
+
+    //!
+    //! \brief  Recycle the suballocations of completed frames
+    //! \param  [in] completedFence
+    //!         Fence value completed by GPU
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Recycle(uint32_t completedFence);
+
+    //!
+    //! \brief  Get occupancy statistics
+    //! \return const Statistics &
+    //!
+    const Statistics &GetStatistics() const { return m_stats; }
+
+    //!
+    //! \brief  Check whether the ring has been created
+    //! \return bool
+    //!
+    bool IsValid() const { return m_data != nullptr; }
+
+protected:
+    struct Frame
+    {
+        uint32_t fence = 0;
+        uint32_t bytes = 0;  //!< Bytes owned by the frame, including padding
+    };
+
+    PMOS_INTERFACE      m_osInterface  = nullptr;
+    MOS_RESOURCE        m_resource     = {};
+    uint8_t             *m_data        = nullptr;   //!< Persistent CPU address of the ring
+    uint32_t            m_size         = 0;
+    uint32_t            m_head         = 0;         //!< Offset of next suballocation
+    uint32_t            m_used         = 0;         //!< Bytes owned by pending and in flight frames
+    uint32_t            m_pendingBytes = 0;         //!< Bytes owned by current frame
+    std::deque<Frame>   m_framesInFlight;
+    Statistics          m_stats        = {};
+
+MEDIA_CLASS_DEFINE_END(MediaUploadRing)
+};
+#endif  // !__MEDIA_UPLOAD_RING_H__
@@ -0,0 +1,455 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_debug_async_dumper.cpp
+//! \brief    Defines the asynchronous dumper of the media debug interface
+//!
+
+#include "media_debug_interface.h"
+#if USE_MEDIA_DEBUG_TOOL
+#include "media_debug_async_dumper.h"
+
+MediaDebugAsyncDumper::MediaDebugAsyncDumper(PMOS_INTERFACE osInterface) : m_osInterface(osInterface)
+{
+}
+
+MediaDebugAsyncDumper::~MediaDebugAsyncDumper()
+{
+    if (m_started)
+    {
+        // Copied requests are locked and written, and their staging unlocked here
+        Flush();
+
+        MosUtilities::MosLockMutex(m_mutex);
+        m_exit = true;
+        MosUtilities::MosUnlockMutex(m_mutex);
+
+        // Worker thread exits once the queue is empty
+        MosUtilities::MosPostSemaphore(m_requestSem, 1);
+        MosUtilities::MosWaitThread(m_thread);
+
+        MEDIA_DEBUG_NORMALMESSAGE("Async dump submitted %llu, written %llu, dropped %llu, failed %llu, peak staging size %llu.",
+            (unsigned long long)m_stats.submitted,
+            (unsigned long long)m_stats.written,
+            (unsigned long long)m_stats.dropped,
+            (unsigned long long)m_stats.failed,
+            (unsigned long long)m_stats.peakStagingSize);
+    }
+
+    for (auto staging : m_stagingPool)
+    {
+        m_osInterface->pfnFreeResource(m_osInterface, &staging->surface.OsResource);
+        MOS_Delete(staging);
+    }
+    m_stagingPool.clear();
+
+    if (m_idleSem)
+    {
+        MosUtilities::MosDestroySemaphore(m_idleSem);
+    }
+    if (m_requestSem)
+    {
+        MosUtilities::MosDestroySemaphore(m_requestSem);
+    }
+    if (m_mutex)
+    {
+        MosUtilities::MosDestroyMutex(m_mutex);
+    }
+}
+
+MOS_STATUS MediaDebugAsyncDumper::Init(uint64_t budget, uint32_t maxQueueDepth)
+{
+    MEDIA_DEBUG_CHK_NULL(m_osInterface);
+
+    if (m_started)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    m_budget        = budget;
+    m_maxQueueDepth = MOS_MAX(maxQueueDepth, 1);
+
+    m_mutex = MosUtilities::MosCreateMutex();
+    MEDIA_DEBUG_CHK_NULL(m_mutex);
+    m_requestSem = MosUtilities::MosCreateSemaphore(0, m_maxQueueDepth + 1);
+    MEDIA_DEBUG_CHK_NULL(m_requestSem);
+    m_idleSem = MosUtilities::MosCreateSemaphore(0, 1);
+    MEDIA_DEBUG_CHK_NULL(m_idleSem);
+
+    m_thread = MosUtilities::MosCreateThread((void *)WorkerThread, this);
+    if (m_thread == 0)
+    {
+        MEDIA_DEBUG_ASSERTMESSAGE("Failed to create async dump thread.");
+        return MOS_STATUS_UNKNOWN;
+    }
+    m_started = true;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+void MediaDebugAsyncDumper::FreeIdleStaging(uint64_t sizeNeeded)
+{
+    for (auto it = m_stagingPool.begin();
+         it != m_stagingPool.end() && m_stats.stagingSize + sizeNeeded > m_budget;)
+    {
+        Staging *staging = *it;
+        if (staging->busy)
+        {
+            ++it;
+            continue;
+        }
+        m_stats.stagingSize -= staging->size;
+        m_osInterface->pfnFreeResource(m_osInterface, &staging->surface.OsResource);
+        MOS_Delete(staging);
+        it = m_stagingPool.erase(it);
+    }
+}
+
+MediaDebugAsyncDumper::Staging *MediaDebugAsyncDumper::AcquireStaging(
+    MOS_ALLOC_GFXRES_PARAMS &allocParams,
+    uint64_t                 size)
+{
+    MosUtilities::MosLockMutex(m_mutex);
+
+    if (m_pending >= m_maxQueueDepth)
+    {
+        m_stats.dropped++;
+        MosUtilities::MosUnlockMutex(m_mutex);
+        return nullptr;
+    }
+
+    for (auto staging : m_stagingPool)
+    {
+        if (!staging->busy &&
+            staging->surface.Format == allocParams.Format &&
+            staging->surface.dwWidth == allocParams.dwWidth &&
+            staging->surface.dwHeight == allocParams.dwHeight)
+        {
+            staging->busy = true;
+            MosUtilities::MosUnlockMutex(m_mutex);
+            return staging;
+        }
+    }
+
+    FreeIdleStaging(size);
+    if (m_stats.stagingSize + size > m_budget)
+    {
+        m_stats.dropped++;
+        MosUtilities::MosUnlockMutex(m_mutex);
+        return nullptr;
+    }
+
+    MosUtilities::MosUnlockMutex(m_mutex);
+
+    // Allocation is done on submitting thread as it may use the context of os interface
+    Staging *staging = MOS_New(Staging);
+    if (staging == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (m_osInterface->pfnAllocateResource(m_osInterface, &allocParams, &staging->surface.OsResource) != MOS_STATUS_SUCCESS)
+    {
+        MOS_Delete(staging);
+        return nullptr;
+    }
+
+    // Lock on worker thread waits for the copy by bo, context based sync is not needed
+    m_osInterface->pfnSkipResourceSync(&staging->surface.OsResource);
+
+    staging->surface.Format = Format_Invalid;
+    if (m_osInterface->pfnGetResourceInfo(m_osInterface, &staging->surface.OsResource, &staging->surface) != MOS_STATUS_SUCCESS)
+    {
+        m_osInterface->pfnFreeResource(m_osInterface, &staging->surface.OsResource);
+        MOS_Delete(staging);
+        return nullptr;
+    }
+    // Keep the allocation parameters for matching
+    staging->surface.Format   = allocParams.Format;
+    staging->surface.dwWidth  = allocParams.dwWidth;
+    staging->surface.dwHeight = allocParams.dwHeight;
+    staging->size             = size;
+    staging->busy             = true;
+
+    MosUtilities::MosLockMutex(m_mutex);
+    m_stagingPool.push_back(staging);
+    m_stats.stagingSize    += size;
+    m_stats.peakStagingSize = MOS_MAX(m_stats.peakStagingSize, m_stats.stagingSize);
+    MosUtilities::MosUnlockMutex(m_mutex);
+
+    return staging;
+}
+
+void MediaDebugAsyncDumper::Complete(bool written)
+{
+    if (written)
+    {
+        m_stats.written++;
+    }
+    else
+    {
+        m_stats.failed++;
+    }
+    m_pending--;
+    if (m_pending == 0 && m_waitIdle)
+    {
+        m_waitIdle = false;
+        MosUtilities::MosPostSemaphore(m_idleSem, 1);
+    }
+}
+
+void MediaDebugAsyncDumper::LockCopied(uint32_t keep)
+{
+    MOS_LOCK_PARAMS lockFlags;
+    MOS_ZeroMemory(&lockFlags, sizeof(MOS_LOCK_PARAMS));
+    lockFlags.ReadOnly = 1;
+
+    while (m_copied.size() > keep)
+    {
+        Request request = std::move(m_copied.front());
+        m_copied.pop_front();
+
+        // Lock waits until the copy to staging is completed, which is likely
+        // done already as later copies have been submitted since
+        request.data = (uint8_t *)m_osInterface->pfnLockResource(m_osInterface, &request.staging->surface.OsResource, &lockFlags);
+
+        MosUtilities::MosLockMutex(m_mutex);
+        if (request.data == nullptr)
+        {
+            request.staging->busy = false;
+            Complete(false);
+            MosUtilities::MosUnlockMutex(m_mutex);
+            continue;
+        }
+        m_requests.push_back(std::move(request));
+        m_stats.queueDepth = (uint32_t)m_requests.size();
+        MosUtilities::MosUnlockMutex(m_mutex);
+
+        MosUtilities::MosPostSemaphore(m_requestSem, 1);
+    }
+}
+
+void MediaDebugAsyncDumper::UnlockWritten()
+{
+    std::vector<Staging *> written;
+
+    MosUtilities::MosLockMutex(m_mutex);
+    written.swap(m_written);
+    MosUtilities::MosUnlockMutex(m_mutex);
+
+    for (auto staging : written)
+    {
+        m_osInterface->pfnUnlockResource(m_osInterface, &staging->surface.OsResource);
+    }
+
+    // Staging is reusable only after unlocked
+    MosUtilities::MosLockMutex(m_mutex);
+    for (auto staging : written)
+    {
+        staging->busy = false;
+    }
+    MosUtilities::MosUnlockMutex(m_mutex);
+}
+
+MOS_STATUS MediaDebugAsyncDumper::Submit(
+    PMOS_RESOURCE            source,
+    MOS_ALLOC_GFXRES_PARAMS &allocParams,
+    uint64_t                 size,
+    WriteFunc               &write)
+{
+    if (!m_started)
+    {
+        return MOS_STATUS_UNINITIALIZED;
+    }
+
+    UnlockWritten();
+
+    Staging *staging = AcquireStaging(allocParams, size);
+    if (staging == nullptr)
+    {
+        MEDIA_DEBUG_VERBOSEMESSAGE("Async dump dropped for budget or queue depth.");
+        // Hand all copies to worker thread so the queue drains even if no more dump comes
+        LockCopied(0);
+        return MOS_STATUS_NO_SPACE;
+    }
+
+    // Detile and decompress are done by the copy, so the lock of staging is a plain map
+    MOS_STATUS status = m_osInterface->pfnDoubleBufferCopyResource(
+        m_osInterface,
+        source,
+        &staging->surface.OsResource,
+        false);
+    if (status != MOS_STATUS_SUCCESS)
+    {
+        MosUtilities::MosLockMutex(m_mutex);
+        staging->busy = false;
+        m_stats.failed++;
+        MosUtilities::MosUnlockMutex(m_mutex);
+        return status;
+    }
+
+    Request request;
+    request.staging = staging;
+    request.write   = std::move(write);
+    m_copied.push_back(std::move(request));
+
+    MosUtilities::MosLockMutex(m_mutex);
+    m_pending++;
+    m_stats.submitted++;
+    MosUtilities::MosUnlockMutex(m_mutex);
+
+    LockCopied(m_lockLag);
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MediaDebugAsyncDumper::SubmitSurface(PMOS_SURFACE surface, WriteFunc write)
+{
+    MEDIA_DEBUG_CHK_NULL(surface);
+    MEDIA_DEBUG_CHK_NULL(surface->OsResource.pGmmResInfo);
+
+    MOS_ALLOC_GFXRES_PARAMS allocParams;
+    MOS_ZeroMemory(&allocParams, sizeof(MOS_ALLOC_GFXRES_PARAMS));
+    allocParams.Type            = MOS_GFXRES_2D;
+    allocParams.TileType        = MOS_TILE_LINEAR;
+    allocParams.Format          = surface->Format;
+    allocParams.dwWidth         = surface->dwWidth;
+    allocParams.dwHeight        = surface->dwHeight;
+    allocParams.dwArraySize     = 1;
+    allocParams.bIsCompressible = false;
+    allocParams.pBufName        = "MediaDbgAsyncDumpStaging";
+
+    // Main surface size of source bounds the linear staging size
+    uint64_t size = surface->OsResource.pGmmResInfo->GetSizeMainSurface();
+
+    return Submit(&surface->OsResource, allocParams, size, write);
+}
+
+MOS_STATUS MediaDebugAsyncDumper::SubmitBuffer(PMOS_RESOURCE resource, WriteFunc write)
+{
+    MEDIA_DEBUG_CHK_NULL(resource);
+    MEDIA_DEBUG_CHK_NULL(resource->pGmmResInfo);
+
+    // The whole buffer is copied, so staging is sized as the source
+    uint32_t size = (uint32_t)resource->pGmmResInfo->GetSizeMainSurface();
+    if (size == 0)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    MOS_ALLOC_GFXRES_PARAMS allocParams;
+    MOS_ZeroMemory(&allocParams, sizeof(MOS_ALLOC_GFXRES_PARAMS));
+    allocParams.Type     = MOS_GFXRES_BUFFER;
+    allocParams.TileType = MOS_TILE_LINEAR;
+    allocParams.Format   = Format_Buffer;
+    allocParams.dwBytes  = MOS_ALIGN_CEIL(size, MOS_PAGE_SIZE);
+    allocParams.dwWidth  = allocParams.dwBytes;
+    allocParams.dwHeight = 1;
+    allocParams.pBufName = "MediaDbgAsyncDumpStaging";
+
+    return Submit(resource, allocParams, allocParams.dwBytes, write);
+}
+
+void MediaDebugAsyncDumper::Process(Request &request)
+{
+    // Only the locked data is touched here, MOS_INTERFACE is used on submitting thread
+    MOS_STATUS status = request.write(request.data, request.staging->surface);
+
+    // Staging stays busy until unlocked on submitting thread
+    MosUtilities::MosLockMutex(m_mutex);
+    m_written.push_back(request.staging);
+    Complete(status == MOS_STATUS_SUCCESS);
+    MosUtilities::MosUnlockMutex(m_mutex);
+}
+
+void *MediaDebugAsyncDumper::WorkerThread(void *context)
+{
+    MediaDebugAsyncDumper *dumper = (MediaDebugAsyncDumper *)context;
+
+    while (true)
+    {
+        MosUtilities::MosWaitSemaphore(dumper->m_requestSem, INFINITE);
+
+        MosUtilities::MosLockMutex(dumper->m_mutex);
+        if (dumper->m_requests.empty())
+        {
+            bool exit = dumper->m_exit;
+            MosUtilities::MosUnlockMutex(dumper->m_mutex);
+            if (exit)
+            {
+                break;
+            }
+            continue;
+        }
+        Request request = std::move(dumper->m_requests.front());
+        dumper->m_requests.pop_front();
+        dumper->m_stats.queueDepth = (uint32_t)dumper->m_requests.size();
+        MosUtilities::MosUnlockMutex(dumper->m_mutex);
+
+        dumper->Process(request);
+    }
+
+    return nullptr;
+}
+
+MOS_STATUS MediaDebugAsyncDumper::Flush()
+{
+    if (!m_started)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    LockCopied(0);
+
+    MOS_STATUS status = MOS_STATUS_SUCCESS;
+    MosUtilities::MosLockMutex(m_mutex);
+    if (m_pending != 0)
+    {
+        m_waitIdle = true;
+        MosUtilities::MosUnlockMutex(m_mutex);
+        status = MosUtilities::MosWaitSemaphore(m_idleSem, INFINITE);
+    }
+    else
+    {
+        MosUtilities::MosUnlockMutex(m_mutex);
+    }
+
+    UnlockWritten();
+
+    return status;
+}
+
+MediaDebugAsyncDumper::Statistics MediaDebugAsyncDumper::GetStatistics()
+{
+    if (!m_started)
+    {
+        return m_stats;
+    }
+
+    Statistics stats;
+    MosUtilities::MosLockMutex(m_mutex);
+    stats = m_stats;
+    MosUtilities::MosUnlockMutex(m_mutex);
+    return stats;
+}
+
+#endif  // USE_MEDIA_DEBUG_TOOL
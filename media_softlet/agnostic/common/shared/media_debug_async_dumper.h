@@ -0,0 +1,232 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_debug_async_dumper.h
+//! \brief    Defines the asynchronous dumper of the media debug interface
+//! \details  A dump request is turned into a GPU copy of the source into a linear,
+//!           uncompressed staging resource. MOS_INTERFACE is not thread safe, so the
+//!           staging resource is locked and unlocked on the submitting thread: it is
+//!           locked once a few later copies are in flight, when its own copy has most
+//!           likely completed, and a worker thread writes the locked data to file.
+//!           The staging resources are pooled under a memory budget, and requests
+//!           exceeding the budget or the queue depth are dropped instead of stalling
+//!           the pipeline.
+//!
+
+#ifndef __MEDIA_DEBUG_ASYNC_DUMPER_H__
+#define __MEDIA_DEBUG_ASYNC_DUMPER_H__
+
+#include <stdint.h>
+#include <deque>
+#include <functional>
+#include <vector>
+#include "mos_defs.h"
+#include "mos_os.h"
+#include "media_class_trace.h"
+
+class MediaDebugAsyncDumper
+{
+public:
+    //!
+    //! \brief  Writes the staging data into the dump file, called on the worker thread
+    //! \param  [in] data
+    //!         CPU address of the locked staging resource
+    //! \param  [in] staging
+    //!         Layout of the staging resource
+    //! \return MOS_STATUS
+    //!
+    using WriteFunc = std::function<MOS_STATUS(uint8_t *data, const MOS_SURFACE &staging)>;
+
+    //!
+    //! \brief  Counters of the dumper
+    //!
+    struct Statistics
+    {
+        uint64_t submitted       = 0;  //!< Requests queued to worker thread
+        uint64_t written         = 0;  //!< Requests written to file
+        uint64_t dropped         = 0;  //!< Requests dropped for budget or queue depth
+        uint64_t failed          = 0;  //!< Requests failed on copy, lock or write
+        uint64_t stagingSize     = 0;  //!< Bytes of staging resources allocated
+        uint64_t peakStagingSize = 0;  //!< Peak of staging bytes
+        uint32_t queueDepth      = 0;  //!< Requests waiting for worker thread
+    };
+
+    //!
+    //! \brief  Constructor
+    //! \param  [in] osInterface
+    //!         Pointer to MOS_INTERFACE
+    //!
+    MediaDebugAsyncDumper(PMOS_INTERFACE osInterface);
+
+    //!
+    //! \brief  Destructor, drains the queue and frees staging resources
+    //!
+    virtual ~MediaDebugAsyncDumper();
+
+    //!
+    //! \brief  Start the worker thread
+    //! \param  [in] budget
+    //!         Maximum bytes of staging resources
+    //! \param  [in] maxQueueDepth
+    //!         Maximum requests waiting for worker thread
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Init(uint64_t budget = m_defaultBudget, uint32_t maxQueueDepth = m_defaultQueueDepth);
+
+    //!
+    //! \brief  Queue the dump of a surface
+    //! \details The surface is copied to a linear uncompressed staging surface with
+    //!          the same width, height and format, which is passed to write.
+    //! \param  [in] surface
+    //!         Surface to dump
+    //! \param  [in] write
+    //!         Function writing the staging surface to file
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if queued, MOS_STATUS_NO_SPACE if dropped,
+    //!         else fail reason
+    //!
+    MOS_STATUS SubmitSurface(PMOS_SURFACE surface, WriteFunc write);
+
+    //!
+    //! \brief  Queue the dump of a buffer
+    //! \details The whole buffer is copied to a staging buffer, which is passed to write.
+    //! \param  [in] resource
+    //!         Buffer to dump
+    //! \param  [in] write
+    //!         Function writing the staging buffer to file
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if queued, MOS_STATUS_NO_SPACE if dropped,
+    //!         else fail reason
+    //!
+    MOS_STATUS SubmitBuffer(PMOS_RESOURCE resource, WriteFunc write);
+
+    //!
+    //! \brief  Lock all copied requests and wait until they are written
+    //! \return MOS_STATUS
+    //!
+    MOS_STATUS Flush();
+
+    //!
+    //! \brief  Get counters of the dumper
+    //! \return Statistics
+    //!
+    Statistics GetStatistics();
+
+    static const uint64_t m_defaultBudget     = 256 * 1024 * 1024;  //!< Default staging memory budget
+    static const uint32_t m_defaultQueueDepth = 16;                 //!< Default maximum queue depth
+    static const uint32_t m_lockLag           = 2;                  //!< Copies left in flight before the oldest is locked
+
+protected:
+    struct Staging
+    {
+        MOS_SURFACE surface = {};
+        uint64_t    size    = 0;
+        bool        busy    = false;  //!< Owned by a queued request
+    };
+
+    struct Request
+    {
+        Staging   *staging = nullptr;
+        uint8_t   *data    = nullptr;  //!< Locked on submitting thread
+        WriteFunc write;
+    };
+
+    //!
+    //! \brief  Get an idle staging resource matching the allocation, allocate one if none
+    //! \details Idle staging resources are freed to fit the budget. Called on submitting thread.
+    //! \return Staging *
+    //!         nullptr if the budget or queue depth is exceeded
+    //!
+    Staging *AcquireStaging(MOS_ALLOC_GFXRES_PARAMS &allocParams, uint64_t size);
+
+    //!
+    //! \brief  Free staging resources not in use, m_mutex must be held
+    //!
+    void FreeIdleStaging(uint64_t sizeNeeded);
+
+    //!
+    //! \brief  Copy the source into a staging resource and keep the request until it is locked
+    //! \param  [in] source
+    //!         Resource to dump
+    //! \param  [in] allocParams
+    //!         Allocation parameters of the staging resource
+    //! \param  [in] size
+    //!         Bytes of the staging resource counted against the budget
+    //! \param  [in] write
+    //!         Function writing the staging resource to file
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if queued, MOS_STATUS_NO_SPACE if dropped,
+    //!         else fail reason
+    //!
+    MOS_STATUS Submit(PMOS_RESOURCE source, MOS_ALLOC_GFXRES_PARAMS &allocParams, uint64_t size, WriteFunc &write);
+
+    //!
+    //! \brief  Lock the oldest copied requests and queue them to worker thread
+    //! \details Called on submitting thread.
+    //! \param  [in] keep
+    //!         Number of the latest copied requests left unlocked
+    //!
+    void LockCopied(uint32_t keep);
+
+    //!
+    //! \brief  Unlock the staging resources written by worker thread
+    //! \details Called on submitting thread.
+    //!
+    void UnlockWritten();
+
+    //!
+    //! \brief  Count a request written or failed and wake up Flush when idle, m_mutex must be held
+    //!
+    void Complete(bool written);
+
+    //!
+    //! \brief  Write one request on worker thread
+    //!
+    void Process(Request &request);
+
+    //!
+    //! \brief  Entry of the worker thread
+    //!
+    static void *WorkerThread(void *context);
+
+    PMOS_INTERFACE        m_osInterface   = nullptr;
+    MOS_THREADHANDLE      m_thread        = 0;
+    PMOS_MUTEX            m_mutex         = nullptr;
+    PMOS_SEMAPHORE        m_requestSem    = nullptr;  //!< Posted for each request and on exit
+    PMOS_SEMAPHORE        m_idleSem       = nullptr;  //!< Posted when the queue gets drained
+    std::deque<Request>   m_copied;                   //!< Copies not locked yet, owned by submitting thread
+    std::deque<Request>   m_requests;                 //!< Locked requests waiting for worker thread
+    std::vector<Staging*> m_written;                  //!< Written by worker thread, to be unlocked
+    std::vector<Staging*> m_stagingPool;
+    uint64_t              m_budget        = m_defaultBudget;
+    uint32_t              m_maxQueueDepth = m_defaultQueueDepth;
+    uint32_t              m_pending       = 0;        //!< Requests copied and not written yet
+    bool                  m_waitIdle      = false;
+    bool                  m_exit          = false;
+    bool                  m_started       = false;
+    Statistics            m_stats         = {};
+
+MEDIA_CLASS_DEFINE_END(MediaDebugAsyncDumper)
+};
+
+#endif  // __MEDIA_DEBUG_ASYNC_DUMPER_H__
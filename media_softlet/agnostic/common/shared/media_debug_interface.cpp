@@ -28,6 +28,7 @@
 #if USE_MEDIA_DEBUG_TOOL
 #include "media_debug_config_manager.h"
 #include "codechal_hw.h"
+#include "media_debug_async_dumper.h"
 #include <fstream>
 #include <sstream>
 #include <iomanip>
@@ -51,6 +52,9 @@ MediaDebugInterface::~MediaDebugInterface()
         MOS_Delete(m_configMgr);
     }
 
+    // Drain queued dumps before the resources are released
+    MOS_Delete(m_asyncDumper);
+
     if (!Mos_ResourceIsNull(&m_temp2DSurfForCopy.OsResource))
     {
         m_osInterface->pfnFreeResource(m_osInterface, &m_temp2DSurfForCopy.OsResource);
@@ -874,6 +878,15 @@ MOS_STATUS MediaDebugInterface::DumpYUVSurface(
         return MOS_STATUS_SUCCESS;
     }
 
+    if (DumpIsEnabled(MediaDbgAttr::attrAsyncDump) && !DumpIsEnabled(MediaDbgAttr::attrDisableSwizzleForDumps))
+    {
+        // Fall back to sync dump if the surface cannot be copied to staging
+        if (DumpYUVSurfaceAsync(surface, surfName, width_in, height_in) == MOS_STATUS_SUCCESS)
+        {
+            return MOS_STATUS_SUCCESS;
+        }
+    }
+
     MOS_LOCK_PARAMS lockFlags;
     MOS_ZeroMemory(&lockFlags, sizeof(MOS_LOCK_PARAMS));
     lockFlags.ReadOnly     = 1;
@@ -977,13 +990,41 @@ MOS_STATUS MediaDebugInterface::DumpYUVSurface(
     MEDIA_DEBUG_CHK_NULL(surfBaseAddr);
     Mos_SwizzleData(lockedAddr, surfBaseAddr, surface->TileType, MOS_TILE_LINEAR, sizeMain / surface->dwPitch, surface->dwPitch, 0);
 
-    uint8_t *data = surfBaseAddr;
-    data += surface->dwOffset + surface->YPlaneOffset.iYOffset * surface->dwPitch;
+    uint32_t width = 0, height = 0, pitch = 0;
+    GetYUVDumpSize(*surface, width_in, height_in, CodecHal_PictureIsField(m_currPic), width, height, pitch);
 
-    uint32_t width  = width_in ? width_in : surface->dwWidth;
-    uint32_t height = height_in ? height_in : surface->dwHeight;
+    const char *funcName = (m_mediafunction == MEDIA_FUNCTION_VP) ? "_VP" : ((m_mediafunction == MEDIA_FUNCTION_ENCODE) ? "_ENC" : "_DEC");
+    std::string bufName  = std::string(surfName) + "_w[" + std::to_string(surface->dwWidth) + "]_h[" + std::to_string(surface->dwHeight) + "]_p[" + std::to_string(pitch) + "]";
+    const char *filePath = CreateFileName(funcName, bufName.c_str(), MediaDbgExtType::yuv);
 
-    switch (surface->Format)
+    MOS_STATUS status = WriteYUVData(*surface, surfBaseAddr, width, height, pitch, CodecHal_PictureIsBottomField(m_currPic), filePath);
+
+    if (DumpIsEnabled(MediaDbgAttr::attrForceYUVDumpWithMemcpy))
+    {
+        MOS_FreeMemory(lockedAddr);
+    }
+    else
+    {
+        m_osInterface->pfnUnlockResource(m_osInterface, &surface->OsResource);
+    }
+    MOS_FreeMemory(surfBaseAddr);
+
+    return status;
+}
+
+void MediaDebugInterface::GetYUVDumpSize(
+    const MOS_SURFACE &surface,
+    uint32_t           widthIn,
+    uint32_t           heightIn,
+    bool               isField,
+    uint32_t          &width,
+    uint32_t          &height,
+    uint32_t          &pitch)
+{
+    width  = widthIn ? widthIn : surface.dwWidth;
+    height = heightIn ? heightIn : surface.dwHeight;
+
+    switch (surface.Format)
     {
     case Format_YUY2:
     case Format_Y216V:
@@ -1003,24 +1044,37 @@ MOS_STATUS MediaDebugInterface::DumpYUVSurface(
         break;
     }
 
-    uint32_t pitch = surface->dwPitch;
-    if (surface->Format == Format_UYVY)
+    pitch = surface.dwPitch;
+    if (surface.Format == Format_UYVY)
         pitch = width;
 
-    if (CodecHal_PictureIsBottomField(m_currPic))
-    {
-        data += pitch;
-    }
-
-    if (CodecHal_PictureIsField(m_currPic))
+    if (isField)
     {
         pitch *= 2;
         height /= 2;
     }
+}
 
-    const char *funcName = (m_mediafunction == MEDIA_FUNCTION_VP) ? "_VP" : ((m_mediafunction == MEDIA_FUNCTION_ENCODE) ? "_ENC" : "_DEC");
-    std::string bufName  = std::string(surfName) + "_w[" + std::to_string(surface->dwWidth) + "]_h[" + std::to_string(surface->dwHeight) + "]_p[" + std::to_string(pitch) + "]";
-    const char *filePath = CreateFileName(funcName, bufName.c_str(), MediaDbgExtType::yuv);
+MOS_STATUS MediaDebugInterface::WriteYUVData(
+    const MOS_SURFACE &surface,
+    uint8_t           *surfBaseAddr,
+    uint32_t           width,
+    uint32_t           height,
+    uint32_t           pitch,
+    bool               isBottomField,
+    const char        *filePath)
+{
+    MEDIA_DEBUG_CHK_NULL(surfBaseAddr);
+    MEDIA_DEBUG_CHK_NULL(filePath);
+
+    uint8_t *data = surfBaseAddr;
+    data += surface.dwOffset + surface.YPlaneOffset.iYOffset * surface.dwPitch;
+
+    if (isBottomField)
+    {
+        // pitch has been doubled for field, bottom field starts from the second row
+        data += pitch / 2;
+    }
 
     std::ofstream ofs(filePath, std::ios_base::out | std::ios_base::binary);
     if (ofs.fail())
@@ -1035,9 +1089,9 @@ MOS_STATUS MediaDebugInterface::DumpYUVSurface(
         data += pitch;
     }
 
-    if (surface->Format != Format_A8B8G8R8)
+    if (surface.Format != Format_A8B8G8R8)
     {
-        switch (surface->Format)
+        switch (surface.Format)
         {
         case Format_NV12:
         case Format_P010:
@@ -1072,16 +1126,16 @@ MOS_STATUS MediaDebugInterface::DumpYUVSurface(
 
         uint8_t *vPlaneData = surfBaseAddr;
 #ifdef LINUX
-        data = surfBaseAddr + surface->UPlaneOffset.iSurfaceOffset;
-        if (surface->Format == Format_422V || surface->Format == Format_IMC3)
+        data = surfBaseAddr + surface.UPlaneOffset.iSurfaceOffset;
+        if (surface.Format == Format_422V || surface.Format == Format_IMC3)
         {
-            vPlaneData = surfBaseAddr + surface->VPlaneOffset.iSurfaceOffset;
+            vPlaneData = surfBaseAddr + surface.VPlaneOffset.iSurfaceOffset;
         }
 #else
-        data = surfBaseAddr + surface->UPlaneOffset.iLockSurfaceOffset;
-        if (surface->Format == Format_422V || surface->Format == Format_IMC3)
+        data = surfBaseAddr + surface.UPlaneOffset.iLockSurfaceOffset;
+        if (surface.Format == Format_422V || surface.Format == Format_IMC3)
         {
-            vPlaneData = surfBaseAddr + surface->VPlaneOffset.iLockSurfaceOffset;
+            vPlaneData = surfBaseAddr + surface.VPlaneOffset.iLockSurfaceOffset;
         }
 
 #endif
@@ -1094,7 +1148,7 @@ MOS_STATUS MediaDebugInterface::DumpYUVSurface(
         }
 
         // write v planar data to file
-        if (surface->Format == Format_422V || surface->Format == Format_IMC3)
+        if (surface.Format == Format_422V || surface.Format == Format_IMC3)
         {
             for (uint32_t h = 0; h < height; h++)
             {
@@ -1105,17 +1159,87 @@ MOS_STATUS MediaDebugInterface::DumpYUVSurface(
     }
     ofs.close();
 
-    if (DumpIsEnabled(MediaDbgAttr::attrForceYUVDumpWithMemcpy))
-    {
-        MOS_FreeMemory(lockedAddr);
-    }
-    else
+    return MOS_STATUS_SUCCESS;
+}
+
+MediaDebugAsyncDumper *MediaDebugInterface::GetAsyncDumper()
+{
+    if (m_asyncDumper == nullptr)
     {
-        m_osInterface->pfnUnlockResource(m_osInterface, &surface->OsResource);
+        m_asyncDumper = MOS_New(MediaDebugAsyncDumper, m_osInterface);
+        if (m_asyncDumper && m_asyncDumper->Init() != MOS_STATUS_SUCCESS)
+        {
+            MOS_Delete(m_asyncDumper);
+        }
     }
-    MOS_FreeMemory(surfBaseAddr);
+    return m_asyncDumper;
+}
 
-    return MOS_STATUS_SUCCESS;
+MOS_STATUS MediaDebugInterface::DumpYUVSurfaceAsync(
+    PMOS_SURFACE surface,
+    const char * surfName,
+    uint32_t     widthIn,
+    uint32_t     heightIn)
+{
+    MEDIA_DEBUG_CHK_NULL(surface);
+
+    MediaDebugAsyncDumper *dumper = GetAsyncDumper();
+    MEDIA_DEBUG_CHK_NULL(dumper);
+
+    // File name takes the pitch of source surface to be same as sync dump
+    uint32_t width = 0, height = 0, pitch = 0;
+    bool     isField       = CodecHal_PictureIsField(m_currPic);
+    bool     isBottomField = CodecHal_PictureIsBottomField(m_currPic);
+    GetYUVDumpSize(*surface, widthIn, heightIn, isField, width, height, pitch);
+
+    const char *funcName = (m_mediafunction == MEDIA_FUNCTION_VP) ? "_VP" : ((m_mediafunction == MEDIA_FUNCTION_ENCODE) ? "_ENC" : "_DEC");
+    std::string bufName  = std::string(surfName) + "_w[" + std::to_string(surface->dwWidth) + "]_h[" + std::to_string(surface->dwHeight) + "]_p[" + std::to_string(pitch) + "]";
+    std::string filePath = CreateFileName(funcName, bufName.c_str(), MediaDbgExtType::yuv);
+
+    MOS_STATUS status = dumper->SubmitSurface(
+        surface,
+        [=](uint8_t *data, const MOS_SURFACE &staging) {
+            // Rows are written with the layout of linear staging surface
+            uint32_t stagingWidth = 0, stagingHeight = 0, stagingPitch = 0;
+            GetYUVDumpSize(staging, widthIn, heightIn, isField, stagingWidth, stagingHeight, stagingPitch);
+            return WriteYUVData(staging, data, stagingWidth, stagingHeight, stagingPitch, isBottomField, filePath.c_str());
+        });
+
+    // Dropped request is not an error, the pipeline must not be stalled by dump
+    return (status == MOS_STATUS_NO_SPACE) ? MOS_STATUS_SUCCESS : status;
+}
+
+MOS_STATUS MediaDebugInterface::DumpBufferAsync(
+    PMOS_RESOURCE resource,
+    uint32_t      size,
+    uint32_t      offset,
+    const char *  filePath)
+{
+    MEDIA_DEBUG_CHK_NULL(resource);
+    MEDIA_DEBUG_CHK_NULL(filePath);
+
+    MediaDebugAsyncDumper *dumper = GetAsyncDumper();
+    MEDIA_DEBUG_CHK_NULL(dumper);
+
+    std::string path   = filePath;
+    MOS_STATUS  status = dumper->SubmitBuffer(
+        resource,
+        [=](uint8_t *data, const MOS_SURFACE &staging) {
+            if ((uint64_t)offset + size > staging.dwWidth)
+            {
+                return MOS_STATUS_INVALID_PARAMETER;
+            }
+            std::ofstream ofs(path, std::ios_base::out | std::ios_base::binary);
+            if (ofs.fail())
+            {
+                return MOS_STATUS_UNKNOWN;
+            }
+            ofs.write((char *)data + offset, size);
+            ofs.close();
+            return MOS_STATUS_SUCCESS;
+        });
+
+    return (status == MOS_STATUS_NO_SPACE) ? MOS_STATUS_SUCCESS : status;
 }
 
 MOS_STATUS MediaDebugInterface::DumpUncompressedYUVSurface(PMOS_SURFACE surface)
@@ -1189,13 +1313,6 @@ MOS_STATUS MediaDebugInterface::DumpBuffer(
         }
     }
 
-    MOS_LOCK_PARAMS lockFlags;
-    MOS_ZeroMemory(&lockFlags, sizeof(MOS_LOCK_PARAMS));
-    lockFlags.ReadOnly = 1;
-    uint8_t *data      = (uint8_t *)m_osInterface->pfnLockResource(m_osInterface, resource, &lockFlags);
-    MEDIA_DEBUG_CHK_NULL(data);
-    data += offset;
-
     const char *fileName;
     bool        binaryDump = m_configMgr->AttrIsEnabled(MediaDbgAttr::attrDumpBufferInBinary);
     const char *extType    = binaryDump ? MediaDbgExtType::dat : MediaDbgExtType::txt;
@@ -1210,6 +1327,22 @@ MOS_STATUS MediaDebugInterface::DumpBuffer(
         fileName               = CreateFileName(kernelName.c_str(), bufferName, extType);
     }
 
+    if (binaryDump && m_configMgr->AttrIsEnabled(MediaDbgAttr::attrAsyncDump))
+    {
+        // Fall back to sync dump if the buffer cannot be copied to staging
+        if (DumpBufferAsync(resource, size, offset, fileName) == MOS_STATUS_SUCCESS)
+        {
+            return MOS_STATUS_SUCCESS;
+        }
+    }
+
+    MOS_LOCK_PARAMS lockFlags;
+    MOS_ZeroMemory(&lockFlags, sizeof(MOS_LOCK_PARAMS));
+    lockFlags.ReadOnly = 1;
+    uint8_t *data      = (uint8_t *)m_osInterface->pfnLockResource(m_osInterface, resource, &lockFlags);
+    MEDIA_DEBUG_CHK_NULL(data);
+    data += offset;
+
     MOS_STATUS status;
     if (binaryDump)
     {
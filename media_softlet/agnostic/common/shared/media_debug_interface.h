@@ -38,6 +38,7 @@
 #include <sstream>
 #include <fstream>
 using GoldenReferences = std::vector<std::vector<uint32_t>>;
+class MediaDebugAsyncDumper;
 class MediaDebugInterface
 {
 public:
@@ -249,11 +250,70 @@ protected:
         uint32_t height,
         uint32_t pitch);
 
+    //!
+    //! \brief  Queue the YUV dump of surface to the async dumper
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if queued or dropped, else fail reason
+    //!
+    MOS_STATUS DumpYUVSurfaceAsync(
+        PMOS_SURFACE surface,
+        const char * surfName,
+        uint32_t     widthIn,
+        uint32_t     heightIn);
+
+    //!
+    //! \brief  Queue the binary dump of buffer to the async dumper
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if queued or dropped, else fail reason
+    //!
+    MOS_STATUS DumpBufferAsync(
+        PMOS_RESOURCE resource,
+        uint32_t      size,
+        uint32_t      offset,
+        const char *  filePath);
+
+    //!
+    //! \brief  Get the async dumper, created on first use
+    //! \return MediaDebugAsyncDumper *
+    //!
+    MediaDebugAsyncDumper *GetAsyncDumper();
+
+    //!
+    //! \brief  Get the size of the YUV dump of surface
+    //! \param  [out] width
+    //!         Bytes of each row to be written
+    //! \param  [out] height
+    //!         Rows of luma plane to be written
+    //! \param  [out] pitch
+    //!         Bytes between two rows to be written
+    //!
+    static void GetYUVDumpSize(
+        const MOS_SURFACE &surface,
+        uint32_t           widthIn,
+        uint32_t           heightIn,
+        bool               isField,
+        uint32_t          &width,
+        uint32_t          &height,
+        uint32_t          &pitch);
+
+    //!
+    //! \brief  Write the planes of deswizzled surface data into YUV file
+    //!
+    static MOS_STATUS WriteYUVData(
+        const MOS_SURFACE &surface,
+        uint8_t           *surfBaseAddr,
+        uint32_t           width,
+        uint32_t           height,
+        uint32_t           pitch,
+        bool               isBottomField,
+        const char        *filePath);
+
     virtual MOS_USER_FEATURE_VALUE_ID SetOutputPathKey()  = 0;
     virtual MOS_USER_FEATURE_VALUE_ID InitDefaultOutput() = 0;
 
-    std::string          m_outputFileName;
-    MediaDebugConfigMgr *m_configMgr = nullptr;
+    std::string            m_outputFileName;
+    MediaDebugConfigMgr   *m_configMgr   = nullptr;
+    MediaDebugAsyncDumper *m_asyncDumper = nullptr;
 MEDIA_CLASS_DEFINE_END(MediaDebugInterface)
 };
 
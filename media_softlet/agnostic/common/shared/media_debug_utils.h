@@ -95,6 +95,7 @@ static const char *attrForceCmdDumpLvl        = "ForceCmdDumpLvl";
 static const char *attrForceCurbeDumpLvl      = "ForceCurbeDumpLvl";
 static const char *attrForceYUVDumpWithMemcpy = "ForceYUVDumpWithMemcpy";
 static const char *attrDisableSwizzleForDumps = "DisableSwizzleForDumps";
+static const char *attrAsyncDump              = "AsyncDump";
 static const char *attrVdencOutput            = "VdencOutput";
 static const char *attrDecodeProcParams       = "DecodeProcParams";
 static const char *attrFrameState             = "FrameState";
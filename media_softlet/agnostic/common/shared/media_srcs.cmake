@@ -41,6 +41,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/media_render_common.cpp
     ${CMAKE_CURRENT_LIST_DIR}/memory_policy_manager.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_debug_dumper.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/media_debug_async_dumper.cpp
 )
 
 set(TMP_HEADERS_
@@ -56,6 +57,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/memory_policy_manager.h
     ${CMAKE_CURRENT_LIST_DIR}/mediamemdecomp.h
     ${CMAKE_CURRENT_LIST_DIR}/media_debug_dumper.h
+    ${CMAKE_CURRENT_LIST_DIR}/media_debug_async_dumper.h
 )
 
 
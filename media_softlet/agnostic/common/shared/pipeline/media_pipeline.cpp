@@ -69,6 +69,7 @@ MediaPipeline::~MediaPipeline()
 {
     DeletePackets();
     DeleteTasks();
+    DestroyUploadRings();
 
     MOS_Delete(m_mediaCopy);
 
@@ -113,6 +114,14 @@ MOS_STATUS MediaPipeline::DeleteTasks()
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS MediaPipeline::GetCompletedReports(void *status, uint32_t maxNum, uint32_t &numReports)
+{
+    numReports = 0;
+    MEDIA_CHK_NULL_RETURN(m_statusReport);
+
+    return m_statusReport->GetCompletedReports(status, maxNum, numReports);
+}
+
 MOS_STATUS MediaPipeline::InitPlatform()
 {
     m_osInterface->pfnGetPlatform(m_osInterface, &m_platform);
@@ -237,6 +246,8 @@ MOS_STATUS MediaPipeline::ExecuteActivePackets()
 
     m_activePacketList.clear();
 
+    MOS_OS_CHK_STATUS_RETURN(SubmitUploadRings());
+
     MOS_TraceEventExt(EVENT_PIPE_EXE, EVENT_TYPE_END, nullptr, 0, nullptr, 0);
     return MOS_STATUS_SUCCESS;
 }
@@ -305,3 +316,62 @@ bool MediaPipeline::IsFrameTrackingEnabled()
     return m_scalability->IsFrameTrackingEnabled();
 }
 
+MediaUploadRing *MediaPipeline::GetUploadRing()
+{
+    if (nullptr == m_osInterface || nullptr == m_statusReport)
+    {
+        return nullptr;
+    }
+
+    MOS_GPU_CONTEXT gpuContext = m_osInterface->pfnGetGpuContext(m_osInterface);
+    MediaUploadRing *ring      = nullptr;
+
+    auto iter = m_uploadRings.find(gpuContext);
+    if (iter != m_uploadRings.end())
+    {
+        ring = iter->second;
+    }
+    else
+    {
+        ring = MOS_New(MediaUploadRing, m_osInterface);
+        if (nullptr == ring)
+        {
+            return nullptr;
+        }
+        if (MOS_STATUS_SUCCESS != ring->Create(m_uploadRingSize, "MediaUploadRing"))
+        {
+            MOS_OS_NORMALMESSAGE("Failed to create upload ring for GPU context %d.", gpuContext);
+            MOS_Delete(ring);
+            return nullptr;
+        }
+        m_uploadRings.insert(std::make_pair(gpuContext, ring));
+    }
+
+    ring->Recycle(m_statusReport->GetCompletedCount());
+    return ring;
+}
+
+MOS_STATUS MediaPipeline::SubmitUploadRings()
+{
+    if (m_uploadRings.empty() || nullptr == m_statusReport)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    // Completed count reaches submitted count + 1 when current frame is done
+    uint32_t fence = m_statusReport->GetSubmittedCount() + 1;
+    for (auto pair : m_uploadRings)
+    {
+        MOS_OS_CHK_STATUS_RETURN(pair.second->Submit(fence));
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
+void MediaPipeline::DestroyUploadRings()
+{
+    for (auto pair : m_uploadRings)
+    {
+        MOS_Delete(pair.second);
+    }
+    m_uploadRings.clear();
+}
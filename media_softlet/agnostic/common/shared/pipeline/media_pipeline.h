@@ -40,6 +40,7 @@
 #include "media_perf_profiler.h"
 #include "media_copy.h"
 #include "media_user_setting.h"
+#include "media_upload_ring.h"
 #if !EMUL
 #include "codechal_debug.h"
 #endif
@@ -94,6 +95,19 @@ public:
     //!
     virtual MOS_STATUS GetStatusReport(void *status, uint16_t numStatus) = 0;
 
+    //!
+    //! \brief  Get all status reports completed since the last call, in submission order
+    //! \param  [out] status
+    //!         The report buffer, with room for maxNum reports
+    //! \param  [in] maxNum
+    //!         The maximum number of reports to get
+    //! \param  [out] numReports
+    //!         The number of reports written to status
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    virtual MOS_STATUS GetCompletedReports(void *status, uint32_t maxNum, uint32_t &numReports);
+
     //!
     //! \brief  Destory the media pipeline and release internal resources
     //! \return MOS_STATUS
@@ -134,6 +148,15 @@ public:
     //!
     bool IsFrameTrackingEnabled();
 
+    //!
+    //! \brief  Get the upload ring of current GPU context
+    //! \details The ring is created on first use. Suballocations of current frame are
+    //!          recycled after the frame is reported completed by status report.
+    //! \return MediaUploadRing*
+    //!         Pointer to the ring, nullptr if the pipeline has no status report
+    //!
+    MediaUploadRing *GetUploadRing();
+
 protected:
     //!
     //! \brief  User Feature Key Report
@@ -259,6 +282,19 @@ protected:
     //!
     virtual MOS_STATUS InitUserSetting(MediaUserSettingSharedPtr userSettingPtr);
 
+    //!
+    //! \brief  Close current frame for all upload rings
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS SubmitUploadRings();
+
+    //!
+    //! \brief  Destroy all upload rings
+    //! \return void
+    //!
+    void DestroyUploadRings();
+
 protected:
     PMOS_INTERFACE                   m_osInterface = nullptr;      //!< OS interface
     CodechalDebugInterface           *m_debugInterface = nullptr;  //!< Interface used for debug dumps
@@ -278,6 +314,9 @@ protected:
     std::vector<PacketProperty>                        m_activePacketList;  //!< Active packets property list
     std::map<MediaTask::TaskType, MediaTask *>         m_taskList;          //!< Task list
     MediaUserSettingSharedPtr                          m_userSettingPtr = nullptr;     //!< usersettingInstance
+    std::map<MOS_GPU_CONTEXT, MediaUploadRing *>       m_uploadRings;       //!< Upload rings per GPU context
+
+    static const uint32_t m_uploadRingSize = 1024 * 1024;   //!< Size of each upload ring
 MEDIA_CLASS_DEFINE_END(MediaPipeline)
 };
 #endif // !__MEDIA_PIPELINE_H__
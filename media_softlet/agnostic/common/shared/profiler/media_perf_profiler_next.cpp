@@ -26,6 +26,7 @@
 //!
 
 #include <stddef.h>
+#include <atomic>
 #include "media_perf_profiler_next.h"
 #include "media_skuwa_specific.h"
 #include "mhw_itf.h"
@@ -41,6 +42,7 @@
 #define NAME_LEN                60
 #define LOCAL_STRING_SIZE       64
 #define OFFSET_OF(TYPE, MEMBER) ((size_t) & ((TYPE *)0)->MEMBER )
+#define STREAM_TAG_INDEX        0   // Reserved dword of PerfEntry holding the completion tag when streaming
 
 typedef enum _UMD_PERF_MODE
 {
@@ -79,6 +81,7 @@ struct NodeHeader
 };
 
 #define BASE_OF_NODE(perfDataIndex) (sizeof(NodeHeader) + (sizeof(PerfEntry) * perfDataIndex))
+#define NODE_CAPACITY(bufferSize)   (((bufferSize) - sizeof(NodeHeader)) / sizeof(PerfEntry))
 
 #define CHK_STATUS_RETURN(_stmt)                   \
 {                                                  \
@@ -196,6 +199,8 @@ void MediaPerfProfilerNext::Destroy(MediaPerfProfilerNext* profiler, void* conte
     {
         if (profiler->m_initializedMap[pOsContext] == true)
         {
+            profiler->StopStream(osInterface);
+
             if(profiler->m_enableProfilerDump)
             {
                 profiler->SavePerfData(osInterface);
@@ -376,6 +381,20 @@ MOS_STATUS MediaPerfProfilerNext::Initialize(void* context, MOS_INTERFACE *osInt
             osInterface,
             pPerfStoreBuffer);
 
+    // Read stream interval, records are only dumped on destroy if it is 0
+    MOS_ZeroMemory(&userFeatureData, sizeof(userFeatureData));
+    MOS_UserFeature_ReadValue_ID(
+        nullptr,
+        __MEDIA_USER_FEATURE_VALUE_PERF_PROFILER_STREAM_INTERVAL,
+        &userFeatureData,
+        osInterface->pOsContext);
+
+    if (userFeatureData.u32Data != 0 &&
+        StartStream(osInterface, userFeatureData.u32Data) != MOS_STATUS_SUCCESS)
+    {
+        MOS_OS_ASSERTMESSAGE("Failed to start perf profiler stream!");
+    }
+
     m_initializedMap[pOsContext] = true;
 
     MosUtilities::MosUnlockMutex(m_mutex);
@@ -489,12 +508,20 @@ MOS_STATUS MediaPerfProfilerNext::AddPerfCollectStartCmd(void* context,
     }
 
     uint32_t perfDataIndex = 0;
+    uint32_t sequence      = 0;
 
     MosUtilities::MosLockMutex(m_mutex);
 
-    perfDataIndex = m_perfDataIndexMap[pOsContext];
+    sequence = m_perfDataIndexMap[pOsContext];
     m_perfDataIndexMap[pOsContext]++;
-    m_contextIndexMap[context] = perfDataIndex;
+    m_contextIndexMap[context] = sequence;
+    perfDataIndex = RecordSlot(pOsContext, sequence);
+
+    auto source = m_streamSourceMap.find(pOsContext);
+    if (source != m_streamSourceMap.end())
+    {
+        MediaPerfProfilerStream::Submit(source->second, sequence + 1);
+    }
 
     MosUtilities::MosUnlockMutex(m_mutex);
 
@@ -616,7 +643,8 @@ MOS_STATUS MediaPerfProfilerNext::AddPerfCollectEndCmd(void* context,
     gpuContext     = osInterface->pfnGetGpuContext(osInterface);
     rcsEngineUsed = MOS_RCS_ENGINE_USED(gpuContext);
 
-    perfDataIndex = m_contextIndexMap[context];
+    uint32_t sequence = m_contextIndexMap[context];
+    perfDataIndex     = RecordSlot(pOsContext, sequence);
 
     int8_t regIndex = 0;
     for (regIndex = 0; regIndex < 8; regIndex++)
@@ -653,9 +681,151 @@ MOS_STATUS MediaPerfProfilerNext::AddPerfCollectEndCmd(void* context,
             offset));
     }
 
+    // Completion tag tells the stream which sequence occupies the slot and that it is done
+    if (m_streamSourceMap.find(pOsContext) != m_streamSourceMap.end())
+    {
+        CHK_STATUS_RETURN(StoreData(
+            miItf,
+            cmdBuffer,
+            pOsContext,
+            BASE_OF_NODE(perfDataIndex) + OFFSET_OF(PerfEntry, reserved[STREAM_TAG_INDEX]),
+            sequence + 1));
+    }
+
     return status;
 }
 
+MOS_STATUS MediaPerfProfilerNext::StartStream(MOS_INTERFACE *osInterface, uint32_t interval)
+{
+    CHK_NULL_RETURN(osInterface);
+
+    PMOS_CONTEXT pOsContext = osInterface->pOsContext;
+    CHK_NULL_RETURN(pOsContext);
+    CHK_NULL_RETURN(m_perfStoreBufferMap[pOsContext]);
+
+    if (m_stream == nullptr)
+    {
+        char fileName[MOS_MAX_PATH_LENGTH + 1];
+        if (m_multiprocess)
+        {
+            MOS_SecureStringPrint(fileName, MOS_MAX_PATH_LENGTH + 1, MOS_MAX_PATH_LENGTH + 1, "%s-pid%d-%u.json",
+                m_outputFileName, MosUtilities::MosGetPid(), m_streamSessionCount);
+        }
+        else
+        {
+            MOS_SecureStringPrint(fileName, MOS_MAX_PATH_LENGTH + 1, MOS_MAX_PATH_LENGTH + 1, "%s-%u.json",
+                m_outputFileName, m_streamSessionCount);
+        }
+
+        m_stream = MOS_New(MediaPerfProfilerStream);
+        CHK_NULL_RETURN(m_stream);
+
+        MOS_STATUS status = m_stream->Start(fileName, m_timerBase, interval);
+        if (status != MOS_STATUS_SUCCESS)
+        {
+            MOS_Delete(m_stream);
+            return status;
+        }
+        m_streamSessionCount++;
+    }
+
+    // Mapped until the context is destroyed, so the worker thread reads without os interface
+    MOS_LOCK_PARAMS lockFlags;
+    MOS_ZeroMemory(&lockFlags, sizeof(MOS_LOCK_PARAMS));
+    lockFlags.WriteOnly   = 1;
+    lockFlags.NoOverWrite = 1;
+
+    uint8_t *data = (uint8_t *)osInterface->pfnLockResource(
+        osInterface,
+        m_perfStoreBufferMap[pOsContext],
+        &lockFlags);
+    if (data == nullptr)
+    {
+        DestroyIdleStream();
+        return MOS_STATUS_NULL_POINTER;
+    }
+
+    uint32_t capacity = NODE_CAPACITY(m_bufferSize);
+
+    auto read = [data, capacity](uint32_t sequence, MediaPerfProfilerStream::Record &record) {
+        const uint8_t *node = data + BASE_OF_NODE(sequence % capacity);
+        const volatile uint32_t *tag = (const volatile uint32_t *)(node + OFFSET_OF(PerfEntry, reserved[STREAM_TAG_INDEX]));
+        if (*tag != sequence + 1)
+        {
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // Timestamps are written to the 8 bytes aligned addresses, as in AddPerfCollectStartCmd
+        const PerfEntry *entry = (const PerfEntry *)node;
+        uint32_t beginOffset = MOS_ALIGN_CEIL(BASE_OF_NODE(sequence % capacity) + OFFSET_OF(PerfEntry, beginTimeClockValue), 8);
+        uint32_t endOffset   = MOS_ALIGN_CEIL(BASE_OF_NODE(sequence % capacity) + OFFSET_OF(PerfEntry, endTimeClockValue), 8);
+
+        record.processId  = entry->processId;
+        record.instanceId = entry->instanceId;
+        record.engineTag  = entry->engineTag;
+        record.perfTag    = entry->perfTag;
+        record.cpuBegin   = ((uint64_t)entry->beginCpuTime[1] << 32) | entry->beginCpuTime[0];
+        record.gpuBegin   = *(const volatile uint64_t *)(data + beginOffset);
+        record.gpuEnd     = *(const volatile uint64_t *)(data + endOffset);
+
+        // End of the previous sequence in a reused slot is older than the new begin
+        return record.gpuEnd >= record.gpuBegin;
+    };
+
+    MediaPerfProfilerStream::Source *source = m_stream->AddSource(capacity, read);
+    if (source == nullptr)
+    {
+        osInterface->pfnUnlockResource(osInterface, m_perfStoreBufferMap[pOsContext]);
+        DestroyIdleStream();
+        return MOS_STATUS_NO_SPACE;
+    }
+    m_streamSourceMap[pOsContext] = source;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+void MediaPerfProfilerNext::DestroyIdleStream()
+{
+    // The stream is only kept while a context streams to it
+    if (m_streamSourceMap.empty())
+    {
+        MOS_Delete(m_stream);
+    }
+}
+
+void MediaPerfProfilerNext::StopStream(MOS_INTERFACE *osInterface)
+{
+    CHK_NULL_NO_STATUS_RETURN(osInterface);
+
+    PMOS_CONTEXT pOsContext = osInterface->pOsContext;
+    auto         source     = m_streamSourceMap.find(pOsContext);
+    if (source == m_streamSourceMap.end())
+    {
+        return;
+    }
+
+    m_stream->RemoveSource(source->second);
+    m_streamSourceMap.erase(source);
+
+    osInterface->pfnUnlockResource(osInterface, m_perfStoreBufferMap[pOsContext]);
+
+    // The file is closed with the last context, a later context streams to a new one
+    DestroyIdleStream();
+}
+
+uint32_t MediaPerfProfilerNext::RecordSlot(PMOS_CONTEXT pOsContext, uint32_t sequence)
+{
+    auto source = m_streamSourceMap.find(pOsContext);
+    if (source == m_streamSourceMap.end())
+    {
+        return sequence;
+    }
+
+    // Streamed records are reused in ring, as the ones exported are no longer needed
+    return MediaPerfProfilerStream::Slot(source->second, sequence);
+}
+
 MOS_STATUS MediaPerfProfilerNext::SavePerfData(MOS_INTERFACE *osInterface)
 {
     MOS_STATUS status = MOS_STATUS_SUCCESS;
@@ -680,6 +850,9 @@ MOS_STATUS MediaPerfProfilerNext::SavePerfData(MOS_INTERFACE *osInterface)
 
         CHK_NULL_RETURN(pData);
 
+        // Records wrap around the buffer when streaming
+        uint32_t nodeCount = MOS_MIN(m_perfDataIndexMap[pOsContext], (uint32_t)NODE_CAPACITY(m_bufferSize));
+
         if (m_multiprocess)
         {
             int32_t pid = MosUtilities::MosGetPid();
@@ -690,11 +863,11 @@ MOS_STATUS MediaPerfProfilerNext::SavePerfData(MOS_INTERFACE *osInterface)
             MOS_SecureStringPrint(outputFileName, MOS_MAX_PATH_LENGTH + 1, MOS_MAX_PATH_LENGTH + 1, "%s-pid%d-%04d%02d%02d%02d%02d%02d.bin",
                 m_outputFileName, pid, localtime.tm_year + 1900, localtime.tm_mon + 1, localtime.tm_mday, localtime.tm_hour, localtime.tm_min, localtime.tm_sec);
 
-            MosUtilities::MosWriteFileFromPtr(outputFileName, pData, BASE_OF_NODE(m_perfDataIndexMap[pOsContext]));
+            MosUtilities::MosWriteFileFromPtr(outputFileName, pData, BASE_OF_NODE(nodeCount));
         }
         else
         {
-            MosUtilities::MosWriteFileFromPtr(m_outputFileName, pData, BASE_OF_NODE(m_perfDataIndexMap[pOsContext]));
+            MosUtilities::MosWriteFileFromPtr(m_outputFileName, pData, BASE_OF_NODE(nodeCount));
         }
 
         osInterface->pfnUnlockResource(
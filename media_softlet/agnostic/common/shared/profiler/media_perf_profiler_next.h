@@ -37,6 +37,7 @@
 #include "igfxfmid.h"
 #include "mos_defs_specific.h"
 #include "mos_os_specific.h"
+#include "media_perf_profiler_stream.h"
 namespace mhw
 {
     namespace mi
@@ -276,6 +277,49 @@ public:
     //!
     virtual uint32_t PlatFormIdMap(PLATFORM platform);
 
+    //!
+    //! \brief    Start streaming the records of the context to trace event file
+    //!
+    //! \param    [in] osInterface
+    //!           Pointer of OS interface
+    //! \param    [in] interval
+    //!           Interval of draining completed records in ms
+    //!
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    virtual MOS_STATUS StartStream(MOS_INTERFACE *osInterface, uint32_t interval);
+
+    //!
+    //! \brief    Export the last records of the context and stop streaming it
+    //!
+    //! \param    [in] osInterface
+    //!           Pointer of OS interface
+    //!
+    //! \return   void
+    //!
+    virtual void StopStream(MOS_INTERFACE *osInterface);
+
+    //!
+    //! \brief    Close the trace event file if no context streams to it
+    //!
+    //! \return   void
+    //!
+    void DestroyIdleStream();
+
+    //!
+    //! \brief    Get the buffer slot of record sequence
+    //!
+    //! \param    [in] pOsContext
+    //!           Pointer of DEVICE CONTEXT
+    //! \param    [in] sequence
+    //!           Sequence number of record
+    //!
+    //! \return   uint32_t
+    //!           Index of performance data node in buffer
+    //!
+    uint32_t RecordSlot(PMOS_CONTEXT pOsContext, uint32_t sequence);
+
 public:
     std::unordered_map<PMOS_CONTEXT, PMOS_RESOURCE>  m_perfStoreBufferMap;   //!< Buffer for perf data collection
     std::unordered_map<PMOS_CONTEXT,uint32_t>        m_refMap;               //!< The number of refereces
@@ -292,6 +336,9 @@ public:
     char                          m_outputFileName[MOS_MAX_PATH_LENGTH + 1];  //!< Name of output file
     bool                          m_enableProfilerDump = true;   //!< Indicate whether enable UMD Profiler dump
     std::shared_ptr<mhw::mi::Itf> m_miItf = nullptr;
+    MediaPerfProfilerStream       *m_stream = nullptr;    //!< Exporter of completed records, null if streaming disabled
+    std::unordered_map<PMOS_CONTEXT, MediaPerfProfilerStream::Source*> m_streamSourceMap;  //!< Streamed buffer of context
+    uint32_t                      m_streamSessionCount = 0;  //!< Number of trace event files opened
 MEDIA_CLASS_DEFINE_END(MediaPerfProfilerNext)
 };
 
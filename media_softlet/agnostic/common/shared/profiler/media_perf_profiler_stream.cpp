@@ -0,0 +1,353 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_perf_profiler_stream.cpp
+//! \brief    Defines the incremental exporter of media performance profiler records
+//!
+
+#include <algorithm>
+#include "media_perf_profiler_stream.h"
+#include "media_perf_profiler_next.h"
+#include "mos_util_debug.h"
+#include "mos_utilities.h"
+
+#define EVENT_LEN 512
+
+static const char *EngineName(uint32_t engineTag)
+{
+    switch (engineTag)
+    {
+        case PERF_GPU_NODE_3D:
+            return "GPU Render/Compute";
+        case PERF_GPU_NODE_VIDEO:
+            return "GPU Video";
+        case PERF_GPU_NODE_BLT:
+            return "GPU Blitter";
+        case PERF_GPU_NODE_VE:
+            return "GPU VideoEnhance";
+        case PERF_GPU_NODE_VIDEO2:
+            return "GPU Video2";
+        default:
+            return "GPU Unknown";
+    }
+}
+
+MediaPerfProfilerStream::MediaPerfProfilerStream()
+{
+}
+
+MediaPerfProfilerStream::~MediaPerfProfilerStream()
+{
+    if (m_started)
+    {
+        MosUtilities::MosLockMutex(m_mutex);
+        m_exit = true;
+        MosUtilities::MosUnlockMutex(m_mutex);
+
+        // Worker thread checks the exit flag after each interval
+        MosUtilities::MosWaitThread(m_thread);
+
+        for (auto source : m_sources)
+        {
+            Drain(source, true);
+            MOS_Delete(source);
+        }
+        m_sources.clear();
+        FlushEvents();
+
+        MOS_OS_NORMALMESSAGE("Perf profiler stream exported %llu records, dropped %llu, in %llu drains.",
+            (unsigned long long)m_stats.exported,
+            (unsigned long long)m_stats.dropped,
+            (unsigned long long)m_stats.drains);
+    }
+
+    if (m_file)
+    {
+        // Closing the array is optional for trace event viewers, so a file cut by a crash is still loadable
+        fputs("\n]\n", m_file);
+        fclose(m_file);
+        m_file = nullptr;
+    }
+    if (m_mutex)
+    {
+        MosUtilities::MosDestroyMutex(m_mutex);
+        m_mutex = nullptr;
+    }
+}
+
+MOS_STATUS MediaPerfProfilerStream::Start(const char *fileName, uint32_t timerBase, uint32_t interval)
+{
+    MOS_OS_CHK_NULL_RETURN(fileName);
+
+    if (m_started)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+    if (timerBase == 0 || interval == 0)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    m_timerBase = timerBase;
+    m_interval  = interval;
+    m_pid       = MosUtilities::MosGetPid();
+
+    m_mutex = MosUtilities::MosCreateMutex();
+    MOS_OS_CHK_NULL_RETURN(m_mutex);
+
+    MOS_OS_CHK_STATUS_RETURN(MosUtilities::MosSecureFileOpen(&m_file, fileName, "w"));
+    MOS_OS_CHK_NULL_RETURN(m_file);
+    fputs("[\n", m_file);
+
+    m_thread = MosUtilities::MosCreateThread((void *)WorkerThread, this);
+    if (m_thread == 0)
+    {
+        MOS_OS_ASSERTMESSAGE("Failed to create perf profiler stream thread.");
+        return MOS_STATUS_UNKNOWN;
+    }
+    m_started = true;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MediaPerfProfilerStream::Source *MediaPerfProfilerStream::AddSource(uint32_t capacity, ReadFunc read)
+{
+    if (!m_started || capacity == 0)
+    {
+        return nullptr;
+    }
+
+    Source *source = MOS_New(Source);
+    if (source == nullptr)
+    {
+        return nullptr;
+    }
+    source->read     = std::move(read);
+    source->capacity = capacity;
+
+    MosUtilities::MosLockMutex(m_mutex);
+    source->id = m_nextSourceId++;
+    m_sources.push_back(source);
+    MosUtilities::MosUnlockMutex(m_mutex);
+
+    return source;
+}
+
+void MediaPerfProfilerStream::RemoveSource(Source *source)
+{
+    if (source == nullptr)
+    {
+        return;
+    }
+
+    MosUtilities::MosLockMutex(m_mutex);
+    auto it = std::find(m_sources.begin(), m_sources.end(), source);
+    if (it != m_sources.end())
+    {
+        Drain(source, true);
+        FlushEvents();
+        m_sources.erase(it);
+    }
+    MosUtilities::MosUnlockMutex(m_mutex);
+
+    MOS_Delete(source);
+}
+
+MediaPerfProfilerStream::Statistics MediaPerfProfilerStream::GetStatistics()
+{
+    if (!m_started)
+    {
+        return m_stats;
+    }
+
+    MosUtilities::MosLockMutex(m_mutex);
+    Statistics stats = m_stats;
+    MosUtilities::MosUnlockMutex(m_mutex);
+    return stats;
+}
+
+uint64_t MediaPerfProfilerStream::TicksToNs(uint64_t ticks)
+{
+    // Split to avoid overflow of ticks * 1e9
+    return (ticks / m_timerBase) * 1000000000ull + (ticks % m_timerBase) * 1000000000ull / m_timerBase;
+}
+
+void MediaPerfProfilerStream::Drain(Source *source, bool final)
+{
+    uint32_t submitted = source->submitted.load(std::memory_order_acquire);
+    bool     advanced  = true;
+
+    while (advanced)
+    {
+        // Slots of sequences older than one ring were reused by newer ones
+        if (submitted - source->next > source->capacity)
+        {
+            uint32_t oldest = submitted - source->capacity;
+            auto     last   = source->exported.lower_bound(oldest);
+            m_stats.dropped += (oldest - source->next) - std::distance(source->exported.begin(), last);
+            source->exported.erase(source->exported.begin(), last);
+            source->next = oldest;
+        }
+
+        // Records complete out of order across engines, so a window after the oldest pending one is scanned
+        uint32_t start = source->next;
+        uint32_t end   = start + MOS_MIN(submitted - start, m_scanWindow);
+        for (uint32_t sequence = start; sequence != end; sequence++)
+        {
+            if (source->exported.count(sequence))
+            {
+                continue;
+            }
+            Record record;
+            if (source->read(sequence, record))
+            {
+                AppendRecord(source, sequence, record);
+                source->exported.insert(sequence);
+                m_stats.exported++;
+            }
+        }
+
+        // The oldest record stays pending forever if its command buffer was never submitted,
+        // so it is given up once half of the window after it is exported
+        while (!source->exported.empty())
+        {
+            if (*source->exported.begin() == source->next)
+            {
+                source->exported.erase(source->exported.begin());
+            }
+            else if (source->exported.size() >= m_scanWindow / 2)
+            {
+                m_stats.dropped++;
+            }
+            else
+            {
+                break;
+            }
+            source->next++;
+        }
+
+        advanced = (source->next - start >= m_scanWindow);
+    }
+
+    if (final)
+    {
+        m_stats.dropped += (submitted - source->next) - source->exported.size();
+        source->exported.clear();
+        source->next = submitted;
+    }
+}
+
+void MediaPerfProfilerStream::AppendRecord(const Source *source, uint32_t sequence, const Record &record)
+{
+    uint64_t gpuBegin = TicksToNs(record.gpuBegin);
+    uint64_t gpuEnd   = TicksToNs(record.gpuEnd);
+    int64_t  cpuBegin = (int64_t)record.cpuBegin * 1000;
+
+    // GPU runs the commands after CPU builds them, so the largest CPU minus GPU time is
+    // the closest estimate of the offset between the clocks
+    int64_t offset = cpuBegin - (int64_t)gpuBegin;
+    if (!m_offsetValid || offset > m_clockOffset)
+    {
+        m_clockOffset = offset;
+        m_offsetValid = true;
+    }
+
+    int32_t  pid      = record.processId ? (int32_t)record.processId : m_pid;
+    uint32_t tid      = m_engineTidBase + (record.engineTag & 0xff);
+    uint32_t cpuTid   = m_engineTidBase + 0x100;
+    uint64_t flowId   = ((uint64_t)source->id << 32) | sequence;
+    double   ts       = (double)((int64_t)gpuBegin + m_clockOffset) / 1000.0;
+    double   dur      = (double)(gpuEnd - gpuBegin) / 1000.0;
+    double   submitTs = (double)record.cpuBegin;
+    char     event[EVENT_LEN];
+
+    if (m_firstEvent)
+    {
+        MOS_SecureStringPrint(event, EVENT_LEN, EVENT_LEN,
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":\"CPU Submit\"}}",
+            pid, cpuTid);
+        m_events += event;
+        m_firstEvent = false;
+    }
+    if (m_namedEngines.insert(record.engineTag).second)
+    {
+        MOS_SecureStringPrint(event, EVENT_LEN, EVENT_LEN,
+            ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+            pid, tid, EngineName(record.engineTag));
+        m_events += event;
+    }
+
+    // Command building on CPU, linked by a flow to the execution on GPU
+    MOS_SecureStringPrint(event, EVENT_LEN, EVENT_LEN,
+        ",\n{\"name\":\"0x%x\",\"cat\":\"submit\",\"ph\":\"X\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"dur\":0}"
+        ",\n{\"name\":\"submit\",\"cat\":\"submit\",\"ph\":\"s\",\"id\":%llu,\"pid\":%d,\"tid\":%u,\"ts\":%.3f}",
+        record.perfTag, pid, cpuTid, submitTs,
+        (unsigned long long)flowId, pid, cpuTid, submitTs);
+    m_events += event;
+
+    MOS_SecureStringPrint(event, EVENT_LEN, EVENT_LEN,
+        ",\n{\"name\":\"0x%x\",\"cat\":\"gpu\",\"ph\":\"X\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,"
+        "\"args\":{\"perfTag\":%u,\"instance\":%u,\"sequence\":%u}}"
+        ",\n{\"name\":\"submit\",\"cat\":\"submit\",\"ph\":\"f\",\"bp\":\"e\",\"id\":%llu,\"pid\":%d,\"tid\":%u,\"ts\":%.3f}",
+        record.perfTag, pid, tid, ts, dur, record.perfTag, record.instanceId, sequence,
+        (unsigned long long)flowId, pid, tid, ts);
+    m_events += event;
+}
+
+void MediaPerfProfilerStream::FlushEvents()
+{
+    if (m_file == nullptr || m_events.empty())
+    {
+        return;
+    }
+
+    fwrite(m_events.data(), 1, m_events.size(), m_file);
+    fflush(m_file);
+    m_events.clear();
+}
+
+void *MediaPerfProfilerStream::WorkerThread(void *context)
+{
+    MediaPerfProfilerStream *stream = (MediaPerfProfilerStream *)context;
+
+    while (true)
+    {
+        // Sleeping between drains keeps the thread off CPU while the pipeline is busy
+        MosUtilities::MosSleep(stream->m_interval);
+
+        MosUtilities::MosLockMutex(stream->m_mutex);
+        if (stream->m_exit)
+        {
+            MosUtilities::MosUnlockMutex(stream->m_mutex);
+            break;
+        }
+        stream->m_stats.drains++;
+        for (auto source : stream->m_sources)
+        {
+            stream->Drain(source, false);
+        }
+        stream->FlushEvents();
+        MosUtilities::MosUnlockMutex(stream->m_mutex);
+    }
+
+    return nullptr;
+}
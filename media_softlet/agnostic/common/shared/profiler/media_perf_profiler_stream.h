@@ -0,0 +1,216 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_perf_profiler_stream.h
+//! \brief    Defines the incremental exporter of media performance profiler records
+//! \details  A worker thread wakes up periodically, collects the records whose
+//!           completion tag was written by GPU and appends them to a trace event
+//!           file, which timeline viewers such as chrome://tracing or Perfetto
+//!           load. GPU timestamps are converted to the CPU monotonic clock, so
+//!           the records line up with CPU side events of the same process.
+//!
+
+#ifndef __MEDIA_PERF_PROFILER_STREAM_H__
+#define __MEDIA_PERF_PROFILER_STREAM_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+#include "mos_defs.h"
+#include "mos_os.h"
+#include "media_class_trace.h"
+
+class MediaPerfProfilerStream
+{
+public:
+    //!
+    //! \brief  Record decoded from the profiler buffer
+    //!
+    struct Record
+    {
+        uint32_t processId  = 0;
+        uint32_t instanceId = 0;
+        uint32_t engineTag  = 0;
+        uint32_t perfTag    = 0;
+        uint64_t cpuBegin   = 0;  //!< CPU time of command building in us
+        uint64_t gpuBegin   = 0;  //!< GPU timestamp in ticks
+        uint64_t gpuEnd     = 0;  //!< GPU timestamp in ticks
+    };
+
+    //!
+    //! \brief  Reads the record of sequence from the profiler buffer, called on the worker thread
+    //! \param  [in] sequence
+    //!         Sequence number of the record
+    //! \param  [out] record
+    //!         Decoded record
+    //! \return bool
+    //!         true if the completion tag of the sequence was written by GPU
+    //!
+    using ReadFunc = std::function<bool(uint32_t sequence, Record &record)>;
+
+    //!
+    //! \brief  Profiler buffer of one device context
+    //!
+    struct Source
+    {
+        ReadFunc               read;
+        uint32_t               capacity  = 0;  //!< Records fitting the buffer, slots are reused in ring
+        std::atomic<uint32_t>  submitted {0};  //!< Sequences handed out by profiler
+        uint32_t               next      = 0;  //!< Oldest sequence not exported nor dropped
+        uint32_t               id        = 0;  //!< Identifies the source in flow events
+        std::set<uint32_t>     exported;       //!< Sequences after next exported out of order
+    };
+
+    //!
+    //! \brief  Counters of the exporter
+    //!
+    struct Statistics
+    {
+        uint64_t exported = 0;  //!< Records written to file
+        uint64_t dropped  = 0;  //!< Records overwritten in ring or never completed
+        uint64_t drains   = 0;  //!< Wake ups of worker thread
+    };
+
+    MediaPerfProfilerStream();
+
+    //!
+    //! \brief  Destructor, stops the worker thread and closes the file
+    //!
+    virtual ~MediaPerfProfilerStream();
+
+    //!
+    //! \brief  Open the trace file and start the worker thread
+    //! \param  [in] fileName
+    //!         Name of trace event file
+    //! \param  [in] timerBase
+    //!         Frequency of GPU timestamp in Hz
+    //! \param  [in] interval
+    //!         Wake up interval of worker thread in ms
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Start(const char *fileName, uint32_t timerBase, uint32_t interval);
+
+    //!
+    //! \brief  Register the buffer of a device context
+    //! \param  [in] capacity
+    //!         Number of records fitting the buffer
+    //! \param  [in] read
+    //!         Function decoding a record from the buffer
+    //! \return Source *
+    //!         Handle passed to Submit and RemoveSource, nullptr if failed
+    //!
+    Source *AddSource(uint32_t capacity, ReadFunc read);
+
+    //!
+    //! \brief  Export the completed records of source and unregister it
+    //! \details Records not completed are counted as dropped. GPU must be idle
+    //!          on the buffer, and the buffer may be unmapped after return.
+    //! \param  [in] source
+    //!         Handle returned by AddSource
+    //!
+    void RemoveSource(Source *source);
+
+    //!
+    //! \brief  Publish sequences handed out by profiler, lock free
+    //! \param  [in] source
+    //!         Handle returned by AddSource
+    //! \param  [in] count
+    //!         Number of sequences handed out
+    //!
+    static void Submit(Source *source, uint32_t count)
+    {
+        source->submitted.store(count, std::memory_order_release);
+    }
+
+    //!
+    //! \brief  Get the ring slot of sequence
+    //!
+    static uint32_t Slot(const Source *source, uint32_t sequence)
+    {
+        return sequence % source->capacity;
+    }
+
+    //!
+    //! \brief  Get counters of the exporter
+    //! \return Statistics
+    //!
+    Statistics GetStatistics();
+
+    static const uint32_t m_scanWindow    = 1024;        //!< Records scanned after the oldest pending one
+    static const uint32_t m_engineTidBase = 0x7fff0000;  //!< Thread id of GPU engine tracks in viewer
+
+protected:
+    //!
+    //! \brief  Export the completed records of source, m_mutex must be held
+    //! \param  [in] source
+    //!         Source to drain
+    //! \param  [in] final
+    //!         Drop the records not completed
+    //!
+    void Drain(Source *source, bool final);
+
+    //!
+    //! \brief  Format one record as trace events
+    //!
+    void AppendRecord(const Source *source, uint32_t sequence, const Record &record);
+
+    //!
+    //! \brief  Convert GPU ticks to ns
+    //!
+    uint64_t TicksToNs(uint64_t ticks);
+
+    //!
+    //! \brief  Write formatted events to file, m_mutex must be held
+    //!
+    void FlushEvents();
+
+    //!
+    //! \brief  Entry of the worker thread
+    //!
+    static void *WorkerThread(void *context);
+
+    MOS_THREADHANDLE       m_thread       = 0;
+    PMOS_MUTEX             m_mutex        = nullptr;
+    FILE                  *m_file         = nullptr;
+    std::vector<Source *>  m_sources;
+    std::string            m_events;                  //!< Events formatted and not written yet
+    uint32_t               m_timerBase    = 0;
+    uint32_t               m_interval     = 0;
+    uint32_t               m_nextSourceId = 0;
+    int32_t                m_pid          = 0;
+    std::set<uint32_t>     m_namedEngines;            //!< Engines whose track name is written
+    int64_t                m_clockOffset  = 0;        //!< CPU monotonic ns minus GPU ns
+    bool                   m_offsetValid  = false;
+    bool                   m_firstEvent   = true;
+    bool                   m_exit         = false;
+    bool                   m_started      = false;
+    Statistics             m_stats        = {};
+
+MEDIA_CLASS_DEFINE_END(MediaPerfProfilerStream)
+};
+
+#endif  // __MEDIA_PERF_PROFILER_STREAM_H__
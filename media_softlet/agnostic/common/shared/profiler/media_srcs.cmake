@@ -21,11 +21,13 @@
 set(TMP_SOURCES_
     ${TMP_SOURCES_}
     ${CMAKE_CURRENT_LIST_DIR}/media_perf_profiler_next.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/media_perf_profiler_stream.cpp
 )
 
 set(TMP_HEADERS_
     ${TMP_HEADERS_}
     ${CMAKE_CURRENT_LIST_DIR}/media_perf_profiler_next.h
+    ${CMAKE_CURRENT_LIST_DIR}/media_perf_profiler_stream.h
 )
 
 media_add_curr_to_include_path()
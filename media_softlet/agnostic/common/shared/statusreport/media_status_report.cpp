@@ -89,6 +89,54 @@ MOS_STATUS MediaStatusReport::GetReport(uint16_t requireNum, void *status)
     return eStatus;
 }
 
+MOS_STATUS MediaStatusReport::GetCompletedReports(void *status, uint32_t maxNum, uint32_t &numReports)
+{
+    MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
+
+    numReports = 0;
+    if (status == nullptr || m_completedCount == nullptr)
+    {
+        return MOS_STATUS_NULL_POINTER;
+    }
+
+    uint32_t completedCount = *(volatile uint32_t *)m_completedCount;
+    uint32_t reportedCount  = m_reportedCount;
+    uint32_t availableCount = completedCount - reportedCount;
+
+    if ((int32_t)availableCount <= 0)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+    if (availableCount > m_statusNum)
+    {
+        // entries older than the ring size are overwritten already
+        reportedCount  = completedCount - m_statusNum;
+        availableCount = m_statusNum;
+    }
+
+    uint32_t count = MOS_MIN(availableCount, maxNum);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t reportIndex = CounterToIndex(reportedCount + i);
+        // m_reportedCount is used by component. Need to assign actual index before call ParseStatus
+        m_reportedCount = reportIndex;
+        uint8_t   *report      = (uint8_t *)status + m_sizeOfReport * i;
+        MOS_STATUS parseStatus = ParseStatus(report, reportIndex);
+        if (parseStatus != MOS_STATUS_SUCCESS)
+        {
+            // the entry is consumed anyway, report it as incomplete so that
+            // the caller still gets the entry and can release its surface
+            SetStatus(report, reportIndex, false);
+            eStatus = parseStatus;
+        }
+    }
+
+    m_reportedCount = reportedCount + count;
+    numReports      = count;
+
+    return eStatus;
+}
+
 MOS_STATUS MediaStatusReport::RegistObserver(MediaStatusReportObserver *observer)
 {
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
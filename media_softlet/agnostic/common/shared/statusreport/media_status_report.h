@@ -96,6 +96,23 @@ public:
     //!
     MOS_STATUS GetReport(uint16_t numStatus, void *status);
     //!
+    //! \brief  Get all reports completed since the last call in one pass.
+    //! \details The completed count is read once and every report up to it is
+    //!          final, so the reports are parsed in submission order without
+    //!          polling or locking each entry.
+    //! \param  [out] status
+    //!         The report buffer, with room for maxNum reports
+    //! \param  [in] maxNum
+    //!         The maximum number of reports to get
+    //! \param  [out] numReports
+    //!         The number of reports written to status, it is valid even if
+    //!         failure is returned. A report failing to parse is written with
+    //!         incomplete status.
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS GetCompletedReports(void *status, uint32_t maxNum, uint32_t &numReports);
+    //!
     //! \brief  Get address of status report.
     //! \param  [in] statusReportType
     //!         status report item type
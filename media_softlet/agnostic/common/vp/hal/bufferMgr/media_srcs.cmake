@@ -19,11 +19,13 @@
 # OTHER DEALINGS IN THE SOFTWARE.
 
 set(TMP_SOURCES_
+    ${CMAKE_CURRENT_LIST_DIR}/vp_3dlut_cache.cpp
     ${CMAKE_CURRENT_LIST_DIR}/vp_allocator.cpp
     ${CMAKE_CURRENT_LIST_DIR}/vp_resource_manager.cpp
 )
 
 set(TMP_HEADERS_
+    ${CMAKE_CURRENT_LIST_DIR}/vp_3dlut_cache.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_allocator.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_resource_manager.h
 )
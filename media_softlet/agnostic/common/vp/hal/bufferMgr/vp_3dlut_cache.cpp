@@ -0,0 +1,84 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_3dlut_cache.cpp
+//! \brief    Cache of the 3DLut tables calculated for HDR tone mapping.
+//!
+#include "vp_3dlut_cache.h"
+
+using namespace vp;
+
+bool Vp3DLutCache::Select(const VP_3DLUT_CACHE_KEY &key)
+{
+    uint32_t lruIndex = 0;
+    for (uint32_t i = 0; i < VP_NUM_3DLUT_CACHE_ENTRIES; ++i)
+    {
+        auto &entry = m_entries[i];
+        if (entry.valid && entry.key == key)
+        {
+            entry.lastUsed = ++m_useCount;
+            m_current      = i;
+            m_stats.hits++;
+            return true;
+        }
+        // Prefer the entry without valid table, then the least recently used one.
+        auto &lru = m_entries[lruIndex];
+        if (lru.valid && (!entry.valid || entry.lastUsed < lru.lastUsed))
+        {
+            lruIndex = i;
+        }
+    }
+
+    auto &entry = m_entries[lruIndex];
+    if (entry.valid)
+    {
+        m_stats.evictions++;
+    }
+    // Not hit by any lookup until the kernel calculating the table is submitted.
+    entry.key      = key;
+    entry.valid    = false;
+    entry.lastUsed = ++m_useCount;
+    m_current      = lruIndex;
+    m_pending      = lruIndex;
+    m_stats.misses++;
+
+    return false;
+}
+
+void Vp3DLutCache::ValidatePending()
+{
+    if (m_pending < VP_NUM_3DLUT_CACHE_ENTRIES)
+    {
+        m_entries[m_pending].valid = true;
+        m_pending                  = VP_NUM_3DLUT_CACHE_ENTRIES;
+    }
+}
+
+void Vp3DLutCache::DropPending()
+{
+    m_pending = VP_NUM_3DLUT_CACHE_ENTRIES;
+}
+
+void Vp3DLutCache::InvalidateCurrent()
+{
+    m_entries[m_current].valid = false;
+}
@@ -0,0 +1,146 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_3dlut_cache.h
+//! \brief    Cache of the 3DLut tables calculated for HDR tone mapping.
+//! \details  A table is looked up by the parameters it is calculated with. An entry
+//!           taken by a miss stays invalid until the 3DLut kernel calculating its
+//!           table has been submitted, so a failed or skipped calculation never
+//!           leaves a stale table to be hit by later frames.
+//!
+#ifndef __VP_3DLUT_CACHE_H__
+#define __VP_3DLUT_CACHE_H__
+
+#include "vp_pipeline_common.h"
+
+#define VP_NUM_3DLUT_CACHE_ENTRIES      4                                       //!< Number of 3DLut tables cached for HDR tone mapping
+
+namespace vp
+{
+//!
+//! \brief Parameters the 3DLut table for HDR tone mapping is calculated with
+//!
+struct VP_3DLUT_CACHE_KEY
+{
+    uint32_t        maxDisplayLum       = 0;
+    uint32_t        maxContentLevelLum  = 0;
+    VPHAL_HDR_MODE  hdrMode             = VPHAL_HDR_MODE_NONE;
+    VPHAL_CSPACE    srcColorSpace       = CSpace_None;
+    VPHAL_CSPACE    dstColorSpace       = CSpace_None;
+
+    bool operator==(const VP_3DLUT_CACHE_KEY &key) const
+    {
+        return maxDisplayLum == key.maxDisplayLum && maxContentLevelLum == key.maxContentLevelLum &&
+               hdrMode == key.hdrMode && srcColorSpace == key.srcColorSpace && dstColorSpace == key.dstColorSpace;
+    }
+};
+
+//!
+//! \brief Counters of the 3DLut table cache
+//!
+struct VP_3DLUT_CACHE_STATISTICS
+{
+    uint64_t    hits        = 0;    //!< Lookups served by a cached table
+    uint64_t    misses      = 0;    //!< Lookups needing the table calculated by kernel
+    uint64_t    evictions   = 0;    //!< Cached tables replaced by misses
+};
+
+class Vp3DLutCache
+{
+public:
+    //!
+    //! \brief    Select the entry for the table calculated with key
+    //! \details  The entry calculated with the same key is selected if cached. Otherwise
+    //!           the least recently used entry is taken and left invalid until
+    //!           ValidatePending is called for it.
+    //! \param    [in] key
+    //!           Parameters the table is calculated with
+    //! \return   bool
+    //!           true if the cached table can be used without calculation
+    //!
+    bool Select(const VP_3DLUT_CACHE_KEY &key);
+
+    //!
+    //! \brief    Mark the entry taken by last miss valid
+    //! \details  Called once the 3DLut kernel calculating its table has been submitted.
+    //!
+    void ValidatePending();
+
+    //!
+    //! \brief    Forget the entry taken by last miss, which stays invalid
+    //! \details  Called at frame end, the calculation has not been submitted if still pending.
+    //!
+    void DropPending();
+
+    //!
+    //! \brief    Invalidate the selected entry, e.g. its surface is reallocated
+    //!
+    void InvalidateCurrent();
+
+    uint32_t GetCurrentIndex()
+    {
+        return m_current;
+    }
+
+    //!
+    //! \brief    Surface of the selected entry, which is allocated and destroyed by resource manager
+    //!
+    VP_SURFACE *&GetCurrentSurface()
+    {
+        return m_entries[m_current].surface;
+    }
+
+    VP_SURFACE *&GetSurface(uint32_t index)
+    {
+        return m_entries[index < VP_NUM_3DLUT_CACHE_ENTRIES ? index : 0].surface;
+    }
+
+    bool IsValid(uint32_t index)
+    {
+        return index < VP_NUM_3DLUT_CACHE_ENTRIES && m_entries[index].valid;
+    }
+
+    const VP_3DLUT_CACHE_STATISTICS &GetStatistics()
+    {
+        return m_stats;
+    }
+
+protected:
+    struct Entry
+    {
+        VP_SURFACE          *surface    = nullptr;
+        VP_3DLUT_CACHE_KEY  key         = {};
+        bool                valid       = false;                                 //!< Table calculated with key has been submitted
+        uint64_t            lastUsed    = 0;
+    };
+
+    Entry                       m_entries[VP_NUM_3DLUT_CACHE_ENTRIES];
+    uint32_t                    m_current   = 0;
+    uint32_t                    m_pending   = VP_NUM_3DLUT_CACHE_ENTRIES;         //!< Entry waiting for calculation, VP_NUM_3DLUT_CACHE_ENTRIES if none
+    uint64_t                    m_useCount  = 0;
+    VP_3DLUT_CACHE_STATISTICS   m_stats     = {};
+
+MEDIA_CLASS_DEFINE_END(vp__Vp3DLutCache)
+};
+}  // namespace vp
+
+#endif  // __VP_3DLUT_CACHE_H__
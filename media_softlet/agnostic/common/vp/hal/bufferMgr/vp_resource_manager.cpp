@@ -196,10 +196,21 @@ VpResourceManager::~VpResourceManager()
         m_allocator.DestroyVpSurface(m_veboxDNSpatialConfigSurface);
     }
 
-    if (m_vebox3DLookUpTables)
+    const VP_3DLUT_CACHE_STATISTICS &lutCacheStats = m_3DLutCache.GetStatistics();
+    VP_PUBLIC_NORMALMESSAGE("3DLut cache hits %llu, misses %llu, evictions %llu.",
+        (unsigned long long)lutCacheStats.hits, (unsigned long long)lutCacheStats.misses,
+        (unsigned long long)lutCacheStats.evictions);
+
+    // m_vebox3DLookUpTables points to one of cache entries.
+    for (uint32_t i = 0; i < VP_NUM_3DLUT_CACHE_ENTRIES; ++i)
     {
-        m_allocator.DestroyVpSurface(m_vebox3DLookUpTables);
+        VP_SURFACE *&surface = m_3DLutCache.GetSurface(i);
+        if (surface)
+        {
+            m_allocator.DestroyVpSurface(surface);
+        }
     }
+    m_vebox3DLookUpTables = nullptr;
 
     if (m_vebox3DLookUpTables2D)
     {
@@ -589,6 +600,8 @@ void VpResourceManager::OnNewFrameProcessEnd()
     m_allocator.CleanRecycler();
     m_currentPipeIndex = 0;
     CleanTempSurfaces();
+    // 3DLut table not submitted for calculation in this frame is left invalid in cache.
+    m_3DLutCache.DropPending();
 }
 
 void VpResourceManager::InitSurfaceConfigMap()
@@ -1853,8 +1866,9 @@ MOS_STATUS VpResourceManager::Allocate3DLut(VP_EXECUTE_CAPS& caps)
         uint32_t lutWidth = 0;
         uint32_t lutHeight = 0;
         size = Get3DLutSize(lutWidth, lutHeight);
+        VP_SURFACE *&surface = m_3DLutCache.GetCurrentSurface();
         VP_PUBLIC_CHK_STATUS_RETURN(m_allocator.ReAllocateSurface(
-            m_vebox3DLookUpTables,
+            surface,
             "Vebox3DLutTableSurface",
             Format_Buffer,
             MOS_GFXRES_BUFFER,
@@ -1868,11 +1882,27 @@ MOS_STATUS VpResourceManager::Allocate3DLut(VP_EXECUTE_CAPS& caps)
             IsDeferredResourceDestroyNeeded(),
             MOS_HW_RESOURCE_USAGE_VP_INTERNAL_READ_WRITE_RENDER));
 
+        if (isAllocated && !caps.b3DLutCalc)
+        {
+            // Cached table is lost with the new allocation, which is to be calculated on next lookup.
+            VP_PUBLIC_NORMALMESSAGE("3DLut cache entry %d reallocated without calculation.", m_3DLutCache.GetCurrentIndex());
+            m_3DLutCache.InvalidateCurrent();
+        }
+        m_vebox3DLookUpTables = surface;
     }
 
     return MOS_STATUS_SUCCESS;
 }
 
+bool VpResourceManager::Select3DLutCacheEntry(const VP_3DLUT_CACHE_KEY &key)
+{
+    VP_FUNC_CALL();
+
+    bool hit              = m_3DLutCache.Select(key);
+    m_vebox3DLookUpTables = m_3DLutCache.GetCurrentSurface();
+    return hit;
+}
+
 MOS_STATUS VpResourceManager::AllocateResourceFor3DLutKernel(VP_EXECUTE_CAPS& caps)
 {
     VP_FUNC_CALL();
@@ -32,6 +32,7 @@
 #include "vp_allocator.h"
 #include "vp_pipeline_common.h"
 #include "vp_utils.h"
+#include "vp_3dlut_cache.h"
 
 #define VP_MAX_NUM_VEBOX_SURFACES     4                                       //!< Vebox output surface creation, also can be reuse for DI usage:
                                                                               //!< for DI: 2 for ADI plus additional 2 for parallel execution
@@ -329,6 +330,7 @@ struct VP_FRAME_IDS
     int32_t     pastFrameId;
     int32_t     futureFrameId;
 };
+
 struct VP_SURFACE_PARAMS;
 
 class VpResourceManager
@@ -355,6 +357,33 @@ public:
 
     bool IsOutputSurfaceNeeded(VP_EXECUTE_CAPS caps);
 
+    //!
+    //! \brief    Select the 3DLut table for HDR tone mapping
+    //! \details  The table calculated with the same parameters is reused if cached.
+    //!           Otherwise the least recently used entry is taken for the table to be
+    //!           calculated by 3DLut kernel, and is only hit by later lookups after
+    //!           On3DLutCalcSubmitted. The selected table is used as 3DLut surface
+    //!           by both 3DLut kernel and vebox until next selection.
+    //! \param    [in] key
+    //!           Parameters the table is calculated with
+    //! \return   bool
+    //!           true if the cached table can be used without calculation
+    //!
+    bool Select3DLutCacheEntry(const VP_3DLUT_CACHE_KEY &key);
+
+    //!
+    //! \brief    Notify the 3DLut kernel calculating the table selected by last miss is submitted
+    //!
+    void On3DLutCalcSubmitted()
+    {
+        m_3DLutCache.ValidatePending();
+    }
+
+    const VP_3DLUT_CACHE_STATISTICS &Get3DLutCacheStatistics()
+    {
+        return m_3DLutCache.GetStatistics();
+    }
+
     bool IsRefValid()
     {
         return m_currentFrameIds.pastFrameAvailable || m_currentFrameIds.futureFrameAvailable;
@@ -532,6 +561,7 @@ protected:
     VP_SURFACE *m_vebox1DLookUpTables                        = nullptr;
     VP_SURFACE *m_veboxDnHVSTables                           = nullptr;
     VP_SURFACE *m_3DLutKernelCoefSurface                     = nullptr;       //!< Coef surface for 3DLut kernel.
+    Vp3DLutCache m_3DLutCache;                                                  //!< m_vebox3DLookUpTables points to the selected one.
     uint32_t    m_currentDnOutput                            = 0;
     uint32_t    m_currentStmmIndex                           = 0;
     uint32_t    m_veboxOutputCount                           = 2;             //!< PE on: 4 used. PE off: 2 used
@@ -28,6 +28,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/sw_filter.cpp
     ${CMAKE_CURRENT_LIST_DIR}/sw_filter_handle.cpp
     ${CMAKE_CURRENT_LIST_DIR}/vp_kernelset.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/vp_policy_plan_cache.cpp
 )
 
 set(TMP_HEADERS_
@@ -41,6 +42,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/vp_feature_caps.h
     ${CMAKE_CURRENT_LIST_DIR}/sw_filter_handle.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_kernelset.h
+    ${CMAKE_CURRENT_LIST_DIR}/vp_policy_plan_cache.h
 )
 
 set(SOFTLET_VP_SOURCES_
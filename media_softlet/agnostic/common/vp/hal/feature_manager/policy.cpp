@@ -45,6 +45,7 @@ Policy::Policy(VpInterface &vpInterface) : m_vpInterface(vpInterface)
 
 Policy::~Policy()
 {
+    MOS_Delete(m_planCache);
     UnregisterFeatures();
 }
 
@@ -56,6 +57,19 @@ MOS_STATUS Policy::Initialize()
     VP_PUBLIC_CHK_NULL_RETURN(vpPlatformInterface);
     VP_PUBLIC_CHK_STATUS_RETURN(vpPlatformInterface->InitVpHwCaps(m_hwCaps));
     VP_PUBLIC_CHK_STATUS_RETURN(RegisterFeatures());
+
+    auto userFeatureControl = m_vpInterface.GetHwInterface()->m_userFeatureControl;
+    if (m_planCache)
+    {
+        // Hw caps may be changed.
+        m_planCache->Invalidate();
+    }
+    else if (userFeatureControl && userFeatureControl->IsPolicyPlanCacheEnabled())
+    {
+        m_planCache = MOS_New(VpPolicyPlanCache, userFeatureControl->IsPolicyPlanCacheCrossCheckEnabled());
+        VP_PUBLIC_CHK_NULL_RETURN(m_planCache);
+    }
+
     m_initialized = true;
     return MOS_STATUS_SUCCESS;
 }
@@ -494,15 +508,201 @@ MOS_STATUS Policy::BuildExecutionEngines(SwFilterPipe &swFilterPipe, bool isInpu
 
     if (pipe)
     {
+        if (m_planCache)
+        {
+            bool hit = false;
+            VP_PUBLIC_CHK_STATUS_RETURN(LookupPlanCache(*pipe, hit));
+            if (hit)
+            {
+                VP_PUBLIC_NORMALMESSAGE("Engine caps applied from policy plan cache.");
+                return MOS_STATUS_SUCCESS;
+            }
+        }
+
         for (auto filterID : m_featurePool)
         {
             VP_PUBLIC_CHK_STATUS_RETURN(GetExecutionCapsForSingleFeature(filterID, *pipe, engineCapsCombined));
         }
         VP_PUBLIC_CHK_STATUS_RETURN(FilterFeatureCombination(swFilterPipe, isInputPipe, index, engineCapsCombined));
+
+        if (m_planCache)
+        {
+            VP_PUBLIC_CHK_STATUS_RETURN(UpdatePlanCache(*pipe));
+        }
     }
     return MOS_STATUS_SUCCESS;
 }
 
+template <class T>
+static MOS_STATUS AppendPlanCacheKey(SwFilter &swFilter, std::vector<uint32_t> &key)
+{
+    T *filter = dynamic_cast<T *>(&swFilter);
+    VP_PUBLIC_CHK_NULL_RETURN(filter);
+    VpPolicyPlanCache::AppendKey(filter->GetSwFilterParams(), key);
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS Policy::LookupPlanCache(SwFilterSubPipe &pipe, bool &hit)
+{
+    VP_FUNC_CALL();
+    VP_PUBLIC_CHK_NULL_RETURN(m_planCache);
+
+    hit = false;
+
+    // Control values read during evaluation besides feature parameters.
+    auto userFeatureControl = m_vpInterface.GetHwInterface()->m_userFeatureControl;
+    VP_PUBLIC_CHK_NULL_RETURN(userFeatureControl);
+    VpPolicyPlanCache::KEY key = {};
+    key.context                = (userFeatureControl->IsSfcDisabled() ? 1 : 0) |
+                                 (userFeatureControl->IsVeboxOutputDisabled() ? 2 : 0);
+
+    for (auto type : m_featurePool)
+    {
+        SwFilter *swFilter = pipe.GetSwFilter(type);
+        if (nullptr == swFilter)
+        {
+            continue;
+        }
+        // Engine caps being set means the sub pipe is evaluated again for next pass,
+        // where features already processed are skipped.
+        if (swFilter->GetFilterEngineCaps().value != 0)
+        {
+            m_planCache->Bypass();
+            return MOS_STATUS_SUCCESS;
+        }
+
+        // DI and HDR are not cacheable, as their evaluation depends on the reference
+        // and 3DLut state of resource manager, which changes from frame to frame.
+        switch (type)
+        {
+        case FeatureTypeCsc:
+            VP_PUBLIC_CHK_STATUS_RETURN(AppendPlanCacheKey<SwFilterCsc>(*swFilter, key.values));
+            break;
+        case FeatureTypeScaling:
+            VP_PUBLIC_CHK_STATUS_RETURN(AppendPlanCacheKey<SwFilterScaling>(*swFilter, key.values));
+            break;
+        case FeatureTypeRotMir:
+            VP_PUBLIC_CHK_STATUS_RETURN(AppendPlanCacheKey<SwFilterRotMir>(*swFilter, key.values));
+            break;
+        case FeatureTypeDn:
+            VP_PUBLIC_CHK_STATUS_RETURN(AppendPlanCacheKey<SwFilterDenoise>(*swFilter, key.values));
+            break;
+        case FeatureTypeSte:
+            VP_PUBLIC_CHK_STATUS_RETURN(AppendPlanCacheKey<SwFilterSte>(*swFilter, key.values));
+            break;
+        case FeatureTypeTcc:
+            VP_PUBLIC_CHK_STATUS_RETURN(AppendPlanCacheKey<SwFilterTcc>(*swFilter, key.values));
+            break;
+        case FeatureTypeProcamp:
+            VP_PUBLIC_CHK_STATUS_RETURN(AppendPlanCacheKey<SwFilterProcamp>(*swFilter, key.values));
+            break;
+        case FeatureTypeLumakey:
+            VP_PUBLIC_CHK_STATUS_RETURN(AppendPlanCacheKey<SwFilterLumakey>(*swFilter, key.values));
+            break;
+        case FeatureTypeBlending:
+            VP_PUBLIC_CHK_STATUS_RETURN(AppendPlanCacheKey<SwFilterBlending>(*swFilter, key.values));
+            break;
+        case FeatureTypeColorFill:
+            VP_PUBLIC_CHK_STATUS_RETURN(AppendPlanCacheKey<SwFilterColorFill>(*swFilter, key.values));
+            break;
+        case FeatureTypeAlpha:
+            VP_PUBLIC_CHK_STATUS_RETURN(AppendPlanCacheKey<SwFilterAlpha>(*swFilter, key.values));
+            break;
+        default:
+            m_planCache->Bypass();
+            return MOS_STATUS_SUCCESS;
+        }
+    }
+
+    const VpPolicyPlanCache::PLAN *plan = m_planCache->Lookup(key);
+    if (nullptr == plan)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    for (auto &featurePlan : *plan)
+    {
+        SwFilter *swFilter = pipe.GetSwFilter(featurePlan.type);
+        VP_PUBLIC_CHK_NULL_RETURN(swFilter);
+
+        // Only the parameters written by evaluation are restored, the others are covered by key.
+        if (FeatureTypeCsc == featurePlan.type && !featurePlan.iefParamsPresent)
+        {
+            SwFilterCsc *csc = dynamic_cast<SwFilterCsc *>(swFilter);
+            VP_PUBLIC_CHK_NULL_RETURN(csc);
+            csc->GetSwFilterParams().pIEFParams = nullptr;
+        }
+        else if (FeatureTypeScaling == featurePlan.type)
+        {
+            SwFilterScaling *scaling = dynamic_cast<SwFilterScaling *>(swFilter);
+            VP_PUBLIC_CHK_NULL_RETURN(scaling);
+            scaling->GetSwFilterParams().scalingPreference = featurePlan.scalingPreference;
+        }
+        else if (FeatureTypeDn == featurePlan.type)
+        {
+            SwFilterDenoise *denoise = dynamic_cast<SwFilterDenoise *>(swFilter);
+            VP_PUBLIC_CHK_NULL_RETURN(denoise);
+            denoise->GetSwFilterParams().stage                = featurePlan.dnStage;
+            denoise->GetSwFilterParams().widthAlignUnitInput  = featurePlan.widthAlignUnitInput;
+            denoise->GetSwFilterParams().heightAlignUnitInput = featurePlan.heightAlignUnitInput;
+        }
+        swFilter->GetFilterEngineCaps() = featurePlan.engineCaps;
+        VP_PUBLIC_CHK_STATUS_RETURN(swFilter->SetRenderTargetType(featurePlan.renderTargetType));
+    }
+
+    hit = true;
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS Policy::UpdatePlanCache(SwFilterSubPipe &pipe)
+{
+    VP_FUNC_CALL();
+    VP_PUBLIC_CHK_NULL_RETURN(m_planCache);
+
+    if (!m_planCache->IsPending())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    VpPolicyPlanCache::PLAN plan;
+    for (auto type : m_featurePool)
+    {
+        SwFilter *swFilter = pipe.GetSwFilter(type);
+        if (nullptr == swFilter)
+        {
+            continue;
+        }
+
+        VpPolicyPlanCache::FEATURE_PLAN featurePlan = {};
+        featurePlan.type             = type;
+        featurePlan.engineCaps       = swFilter->GetFilterEngineCaps();
+        featurePlan.renderTargetType = swFilter->GetRenderTargetType();
+        if (FeatureTypeCsc == type)
+        {
+            SwFilterCsc *csc = dynamic_cast<SwFilterCsc *>(swFilter);
+            VP_PUBLIC_CHK_NULL_RETURN(csc);
+            featurePlan.iefParamsPresent = nullptr != csc->GetSwFilterParams().pIEFParams;
+        }
+        else if (FeatureTypeScaling == type)
+        {
+            SwFilterScaling *scaling = dynamic_cast<SwFilterScaling *>(swFilter);
+            VP_PUBLIC_CHK_NULL_RETURN(scaling);
+            featurePlan.scalingPreference = scaling->GetSwFilterParams().scalingPreference;
+        }
+        else if (FeatureTypeDn == type)
+        {
+            SwFilterDenoise *denoise = dynamic_cast<SwFilterDenoise *>(swFilter);
+            VP_PUBLIC_CHK_NULL_RETURN(denoise);
+            featurePlan.dnStage              = denoise->GetSwFilterParams().stage;
+            featurePlan.widthAlignUnitInput  = denoise->GetSwFilterParams().widthAlignUnitInput;
+            featurePlan.heightAlignUnitInput = denoise->GetSwFilterParams().heightAlignUnitInput;
+        }
+        plan.push_back(featurePlan);
+    }
+
+    return m_planCache->Update(plan);
+}
+
 MOS_STATUS Policy::Update3DLutoutputColorAndFormat(FeatureParamCsc *cscParams, FeatureParamHdr *hdrParams, MOS_FORMAT Format, VPHAL_CSPACE CSpace)
 {
     // For vebox + render, e.g. BT2020 P010->SRGB, if not correct the format here, since forceCscToRender being enabled, outputFormat in csc filter of
@@ -1614,13 +1814,18 @@ MOS_STATUS Policy::GetHdrExecutionCaps(SwFilter *feature)
     {
         if (Is3DLutKernelSupported())
         {
-            if (hdrParams->uiMaxContentLevelLum != m_savedMaxCLL || hdrParams->uiMaxDisplayLum != m_savedMaxDLL ||
-                hdrParams->hdrMode != m_savedHdrMode)
-            {
-                m_savedMaxCLL = hdrParams->uiMaxContentLevelLum;
-                m_savedMaxDLL = hdrParams->uiMaxDisplayLum;
-                m_savedHdrMode = hdrParams->hdrMode;
+            VpResourceManager *resourceManager = m_vpInterface.GetResourceManager();
+            VP_PUBLIC_CHK_NULL_RETURN(resourceManager);
+
+            VP_3DLUT_CACHE_KEY key = {};
+            key.maxDisplayLum      = hdrParams->uiMaxDisplayLum;
+            key.maxContentLevelLum = hdrParams->uiMaxContentLevelLum;
+            key.hdrMode            = hdrParams->hdrMode;
+            key.srcColorSpace      = hdrParams->srcColorSpace;
+            key.dstColorSpace      = hdrParams->dstColorSpace;
 
+            if (!resourceManager->Select3DLutCacheEntry(key))
+            {
                 hdrParams->stage         = HDR_STAGE_3DLUT_KERNEL;
                 pHDREngine->bEnabled     = 1;
                 pHDREngine->isolated     = 1;
@@ -38,6 +38,7 @@
 #include "hw_filter.h"
 #include "sw_filter_pipe.h"
 #include "vp_resource_manager.h"
+#include "vp_policy_plan_cache.h"
 #include <map>
 
 namespace vp
@@ -73,6 +74,18 @@ public:
         return m_featurePool;
     }
 
+    //!
+    //! \brief    Drop the engine assignment cached for sub pipes
+    //! \details  Needed once anything besides feature parameters affects policy evaluation.
+    //!
+    void InvalidatePlanCache()
+    {
+        if (m_planCache)
+        {
+            m_planCache->Invalidate();
+        }
+    }
+
 protected:
     virtual MOS_STATUS RegisterFeatures();
     virtual void UnregisterFeatures();
@@ -81,6 +94,24 @@ protected:
     virtual MOS_STATUS BuildVeboxSecureFilters(SwFilterPipe& featurePipe, VP_EXECUTE_CAPS& caps, HW_FILTER_PARAMS& params);
 
     MOS_STATUS BuildExecutionEngines(SwFilterPipe &swFilterPipe, bool isInputPipe, uint32_t index);
+    //!
+    //! \brief    Apply the plan cached for sub pipe before its evaluation
+    //! \param    [in] pipe
+    //!           Sub pipe whose features are not evaluated yet
+    //! \param    [out] hit
+    //!           true if engine caps of the sub pipe are set from the plan cache
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    MOS_STATUS LookupPlanCache(SwFilterSubPipe &pipe, bool &hit);
+    //!
+    //! \brief    Keep the plan of sub pipe evaluated after LookupPlanCache missed
+    //! \param    [in] pipe
+    //!           Sub pipe passed to LookupPlanCache
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    MOS_STATUS UpdatePlanCache(SwFilterSubPipe &pipe);
     MOS_STATUS GetHwFilterParam(SwFilterPipe& subSwFilterPipe, HW_FILTER_PARAMS& params);
     MOS_STATUS ReleaseHwFilterParam(HW_FILTER_PARAMS &params);
     MOS_STATUS InitExecuteCaps(VP_EXECUTE_CAPS &caps, VP_EngineEntry &engineCapsInputPipe, VP_EngineEntry &engineCapsOutputPipe);
@@ -187,11 +218,7 @@ protected:
     VpInterface         &m_vpInterface;
     VP_HW_CAPS          m_hwCaps = {};
     bool                m_initialized = false;
-
-    // HDR 3DLut Parameters
-    uint32_t            m_savedMaxDLL   = 1000;
-    uint32_t            m_savedMaxCLL   = 4000;
-    VPHAL_HDR_MODE      m_savedHdrMode  = VPHAL_HDR_MODE_NONE;
+    VpPolicyPlanCache   *m_planCache = nullptr;
 
     //!
     //! \brief    Check whether Alpha Supported
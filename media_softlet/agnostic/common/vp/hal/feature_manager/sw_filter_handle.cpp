@@ -282,28 +282,57 @@ int SwFilterScalingHandler::GetPipeCountForProcessing(VP_PIPELINE_PARAMS& params
 {
     VP_FUNC_CALL();
 
+    int fieldPipeCount = 1;
+
     // For interlaced scaling field-to-interleave mode, need two submission for top field and bottom field,
     // thus we need 2 pipe to handle it.
     if (params.pSrc[0] && params.pSrc[0]->InterlacedScalingType == ISCALING_FIELD_TO_INTERLEAVED &&
         params.pSrc[0]->pBwdRef != nullptr)
     {
-        return 2;
+        fieldPipeCount = 2;
+    }
+
+    // For 1:N multiple outputs, each output is handled by its own pipe.
+    if (1 == params.uSrcCount && params.uDstCount > 1)
+    {
+        return fieldPipeCount * (int)params.uDstCount;
     }
-    return 1;
+
+    return fieldPipeCount;
 }
 
 MOS_STATUS SwFilterScalingHandler::UpdateParamsForProcessing(VP_PIPELINE_PARAMS& params, int index)
 {
     VP_FUNC_CALL();
 
-    if (index >= GetPipeCountForProcessing(params))
+    int pipeCount = GetPipeCountForProcessing(params);
+    if (index >= pipeCount)
     {
         return MOS_STATUS_INVALID_PARAMETER;
     }
 
+    int fieldPipeCount = (1 == params.uSrcCount && params.uDstCount > 1) ? pipeCount / (int)params.uDstCount : pipeCount;
+    int fieldIndex     = index % fieldPipeCount;
+
+    if (1 == params.uSrcCount && params.uDstCount > 1)
+    {
+        uint32_t dstIndex = (uint32_t)(index / fieldPipeCount);
+        VP_PUBLIC_CHK_NULL_RETURN(params.pSrc[0]);
+        VP_PUBLIC_CHK_NULL_RETURN(params.pTarget[dstIndex]);
+
+        params.pTarget[0] = params.pTarget[dstIndex];
+        params.uDstCount  = 1;
+
+        // For multi output, support different scaling ratio but doesn't support cropping.
+        params.pSrc[0]->rcDst.top    = params.pTarget[0]->rcSrc.top;
+        params.pSrc[0]->rcDst.left   = params.pTarget[0]->rcSrc.left;
+        params.pSrc[0]->rcDst.bottom = params.pTarget[0]->rcSrc.bottom;
+        params.pSrc[0]->rcDst.right  = params.pTarget[0]->rcSrc.right;
+    }
+
     // For second submission of field-to-interleaved mode, we will take second field as input surface,
     // second field is stored in pBwdRef.
-    if (params.pSrc[0] && params.pSrc[0]->InterlacedScalingType == ISCALING_FIELD_TO_INTERLEAVED && index == 1)
+    if (params.pSrc[0] && params.pSrc[0]->InterlacedScalingType == ISCALING_FIELD_TO_INTERLEAVED && fieldIndex == 1)
     {
         if (params.pSrc[0] && params.pSrc[0]->pBwdRef)
         {
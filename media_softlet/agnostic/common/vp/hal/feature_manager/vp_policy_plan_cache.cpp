@@ -0,0 +1,372 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_policy_plan_cache.cpp
+//! \brief    Implements the cache of engine assignment done by policy
+//!
+#include "vp_policy_plan_cache.h"
+#include "vp_utils.h"
+
+namespace vp
+{
+VpPolicyPlanCache::VpPolicyPlanCache(bool crossCheck) : m_crossCheck(crossCheck)
+{
+}
+
+VpPolicyPlanCache::~VpPolicyPlanCache()
+{
+    VP_PUBLIC_NORMALMESSAGE("Policy plan cache: hits %lld, misses %lld, bypassed %lld, mismatches %lld, invalidations %lld",
+        (long long)m_stats.hits, (long long)m_stats.misses, (long long)m_stats.bypassed,
+        (long long)m_stats.mismatches, (long long)m_stats.invalidations);
+}
+
+void VpPolicyPlanCache::AppendKey(float value, std::vector<uint32_t> &key)
+{
+    uint32_t bits = 0;
+    MOS_SecureMemcpy(&bits, sizeof(bits), &value, sizeof(value));
+    key.push_back(bits);
+}
+
+void VpPolicyPlanCache::AppendKey(const RECT &rect, std::vector<uint32_t> &key)
+{
+    key.push_back((uint32_t)rect.left);
+    key.push_back((uint32_t)rect.top);
+    key.push_back((uint32_t)rect.right);
+    key.push_back((uint32_t)rect.bottom);
+}
+
+void VpPolicyPlanCache::AppendKey(const FeatureParam &params, std::vector<uint32_t> &key)
+{
+    key.push_back((uint32_t)params.type);
+    key.push_back((uint32_t)params.formatInput);
+    key.push_back((uint32_t)params.formatOutput);
+}
+
+void VpPolicyPlanCache::AppendKey(const VPHAL_IEF_PARAMS *params, std::vector<uint32_t> &key)
+{
+    key.push_back(params ? 1 : 0);
+    if (params)
+    {
+        key.push_back(params->bEnabled);
+        key.push_back(params->bSmoothMode);
+        key.push_back(params->bSkintoneTuned);
+        key.push_back(params->bEmphasizeSkinDetail);
+        AppendKey(params->fIEFFactor, key);
+        key.push_back(params->StrongEdgeWeight);
+        key.push_back(params->RegularWeight);
+        key.push_back(params->StrongEdgeThreshold);
+        key.push_back(params->pExtParam ? 1 : 0);
+    }
+}
+
+void VpPolicyPlanCache::AppendKey(const VPHAL_ALPHA_PARAMS *params, std::vector<uint32_t> &key)
+{
+    key.push_back(params ? 1 : 0);
+    if (params)
+    {
+        AppendKey(params->fAlpha, key);
+        key.push_back((uint32_t)params->AlphaMode);
+    }
+}
+
+void VpPolicyPlanCache::AppendKey(const VPHAL_COLORFILL_PARAMS *params, std::vector<uint32_t> &key)
+{
+    key.push_back(params ? 1 : 0);
+    if (params)
+    {
+        key.push_back(params->bYCbCr);
+        key.push_back(params->Color);
+        key.push_back((uint32_t)params->CSpace);
+        key.push_back(params->bDisableColorfillinSFC);
+        key.push_back(params->bOnePixelBiasinSFC);
+    }
+}
+
+void VpPolicyPlanCache::AppendKey(const FeatureParamCsc &params, std::vector<uint32_t> &key)
+{
+    AppendKey((const FeatureParam &)params, key);
+    key.push_back((uint32_t)params.input.colorSpace);
+    key.push_back(params.input.chromaSiting);
+    key.push_back((uint32_t)params.output.colorSpace);
+    key.push_back(params.output.chromaSiting);
+    AppendKey(params.pIEFParams, key);
+    AppendKey(params.pAlphaParams, key);
+}
+
+void VpPolicyPlanCache::AppendKey(const FeatureParamScaling &params, std::vector<uint32_t> &key)
+{
+    AppendKey((const FeatureParam &)params, key);
+    for (auto scaling : {&params.input, &params.output})
+    {
+        key.push_back(scaling->dwWidth);
+        key.push_back(scaling->dwHeight);
+        AppendKey(scaling->rcSrc, key);
+        AppendKey(scaling->rcDst, key);
+        AppendKey(scaling->rcMaxSrc, key);
+        key.push_back((uint32_t)scaling->sampleType);
+    }
+    key.push_back(params.isPrimary);
+    key.push_back((uint32_t)params.scalingMode);
+    key.push_back((uint32_t)params.scalingPreference);
+    key.push_back(params.bDirectionalScalar);
+    key.push_back(params.bTargetRectangle);
+    key.push_back((uint32_t)params.interlacedScalingType);
+    key.push_back((uint32_t)params.csc.colorSpaceOutput);
+    key.push_back(params.rotation.rotationNeeded);
+    AppendKey(params.pColorFillParams, key);
+    AppendKey(params.pCompAlpha, key);
+}
+
+void VpPolicyPlanCache::AppendKey(const FeatureParamRotMir &params, std::vector<uint32_t> &key)
+{
+    AppendKey((const FeatureParam &)params, key);
+    key.push_back((uint32_t)params.rotation);
+    key.push_back((uint32_t)params.surfInfo.tileOutput);
+}
+
+void VpPolicyPlanCache::AppendKey(const FeatureParamDenoise &params, std::vector<uint32_t> &key)
+{
+    // The HVS and SLIMIPU denoise parameters besides their enabling change from frame to
+    // frame and are not read by evaluation. Alignment units are written by evaluation.
+    AppendKey((const FeatureParam &)params, key);
+    key.push_back((uint32_t)params.sampleTypeInput);
+    key.push_back(params.denoiseParams.bEnableChroma);
+    key.push_back(params.denoiseParams.bEnableLuma);
+    key.push_back(params.denoiseParams.bAutoDetect);
+    AppendKey(params.denoiseParams.fDenoiseFactor, key);
+    key.push_back((uint32_t)params.denoiseParams.NoiseLevel);
+    key.push_back(params.denoiseParams.bEnableHVSDenoise);
+    key.push_back((uint32_t)params.denoiseParams.HVSDenoise.Mode);
+    key.push_back(params.denoiseParams.bEnableSlimIPUDenoise);
+    key.push_back(params.heightInput);
+    key.push_back(params.secureDnNeeded);
+    key.push_back((uint32_t)params.stage);
+}
+
+void VpPolicyPlanCache::AppendKey(const FeatureParamSte &params, std::vector<uint32_t> &key)
+{
+    AppendKey((const FeatureParam &)params, key);
+    key.push_back(params.bEnableSTE);
+    key.push_back(params.dwSTEFactor);
+}
+
+void VpPolicyPlanCache::AppendKey(const FeatureParamTcc &params, std::vector<uint32_t> &key)
+{
+    AppendKey((const FeatureParam &)params, key);
+    key.push_back(params.bEnableTCC);
+    key.push_back(params.Red);
+    key.push_back(params.Green);
+    key.push_back(params.Blue);
+    key.push_back(params.Cyan);
+    key.push_back(params.Magenta);
+    key.push_back(params.Yellow);
+}
+
+void VpPolicyPlanCache::AppendKey(const FeatureParamProcamp &params, std::vector<uint32_t> &key)
+{
+    AppendKey((const FeatureParam &)params, key);
+    key.push_back(params.procampParams ? 1 : 0);
+    if (params.procampParams)
+    {
+        key.push_back(params.procampParams->bEnabled);
+        AppendKey(params.procampParams->fBrightness, key);
+        AppendKey(params.procampParams->fContrast, key);
+        AppendKey(params.procampParams->fHue, key);
+        AppendKey(params.procampParams->fSaturation, key);
+    }
+}
+
+void VpPolicyPlanCache::AppendKey(const FeatureParamLumakey &params, std::vector<uint32_t> &key)
+{
+    AppendKey((const FeatureParam &)params, key);
+    key.push_back(params.lumaKeyParams ? 1 : 0);
+    if (params.lumaKeyParams)
+    {
+        key.push_back((uint32_t)params.lumaKeyParams->LumaLow);
+        key.push_back((uint32_t)params.lumaKeyParams->LumaHigh);
+    }
+}
+
+void VpPolicyPlanCache::AppendKey(const FeatureParamBlending &params, std::vector<uint32_t> &key)
+{
+    AppendKey((const FeatureParam &)params, key);
+    key.push_back(params.blendingParams ? 1 : 0);
+    if (params.blendingParams)
+    {
+        key.push_back((uint32_t)params.blendingParams->BlendType);
+        AppendKey(params.blendingParams->fAlpha, key);
+    }
+}
+
+void VpPolicyPlanCache::AppendKey(const FeatureParamColorFill &params, std::vector<uint32_t> &key)
+{
+    AppendKey((const FeatureParam &)params, key);
+    AppendKey(params.colorFillParams, key);
+}
+
+void VpPolicyPlanCache::AppendKey(const FeatureParamAlpha &params, std::vector<uint32_t> &key)
+{
+    AppendKey((const FeatureParam &)params, key);
+    AppendKey(params.compAlpha, key);
+    key.push_back(params.calculatingAlpha);
+}
+
+bool VpPolicyPlanCache::IsEqual(const KEY &a, const KEY &b)
+{
+    return a.context == b.context && a.values == b.values;
+}
+
+bool VpPolicyPlanCache::IsEqual(const PLAN &a, const PLAN &b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < a.size(); ++i)
+    {
+        if (a[i].type != b[i].type ||
+            a[i].engineCaps.value != b[i].engineCaps.value ||
+            a[i].renderTargetType != b[i].renderTargetType ||
+            a[i].iefParamsPresent != b[i].iefParamsPresent ||
+            a[i].scalingPreference != b[i].scalingPreference ||
+            a[i].dnStage != b[i].dnStage ||
+            a[i].widthAlignUnitInput != b[i].widthAlignUnitInput ||
+            a[i].heightAlignUnitInput != b[i].heightAlignUnitInput)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t VpPolicyPlanCache::Hash(const KEY &key)
+{
+    // FNV-1a over the values
+    uint64_t hash = 0xcbf29ce484222325ull;
+    hash          = (hash ^ key.context) * 0x100000001b3ull;
+    for (auto value : key.values)
+    {
+        hash = (hash ^ value) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+const VpPolicyPlanCache::PLAN *VpPolicyPlanCache::Lookup(KEY &key)
+{
+    m_pendingEntry = nullptr;
+    m_pendingKey.context = key.context;
+    m_pendingKey.values.swap(key.values);
+    m_pendingSignature = Hash(m_pendingKey);
+    m_pending          = true;
+
+    auto it = m_entries.find(m_pendingSignature);
+    if (it == m_entries.end() || !IsEqual(it->second.key, m_pendingKey))
+    {
+        return nullptr;
+    }
+
+    it->second.lastUse = ++m_useCount;
+    if (m_crossCheck)
+    {
+        // Evaluate as usual and compare in Update.
+        m_pendingEntry = &it->second;
+        return nullptr;
+    }
+
+    ++m_stats.hits;
+    m_pending = false;
+    return &it->second.plan;
+}
+
+MOS_STATUS VpPolicyPlanCache::Update(const PLAN &plan)
+{
+    if (!m_pending)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+    m_pending = false;
+
+    if (m_pendingEntry)
+    {
+        if (IsEqual(m_pendingEntry->plan, plan))
+        {
+            ++m_stats.hits;
+        }
+        else
+        {
+            ++m_stats.mismatches;
+            VP_PUBLIC_ASSERTMESSAGE("Cached policy plan differs from evaluation, signature 0x%llx", (unsigned long long)m_pendingSignature);
+            m_pendingEntry->plan = plan;
+        }
+        m_pendingEntry = nullptr;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    ++m_stats.misses;
+
+    if (m_entries.size() >= m_maxEntries && m_entries.find(m_pendingSignature) == m_entries.end())
+    {
+        auto lru = m_entries.begin();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if (it->second.lastUse < lru->second.lastUse)
+            {
+                lru = it;
+            }
+        }
+        m_entries.erase(lru);
+    }
+
+    // A different key of same signature is replaced.
+    PLAN_ENTRY &entry = m_entries[m_pendingSignature];
+    entry.key         = m_pendingKey;
+    entry.plan        = plan;
+    entry.lastUse     = ++m_useCount;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+void VpPolicyPlanCache::Bypass()
+{
+    ++m_stats.bypassed;
+    m_pending      = false;
+    m_pendingEntry = nullptr;
+}
+
+void VpPolicyPlanCache::Invalidate()
+{
+    if (!m_entries.empty())
+    {
+        ++m_stats.invalidations;
+    }
+    m_entries.clear();
+    m_pending      = false;
+    m_pendingEntry = nullptr;
+}
+
+VpPolicyPlanCache::Statistics VpPolicyPlanCache::GetStatistics()
+{
+    Statistics stats = m_stats;
+    stats.entries    = m_entries.size();
+    return stats;
+}
+}  // namespace vp
@@ -0,0 +1,187 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_policy_plan_cache.h
+//! \brief    Defines the cache of engine assignment done by policy
+//! \details  Policy evaluates the execution caps of every feature in a sub pipe for each
+//!           frame. The result only depends on feature parameters and a few control
+//!           values, so it is kept under a key built from their values and replayed to
+//!           the sub pipe of later frames with the same key.
+//!
+#ifndef __VP_POLICY_PLAN_CACHE_H__
+#define __VP_POLICY_PLAN_CACHE_H__
+
+#include <map>
+#include <vector>
+#include "sw_filter.h"
+
+namespace vp
+{
+class VpPolicyPlanCache
+{
+public:
+    //!
+    //! \brief  Counters of the cache
+    //!
+    struct Statistics
+    {
+        uint64_t hits          = 0;
+        uint64_t misses        = 0;
+        uint64_t bypassed      = 0;  //!< Sub pipes not cacheable
+        uint64_t mismatches    = 0;  //!< Cached plans differing from fresh evaluation in cross check mode
+        uint64_t invalidations = 0;
+        uint64_t entries       = 0;
+    };
+
+    //!
+    //! \brief  Values policy evaluation reads, feature by feature
+    //! \details Only values are appended, never addresses, so that structures
+    //!          at different addresses or with different padding share the key.
+    //!
+    struct KEY
+    {
+        uint32_t              context = 0;  //!< Control values read during evaluation besides feature parameters
+        std::vector<uint32_t> values;
+    };
+
+    //!
+    //! \brief  State of one feature after evaluation
+    //!
+    struct FEATURE_PLAN
+    {
+        FeatureType              type                 = FeatureTypeInvalid;
+        VP_EngineEntry           engineCaps           = {};
+        RenderTargetType         renderTargetType     = RenderTargetTypeSurface;
+        // Parameters written by evaluation
+        bool                     iefParamsPresent     = false;  //!< Csc
+        VPHAL_SCALING_PREFERENCE scalingPreference    = VPHAL_SCALING_PREFER_SFC;
+        DN_STAGE                 dnStage              = DN_STAGE_DEFAULT;
+        uint32_t                 widthAlignUnitInput  = 0;  //!< Denoise
+        uint32_t                 heightAlignUnitInput = 0;  //!< Denoise
+    };
+
+    using PLAN = std::vector<FEATURE_PLAN>;
+
+    //!
+    //! \brief  Constructor
+    //! \param  [in] crossCheck
+    //!         Evaluate each cached plan again and compare it with the cached one
+    //!
+    VpPolicyPlanCache(bool crossCheck);
+
+    virtual ~VpPolicyPlanCache();
+
+    //!
+    //! \brief  Look up the plan of a sub pipe
+    //! \details If nullptr is returned, Update must be called after the sub pipe being evaluated.
+    //! \param  [in, out] key
+    //!         Key of sub pipe, which is taken over by the cache
+    //! \return const PLAN *
+    //!         Plan to apply to the sub pipe, nullptr if not hit
+    //!
+    const PLAN *Lookup(KEY &key);
+
+    //!
+    //! \brief  Keep the plan of sub pipe evaluated after Lookup missed
+    //! \param  [in] plan
+    //!         Plan of the sub pipe passed to Lookup
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Update(const PLAN &plan);
+
+    //!
+    //! \brief  Count a sub pipe which is not cacheable
+    //!
+    void Bypass();
+
+    //!
+    //! \brief  Check whether Update is expected for the sub pipe looked up
+    //!
+    bool IsPending()
+    {
+        return m_pending;
+    }
+
+    //!
+    //! \brief  Drop all plans, which is needed once anything besides the key affects evaluation
+    //!
+    void Invalidate();
+
+    Statistics GetStatistics();
+
+    //!
+    //! \brief  Append the values of feature parameters evaluation reads to key
+    //! \details Structures referenced by parameters are appended field by field,
+    //!          after a marker telling whether they are present.
+    //!
+    static void AppendKey(const FeatureParamCsc &params, std::vector<uint32_t> &key);
+    static void AppendKey(const FeatureParamScaling &params, std::vector<uint32_t> &key);
+    static void AppendKey(const FeatureParamRotMir &params, std::vector<uint32_t> &key);
+    static void AppendKey(const FeatureParamDenoise &params, std::vector<uint32_t> &key);
+    static void AppendKey(const FeatureParamSte &params, std::vector<uint32_t> &key);
+    static void AppendKey(const FeatureParamTcc &params, std::vector<uint32_t> &key);
+    static void AppendKey(const FeatureParamProcamp &params, std::vector<uint32_t> &key);
+    static void AppendKey(const FeatureParamLumakey &params, std::vector<uint32_t> &key);
+    static void AppendKey(const FeatureParamBlending &params, std::vector<uint32_t> &key);
+    static void AppendKey(const FeatureParamColorFill &params, std::vector<uint32_t> &key);
+    static void AppendKey(const FeatureParamAlpha &params, std::vector<uint32_t> &key);
+
+    static const uint32_t m_maxEntries = 32;
+
+protected:
+    struct PLAN_ENTRY
+    {
+        KEY      key;
+        PLAN     plan;
+        uint64_t lastUse = 0;
+    };
+
+    static void AppendKey(const FeatureParam &params, std::vector<uint32_t> &key);
+    static void AppendKey(const VPHAL_IEF_PARAMS *params, std::vector<uint32_t> &key);
+    static void AppendKey(const VPHAL_ALPHA_PARAMS *params, std::vector<uint32_t> &key);
+    static void AppendKey(const VPHAL_COLORFILL_PARAMS *params, std::vector<uint32_t> &key);
+    static void AppendKey(const RECT &rect, std::vector<uint32_t> &key);
+    static void AppendKey(float value, std::vector<uint32_t> &key);
+
+    static bool IsEqual(const KEY &a, const KEY &b);
+
+    static bool IsEqual(const PLAN &a, const PLAN &b);
+
+    static uint64_t Hash(const KEY &key);
+
+    std::map<uint64_t, PLAN_ENTRY>  m_entries;
+    bool                            m_crossCheck = false;
+    uint64_t                        m_useCount   = 0;
+    Statistics                      m_stats      = {};
+
+    // Sub pipe looked up and waiting for Update
+    bool                            m_pending          = false;
+    uint64_t                        m_pendingSignature = 0;
+    PLAN_ENTRY                     *m_pendingEntry     = nullptr;  //!< Entry hit in cross check mode
+    KEY                             m_pendingKey;
+
+MEDIA_CLASS_DEFINE_END(vp__VpPolicyPlanCache)
+};
+}  // namespace vp
+
+#endif  // __VP_POLICY_PLAN_CACHE_H__
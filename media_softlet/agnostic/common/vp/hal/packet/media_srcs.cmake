@@ -20,6 +20,7 @@
 
 set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/vp_cmd_packet.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/vp_cmd_recorder.cpp
     ${CMAKE_CURRENT_LIST_DIR}/vp_packet_pipe.cpp
     ${CMAKE_CURRENT_LIST_DIR}/vp_render_ief.cpp
     ${CMAKE_CURRENT_LIST_DIR}/vp_render_sfc_base.cpp
@@ -36,6 +37,7 @@ set(TMP_SOURCES_
 
 set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/vp_cmd_packet.h
+    ${CMAKE_CURRENT_LIST_DIR}/vp_cmd_recorder.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_packet_pipe.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_render_ief.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_render_sfc_base.h
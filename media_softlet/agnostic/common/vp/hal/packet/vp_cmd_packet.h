@@ -127,6 +127,36 @@ public:
         return m_PacketCaps;
     }
 
+    //!
+    //! \brief    Check whether packet can be submitted in batch with packets of other packet pipes
+    //! \return   bool
+    //!           true if batch submission supported, otherwise false
+    //!
+    virtual bool IsBatchSubmitSupported()
+    {
+        return false;
+    }
+
+    //!
+    //! \brief    Set phase of packet in batch submission
+    //! \details  For batch submission, the packets of several packet pipes are added to one command
+    //!           buffer. Only the first packet inserts the prolog and only the last packet ends the
+    //!           command buffer.
+    //! \param    [in] phase
+    //!           Combination of MediaPacket::firstPacket and MediaPacket::lastPacket.
+    //!           0 if packet is not submitted in batch.
+    //! \return   void
+    //!
+    void SetBatchSubmitPhase(uint8_t phase)
+    {
+        m_batchSubmitPhase = phase;
+    }
+
+    uint8_t GetBatchSubmitPhase()
+    {
+        return m_batchSubmitPhase;
+    }
+
 protected:
     virtual MOS_STATUS VpCmdPacketInit();
     bool IsOutputPipeVebox()
@@ -134,6 +164,16 @@ protected:
         return m_PacketCaps.bVebox && !m_PacketCaps.bSFC && !m_PacketCaps.bRender;
     }
 
+    bool IsFirstPacketInBatch()
+    {
+        return 0 == m_batchSubmitPhase || (m_batchSubmitPhase & MediaPacket::firstPacket);
+    }
+
+    bool IsLastPacketInBatch()
+    {
+        return 0 == m_batchSubmitPhase || (m_batchSubmitPhase & MediaPacket::lastPacket);
+    }
+
     virtual MOS_STATUS SetMediaFrameTracking(RENDERHAL_GENERIC_PROLOG_PARAMS &genericPrologParams);
 
 public:
@@ -149,6 +189,7 @@ protected:
     VP_PACKET_SHARED_CONTEXT*   m_packetSharedContext = nullptr;
     VP_SURFACE_SETTING          m_surfSetting;
     bool                        m_packetResourcesPrepared = false;
+    uint8_t                     m_batchSubmitPhase = 0;
 
 private:
     MediaScalability *          m_scalability = nullptr;
@@ -0,0 +1,502 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_cmd_recorder.cpp
+//! \brief    Record and replay of packet command segments for reused packet pipes.
+//!
+#include <map>
+#include <mutex>
+#include <thread>
+#include "vp_cmd_recorder.h"
+#include "vp_utils.h"
+
+using namespace vp;
+
+//!
+//! \brief Os interface hooked by command recorders.
+//!        The callbacks of an os interface are redirected while one of its recorders
+//!        records a segment. Calls from other threads sharing the os interface are
+//!        forwarded to the original callbacks, so only the recording thread is captured.
+//!
+struct VP_CMD_RECORD_HOOK
+{
+    MOS_STATUS (*pfnRegisterResource)(PMOS_INTERFACE, PMOS_RESOURCE, int32_t, int32_t) = nullptr;
+    MOS_STATUS (*pfnSetPatchEntry)(PMOS_INTERFACE, PMOS_PATCH_ENTRY_PARAMS)           = nullptr;
+    VpCmdRecorder   *recorder = nullptr;    //!< Recorder recording on the os interface, nullptr if none
+    std::thread::id thread;                 //!< Thread of the recorder
+    uint32_t        refCount  = 0;          //!< Recorders created on the os interface
+};
+
+// The entry of an os interface is kept as long as any recorder of it exists, for a
+// thread may still call the hook after the callbacks are restored.
+static std::mutex                                   s_hookMutex;
+static std::map<PMOS_INTERFACE, VP_CMD_RECORD_HOOK> s_hooks;
+
+//!
+//! \brief   Get the hook of os interface
+//! \param   [in] osInterface
+//!          Os interface passed to the callback
+//! \param   [out] hook
+//!          Copy of the hook, recorder is set only if called on the recording thread
+//! \return  bool
+//!          true if os interface is hooked, otherwise false
+//!
+static bool GetCmdRecordHook(PMOS_INTERFACE osInterface, VP_CMD_RECORD_HOOK &hook)
+{
+    std::lock_guard<std::mutex> lock(s_hookMutex);
+    auto it = s_hooks.find(osInterface);
+    if (it == s_hooks.end())
+    {
+        return false;
+    }
+    hook = it->second;
+    if (hook.thread != std::this_thread::get_id())
+    {
+        hook.recorder = nullptr;
+    }
+    return true;
+}
+
+VpCmdRecorder::VpCmdRecorder(PMOS_INTERFACE osInterface) : m_osInterface(osInterface)
+{
+    std::lock_guard<std::mutex> lock(s_hookMutex);
+    s_hooks[m_osInterface].refCount++;
+}
+
+VpCmdRecorder::~VpCmdRecorder()
+{
+    if (m_recordCmdBuffer)
+    {
+        EndSegment(m_recordCmdBuffer);
+    }
+
+    std::lock_guard<std::mutex> lock(s_hookMutex);
+    auto it = s_hooks.find(m_osInterface);
+    if (it != s_hooks.end() && --it->second.refCount == 0)
+    {
+        s_hooks.erase(it);
+    }
+}
+
+void VpCmdRecorder::Reset()
+{
+    m_segments.clear();
+    m_recordResources.clear();
+    m_signature.clear();
+    m_completed = false;
+    m_valid     = false;
+}
+
+int32_t VpCmdRecorder::GetRole(PMOS_RESOURCE resource)
+{
+    for (uint32_t i = 0; i < m_recordResources.size(); ++i)
+    {
+        if (m_recordResources[i].resource == resource)
+        {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+void VpCmdRecorder::BuildSignature(const VP_CMD_RECORD_RESOURCES &resources, std::vector<uint32_t> &signature)
+{
+    signature.clear();
+    signature.push_back((uint32_t)resources.size());
+
+    for (uint32_t i = 0; i < resources.size(); ++i)
+    {
+        const VP_CMD_RECORD_RESOURCE &res = resources[i];
+
+        // Alias layout: commands recorded with one resource for two roles can only be
+        // replayed if the two roles still share one resource.
+        uint32_t alias = i;
+        for (uint32_t j = 0; j < i; ++j)
+        {
+            if (resources[j].resource == res.resource)
+            {
+                alias = j;
+                break;
+            }
+        }
+        signature.push_back(alias);
+        signature.push_back(res.resource ? 1 : 0);
+        signature.push_back(res.rangeSize);
+
+        if (res.surface == nullptr || res.surface->osSurface == nullptr)
+        {
+            continue;
+        }
+
+        PMOS_SURFACE osSurface = res.surface->osSurface;
+        signature.push_back((uint32_t)osSurface->Format);
+        signature.push_back((uint32_t)osSurface->TileType);
+        signature.push_back(osSurface->dwWidth);
+        signature.push_back(osSurface->dwHeight);
+        signature.push_back(osSurface->dwPitch);
+        signature.push_back(osSurface->dwOffset);
+        signature.push_back((uint32_t)osSurface->YPlaneOffset.iSurfaceOffset);
+        signature.push_back((uint32_t)osSurface->YPlaneOffset.iYOffset);
+        signature.push_back((uint32_t)osSurface->UPlaneOffset.iSurfaceOffset);
+        signature.push_back((uint32_t)osSurface->UPlaneOffset.iYOffset);
+        signature.push_back((uint32_t)osSurface->VPlaneOffset.iSurfaceOffset);
+        signature.push_back((uint32_t)osSurface->VPlaneOffset.iYOffset);
+        signature.push_back((uint32_t)osSurface->bCompressible);
+        signature.push_back((uint32_t)osSurface->bIsCompressed);
+        signature.push_back((uint32_t)osSurface->CompressionMode);
+        signature.push_back(osSurface->CompressionFormat);
+        signature.push_back((uint32_t)res.surface->rcSrc.left);
+        signature.push_back((uint32_t)res.surface->rcSrc.top);
+        signature.push_back((uint32_t)res.surface->rcSrc.right);
+        signature.push_back((uint32_t)res.surface->rcSrc.bottom);
+        signature.push_back((uint32_t)res.surface->rcDst.left);
+        signature.push_back((uint32_t)res.surface->rcDst.top);
+        signature.push_back((uint32_t)res.surface->rcDst.right);
+        signature.push_back((uint32_t)res.surface->rcDst.bottom);
+        signature.push_back((uint32_t)res.surface->ColorSpace);
+        signature.push_back((uint32_t)res.surface->SampleType);
+    }
+}
+
+bool VpCmdRecorder::IsReplayable(const VP_CMD_RECORD_RESOURCES &resources)
+{
+    if (!m_completed || !m_valid || m_segments.empty())
+    {
+        return false;
+    }
+
+    std::vector<uint32_t> signature;
+    BuildSignature(resources, signature);
+    return signature == m_signature;
+}
+
+uint32_t VpCmdRecorder::RelocateOffset(const VP_CMD_RECORD_RESOURCES &resources, int32_t role, uint32_t offset)
+{
+    if (role < 0 || (uint32_t)role >= resources.size() || (uint32_t)role >= m_recordResources.size())
+    {
+        return offset;
+    }
+
+    const VP_CMD_RECORD_RESOURCE &recorded = m_recordResources[role];
+    if (recorded.rangeSize == 0 ||
+        offset < recorded.rangeBase ||
+        offset > recorded.rangeBase + recorded.rangeSize)
+    {
+        return offset;
+    }
+
+    // Offset inside the per-frame range, e.g. vebox heap instance, follows the range of current frame.
+    return offset - recorded.rangeBase + resources[role].rangeBase;
+}
+
+MOS_STATUS VpCmdRecorder::RecordRegisterResource(
+    PMOS_INTERFACE  osInterface,
+    PMOS_RESOURCE   resource,
+    int32_t         write,
+    int32_t         syncTag)
+{
+    VP_CMD_RECORD_HOOK hook;
+    if (!GetCmdRecordHook(osInterface, hook))
+    {
+        VP_RENDER_ASSERTMESSAGE("Os interface is not hooked by command recorder.");
+        return MOS_STATUS_NULL_POINTER;
+    }
+    VP_RENDER_CHK_NULL_RETURN(hook.pfnRegisterResource);
+    VP_RENDER_CHK_STATUS_RETURN(hook.pfnRegisterResource(osInterface, resource, write, syncTag));
+
+    VpCmdRecorder *recorder = hook.recorder;
+    if (recorder == nullptr || resource == nullptr || recorder->m_segments.empty())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    Segment &segment = recorder->m_segments.back();
+    int32_t  role    = recorder->GetRole(resource);
+    for (auto &reg : segment.registers)
+    {
+        if (reg.role == role && (role >= 0 || reg.resource == resource))
+        {
+            reg.write   |= write;
+            reg.syncTag |= syncTag;
+            return MOS_STATUS_SUCCESS;
+        }
+    }
+
+    RecordedRegister reg = {};
+    reg.role     = role;
+    reg.resource = role < 0 ? resource : nullptr;
+    reg.write    = write;
+    reg.syncTag  = syncTag;
+    segment.registers.push_back(reg);
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS VpCmdRecorder::RecordPatchEntry(
+    PMOS_INTERFACE              osInterface,
+    PMOS_PATCH_ENTRY_PARAMS     params)
+{
+    VP_CMD_RECORD_HOOK hook;
+    if (!GetCmdRecordHook(osInterface, hook))
+    {
+        VP_RENDER_ASSERTMESSAGE("Os interface is not hooked by command recorder.");
+        return MOS_STATUS_NULL_POINTER;
+    }
+    VP_RENDER_CHK_NULL_RETURN(hook.pfnSetPatchEntry);
+    VP_RENDER_CHK_NULL_RETURN(params);
+    VP_RENDER_CHK_STATUS_RETURN(hook.pfnSetPatchEntry(osInterface, params));
+
+    VpCmdRecorder *recorder = hook.recorder;
+    if (recorder == nullptr || recorder->m_segments.empty() || !recorder->m_valid)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    // Only base address patches inside the recorded range of command buffer can be relocated.
+    if (params->presResource == nullptr                         ||
+        params->offsetInSSH != 0                                ||
+        params->patchType != MOS_PATCH_TYPE_BASE_ADDRESS        ||
+        params->uiPatchOffset < recorder->m_recordStartOffset)
+    {
+        VP_RENDER_NORMALMESSAGE("Unsupported patch entry, command recording dropped.");
+        recorder->m_valid = false;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    RecordedPatch patch     = {};
+    patch.role              = recorder->GetRole(params->presResource);
+    patch.resource          = patch.role < 0 ? params->presResource : nullptr;
+    patch.resourceOffset    = params->uiResourceOffset;
+    patch.patchOffset       = params->uiPatchOffset - recorder->m_recordStartOffset;
+    patch.write             = params->bWrite;
+    patch.upperBoundPatch   = params->bUpperBoundPatch;
+    patch.hwCommandType     = params->HwCommandType;
+    patch.forceDwordOffset  = params->forceDwordOffset;
+    patch.shiftAmount       = params->shiftAmount;
+    patch.shiftDirection    = params->shiftDirection;
+    patch.hasCmdBufBase     = params->cmdBufBase != nullptr;
+    patch.hasCmdBuffer      = params->cmdBuffer != nullptr;
+    if (osInterface->bUsesGfxAddress)
+    {
+        patch.gfxAddress = osInterface->pfnGetResourceGfxAddress(osInterface, params->presResource) + params->uiResourceOffset;
+    }
+    recorder->m_segments.back().patches.push_back(patch);
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS VpCmdRecorder::BeginSegment(PMOS_COMMAND_BUFFER cmdBuffer, const VP_CMD_RECORD_RESOURCES &resources)
+{
+    VP_RENDER_CHK_NULL_RETURN(cmdBuffer);
+    VP_RENDER_CHK_NULL_RETURN(m_osInterface);
+    VP_RENDER_CHK_NULL_RETURN(m_osInterface->pfnRegisterResource);
+    VP_RENDER_CHK_NULL_RETURN(m_osInterface->pfnSetPatchEntry);
+    VP_RENDER_CHK_NULL_RETURN(m_osInterface->pfnGetResourceGfxAddress);
+
+    if (m_recordCmdBuffer)
+    {
+        VP_RENDER_ASSERTMESSAGE("Command recording already in progress.");
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    if (m_segments.empty())
+    {
+        m_recordResources = resources;
+        m_completed       = false;
+        m_valid           = true;
+    }
+    m_segments.push_back(Segment());
+
+    m_recordCmdBuffer   = cmdBuffer;
+    m_recordStartOffset = (uint32_t)cmdBuffer->iOffset;
+
+    std::lock_guard<std::mutex> lock(s_hookMutex);
+    VP_CMD_RECORD_HOOK &hook = s_hooks[m_osInterface];
+    if (hook.recorder)
+    {
+        // Os interface is taken by another recorder. Commands are still sent through the
+        // original callbacks, but this recording is dropped.
+        VP_RENDER_NORMALMESSAGE("Os interface in use by another command recorder, command recording dropped.");
+        m_valid  = false;
+        m_hooked = false;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    hook.pfnRegisterResource           = m_osInterface->pfnRegisterResource;
+    hook.pfnSetPatchEntry              = m_osInterface->pfnSetPatchEntry;
+    hook.recorder                      = this;
+    hook.thread                        = std::this_thread::get_id();
+    m_osInterface->pfnRegisterResource = RecordRegisterResource;
+    m_osInterface->pfnSetPatchEntry    = RecordPatchEntry;
+    m_hooked                           = true;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS VpCmdRecorder::EndSegment(PMOS_COMMAND_BUFFER cmdBuffer)
+{
+    VP_RENDER_CHK_NULL_RETURN(m_osInterface);
+
+    if (m_recordCmdBuffer == nullptr)
+    {
+        VP_RENDER_ASSERTMESSAGE("Command recording not started.");
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    // Always restore the os interface callbacks, even if the segment is dropped.
+    if (m_hooked)
+    {
+        std::lock_guard<std::mutex> lock(s_hookMutex);
+        VP_CMD_RECORD_HOOK &hook           = s_hooks[m_osInterface];
+        m_osInterface->pfnRegisterResource = hook.pfnRegisterResource;
+        m_osInterface->pfnSetPatchEntry    = hook.pfnSetPatchEntry;
+        hook.recorder                      = nullptr;
+        m_hooked                           = false;
+    }
+
+    PMOS_COMMAND_BUFFER recordCmdBuffer = m_recordCmdBuffer;
+    m_recordCmdBuffer                   = nullptr;
+
+    if (cmdBuffer != recordCmdBuffer || cmdBuffer->pCmdBase == nullptr ||
+        (uint32_t)cmdBuffer->iOffset < m_recordStartOffset)
+    {
+        m_valid = false;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    Segment &segment = m_segments.back();
+    uint32_t size    = (uint32_t)cmdBuffer->iOffset - m_recordStartOffset;
+
+    // Commands added through another os interface cannot be relocated.
+    if (size > 0 && segment.patches.empty())
+    {
+        VP_RENDER_NORMALMESSAGE("No patch entry recorded, command recording dropped.");
+        m_valid = false;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    // Address patched by graphics address takes 2 dwords.
+    for (auto &patch : segment.patches)
+    {
+        if (patch.patchOffset + 2 * sizeof(uint32_t) > size)
+        {
+            VP_RENDER_NORMALMESSAGE("Patch entry out of recorded range, command recording dropped.");
+            m_valid = false;
+            return MOS_STATUS_SUCCESS;
+        }
+    }
+
+    uint8_t *start = (uint8_t *)cmdBuffer->pCmdBase + m_recordStartOffset;
+    segment.cmds.assign(start, start + size);
+
+    return MOS_STATUS_SUCCESS;
+}
+
+void VpCmdRecorder::Complete(const VP_CMD_RECORD_RESOURCES &resources)
+{
+    if (!m_valid || m_segments.empty())
+    {
+        Reset();
+        return;
+    }
+
+    BuildSignature(resources, m_signature);
+    m_completed = true;
+}
+
+MOS_STATUS VpCmdRecorder::ReplaySegment(PMOS_COMMAND_BUFFER cmdBuffer, uint32_t segmentIndex, const VP_CMD_RECORD_RESOURCES &resources)
+{
+    VP_RENDER_CHK_NULL_RETURN(cmdBuffer);
+    VP_RENDER_CHK_NULL_RETURN(cmdBuffer->pCmdPtr);
+    VP_RENDER_CHK_NULL_RETURN(m_osInterface);
+
+    if (!m_completed || segmentIndex >= m_segments.size())
+    {
+        VP_RENDER_ASSERTMESSAGE("No command recording for segment %d.", segmentIndex);
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    const Segment &segment = m_segments[segmentIndex];
+    uint32_t       size    = (uint32_t)segment.cmds.size();
+
+    if (cmdBuffer->iRemaining < 0 || (uint32_t)cmdBuffer->iRemaining < size)
+    {
+        VP_RENDER_ASSERTMESSAGE("Command buffer overflow, remaining %d, needed %d.", cmdBuffer->iRemaining, size);
+        return MOS_STATUS_NO_SPACE;
+    }
+
+    for (auto &reg : segment.registers)
+    {
+        PMOS_RESOURCE resource = reg.role < 0 ? reg.resource : resources[reg.role].resource;
+        VP_RENDER_CHK_NULL_RETURN(resource);
+        VP_RENDER_CHK_STATUS_RETURN(m_osInterface->pfnRegisterResource(m_osInterface, resource, reg.write, reg.syncTag));
+    }
+
+    uint32_t startOffset = (uint32_t)cmdBuffer->iOffset;
+    uint8_t *cmds        = (uint8_t *)cmdBuffer->pCmdPtr;
+    VP_RENDER_CHK_STATUS_RETURN(MOS_SecureMemcpy(cmds, cmdBuffer->iRemaining, segment.cmds.data(), size));
+
+    for (auto &patch : segment.patches)
+    {
+        PMOS_RESOURCE resource = patch.role < 0 ? patch.resource : resources[patch.role].resource;
+        VP_RENDER_CHK_NULL_RETURN(resource);
+
+        uint32_t resourceOffset = RelocateOffset(resources, patch.role, patch.resourceOffset);
+
+        if (m_osInterface->bUsesGfxAddress)
+        {
+            uint64_t gfxAddress = m_osInterface->pfnGetResourceGfxAddress(m_osInterface, resource) + resourceOffset;
+            if (gfxAddress == 0)
+            {
+                VP_RENDER_ASSERTMESSAGE("Invalid graphics address for patch at %d.", patch.patchOffset);
+                return MOS_STATUS_INVALID_PARAMETER;
+            }
+
+            // Field bits below the address alignment are kept as recorded.
+            uint32_t *addr = (uint32_t *)(cmds + patch.patchOffset);
+            addr[0]        = addr[0] - (uint32_t)patch.gfxAddress + (uint32_t)gfxAddress;
+            addr[1]        = (uint32_t)(gfxAddress >> 32);
+        }
+
+        MOS_PATCH_ENTRY_PARAMS patchEntryParams;
+        MOS_ZeroMemory(&patchEntryParams, sizeof(patchEntryParams));
+        patchEntryParams.presResource      = resource;
+        patchEntryParams.uiAllocationIndex = m_osInterface->pfnGetResourceAllocationIndex(m_osInterface, resource);
+        patchEntryParams.uiResourceOffset  = resourceOffset;
+        patchEntryParams.uiPatchOffset     = startOffset + patch.patchOffset;
+        patchEntryParams.bWrite            = patch.write;
+        patchEntryParams.bUpperBoundPatch  = patch.upperBoundPatch;
+        patchEntryParams.HwCommandType     = patch.hwCommandType;
+        patchEntryParams.forceDwordOffset  = patch.forceDwordOffset;
+        patchEntryParams.shiftAmount       = patch.shiftAmount;
+        patchEntryParams.shiftDirection    = patch.shiftDirection;
+        patchEntryParams.cmdBufBase        = patch.hasCmdBufBase ? (uint8_t *)cmdBuffer->pCmdBase : nullptr;
+        patchEntryParams.cmdBuffer         = patch.hasCmdBuffer ? cmdBuffer : nullptr;
+        VP_RENDER_CHK_STATUS_RETURN(m_osInterface->pfnSetPatchEntry(m_osInterface, &patchEntryParams));
+    }
+
+    cmdBuffer->pCmdPtr    += size / sizeof(uint32_t);
+    cmdBuffer->iOffset    += size;
+    cmdBuffer->iRemaining -= size;
+
+    return MOS_STATUS_SUCCESS;
+}
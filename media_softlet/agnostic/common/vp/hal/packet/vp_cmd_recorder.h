@@ -0,0 +1,185 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_cmd_recorder.h
+//! \brief    Record and replay of packet command segments for reused packet pipes.
+//! \details  A segment is a range of the command buffer built by MHW. The commands
+//!           are copied once, together with the patch entries added while building
+//!           them. Replaying a segment copies the commands into a new command buffer
+//!           and relocates the recorded patch entries to the resources of the current
+//!           frame, which skips the MHW parameter setup and command generation.
+//!
+#ifndef __VP_CMD_RECORDER_H__
+#define __VP_CMD_RECORDER_H__
+
+#include <vector>
+#include "mos_os.h"
+#include "vp_pipeline_common.h"
+
+namespace vp
+{
+//!
+//! \brief Resource which may be referenced by recorded commands.
+//!        The list is built by the packet in the same order for every frame, so that
+//!        the index of an entry identifies the role of the resource, e.g. input surface.
+//!
+struct VP_CMD_RECORD_RESOURCE
+{
+    PMOS_RESOURCE   resource  = nullptr;    //!< Resource of current frame
+    VP_SURFACE      *surface  = nullptr;    //!< Surface of the resource, nullptr for non-surface resource
+    uint32_t        rangeBase = 0;          //!< Base offset of per-frame range in the resource, e.g. current vebox heap instance
+    uint32_t        rangeSize = 0;          //!< Size of per-frame range, 0 if offsets in resource are fixed
+};
+
+using VP_CMD_RECORD_RESOURCES = std::vector<VP_CMD_RECORD_RESOURCE>;
+
+class VpCmdRecorder
+{
+public:
+    VpCmdRecorder(PMOS_INTERFACE osInterface);
+    virtual ~VpCmdRecorder();
+
+    //!
+    //! \brief    Drop current recording
+    //! \return   void
+    //!
+    void Reset();
+
+    //!
+    //! \brief    Check whether the recording can be replayed for current frame
+    //! \details  The recording is replayable if it has been completed without unsupported
+    //!           patch entries and the resource list matches the recorded one in role layout
+    //!           and surface geometry.
+    //! \param    [in] resources
+    //!           Resources of current frame
+    //! \return   bool
+    //!           true if replayable, otherwise false
+    //!
+    bool IsReplayable(const VP_CMD_RECORD_RESOURCES &resources);
+
+    //!
+    //! \brief    Start recording a new segment
+    //! \details  Patch entries added to the command buffer between BeginSegment and EndSegment
+    //!           are recorded, so that they can be relocated on replay.
+    //! \param    [in] cmdBuffer
+    //!           Command buffer to be recorded
+    //! \param    [in] resources
+    //!           Resources of current frame
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS BeginSegment(PMOS_COMMAND_BUFFER cmdBuffer, const VP_CMD_RECORD_RESOURCES &resources);
+
+    //!
+    //! \brief    Finish recording current segment
+    //! \param    [in] cmdBuffer
+    //!           Command buffer being recorded
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS EndSegment(PMOS_COMMAND_BUFFER cmdBuffer);
+
+    //!
+    //! \brief    Complete the recording
+    //! \details  Stores the signature of the resources, after which the recording can be replayed.
+    //! \param    [in] resources
+    //!           Resources of current frame
+    //! \return   void
+    //!
+    void Complete(const VP_CMD_RECORD_RESOURCES &resources);
+
+    //!
+    //! \brief    Replay recorded segment into command buffer
+    //! \param    [in,out] cmdBuffer
+    //!           Command buffer to be filled
+    //! \param    [in] segmentIndex
+    //!           Index of segment, in the order of recording
+    //! \param    [in] resources
+    //!           Resources of current frame
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS ReplaySegment(PMOS_COMMAND_BUFFER cmdBuffer, uint32_t segmentIndex, const VP_CMD_RECORD_RESOURCES &resources);
+
+protected:
+    struct RecordedRegister
+    {
+        int32_t         role      = -1;         //!< Index in resource list, -1 for resource not in the list
+        PMOS_RESOURCE   resource  = nullptr;    //!< Resource used when role is -1
+        int32_t         write     = 0;
+        int32_t         syncTag   = 0;
+    };
+
+    struct RecordedPatch
+    {
+        int32_t         role             = -1;  //!< Index in resource list, -1 for resource not in the list
+        PMOS_RESOURCE   resource         = nullptr;
+        uint32_t        resourceOffset   = 0;
+        uint32_t        patchOffset      = 0;   //!< Patch offset relative to segment start
+        uint32_t        write            = 0;
+        int32_t         upperBoundPatch  = 0;
+        MOS_HW_COMMAND  hwCommandType    = MOS_MI_BATCH_BUFFER_START;
+        uint32_t        forceDwordOffset = 0;
+        uint32_t        shiftAmount      = 0;
+        uint32_t        shiftDirection   = 0;
+        bool            hasCmdBufBase    = false;
+        bool            hasCmdBuffer     = false;
+        uint64_t        gfxAddress       = 0;   //!< Graphics address written to the recorded commands
+    };
+
+    struct Segment
+    {
+        std::vector<uint8_t>            cmds;
+        std::vector<RecordedRegister>   registers;
+        std::vector<RecordedPatch>      patches;
+    };
+
+    static MOS_STATUS RecordRegisterResource(
+        PMOS_INTERFACE  osInterface,
+        PMOS_RESOURCE   resource,
+        int32_t         write,
+        int32_t         syncTag);
+
+    static MOS_STATUS RecordPatchEntry(
+        PMOS_INTERFACE              osInterface,
+        PMOS_PATCH_ENTRY_PARAMS     params);
+
+    int32_t GetRole(PMOS_RESOURCE resource);
+    void BuildSignature(const VP_CMD_RECORD_RESOURCES &resources, std::vector<uint32_t> &signature);
+    uint32_t RelocateOffset(const VP_CMD_RECORD_RESOURCES &resources, int32_t role, uint32_t offset);
+
+    PMOS_INTERFACE                  m_osInterface = nullptr;
+    std::vector<Segment>            m_segments;
+    std::vector<VP_CMD_RECORD_RESOURCE> m_recordResources;  //!< Resources of the recorded frame
+    std::vector<uint32_t>           m_signature;
+    bool                            m_completed = false;
+    bool                            m_valid     = false;
+
+    // Recording state of current segment
+    PMOS_COMMAND_BUFFER             m_recordCmdBuffer     = nullptr;
+    uint32_t                        m_recordStartOffset   = 0;
+    bool                            m_hooked              = false;  //!< Os interface callbacks redirected to this recorder
+
+MEDIA_CLASS_DEFINE_END(vp__VpCmdRecorder)
+};
+}  // namespace vp
+#endif // !__VP_CMD_RECORDER_H__
@@ -170,6 +170,7 @@ MOS_STATUS PacketPipe::Clean()
 
     m_outputPipeMode = VPHAL_OUTPUT_PIPE_MODE_INVALID;
     m_veboxFeatureInuse = false;
+    m_3DLutCalcSubmitted = false;
     for (std::vector<VpCmdPacket *>::iterator it = m_Pipe.begin(); it != m_Pipe.end(); ++it)
     {
         m_PacketFactory.ReturnPacket(*it);
@@ -264,18 +265,23 @@ MOS_STATUS PacketPipe::SwitchContext(PacketType type, MediaScalability *&scalabi
     return MOS_STATUS_SUCCESS;
 }
 
-MOS_STATUS PacketPipe::Execute(MediaStatusReport *statusReport, MediaScalability *&scalability, MediaContext *mediaContext, bool bEnableVirtualEngine, uint8_t numVebox)
+MOS_STATUS PacketPipe::Execute(MediaStatusReport *statusReport, MediaScalability *&scalability, MediaContext *mediaContext, bool bEnableVirtualEngine, uint8_t numVebox, bool deferSubmit)
 {
     VP_FUNC_CALL();
 
     VP_PUBLIC_NORMALMESSAGE("PacketPipe %p in execute.", this);
 
     // PrePare Packet in case any packet resources shared
+    // For deferred submission, the state is prepared in packet Prepare right before the commands being built.
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
-    for (std::vector<VpCmdPacket*>::reverse_iterator it = m_Pipe.rbegin(); it != m_Pipe.rend(); ++it)
+    m_3DLutCalcSubmitted = false;
+    if (!deferSubmit)
     {
-        VpCmdPacket* packet = *it;
-        VP_PUBLIC_CHK_STATUS_RETURN(packet->PrepareState());
+        for (std::vector<VpCmdPacket*>::reverse_iterator it = m_Pipe.rbegin(); it != m_Pipe.rend(); ++it)
+        {
+            VpCmdPacket* packet = *it;
+            VP_PUBLIC_CHK_STATUS_RETURN(packet->PrepareState());
+        }
     }
 
     for (std::vector<VpCmdPacket *>::iterator it = m_Pipe.begin(); it != m_Pipe.end(); ++it)
@@ -284,7 +290,7 @@ MOS_STATUS PacketPipe::Execute(MediaStatusReport *statusReport, MediaScalability
         PacketProperty prop  = {};
         prop.packetId        = pPacket->GetPacketId();
         prop.packet          = pPacket;
-        prop.immediateSubmit = true;
+        prop.immediateSubmit = !deferSubmit;
         prop.stateProperty.statusReport = statusReport;
 
         bool isSkip = false;
@@ -302,30 +308,124 @@ MOS_STATUS PacketPipe::Execute(MediaStatusReport *statusReport, MediaScalability
         VP_PUBLIC_CHK_STATUS_RETURN(SwitchContext(pPacket->GetPacketId(), scalability, mediaContext, bEnableVirtualEngine, numVebox));
         VP_PUBLIC_CHK_NULL_RETURN(scalability);
         pPacket->SetMediaScalability(scalability);
+        // Phase of deferred packet is set in SubmitBatch.
+        pPacket->SetBatchSubmitPhase(0);
 
         VP_PUBLIC_CHK_STATUS_RETURN(pTask->AddPacket(&prop));
         if (prop.immediateSubmit)
         {
             VP_PUBLIC_NORMALMESSAGE("Execute Packet %p.", pPacket);
             VP_PUBLIC_CHK_STATUS_RETURN(pTask->Submit(true, scalability, nullptr));
+            m_3DLutCalcSubmitted |= (pPacket->GetExecuteCaps().b3DLutCalc != 0);
+            DumpPacketSurfaces(pPacket);
         }
+    }
 
-#if USE_MEDIA_DEBUG_TOOL
-        for (auto& handle : pPacket->GetSurfSetting().surfGroup)
+    return eStatus;
+}
+
+bool PacketPipe::IsBatchSubmitSupported()
+{
+    VP_FUNC_CALL();
+
+    // Packets in one packet pipe may share the resources prepared together in Execute,
+    // thus only packet pipe with single packet can be submitted in batch.
+    return 1 == m_Pipe.size() && m_Pipe[0] && m_Pipe[0]->IsBatchSubmitSupported() && !m_Pipe[0]->ExtraProcessing();
+}
+
+MOS_STATUS PacketPipe::SubmitBatch(std::vector<PacketPipe *> &packetPipes, MediaScalability *scalability)
+{
+    VP_FUNC_CALL();
+
+    if (packetPipes.empty())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    VP_PUBLIC_CHK_NULL_RETURN(scalability);
+
+    MediaTask *pTask = nullptr;
+    for (uint32_t i = 0; i < packetPipes.size(); ++i)
+    {
+        VP_PUBLIC_CHK_NULL_RETURN(packetPipes[i]);
+        VpCmdPacket *pPacket = packetPipes[i]->GetPacket(0);
+        VP_PUBLIC_CHK_NULL_RETURN(pPacket);
+
+        uint8_t phase = 0;
+        if (0 == i)
         {
-            if(handle.first && handle.second)
-            {
-                VP_SURFACE_DUMP(m_PacketFactory.m_debugInterface,
-                handle.second,
-                0,
-                handle.first,
-                VPHAL_DUMP_TYPE_POST_COMP);
-            }
+            phase |= MediaPacket::firstPacket;
         }
-#endif
+        if (packetPipes.size() - 1 == i)
+        {
+            phase |= MediaPacket::lastPacket;
+        }
+        pPacket->SetBatchSubmitPhase(phase);
+
+        if (pTask && pTask != pPacket->GetActiveTask())
+        {
+            VP_PUBLIC_ASSERTMESSAGE("Packets in batch are added to different tasks!");
+            return MOS_STATUS_INVALID_PARAMETER;
+        }
+        pTask = pPacket->GetActiveTask();
+        VP_PUBLIC_CHK_NULL_RETURN(pTask);
     }
 
-    return eStatus;
+    VP_PUBLIC_NORMALMESSAGE("Execute %d packet pipes in one submission.", (uint32_t)packetPipes.size());
+    MOS_STATUS status = pTask->Submit(true, scalability, nullptr);
+    if (MOS_FAILED(status))
+    {
+        // Packets are not removed from task by failed submission.
+        pTask->Clear();
+    }
+
+    for (auto &pipe : packetPipes)
+    {
+        VpCmdPacket *pPacket = pipe->GetPacket(0);
+        pPacket->SetBatchSubmitPhase(0);
+        if (MOS_SUCCEEDED(status))
+        {
+            pipe->DumpPacketSurfaces(pPacket);
+        }
+    }
+
+    return status;
+}
+
+void PacketPipe::DiscardBatch(std::vector<PacketPipe *> &packetPipes)
+{
+    VP_FUNC_CALL();
+
+    for (auto &pipe : packetPipes)
+    {
+        VpCmdPacket *pPacket = pipe ? pipe->GetPacket(0) : nullptr;
+        if (pPacket && pPacket->GetActiveTask())
+        {
+            pPacket->SetBatchSubmitPhase(0);
+            pPacket->GetActiveTask()->Clear();
+        }
+    }
+}
+
+void PacketPipe::DumpPacketSurfaces(VpCmdPacket *packet)
+{
+#if USE_MEDIA_DEBUG_TOOL
+    if (nullptr == packet)
+    {
+        return;
+    }
+    for (auto& handle : packet->GetSurfSetting().surfGroup)
+    {
+        if(handle.first && handle.second)
+        {
+            VP_SURFACE_DUMP(m_PacketFactory.m_debugInterface,
+            handle.second,
+            0,
+            handle.first,
+            VPHAL_DUMP_TYPE_POST_COMP);
+        }
+    }
+#endif
 }
 
 VpCmdPacket *PacketPipe::CreatePacket(EngineType type)
@@ -81,7 +81,42 @@ public:
     virtual ~PacketPipe();
     MOS_STATUS Clean();
     MOS_STATUS AddPacket(HwFilter &hwFilter);
-    MOS_STATUS Execute(MediaStatusReport *statusReport, MediaScalability *&scalability, MediaContext *mediaContext, bool bEnableVirtualEngine, uint8_t numVebox);
+    //!
+    //! \brief    Execute packet pipe
+    //! \param    [in] deferSubmit
+    //!           If true, packets are only added to task and will be submitted by SubmitBatch
+    //!           together with the packets of other packet pipes.
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Execute(MediaStatusReport *statusReport, MediaScalability *&scalability, MediaContext *mediaContext, bool bEnableVirtualEngine, uint8_t numVebox, bool deferSubmit = false);
+
+    //!
+    //! \brief    Check whether packet pipe can be submitted in batch with other packet pipes
+    //! \return   bool
+    //!           true if batch submission supported, otherwise false
+    //!
+    bool IsBatchSubmitSupported();
+
+    //!
+    //! \brief    Submit packet pipes in one command buffer
+    //! \details  Packets of the packet pipes should have been added to task by Execute with deferSubmit.
+    //! \param    [in] packetPipes
+    //!           Packet pipes in the order of execution
+    //! \param    [in] scalability
+    //!           Scalability of current context
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    static MOS_STATUS SubmitBatch(std::vector<PacketPipe *> &packetPipes, MediaScalability *scalability);
+
+    //!
+    //! \brief    Remove packets of packet pipes from task without submission
+    //! \param    [in] packetPipes
+    //!           Packet pipes executed with deferSubmit
+    //! \return   void
+    //!
+    static void DiscardBatch(std::vector<PacketPipe *> &packetPipes);
     VPHAL_OUTPUT_PIPE_MODE GetOutputPipeMode()
     {
         return m_outputPipeMode;
@@ -92,6 +127,14 @@ public:
         return m_veboxFeatureInuse;
     }
 
+    //!
+    //! \brief    Check whether a 3DLut kernel packet has been submitted by last Execute
+    //!
+    bool Is3DLutCalcSubmitted()
+    {
+        return m_3DLutCalcSubmitted;
+    }
+
     uint32_t PacketNum()
     {
         return m_Pipe.size();
@@ -107,11 +150,13 @@ public:
 private:
     VpCmdPacket *CreatePacket(EngineType type);
     MOS_STATUS SetOutputPipeMode(EngineType engineType);
+    void DumpPacketSurfaces(VpCmdPacket *packet);
 
     PacketFactory &m_PacketFactory;
     std::vector<VpCmdPacket *> m_Pipe;
     VPHAL_OUTPUT_PIPE_MODE m_outputPipeMode = VPHAL_OUTPUT_PIPE_MODE_INVALID;
     bool m_veboxFeatureInuse = false;
+    bool m_3DLutCalcSubmitted = false;
 
 MEDIA_CLASS_DEFINE_END(vp__PacketPipe)
 };
@@ -1399,7 +1399,11 @@ MOS_STATUS VpVeboxCmdPacket::PrepareVeboxCmd(
 
     MOS_ZeroMemory(&GenericPrologParams, sizeof(GenericPrologParams));
 
-    VP_RENDER_CHK_STATUS_RETURN(SetMediaFrameTracking(GenericPrologParams));
+    // For batch submission, media frame tracking is set in the prolog of the first packet.
+    if (IsFirstPacketInBatch())
+    {
+        VP_RENDER_CHK_STATUS_RETURN(SetMediaFrameTracking(GenericPrologParams));
+    }
 
     return eStatus;
 }
@@ -1463,6 +1467,154 @@ MOS_STATUS VpVeboxCmdPacket::SetVeboxDiIecp(
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS VpVeboxCmdPacket::SendVeboxCmdSegment(
+    VEBOX_CMD_SEGMENT                   segment,
+    PMOS_COMMAND_BUFFER                 pCmdBufferInUse,
+    PMHW_VEBOX_SURFACE_STATE_CMD_PARAMS pMhwVeboxSurfaceStateCmdParams,
+    uint32_t                            curPipe,
+    uint32_t                            numPipe)
+{
+    VP_FUNC_CALL();
+
+    VpVeboxRenderData *pRenderData = GetLastExecRenderData();
+    VP_RENDER_CHK_NULL_RETURN(pRenderData);
+
+    switch (segment)
+    {
+    case VEBOX_CMD_SEGMENT_STATE:
+        //---------------------------------
+        // Send CMD: Vebox_State
+        //---------------------------------
+        VP_RENDER_CHK_STATUS_RETURN(SetVeboxState(
+            pCmdBufferInUse));
+
+        //---------------------------------
+        // Send CMD: Vebox_Surface_State
+        //---------------------------------
+        VP_RENDER_CHK_STATUS_RETURN(SetVeboxSurfaces(
+            pCmdBufferInUse,
+            pMhwVeboxSurfaceStateCmdParams));
+
+        //---------------------------------
+        // Send CMD: SFC pipe commands
+        //---------------------------------
+        if (m_IsSfcUsed)
+        {
+            VP_RENDER_CHK_NULL_RETURN(m_sfcRender);
+
+            VP_RENDER_CHK_STATUS_RETURN(m_sfcRender->SetSfcPipe(curPipe, numPipe));
+
+            VP_RENDER_CHK_STATUS_RETURN(m_sfcRender->SetupSfcState(m_renderTarget));
+
+            VP_RENDER_CHK_STATUS_RETURN(m_sfcRender->SendSfcCmd(
+                (pRenderData->DI.bDeinterlace || pRenderData->DN.bDnEnabled),
+                pCmdBufferInUse));
+        }
+        break;
+    case VEBOX_CMD_SEGMENT_DI_IECP:
+        //---------------------------------
+        // Send CMD: Vebox_DI_IECP
+        //---------------------------------
+        VP_RENDER_CHK_STATUS_RETURN(SetVeboxDiIecp(
+            pCmdBufferInUse));
+        break;
+    default:
+        VP_RENDER_ASSERTMESSAGE("Invalid vebox command segment %d.", segment);
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS VpVeboxCmdPacket::RenderVeboxCmdSegment(
+    VEBOX_CMD_SEGMENT                   segment,
+    PMOS_COMMAND_BUFFER                 pCmdBufferInUse,
+    PMHW_VEBOX_SURFACE_STATE_CMD_PARAMS pMhwVeboxSurfaceStateCmdParams,
+    uint32_t                            curPipe,
+    uint32_t                            numPipe,
+    const VP_CMD_RECORD_RESOURCES       &recordResources,
+    bool                                replayCmd,
+    bool                                recordCmd)
+{
+    VP_FUNC_CALL();
+
+    if (replayCmd)
+    {
+        VP_RENDER_CHK_NULL_RETURN(m_cmdRecorder);
+        return m_cmdRecorder->ReplaySegment(pCmdBufferInUse, (uint32_t)segment, recordResources);
+    }
+
+    if (!recordCmd)
+    {
+        return SendVeboxCmdSegment(segment, pCmdBufferInUse, pMhwVeboxSurfaceStateCmdParams, curPipe, numPipe);
+    }
+
+    VP_RENDER_CHK_NULL_RETURN(m_cmdRecorder);
+    VP_RENDER_CHK_STATUS_RETURN(m_cmdRecorder->BeginSegment(pCmdBufferInUse, recordResources));
+
+    MOS_STATUS eStatus = SendVeboxCmdSegment(segment, pCmdBufferInUse, pMhwVeboxSurfaceStateCmdParams, curPipe, numPipe);
+
+    // Os interface callbacks are restored by EndSegment, which must be called even if failed to send commands.
+    VP_RENDER_CHK_STATUS_RETURN(m_cmdRecorder->EndSegment(pCmdBufferInUse));
+    if (MOS_FAILED(eStatus))
+    {
+        m_cmdRecorder->Reset();
+    }
+
+    return eStatus;
+}
+
+MOS_STATUS VpVeboxCmdPacket::GetCmdRecordResources(
+    VP_CMD_RECORD_RESOURCES             &resources,
+    const MHW_VEBOX_HEAP                *pVeboxHeap)
+{
+    VP_FUNC_CALL();
+
+    VP_RENDER_CHK_NULL_RETURN(pVeboxHeap);
+
+    VP_SURFACE *surfaces[] = {
+        m_veboxPacketSurface.pCurrInput,
+        m_veboxPacketSurface.pPrevInput,
+        m_veboxPacketSurface.pSTMMInput,
+        m_veboxPacketSurface.pSTMMOutput,
+        m_veboxPacketSurface.pDenoisedCurrOutput,
+        m_veboxPacketSurface.pCurrOutput,
+        m_veboxPacketSurface.pPrevOutput,
+        m_veboxPacketSurface.pStatisticsOutput,
+        m_veboxPacketSurface.pAlphaOrVignette,
+        m_veboxPacketSurface.pLaceOrAceOrRgbHistogram,
+        m_veboxPacketSurface.pSurfSkinScoreOutput,
+        m_veboxPacketSurface.pFMDHistorySurface,
+        m_currentSurface,
+        m_previousSurface,
+        m_renderTarget};
+
+    resources.clear();
+    resources.reserve(sizeof(surfaces) / sizeof(surfaces[0]) + 2);
+
+    for (auto surface : surfaces)
+    {
+        VP_CMD_RECORD_RESOURCE res = {};
+        if (surface && surface->osSurface)
+        {
+            res.resource = &surface->osSurface->OsResource;
+            res.surface  = surface;
+        }
+        resources.push_back(res);
+    }
+
+    // Vebox states are in the instance of vebox heap assigned for current frame.
+    VP_CMD_RECORD_RESOURCE heap = {};
+    heap.rangeBase = pVeboxHeap->uiCurState * pVeboxHeap->uiInstanceSize;
+    heap.rangeSize = pVeboxHeap->uiInstanceSize;
+    heap.resource  = const_cast<PMOS_RESOURCE>(&pVeboxHeap->DriverResource);
+    resources.push_back(heap);
+    heap.resource  = const_cast<PMOS_RESOURCE>(&pVeboxHeap->KernelResource);
+    resources.push_back(heap);
+
+    return MOS_STATUS_SUCCESS;
+}
+
 MOS_STATUS VpVeboxCmdPacket::RenderVeboxCmd(
     MOS_COMMAND_BUFFER                      *CmdBuffer,
     VPHAL_VEBOX_SURFACE_STATE_CMD_PARAMS    &VeboxSurfaceStateCmdParams,
@@ -1487,6 +1639,9 @@ MOS_STATUS VpVeboxCmdPacket::RenderVeboxCmd(
     uint8_t               inputPipe       = 0;
     uint32_t              numPipe         = 1;
     bool                  bMultipipe      = false;
+    bool                  replayCmd       = false;
+    bool                  recordCmd       = false;
+    VP_CMD_RECORD_RESOURCES recordResources;
 
     VP_RENDER_CHK_NULL_RETURN(m_hwInterface->m_renderHal);
     VP_RENDER_CHK_NULL_RETURN(m_hwInterface->m_mhwMiInterface);
@@ -1527,6 +1682,20 @@ MOS_STATUS VpVeboxCmdPacket::RenderVeboxCmd(
 
     VP_RENDER_CHK_STATUS_RETURN(SetVeboxIndex(0, numPipe, m_IsSfcUsed));
 
+    // Commands of reused packet are recorded on first reuse and replayed on later frames.
+    // Scalability case is excluded, for the commands differ between pipes.
+    if (m_packetReused && m_cmdRecorder && !bMultipipe)
+    {
+        VP_RENDER_CHK_STATUS_RETURN(GetCmdRecordResources(recordResources, pVeboxHeap));
+        replayCmd = m_cmdRecorder->IsReplayable(recordResources);
+        recordCmd = !replayCmd;
+        if (recordCmd)
+        {
+            m_cmdRecorder->Reset();
+        }
+        VP_RENDER_NORMALMESSAGE("Vebox command %s for reused packet.", replayCmd ? "replayed" : "recorded");
+    }
+
     bDiVarianceEnable = m_PacketCaps.bDI;
 
     SetupSurfaceStates(
@@ -1543,8 +1712,11 @@ MOS_STATUS VpVeboxCmdPacket::RenderVeboxCmd(
         veboxDiIecpCmdParams,
         VeboxSurfaceStateCmdParams));
 
-    // Initialize command buffer and insert prolog
-    VP_RENDER_CHK_STATUS_RETURN(InitCmdBufferWithVeParams(pRenderHal, *CmdBuffer, pGenericPrologParams));
+    // Initialize command buffer and insert prolog. For batch submission, it has been done by the first packet.
+    if (IsFirstPacketInBatch())
+    {
+        VP_RENDER_CHK_STATUS_RETURN(InitCmdBufferWithVeParams(pRenderHal, *CmdBuffer, pGenericPrologParams));
+    }
 
     //---------------------------------
     // Initialize Vebox Surface State Params
@@ -1570,7 +1742,10 @@ MOS_STATUS VpVeboxCmdPacket::RenderVeboxCmd(
 
         VP_RENDER_CHK_STATUS_RETURN(SetVeboxIndex(curPipe, numPipe, m_IsSfcUsed));
 
-        HalOcaInterfaceNext::On1stLevelBBStart(*pCmdBufferInUse, *pOsContext, pOsInterface->CurrentGpuContextHandle, m_miItf, *pMmioRegisters);
+        if (IsFirstPacketInBatch())
+        {
+            HalOcaInterfaceNext::On1stLevelBBStart(*pCmdBufferInUse, *pOsContext, pOsInterface->CurrentGpuContextHandle, m_miItf, *pMmioRegisters);
+        }
 
         char ocaMsg[] = "VP APG Vebox Packet";
         HalOcaInterfaceNext::TraceMessage(*pCmdBufferInUse, *pOsContext, ocaMsg, sizeof(ocaMsg));
@@ -1633,33 +1808,17 @@ MOS_STATUS VpVeboxCmdPacket::RenderVeboxCmd(
         }
 
         //---------------------------------
-        // Send CMD: Vebox_State
-        //---------------------------------
-        VP_RENDER_CHK_STATUS_RETURN(SetVeboxState(
-            pCmdBufferInUse));
-
-        //---------------------------------
-        // Send CMD: Vebox_Surface_State
+        // Send CMD: Vebox_State, Vebox_Surface_State and SFC pipe commands
         //---------------------------------
-        VP_RENDER_CHK_STATUS_RETURN(SetVeboxSurfaces(
+        VP_RENDER_CHK_STATUS_RETURN(RenderVeboxCmdSegment(
+            VEBOX_CMD_SEGMENT_STATE,
             pCmdBufferInUse,
-            &MhwVeboxSurfaceStateCmdParams));
-
-        //---------------------------------
-        // Send CMD: SFC pipe commands
-        //---------------------------------
-        if (m_IsSfcUsed)
-        {
-            VP_RENDER_CHK_NULL_RETURN(m_sfcRender);
-
-            VP_RENDER_CHK_STATUS_RETURN(m_sfcRender->SetSfcPipe(curPipe, numPipe));
-
-            VP_RENDER_CHK_STATUS_RETURN(m_sfcRender->SetupSfcState(m_renderTarget));
-
-            VP_RENDER_CHK_STATUS_RETURN(m_sfcRender->SendSfcCmd(
-                (pRenderData->DI.bDeinterlace || pRenderData->DN.bDnEnabled),
-                pCmdBufferInUse));
-        }
+            &MhwVeboxSurfaceStateCmdParams,
+            curPipe,
+            numPipe,
+            recordResources,
+            replayCmd,
+            recordCmd));
 
         pRenderHal->pRenderHalPltInterface->OnDispatch(pRenderHal, pCmdBufferInUse, pOsContext, pMmioRegisters);
         //HalOcaInterfaceNext::OnDispatch(*pCmdBufferInUse, *pOsContext, m_miItf, *pMmioRegisters);
@@ -1667,8 +1826,15 @@ MOS_STATUS VpVeboxCmdPacket::RenderVeboxCmd(
         //---------------------------------
         // Send CMD: Vebox_DI_IECP
         //---------------------------------
-        VP_RENDER_CHK_STATUS_RETURN(SetVeboxDiIecp(
-            pCmdBufferInUse));
+        VP_RENDER_CHK_STATUS_RETURN(RenderVeboxCmdSegment(
+            VEBOX_CMD_SEGMENT_DI_IECP,
+            pCmdBufferInUse,
+            &MhwVeboxSurfaceStateCmdParams,
+            curPipe,
+            numPipe,
+            recordResources,
+            replayCmd,
+            recordCmd));
 
         VP_RENDER_CHK_NULL_RETURN(pOsInterface);
         VP_RENDER_CHK_NULL_RETURN(pOsInterface->pfnGetSkuTable);
@@ -1696,7 +1862,7 @@ MOS_STATUS VpVeboxCmdPacket::RenderVeboxCmd(
         // Write GPU Status Tag for Tag based synchronization
         //---------------------------------
 #if !EMUL
-        if (!pOsInterface->bEnableKmdMediaFrameTracking)
+        if (!pOsInterface->bEnableKmdMediaFrameTracking && IsLastPacketInBatch())
         {
             VP_RENDER_CHK_STATUS_RETURN(SendVecsStatusTag(
                 pOsInterface,
@@ -1729,16 +1895,20 @@ MOS_STATUS VpVeboxCmdPacket::RenderVeboxCmd(
 
         VP_RENDER_CHK_STATUS_RETURN(pRenderHal->pRenderHalPltInterface->AddPerfCollectEndCmd(pRenderHal, pOsInterface, pCmdBufferInUse));
 
-        HalOcaInterfaceNext::On1stLevelBBEnd(*pCmdBufferInUse, *pOsInterface);
-
-        if (pOsInterface->bNoParsingAssistanceInKmd)
+        // For batch submission, the command buffer is ended by the last packet.
+        if (IsLastPacketInBatch())
         {
-            m_miItf->AddMiBatchBufferEnd(pCmdBufferInUse, nullptr);
-        }
-        else if (RndrCommonIsMiBBEndNeeded(pOsInterface))
-        {
-            // Add Batch Buffer end command (HW/OS dependent)
-            m_miItf->AddMiBatchBufferEnd(pCmdBufferInUse, nullptr);
+            HalOcaInterfaceNext::On1stLevelBBEnd(*pCmdBufferInUse, *pOsInterface);
+
+            if (pOsInterface->bNoParsingAssistanceInKmd)
+            {
+                m_miItf->AddMiBatchBufferEnd(pCmdBufferInUse, nullptr);
+            }
+            else if (RndrCommonIsMiBBEndNeeded(pOsInterface))
+            {
+                // Add Batch Buffer end command (HW/OS dependent)
+                m_miItf->AddMiBatchBufferEnd(pCmdBufferInUse, nullptr);
+            }
         }
 
         if (bMultipipe)
@@ -1747,6 +1917,11 @@ MOS_STATUS VpVeboxCmdPacket::RenderVeboxCmd(
         }
     }
 
+    if (recordCmd)
+    {
+        m_cmdRecorder->Complete(recordResources);
+    }
+
     if (bMultipipe)
     {
         scalability->SetCurrentPipeIndex(inputPipe);
@@ -2010,6 +2185,13 @@ MOS_STATUS VpVeboxCmdPacket::Prepare()
 
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
 
+    if (m_batchSubmitPhase)
+    {
+        // For batch submission, the state is prepared right before the commands being built,
+        // so that each packet in the batch gets its own vebox heap instance.
+        VP_RENDER_CHK_STATUS_RETURN(PrepareState());
+    }
+
     return eStatus;
 }
 
@@ -2128,6 +2310,29 @@ MOS_STATUS VpVeboxCmdPacket::SetUpdatedExecuteResource(
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS VpVeboxCmdPacket::PacketInitForReuse()
+{
+    VP_FUNC_CALL();
+
+    VP_RENDER_CHK_STATUS_RETURN(VpCmdPacket::PacketInitForReuse());
+
+    m_packetReused = true;
+
+    if (nullptr == m_cmdRecorder)
+    {
+        VP_RENDER_CHK_NULL_RETURN(m_hwInterface);
+        VpUserFeatureControl *userFeatureControl = m_hwInterface->m_userFeatureControl;
+        if (userFeatureControl && userFeatureControl->IsPacketCmdReplayDisabled())
+        {
+            return MOS_STATUS_SUCCESS;
+        }
+        m_cmdRecorder = MOS_New(VpCmdRecorder, m_hwInterface->m_osInterface);
+        VP_RENDER_CHK_NULL_RETURN(m_cmdRecorder);
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
 MOS_STATUS VpVeboxCmdPacket::PacketInit(
     VP_SURFACE                          *inputSurface,
     VP_SURFACE                          *outputSurface,
@@ -2139,6 +2344,13 @@ MOS_STATUS VpVeboxCmdPacket::PacketInit(
 
     VpVeboxRenderData       *pRenderData = GetLastExecRenderData();
     m_packetResourcesPrepared = false;
+    m_packetReused            = false;
+
+    if (m_cmdRecorder)
+    {
+        // Packet parameters may be changed. Drop the commands recorded for last pipe.
+        m_cmdRecorder->Reset();
+    }
 
     VP_RENDER_CHK_NULL_RETURN(pRenderData);
     VP_RENDER_CHK_NULL_RETURN(inputSurface);
@@ -2295,6 +2507,7 @@ VpVeboxCmdPacket:: ~VpVeboxCmdPacket()
     MOS_Delete(m_sfcRender);
     MOS_Delete(m_lastExecRenderData);
     MOS_Delete(m_surfMemCacheCtl);
+    MOS_Delete(m_cmdRecorder);
 
     m_allocator->DestroyVpSurface(m_currentSurface);
     m_allocator->DestroyVpSurface(m_previousSurface);
@@ -32,6 +32,7 @@
 #include "vp_vebox_common.h"
 #include "vp_render_sfc_base_legacy.h"
 #include "vp_filter.h"
+#include "vp_cmd_recorder.h"
 #include "mhw_mi_itf.h"
 
 #define VP_MAX_NUM_FFDI_SURFACES     4                                       //!< 2 for ADI plus additional 2 for parallel execution on HSW+
@@ -300,6 +301,15 @@ typedef struct _VEBOX_PACKET_SURFACE_PARAMS
 }VEBOX_PACKET_SURFACE_PARAMS, *PVEBOX_PACKET_SURFACE_PARAMS;
 };
 
+//!
+//! \brief Vebox command segments which can be recorded and replayed for reused packet
+//!
+enum VEBOX_CMD_SEGMENT
+{
+    VEBOX_CMD_SEGMENT_STATE = 0,        //!< VEBOX_STATE, VEBOX_SURFACE_STATE and SFC pipe commands
+    VEBOX_CMD_SEGMENT_DI_IECP           //!< VEB_DI_IECP command
+};
+
 enum MEDIASTATE_DNDI_FIELDCOPY_SELECT
 {
     MEDIASTATE_DNDI_DEINTERLACE     = 0,
@@ -353,6 +363,11 @@ public:
 
     virtual MOS_STATUS PrepareState() override;
 
+    virtual bool IsBatchSubmitSupported() override
+    {
+        return true;
+    }
+
     virtual MOS_STATUS                  AllocateExecRenderData()
     {
         MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
@@ -777,6 +792,8 @@ public:
         VP_SURFACE                          *previousSurface,
         VP_SURFACE_SETTING                  &surfSetting) override;
 
+    virtual MOS_STATUS PacketInitForReuse() override;
+
     //!
     //! \brief    Check whether the Vebox command parameters are correct
     //! \param    [in] VeboxStateCmdParams
@@ -1141,6 +1158,76 @@ private:
     MOS_STATUS SetVeboxDiIecp(
         PMOS_COMMAND_BUFFER                pCmdBufferInUse);
 
+    //!
+    //! \brief    Send the commands of vebox command segment
+    //! \param    [in] segment
+    //!           Command segment to be sent
+    //! \param    [in,out] pCmdBufferInUse
+    //!           Pointer to command buffer
+    //! \param    [in] pMhwVeboxSurfaceStateCmdParams
+    //!           Pointer to MHW vebox surface state cmd params
+    //! \param    [in] curPipe
+    //!           Current pipe index
+    //! \param    [in] numPipe
+    //!           Number of pipes
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    virtual MOS_STATUS SendVeboxCmdSegment(
+        VEBOX_CMD_SEGMENT                   segment,
+        PMOS_COMMAND_BUFFER                 pCmdBufferInUse,
+        PMHW_VEBOX_SURFACE_STATE_CMD_PARAMS pMhwVeboxSurfaceStateCmdParams,
+        uint32_t                            curPipe,
+        uint32_t                            numPipe);
+
+    //!
+    //! \brief    Render vebox command segment
+    //! \details  Replay the commands recorded for reused packet if replayCmd is true,
+    //!           otherwise send the commands, recording them if recordCmd is true.
+    //! \param    [in] segment
+    //!           Command segment to be rendered
+    //! \param    [in,out] pCmdBufferInUse
+    //!           Pointer to command buffer
+    //! \param    [in] pMhwVeboxSurfaceStateCmdParams
+    //!           Pointer to MHW vebox surface state cmd params
+    //! \param    [in] curPipe
+    //!           Current pipe index
+    //! \param    [in] numPipe
+    //!           Number of pipes
+    //! \param    [in] recordResources
+    //!           Resources referenced by recorded commands
+    //! \param    [in] replayCmd
+    //!           Replay recorded commands
+    //! \param    [in] recordCmd
+    //!           Record the commands being sent
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    MOS_STATUS RenderVeboxCmdSegment(
+        VEBOX_CMD_SEGMENT                   segment,
+        PMOS_COMMAND_BUFFER                 pCmdBufferInUse,
+        PMHW_VEBOX_SURFACE_STATE_CMD_PARAMS pMhwVeboxSurfaceStateCmdParams,
+        uint32_t                            curPipe,
+        uint32_t                            numPipe,
+        const VP_CMD_RECORD_RESOURCES       &recordResources,
+        bool                                replayCmd,
+        bool                                recordCmd);
+
+    //!
+    //! \brief    Get resources which may be referenced by recorded vebox commands
+    //! \details  The list is in the same order for every frame, which lets recorded
+    //!           commands be relocated to the surfaces of current frame.
+    //! \param    [out] resources
+    //!           Resource list
+    //! \param    [in] pVeboxHeap
+    //!           Pointer to vebox heap
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    virtual MOS_STATUS GetCmdRecordResources(
+        VP_CMD_RECORD_RESOURCES             &resources,
+        const MHW_VEBOX_HEAP                *pVeboxHeap);
+
 protected:
 
     // Execution state
@@ -1183,6 +1270,10 @@ protected:
     MediaFeatureManager        *m_featureManager           = nullptr;
     std::shared_ptr<mhw::mi::Itf> m_miItf                  = nullptr;
 
+    // Command record and replay for reused packet
+    VpCmdRecorder              *m_cmdRecorder              = nullptr;            //!< Recorded commands of reused packet
+    bool                        m_packetReused             = false;              //!< Packet is initialized by PacketInitForReuse
+
 MEDIA_CLASS_DEFINE_END(vp__VpVeboxCmdPacket)
 };
 
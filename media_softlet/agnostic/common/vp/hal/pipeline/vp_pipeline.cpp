@@ -151,10 +151,14 @@ MOS_STATUS VpPipeline::UserFeatureReport()
                 m_reporting->GetFeatures().primaryCompressMode = (uint8_t)(params->pSrc[0]->CompressionMode);
             }
 
-            if (params->pTarget[0]->bCompressible)
+            for (uint32_t i = 0; i < params->uDstCount && i < VPHAL_MAX_TARGETS; ++i)
             {
-                m_reporting->GetFeatures().rtCompressible = true;
-                m_reporting->GetFeatures().rtCompressMode = (uint8_t)(params->pTarget[0]->CompressionMode);
+                if (params->pTarget[i] && params->pTarget[i]->bCompressible)
+                {
+                    m_reporting->GetFeatures().rtCompressible = true;
+                    m_reporting->GetFeatures().rtCompressMode = (uint8_t)(params->pTarget[i]->CompressionMode);
+                    break;
+                }
             }
         }
     }
@@ -352,8 +356,17 @@ MOS_STATUS VpPipeline::ExecuteVpPipeline()
 
     VP_PUBLIC_CHK_STATUS_RETURN(CreateSwFilterPipe(m_pvpParams, swFilterPipes));
 
+    // Packet pipes whose packets have been added to task, waiting for batch submission.
+    std::vector<PacketPipe *> batchedPipes;
+
     auto retHandler = [&]()
     {
+        PacketPipe::DiscardBatch(batchedPipes);
+        for (auto &pipe : batchedPipes)
+        {
+            m_pPacketPipeFactory->ReturnPacketPipe(pipe);
+        }
+        batchedPipes.clear();
         m_pPacketPipeFactory->ReturnPacketPipe(pPacketPipe);
         for (auto &pipe : swFilterPipes)
         {
@@ -409,6 +422,10 @@ MOS_STATUS VpPipeline::ExecuteVpPipeline()
         // MediaPipeline::m_statusReport is always nullptr in VP APO path right now.
         eStatus = pipeReused->Execute(MediaPipeline::m_statusReport, m_scalability, m_mediaContext, MOS_VE_SUPPORTED(m_osInterface), m_numVebox);
 
+        if (MOS_SUCCEEDED(eStatus) && pipeReused->Is3DLutCalcSubmitted())
+        {
+            m_resourceManager->On3DLutCalcSubmitted();
+        }
         if (MOS_SUCCEEDED(eStatus))
         {
             VP_PUBLIC_CHK_STATUS_RETURN(chkStatusHandler(UpdateExecuteStatus()));
@@ -430,6 +447,11 @@ MOS_STATUS VpPipeline::ExecuteVpPipeline()
         m_packetReused = false;
     }
 
+    // For 1:N multiple outputs, the vebox/sfc packets of the outputs are built into one command buffer
+    // and submitted together, instead of one submission for each output.
+    bool     batchSubmit  = IsMultiOutputBatchSubmitEnabled(swFilterPipes);
+    uint32_t maxBatchSize = batchSubmit ? GetMaxBatchSubmitSize() : 0;
+
     for (auto &pipe : swFilterPipes)
     {
         pPacketPipe = m_pPacketPipeFactory->CreatePacketPipe();
@@ -443,9 +465,33 @@ MOS_STATUS VpPipeline::ExecuteVpPipeline()
         m_vpOutputPipe = pPacketPipe->GetOutputPipeMode();
         m_veboxFeatureInuse = pPacketPipe->IsVeboxFeatureInuse();
 
+        if (batchSubmit && maxBatchSize > 1 && pPacketPipe->IsBatchSubmitSupported())
+        {
+            if (batchedPipes.size() >= maxBatchSize)
+            {
+                VP_PUBLIC_CHK_STATUS_RETURN(chkStatusHandler(SubmitBatchedPacketPipes(batchedPipes)));
+            }
+
+            // Commands of the packet are built in SubmitBatchedPacketPipes.
+            eStatus = pPacketPipe->Execute(MediaPipeline::m_statusReport, m_scalability, m_mediaContext, MOS_VE_SUPPORTED(m_osInterface), m_numVebox, true);
+            VP_PUBLIC_CHK_STATUS_RETURN(chkStatusHandler(eStatus));
+
+            batchedPipes.push_back(pPacketPipe);
+            pPacketPipe = nullptr;
+            continue;
+        }
+
+        // Packet pipes added to task before need be submitted first to keep the execution order.
+        VP_PUBLIC_CHK_STATUS_RETURN(chkStatusHandler(SubmitBatchedPacketPipes(batchedPipes)));
+
         // MediaPipeline::m_statusReport is always nullptr in VP APO path right now.
         eStatus = pPacketPipe->Execute(MediaPipeline::m_statusReport, m_scalability, m_mediaContext, MOS_VE_SUPPORTED(m_osInterface), m_numVebox);
 
+        // 3DLut table is cached only if the kernel calculating it is submitted.
+        if (MOS_SUCCEEDED(eStatus) && pPacketPipe->Is3DLutCalcSubmitted())
+        {
+            m_resourceManager->On3DLutCalcSubmitted();
+        }
         if (MOS_SUCCEEDED(eStatus))
         {
             VP_PUBLIC_CHK_STATUS_RETURN(chkStatusHandler(m_packetReuseMgr->UpdatePacketPipeConfig(pPacketPipe)));
@@ -455,11 +501,118 @@ MOS_STATUS VpPipeline::ExecuteVpPipeline()
         m_pPacketPipeFactory->ReturnPacketPipe(pPacketPipe);
     }
 
+    VP_PUBLIC_CHK_STATUS_RETURN(chkStatusHandler(SubmitBatchedPacketPipes(batchedPipes)));
+
     retHandler();
 
     return eStatus;
 }
 
+bool VpPipeline::IsMultiOutputExecutionSupported(PCVP_PIPELINE_PARAMS params)
+{
+    VP_FUNC_CALL();
+
+    if (nullptr == params || 1 != params->uSrcCount || params->uDstCount <= 1)
+    {
+        return true;
+    }
+
+    if (!IsMultiOutputUniform(params))
+    {
+        VP_PUBLIC_NORMALMESSAGE("Targets differ in format, size or compression, execute 1:N outputs separately.");
+        return false;
+    }
+
+#if (_DEBUG || _RELEASE_INTERNAL)
+    // Output surface replacement for debug only replaces the first target.
+    if (m_userFeatureControl &&
+        (m_userFeatureControl->EnabledSFCNv12P010LinearOutput() ||
+         m_userFeatureControl->EnabledSFCRGBPRGB24Output() != VP_RGB_OUTPUT_OVERRIDE_ID_INVALID))
+    {
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+bool VpPipeline::IsMultiOutputBatchSubmitEnabled(std::vector<SwFilterPipe *> &swFilterPipes)
+{
+    VP_FUNC_CALL();
+
+    if (PIPELINE_PARAM_TYPE_LEGACY != m_pvpParams.type || nullptr == m_pvpParams.renderParams ||
+        swFilterPipes.size() <= 1)
+    {
+        return false;
+    }
+
+    PVP_PIPELINE_PARAMS params = m_pvpParams.renderParams;
+    if (1 != params->uSrcCount || params->uDstCount <= 1)
+    {
+        return false;
+    }
+
+    // Vebox scalability uses one command buffer for each pipe.
+    if (IsMultiple() && MOS_VE_SUPPORTED(m_osInterface))
+    {
+        return false;
+    }
+
+    if (m_userFeatureControl && m_userFeatureControl->IsMultiOutputBatchSubmitDisabled())
+    {
+        VP_PUBLIC_NORMALMESSAGE("Multi output batch submit disabled.");
+        return false;
+    }
+
+    return true;
+}
+
+uint32_t VpPipeline::GetMaxBatchSubmitSize()
+{
+    VP_FUNC_CALL();
+
+    if (nullptr == m_vpMhwInterface.m_vpPlatformInterface)
+    {
+        return 0;
+    }
+
+    auto veboxItf = m_vpMhwInterface.m_vpPlatformInterface->GetMhwVeboxItf();
+    if (nullptr == veboxItf)
+    {
+        return 0;
+    }
+
+    // Each packet in the batch uses its own vebox heap instance. Keep one instance
+    // for the packets submitted before, which may still be in use by GPU.
+    uint32_t numInstances = veboxItf->GetVeboxNumInstances();
+    return numInstances > 1 ? numInstances - 1 : 0;
+}
+
+MOS_STATUS VpPipeline::SubmitBatchedPacketPipes(std::vector<PacketPipe *> &packetPipes)
+{
+    VP_FUNC_CALL();
+
+    if (packetPipes.empty())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_STATUS status = PacketPipe::SubmitBatch(packetPipes, m_scalability);
+
+    if (MOS_SUCCEEDED(status))
+    {
+        status = UpdateExecuteStatus();
+    }
+
+    for (auto &pipe : packetPipes)
+    {
+        m_pPacketPipeFactory->ReturnPacketPipe(pipe);
+    }
+    packetPipes.clear();
+
+    return status;
+}
+
 MOS_STATUS VpPipeline::UpdateExecuteStatus()
 {
     VP_FUNC_CALL();
@@ -484,7 +637,10 @@ MOS_STATUS VpPipeline::UpdateExecuteStatus()
         if (uiForceDecompressedOutput)
         {
             VP_PUBLIC_NORMALMESSAGE("uiForceDecompressedOutput: %d", uiForceDecompressedOutput);
-            m_mmc->DecompressVPResource(params->pTarget[0]);
+            for (uint32_t i = 0; i < params->uDstCount && i < VPHAL_MAX_TARGETS; ++i)
+            {
+                m_mmc->DecompressVPResource(params->pTarget[i]);
+            }
         }
     }
 finish:
@@ -668,7 +824,33 @@ MOS_STATUS VpPipeline::CheckFeatures(void *params, bool &bapgFuncSupported)
     VP_FUNC_CALL();
 
     VP_PUBLIC_CHK_NULL_RETURN(m_paramChecker);
-    return m_paramChecker->CheckFeatures(params, bapgFuncSupported);
+    VP_PUBLIC_CHK_NULL_RETURN(params);
+
+    PVP_PIPELINE_PARAMS pvpParams = (PVP_PIPELINE_PARAMS)params;
+    if (1 != pvpParams->uSrcCount || pvpParams->uDstCount <= 1 || nullptr == pvpParams->pSrc[0])
+    {
+        return m_paramChecker->CheckFeatures(params, bapgFuncSupported);
+    }
+
+    // 1:N multiple outputs are processed with one pipe per output in ExecuteVpPipeline,
+    // thus check the features for each output separately. The source is copied, for
+    // its rcDst differs between outputs and the caller's surface is kept unchanged.
+    VP_PIPELINE_PARAMS targetParams = *pvpParams;
+    VPHAL_SURFACE      source       = *pvpParams->pSrc[0];
+
+    targetParams.pSrc[0]   = &source;
+    targetParams.uDstCount = 1;
+    bapgFuncSupported      = true;
+    for (uint32_t i = 0; i < pvpParams->uDstCount && bapgFuncSupported; ++i)
+    {
+        VP_PUBLIC_CHK_NULL_RETURN(pvpParams->pTarget[i]);
+        targetParams.pTarget[0] = pvpParams->pTarget[i];
+        source.rcDst            = pvpParams->pTarget[i]->rcSrc;
+
+        VP_PUBLIC_CHK_STATUS_RETURN(m_paramChecker->CheckFeatures(&targetParams, bapgFuncSupported));
+    }
+
+    return MOS_STATUS_SUCCESS;
 }
 
 MOS_STATUS VpPipeline::CreateFeatureReport()
@@ -843,10 +1025,14 @@ MOS_STATUS VpPipeline::PrepareVpPipelineParams(PVP_PIPELINE_PARAMS params)
             info));
     }
 
-    MOS_ZeroMemory(&info, sizeof(VPHAL_GET_SURFACE_INFO));
-    VP_PUBLIC_CHK_STATUS_RETURN(m_allocator->GetSurfaceInfo(
-        params->pTarget[0],
-        info));
+    for (uint32_t i = 0; i < params->uDstCount; ++i)
+    {
+        VP_PUBLIC_CHK_NULL_RETURN(params->pTarget[i]);
+        MOS_ZeroMemory(&info, sizeof(VPHAL_GET_SURFACE_INFO));
+        VP_PUBLIC_CHK_STATUS_RETURN(m_allocator->GetSurfaceInfo(
+            params->pTarget[i],
+            info));
+    }
 
     if (params->uSrcCount>0)
     {
@@ -931,6 +1117,19 @@ MOS_STATUS VpPipeline::PrepareVpPipelineScalabilityParams(PVP_PIPELINE_PARAMS pa
 
     VP_PUBLIC_CHK_NULL_RETURN(params->pTarget[0]);
 
+    // For 1:N multiple outputs, any 4k+ output enables scalability.
+    bool is4kTarget = false;
+    for (uint32_t i = 0; i < params->uDstCount && i < VPHAL_MAX_TARGETS; ++i)
+    {
+        VP_PUBLIC_CHK_NULL_RETURN(params->pTarget[i]);
+        if ((MOS_MIN(params->pTarget[i]->dwWidth, (uint32_t)params->pTarget[i]->rcSrc.right) > m_4k_content_width) &&
+            (MOS_MIN(params->pTarget[i]->dwHeight, (uint32_t)params->pTarget[i]->rcSrc.bottom) > m_4k_content_height))
+        {
+            is4kTarget = true;
+            break;
+        }
+    }
+
     // Disable vesfc scalability when reg key "Enable Vebox Scalability" was set to zero
     if (m_forceMultiplePipe == (MOS_SCALABILITY_ENABLE_MODE_USER_FORCE | MOS_SCALABILITY_ENABLE_MODE_FALSE))
     {
@@ -940,8 +1139,7 @@ MOS_STATUS VpPipeline::PrepareVpPipelineScalabilityParams(PVP_PIPELINE_PARAMS pa
     {
         if (((MOS_MIN(params->pSrc[0]->dwWidth, (uint32_t)params->pSrc[0]->rcSrc.right) > m_4k_content_width) &&
              (MOS_MIN(params->pSrc[0]->dwHeight, (uint32_t)params->pSrc[0]->rcSrc.bottom) > m_4k_content_height)) ||
-            ((MOS_MIN(params->pTarget[0]->dwWidth, (uint32_t)params->pTarget[0]->rcSrc.right) > m_4k_content_width) &&
-             (MOS_MIN(params->pTarget[0]->dwHeight, (uint32_t)params->pTarget[0]->rcSrc.bottom) > m_4k_content_height)))
+            is4kTarget)
         {
             // Enable vesfc scalability only with 4k+ clips
         }
@@ -48,6 +48,7 @@ namespace vp
 
 class PacketFactory;
 class PacketPipeFactory;
+class PacketPipe;
 class VpResourceManager;
 class SwFilterFeatureHandler;
 
@@ -160,6 +161,17 @@ public:
     //!
     bool IsVeboxSfcFormatSupported(MOS_FORMAT formatInput, MOS_FORMAT formatOutput);
 
+    //!
+    //! \brief    Check whether 1:N multiple outputs can be processed in one execution
+    //! \details  Targets differing in format, size or compression are executed one by one,
+    //!           for frame level decisions are made on the first target.
+    //! \param    params
+    //!           [in] Pipeline params
+    //! \return   bool
+    //!           Return true if supported, otherwise execute each output separately
+    //!
+    virtual bool IsMultiOutputExecutionSupported(PCVP_PIPELINE_PARAMS params);
+
     virtual MOS_STATUS ProcessBypassHandler(PVP_PIPELINE_PARAMS renderParams, bool &isBypassNeeded)
     {
         return MOS_STATUS_SUCCESS;
@@ -222,6 +234,31 @@ protected:
     //!
     virtual MOS_STATUS UpdateExecuteStatus();
 
+    //!
+    //! \brief  Check whether packet pipes of 1:N multiple outputs can be submitted in batch
+    //! \param  [in] swFilterPipes
+    //!         SwFilterPipes of current frame
+    //! \return bool
+    //!         true if batch submission enabled, otherwise false
+    //!
+    virtual bool IsMultiOutputBatchSubmitEnabled(std::vector<SwFilterPipe *> &swFilterPipes);
+
+    //!
+    //! \brief  Get max number of packet pipes in one batch submission
+    //! \return uint32_t
+    //!         Max number of packet pipes, 0 if batch submission not supported
+    //!
+    virtual uint32_t GetMaxBatchSubmitSize();
+
+    //!
+    //! \brief  Submit packet pipes added to task in one command buffer and return them to factory
+    //! \param  [in, out] packetPipes
+    //!         Packet pipes executed with deferred submission, which is cleared after submission
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    virtual MOS_STATUS SubmitBatchedPacketPipes(std::vector<PacketPipe *> &packetPipes);
+
     //!
     //! \brief  Create SwFilterPipe
     //! \param  [in] params
@@ -140,7 +140,8 @@ MOS_STATUS VpPipelineAdapter::Render(PCVPHAL_RENDER_PARAMS pcRenderParams)
     VP_PUBLIC_CHK_NULL_RETURN(pcRenderParams);
     VP_PUBLIC_CHK_NULL_RETURN(m_vpPipeline);
 
-    if (1 == pcRenderParams->uSrcCount && pcRenderParams->uDstCount > 1)
+    if (1 == pcRenderParams->uSrcCount && pcRenderParams->uDstCount > 1 &&
+        !m_vpPipeline->IsMultiOutputExecutionSupported(pcRenderParams))
     {
         for (uint32_t dstIndex = 0; dstIndex < pcRenderParams->uDstCount; ++dstIndex)
         {
@@ -149,14 +150,11 @@ MOS_STATUS VpPipelineAdapter::Render(PCVPHAL_RENDER_PARAMS pcRenderParams)
             // update the first target point
             params.pTarget[0]            = pcRenderParams->pTarget[dstIndex];
             params.pTarget[0]->b16UsrPtr = pcRenderParams->pTarget[dstIndex]->b16UsrPtr;
-            if (pcRenderParams->uDstCount > 1)
-            {
-                // for multi output, support different scaling ratio but doesn't support cropping.
-                params.pSrc[0]->rcDst.top    = params.pTarget[0]->rcSrc.top;
-                params.pSrc[0]->rcDst.left   = params.pTarget[0]->rcSrc.left;
-                params.pSrc[0]->rcDst.bottom = params.pTarget[0]->rcSrc.bottom;
-                params.pSrc[0]->rcDst.right  = params.pTarget[0]->rcSrc.right;
-            }
+            // for multi output, support different scaling ratio but doesn't support cropping.
+            params.pSrc[0]->rcDst.top    = params.pTarget[0]->rcSrc.top;
+            params.pSrc[0]->rcDst.left   = params.pTarget[0]->rcSrc.left;
+            params.pSrc[0]->rcDst.bottom = params.pTarget[0]->rcSrc.bottom;
+            params.pSrc[0]->rcDst.right  = params.pTarget[0]->rcSrc.right;
             // default render of video
             params.bIsDefaultStream = true;
 
@@ -170,6 +168,8 @@ MOS_STATUS VpPipelineAdapter::Render(PCVPHAL_RENDER_PARAMS pcRenderParams)
     }
     else
     {
+        // For 1:N multiple outputs of same format, size and compression, the outputs are split
+        // into separate pipes inside VpPipeline, which allows them to be submitted together.
         params = *(PVP_PIPELINE_PARAMS)pcRenderParams;
         // default render of video
         params.bIsDefaultStream = true;
@@ -278,4 +278,39 @@ inline bool IsVeboxFeatureInuse(VP_EXECUTE_CAPS &caps)
             caps.bHDR3DLUT || caps.bDV));
 }
 
+//!
+//! \brief   Check whether the targets of 1:N multiple outputs share format, size, tiling and compression
+//! \details Frame level decisions, e.g. scalability and MMC, are made on the first target. They
+//!          only hold for all outputs processed in one execution when the targets match.
+//! \param   [in] params
+//!          Pipeline params
+//! \return  bool
+//!          true if all targets match, otherwise false
+//!
+inline bool IsMultiOutputUniform(PCVP_PIPELINE_PARAMS params)
+{
+    if (nullptr == params || nullptr == params->pTarget[0])
+    {
+        return false;
+    }
+
+    PVPHAL_SURFACE target0 = params->pTarget[0];
+    for (uint32_t i = 1; i < params->uDstCount && i < VPHAL_MAX_TARGETS; ++i)
+    {
+        PVPHAL_SURFACE target = params->pTarget[i];
+        if (nullptr == target                                   ||
+            target->Format          != target0->Format          ||
+            target->TileType        != target0->TileType        ||
+            target->dwWidth         != target0->dwWidth         ||
+            target->dwHeight        != target0->dwHeight        ||
+            target->bCompressible   != target0->bCompressible   ||
+            target->bIsCompressed   != target0->bIsCompressed   ||
+            target->CompressionMode != target0->CompressionMode)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 #endif
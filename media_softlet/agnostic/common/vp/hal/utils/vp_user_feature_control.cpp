@@ -148,6 +148,57 @@ VpUserFeatureControl::VpUserFeatureControl(MOS_INTERFACE &osInterface, VpPlatfor
     }
     VP_PUBLIC_NORMALMESSAGE("disablePacketReuse %d", m_ctrlValDefault.disablePacketReuse);
 
+    bool disablePacketCmdReplay = false;
+    status = ReadUserSetting(
+        m_userSettingPtr,
+        disablePacketCmdReplay,
+        __MEDIA_USER_FEATURE_VALUE_DISABLE_PACKET_CMD_REPLAY,
+        MediaUserSetting::Group::Sequence);
+    if (MOS_SUCCEEDED(status))
+    {
+        m_ctrlValDefault.disablePacketCmdReplay = disablePacketCmdReplay;
+    }
+    else
+    {
+        // Default value
+        m_ctrlValDefault.disablePacketCmdReplay = false;
+    }
+    VP_PUBLIC_NORMALMESSAGE("disablePacketCmdReplay %d", m_ctrlValDefault.disablePacketCmdReplay);
+
+    bool disableMultiOutputBatchSubmit = false;
+    status = ReadUserSetting(
+        m_userSettingPtr,
+        disableMultiOutputBatchSubmit,
+        __MEDIA_USER_FEATURE_VALUE_DISABLE_MULTI_OUTPUT_BATCH_SUBMIT,
+        MediaUserSetting::Group::Sequence);
+    if (MOS_SUCCEEDED(status))
+    {
+        m_ctrlValDefault.disableMultiOutputBatchSubmit = disableMultiOutputBatchSubmit;
+    }
+    else
+    {
+        // Default value
+        m_ctrlValDefault.disableMultiOutputBatchSubmit = false;
+    }
+    VP_PUBLIC_NORMALMESSAGE("disableMultiOutputBatchSubmit %d", m_ctrlValDefault.disableMultiOutputBatchSubmit);
+
+    bool enablePolicyPlanCache = false;
+    status = ReadUserSetting(
+        m_userSettingPtr,
+        enablePolicyPlanCache,
+        __MEDIA_USER_FEATURE_VALUE_ENABLE_POLICY_PLAN_CACHE,
+        MediaUserSetting::Group::Sequence);
+    if (MOS_SUCCEEDED(status))
+    {
+        m_ctrlValDefault.enablePolicyPlanCache = enablePolicyPlanCache;
+    }
+    else
+    {
+        // Default value
+        m_ctrlValDefault.enablePolicyPlanCache = false;
+    }
+    VP_PUBLIC_NORMALMESSAGE("enablePolicyPlanCache %d", m_ctrlValDefault.enablePolicyPlanCache);
+
     // bComputeContextEnabled is true only if Gen12+. 
     // Gen12+, compute context(MOS_GPU_NODE_COMPUTE, MOS_GPU_CONTEXT_COMPUTE) can be used for render engine.
     // Before Gen12, we only use MOS_GPU_NODE_3D and MOS_GPU_CONTEXT_RENDER.
@@ -257,6 +308,22 @@ MOS_STATUS VpUserFeatureControl::CreateUserSettingForDebug()
         // Default value
         m_ctrlValDefault.enabledSFCRGBPRGB24Output = 0;
     }
+
+    bool policyPlanCacheCrossCheck = false;
+    eRegKeyReadStatus = ReadUserSettingForDebug(
+        m_userSettingPtr,
+        policyPlanCacheCrossCheck,
+        __VPHAL_POLICY_PLAN_CACHE_CROSS_CHECK,
+        MediaUserSetting::Group::Sequence);
+    if (MOS_SUCCEEDED(eRegKeyReadStatus))
+    {
+        m_ctrlValDefault.policyPlanCacheCrossCheck = policyPlanCacheCrossCheck;
+    }
+    else
+    {
+        // Default value
+        m_ctrlValDefault.policyPlanCacheCrossCheck = false;
+    }
 #endif
     return MOS_STATUS_SUCCESS;
 }
@@ -54,8 +54,12 @@ public:
         bool forceDecompressedOutput        = false;
         uint32_t enabledSFCNv12P010LinearOutput = 0;
         uint32_t enabledSFCRGBPRGB24Output  = 0;
+        bool policyPlanCacheCrossCheck      = false;
 #endif
         bool disablePacketReuse             = false;
+        bool disablePacketCmdReplay         = false;
+        bool disableMultiOutputBatchSubmit  = false;
+        bool enablePolicyPlanCache          = false;
     };
 
 #if (_DEBUG || _RELEASE_INTERNAL)
@@ -114,6 +118,30 @@ public:
         return m_ctrlVal.disablePacketReuse;
     }
 
+    bool IsPacketCmdReplayDisabled()
+    {
+        return m_ctrlVal.disablePacketCmdReplay;
+    }
+
+    bool IsMultiOutputBatchSubmitDisabled()
+    {
+        return m_ctrlVal.disableMultiOutputBatchSubmit;
+    }
+
+    bool IsPolicyPlanCacheEnabled()
+    {
+        return m_ctrlVal.enablePolicyPlanCache;
+    }
+
+    bool IsPolicyPlanCacheCrossCheckEnabled()
+    {
+#if (_DEBUG || _RELEASE_INTERNAL)
+        return m_ctrlVal.policyPlanCacheCrossCheck;
+#else
+        return false;
+#endif
+    }
+
     const void *m_owner = nullptr; // The object who create current instance.
 
 protected:
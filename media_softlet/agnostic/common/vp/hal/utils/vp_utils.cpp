@@ -656,6 +656,27 @@ MOS_STATUS VpUtils::DeclareUserSettings(MediaUserSettingSharedPtr userSettingPtr
         0,
         true);
 
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_DISABLE_PACKET_CMD_REPLAY,
+        MediaUserSetting::Group::Sequence,
+        0,
+        true);
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_DISABLE_MULTI_OUTPUT_BATCH_SUBMIT,
+        MediaUserSetting::Group::Sequence,
+        0,
+        true);
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_ENABLE_POLICY_PLAN_CACHE,
+        MediaUserSetting::Group::Sequence,
+        0,
+        true);
+
 #if (_DEBUG || _RELEASE_INTERNAL)
     DeclareUserSettingKeyForDebug(  // FORCE VP DECOMPRESSED OUTPUT
         userSettingPtr,
@@ -727,6 +748,13 @@ MOS_STATUS VpUtils::DeclareUserSettings(MediaUserSettingSharedPtr userSettingPtr
         0,
         true);
 
+    DeclareUserSettingKeyForDebug(  // Compare cached policy plans with fresh evaluation
+        userSettingPtr,
+        __VPHAL_POLICY_PLAN_CACHE_CROSS_CHECK,
+        MediaUserSetting::Group::Sequence,
+        0,
+        true);
+
     DeclareUserSettingKeyForDebug(  // Surface Dump Outfile
         userSettingPtr,
         __VPHAL_DBG_SURF_DUMP_OUTFILE_KEY_NAME,
@@ -282,6 +282,9 @@ protected:
 #define __MEDIA_USER_FEATURE_VALUE_CSC_COEFF_PATCH_MODE_DISABLE         "CSC Patch Mode Disable"
 #define __MEDIA_USER_FEATURE_VALUE_BYPASS_VEBOX_DN_STATE_UPDATE         "Bypass Vebox Dn State Update"
 #define __MEDIA_USER_FEATURE_VALUE_DISABLE_PACKET_REUSE                 "Disable PacketReuse"
+#define __MEDIA_USER_FEATURE_VALUE_DISABLE_PACKET_CMD_REPLAY            "Disable Packet Cmd Replay"
+#define __MEDIA_USER_FEATURE_VALUE_DISABLE_MULTI_OUTPUT_BATCH_SUBMIT   "Disable Multi Output Batch Submit"
+#define __MEDIA_USER_FEATURE_VALUE_ENABLE_POLICY_PLAN_CACHE             "Enable Policy Plan Cache"
 
 #if (_DEBUG || _RELEASE_INTERNAL)
 #define __VPHAL_ENABLE_COMPUTE_CONTEXT                                  "VP Enable Compute Context"
@@ -295,6 +298,7 @@ protected:
 #define __VPHAL_VEBOX_FORCE_VP_MEMCOPY_OUTPUTCOMPRESSED                 "Force VP Memorycopy Outputcompressed"
 #define __VPHAL_ENABLE_SFC_NV12_P010_LINEAR_OUTPUT                      "Enable SFC NV12 P010 Linear Output"
 #define __VPHAL_ENABLE_SFC_RGBP_RGB24_OUTPUT                            "Enable SFC RGBP RGB24 Output"
+#define __VPHAL_POLICY_PLAN_CACHE_CROSS_CHECK                           "VP Policy Plan Cache Cross Check"
 
 #define __VPHAL_DBG_SURF_DUMP_OUTFILE_KEY_NAME                          "outfileLocation"
 #define __VPHAL_DBG_SURF_DUMP_LOCATION_KEY_NAME                         "dumpLocations"
@@ -138,6 +138,16 @@ MOS_STATUS OsContextSpecificNext::Init(DDI_DEVICE_CONTEXT ddiDriverContext)
             }
 
             mos_bufmgr_gem_enable_softpin(m_bufmgr, softpin_va1Malign);
+
+            ReadUserSetting(
+                userSettingPtr,
+                value,
+                __MEDIA_USER_FEATURE_VALUE_ENABLE_INDEXED_VMA_HEAP,
+                MediaUserSetting::Group::Device);
+            if (value)
+            {
+                mos_bufmgr_gem_enable_indexed_vma_heap(m_bufmgr);
+            }
         }
 
         if (MEDIA_IS_SKU(&m_skuTable, FtrEnableMediaKernels) == 0)
@@ -269,6 +279,11 @@ void OsContextSpecificNext::Destroy()
 
     if (GetOsContextValid() == true)
     {
+        if (NullHW::IsEnabled())
+        {
+            NullHW::ReportCost();
+        }
+
         if (m_auxTableMgr != nullptr)
         {
             MOS_Delete(m_auxTableMgr);
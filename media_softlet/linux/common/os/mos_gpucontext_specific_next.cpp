@@ -32,6 +32,7 @@
 #include "mos_os_virtualengine_next.h"
 #include <unistd.h>
 #include "mos_interface.h"
+#include "mos_vdbox_scheduler_specific.h"
 
 #define MI_BATCHBUFFER_END 0x05000000
 static pthread_mutex_t command_dump_mutex = PTHREAD_MUTEX_INITIALIZER;
@@ -151,6 +152,11 @@ MOS_STATUS GpuContextSpecificNext::Init(OsContextNext *osContext,
 
     m_GPUStatusTag = 1;
 
+    if (m_historyRing == MOS_OCA_INVALID_HISTORY_RING)
+    {
+        m_historyRing = MosOcaSubmissionHistory::GetInstance().AcquireRing();
+    }
+
     m_createOptionEnhanced = (MOS_GPUCTX_CREATOPTIONS_ENHANCED*)MOS_AllocAndZeroMemory(sizeof(MOS_GPUCTX_CREATOPTIONS_ENHANCED));
     MOS_OS_CHK_NULL_RETURN(m_createOptionEnhanced);
     m_createOptionEnhanced->SSEUValue = createOption->SSEUValue;
@@ -424,6 +430,11 @@ void GpuContextSpecificNext::Clear()
     }
     MOS_FreeMemAndSetNull(m_statusBufferResource);
 
+    MosVdboxScheduler::Instance().RemoveOwner(this);
+
+    MosOcaSubmissionHistory::GetInstance().ReleaseRing(m_historyRing);
+    m_historyRing = MOS_OCA_INVALID_HISTORY_RING;
+
     MosUtilities::MosLockMutex(m_cmdBufPoolMutex);
 
     if (m_cmdBufMgr)
@@ -877,7 +888,8 @@ MOS_VDBOX_NODE_IND GpuContextSpecificNext::GetVdboxNodeId(
 
 uint32_t GpuContextSpecificNext::GetVcsExecFlag(
     PMOS_COMMAND_BUFFER cmdBuffer,
-    MOS_GPU_NODE gpuNode)
+    MOS_GPU_NODE gpuNode,
+    bool loadAware)
 {
     if (cmdBuffer == 0)
     {
@@ -895,8 +907,16 @@ uint32_t GpuContextSpecificNext::GetVcsExecFlag(
        cmdBuffer->iVdboxNodeIndex = GetVdboxNodeId(cmdBuffer);
        if (MOS_VDBOX_NODE_INVALID == cmdBuffer->iVdboxNodeIndex)
        {
-           cmdBuffer->iVdboxNodeIndex = (gpuNode == MOS_GPU_NODE_VIDEO)?
-               MOS_VDBOX_NODE_1: MOS_VDBOX_NODE_2;
+           // No reference state ties the BB to a VDBOX, place it on the least loaded one.
+           if (loadAware)
+           {
+               cmdBuffer->iVdboxNodeIndex = MosVdboxScheduler::Instance().SelectCmdBufferNode();
+           }
+           else
+           {
+               cmdBuffer->iVdboxNodeIndex = (gpuNode == MOS_GPU_NODE_VIDEO)?
+                   MOS_VDBOX_NODE_1: MOS_VDBOX_NODE_2;
+           }
        }
      }
 
@@ -1231,7 +1251,7 @@ MOS_STATUS GpuContextSpecificNext::SubmitCommandBuffer(
         {
             if (perStreamParameters->bPerCmdBufferBalancing)
             {
-                execFlag = GetVcsExecFlag(cmdBuffer, gpuNode);
+                execFlag = GetVcsExecFlag(cmdBuffer, gpuNode, perStreamParameters->bVdboxLoadAware);
             }
             else if (gpuNode == MOS_GPU_NODE_VIDEO)
             {
@@ -1356,11 +1376,20 @@ MOS_STATUS GpuContextSpecificNext::SubmitCommandBuffer(
                 DR4,
                 execFlag,
                 nullptr);
+
+            if (ret == 0 && perStreamParameters->bKMDHasVCS2 && perStreamParameters->bVdboxLoadAware &&
+                (execFlag == (I915_EXEC_BSD | I915_EXEC_BSD_RING1) || execFlag == (I915_EXEC_BSD | I915_EXEC_BSD_RING2)))
+            {
+                MosVdboxScheduler::Instance().OnSubmit(this,
+                    (execFlag == (I915_EXEC_BSD | I915_EXEC_BSD_RING1)) ? MOS_VDBOX_NODE_1 : MOS_VDBOX_NODE_2,
+                    cmd_bo);
+            }
         }
         if (ret != 0)
         {
             eStatus = MOS_STATUS_UNKNOWN;
         }
+        RecordSubmissionHistory(streamState, cmdBuffer, gpuNode, DR4, ret);
     }
 
     if (eStatus != MOS_STATUS_SUCCESS)
@@ -1435,6 +1464,57 @@ finish:
     return eStatus;
 }
 
+void GpuContextSpecificNext::RecordSubmissionHistory(
+    MOS_STREAM_HANDLE   streamState,
+    PMOS_COMMAND_BUFFER cmdBuffer,
+    MOS_GPU_NODE        gpuNode,
+    int32_t             perfTag,
+    int32_t             result)
+{
+    if (m_historyRing == MOS_OCA_INVALID_HISTORY_RING)
+    {
+        return;
+    }
+
+    MOS_OCA_SUBMISSION_RECORD record = {};
+    record.batchBufferGfxAddress     = cmdBuffer->OsResource.bo ? cmdBuffer->OsResource.bo->offset64 : 0;
+    record.batchBufferSize           = (uint32_t)cmdBuffer->iOffset;
+    record.gpuContextHandle          = m_gpuContextHandle;
+    record.gpuNode                   = (uint32_t)gpuNode;
+    record.component                 = (uint32_t)streamState->component;
+    record.perfTag                   = (uint32_t)perfTag;
+    record.fence                     = m_GPUStatusTag;
+    record.submissionType            = (uint32_t)cmdBuffer->iSubmissionType;
+    record.result                    = result;
+
+    for (auto &secondary : m_secondaryCmdBufs)
+    {
+        if (record.subBBCount < MOS_OCA_SUBMISSION_MAX_SUB_BB_COUNT && secondary.second && secondary.second->OsResource.bo)
+        {
+            record.subBBGfxAddress[record.subBBCount] = secondary.second->OsResource.bo->offset64;
+        }
+        ++record.subBBCount;
+    }
+
+    // Written resources are the most likely to be involved in a hang, so they are kept first.
+    uint32_t resIndex = 0;
+    for (uint32_t pass = 0; pass < 2 && resIndex < MOS_OCA_SUBMISSION_MAX_RES_COUNT; ++pass)
+    {
+        for (uint32_t i = 0; i < m_numAllocations && resIndex < MOS_OCA_SUBMISSION_MAX_RES_COUNT; ++i)
+        {
+            auto resource = (PMOS_RESOURCE)m_allocationList[i].hAllocation;
+            if (resource == nullptr || resource->bo == nullptr || (m_allocationList[i].WriteOperation != 0) != (pass == 0))
+            {
+                continue;
+            }
+            record.resGfxAddress[resIndex++] = resource->bo->offset64;
+        }
+    }
+    record.resCount = m_numAllocations;
+
+    MosOcaSubmissionHistory::GetInstance().Record(m_historyRing, record);
+}
+
 int32_t GpuContextSpecificNext::SubmitPipeCommands(
     MOS_COMMAND_BUFFER *cmdBuffer,
     MOS_LINUX_BO *cmdBo,
@@ -213,7 +213,8 @@ protected:
 
     uint32_t GetVcsExecFlag(
         PMOS_COMMAND_BUFFER cmdBuffer,
-        MOS_GPU_NODE gpuNode);
+        MOS_GPU_NODE gpuNode,
+        bool loadAware);
 
     //!
     //! \brief    Submit command buffer for single pipe in scalability mode
@@ -252,6 +253,27 @@ protected:
     MOS_STATUS ReportMemoryInfo(
         struct mos_bufmgr *bufmgr);
 
+    //!
+    //! \brief    Record the submission to submission history for gpu hang analysis
+    //! \param    [in] streamState
+    //!           Stream state of the submission
+    //! \param    [in] cmdBuffer
+    //!           Primary command buffer
+    //! \param    [in] gpuNode
+    //!           Gpu node of the context
+    //! \param    [in] perfTag
+    //!           Perf tag passed to kernel with the submission
+    //! \param    [in] result
+    //!           Return value of submission
+    //! \return   void
+    //!
+    void RecordSubmissionHistory(
+        MOS_STREAM_HANDLE   streamState,
+        PMOS_COMMAND_BUFFER cmdBuffer,
+        MOS_GPU_NODE        gpuNode,
+        int32_t             perfTag,
+        int32_t             result);
+
 #if (_DEBUG || _RELEASE_INTERNAL)
     MOS_LINUX_BO* GetNopCommandBuffer(
         MOS_STREAM_HANDLE streamState);
@@ -309,6 +331,7 @@ private:
     uint32_t     m_i915ExecFlag = 0;
     int32_t      m_currCtxPriority = 0;
     bool m_ocaLogSectionSupported = true;
+    int32_t m_historyRing = MOS_OCA_INVALID_HISTORY_RING;  //!< Ring of submission history
     // bool m_ocaSizeIncreaseDone = false;
 
 #if (_DEBUG || _RELEASE_INTERNAL)
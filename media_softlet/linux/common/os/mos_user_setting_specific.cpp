@@ -36,6 +36,13 @@ MOS_STATUS MosUserSetting::InitMosUserSettingSpecific(MediaUserSettingSharedPtr
         1,
         true); //"Switch between softpin and relocation."
 
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_ENABLE_INDEXED_VMA_HEAP,
+        MediaUserSetting::Group::Device,
+        0,
+        true); //"Allocate softpin addresses from holes indexed by size and address instead of the hole list."
+
 #if (_DEBUG || _RELEASE_INTERNAL)
     DeclareUserSettingKeyForDebug(
         userSettingPtr,
@@ -0,0 +1,239 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_vdbox_scheduler_specific.cpp
+//! \brief    Process wide load aware VDBox scheduler for linux
+//!
+
+#include "mos_vdbox_scheduler_specific.h"
+#include "mos_utilities.h"
+#include "mos_util_debug.h"
+
+MosVdboxScheduler &MosVdboxScheduler::Instance()
+{
+    static MosVdboxScheduler scheduler;
+    return scheduler;
+}
+
+void MosVdboxScheduler::Retire(uint64_t now)
+{
+    for (auto &engine : m_engines)
+    {
+        // Each VDBox ring executes in submission order, so the completed ones are at the front
+        uint32_t completed = 0;
+        while (completed < engine.inFlight.size() && !mos_bo_busy(engine.inFlight[completed].cmdBo))
+        {
+            completed++;
+        }
+
+        if (completed > 0)
+        {
+            // Completion is only observed at polling time. The completed batches ran one after
+            // another since the previous completion or the first submission, whichever is later,
+            // so the interval is charged evenly across them.
+            uint64_t start    = MOS_MAX(engine.inFlight.front().submitTime, engine.lastCompleteTime);
+            uint64_t interval = (now > start) ? (now - start) : 0;
+            uint64_t duration = interval / completed;
+
+            engine.stats.busyTime += interval;
+            engine.lastCompleteTime = now;
+
+            for (uint32_t i = 0; i < completed; i++)
+            {
+                engine.stats.avgBatchTime = (engine.stats.avgBatchTime * 7 + duration) / 8;
+                mos_bo_unreference(engine.inFlight.front().cmdBo);
+                engine.inFlight.pop_front();
+            }
+        }
+        engine.stats.inFlight = (uint32_t)engine.inFlight.size();
+    }
+}
+
+uint64_t MosVdboxScheduler::GetPendingLoad(uint32_t index)
+{
+    Engine &engine = m_engines[index];
+    return engine.inFlight.size() * engine.stats.avgBatchTime;
+}
+
+uint32_t MosVdboxScheduler::SelectLeastLoaded(const uint32_t *tieBreaker)
+{
+    uint64_t load0 = GetPendingLoad(0);
+    uint64_t load1 = GetPendingLoad(1);
+
+    uint32_t index = 0;
+    if (load0 != load1)
+    {
+        index = (load0 < load1) ? 0 : 1;
+    }
+    else if (tieBreaker != nullptr && tieBreaker[0] != tieBreaker[1])
+    {
+        index = (tieBreaker[0] < tieBreaker[1]) ? 0 : 1;
+    }
+    else
+    {
+        index       = m_nextIndex;
+        m_nextIndex = (m_nextIndex + 1) % m_maxVdboxNum;
+    }
+    return index;
+}
+
+MOS_GPU_NODE MosVdboxScheduler::SelectSessionNode(const uint32_t sessionCount[m_maxVdboxNum])
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Retire(GetCurTime());
+
+    // Sessions of other processes are not visible by load, so session counts decide
+    // when the difference is large enough to dominate the load of this process.
+    uint32_t index = SelectLeastLoaded(sessionCount);
+    if (sessionCount != nullptr && sessionCount[index] > sessionCount[1 - index] + 1)
+    {
+        index = 1 - index;
+    }
+
+    m_engines[index].stats.sessions++;
+    return (index == 0) ? MOS_GPU_NODE_VIDEO : MOS_GPU_NODE_VIDEO2;
+}
+
+void MosVdboxScheduler::AddSession(MOS_GPU_NODE node)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint32_t index = (node == MOS_GPU_NODE_VIDEO2) ? 1 : 0;
+    m_engines[index].stats.sessions++;
+}
+
+void MosVdboxScheduler::RemoveSession(MOS_GPU_NODE node)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint32_t index = (node == MOS_GPU_NODE_VIDEO2) ? 1 : 0;
+    if (m_engines[index].stats.sessions > 0)
+    {
+        m_engines[index].stats.sessions--;
+    }
+}
+
+MOS_VDBOX_NODE_IND MosVdboxScheduler::SelectCmdBufferNode()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Retire(GetCurTime());
+
+    uint32_t sessions[m_maxVdboxNum] = {m_engines[0].stats.sessions, m_engines[1].stats.sessions};
+    uint32_t index = SelectLeastLoaded(sessions);
+    return (index == 0) ? MOS_VDBOX_NODE_1 : MOS_VDBOX_NODE_2;
+}
+
+void MosVdboxScheduler::OnSubmit(void *owner, MOS_VDBOX_NODE_IND node, MOS_LINUX_BO *cmdBo)
+{
+    if (cmdBo == nullptr || (node != MOS_VDBOX_NODE_1 && node != MOS_VDBOX_NODE_2))
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint64_t now = GetCurTime();
+    Retire(now);
+
+    Engine &engine = m_engines[node == MOS_VDBOX_NODE_1 ? 0 : 1];
+    if (engine.stats.submissions == 0)
+    {
+        engine.firstSubmitTime     = now;
+        engine.stats.avgBatchTime  = m_defaultBatchTime;
+    }
+
+    // Hold the bo, which may be released by its owner before completion is polled
+    mos_bo_reference(cmdBo);
+
+    Submission submission;
+    submission.owner      = owner;
+    submission.cmdBo      = cmdBo;
+    submission.submitTime = now;
+    engine.inFlight.push_back(submission);
+
+    engine.stats.submissions++;
+    engine.stats.inFlight = (uint32_t)engine.inFlight.size();
+}
+
+void MosVdboxScheduler::RemoveOwner(void *owner)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto &engine : m_engines)
+    {
+        for (auto it = engine.inFlight.begin(); it != engine.inFlight.end();)
+        {
+            if (it->owner == owner)
+            {
+                mos_bo_unreference(it->cmdBo);
+                it = engine.inFlight.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        engine.stats.inFlight = (uint32_t)engine.inFlight.size();
+    }
+}
+
+MOS_STATUS MosVdboxScheduler::GetEngineStats(MOS_VDBOX_NODE_IND node, EngineStats &stats)
+{
+    if (node != MOS_VDBOX_NODE_1 && node != MOS_VDBOX_NODE_2)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint64_t now = GetCurTime();
+    Retire(now);
+
+    Engine &engine = m_engines[node == MOS_VDBOX_NODE_1 ? 0 : 1];
+    stats = engine.stats;
+
+    uint64_t elapsed = (engine.stats.submissions > 0 && now > engine.firstSubmitTime) ? (now - engine.firstSubmitTime) : 0;
+    stats.utilization = elapsed ? (uint32_t)MOS_MIN(100, engine.stats.busyTime * 100 / elapsed) : 0;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+void MosVdboxScheduler::ReportEngineStats()
+{
+    for (uint32_t i = 0; i < m_maxVdboxNum; i++)
+    {
+        EngineStats stats;
+        if (GetEngineStats(i == 0 ? MOS_VDBOX_NODE_1 : MOS_VDBOX_NODE_2, stats) == MOS_STATUS_SUCCESS)
+        {
+            MOS_OS_NORMALMESSAGE("VDBox%d: sessions %d, in flight %d, submissions %lld, busy %lld us, avg batch %lld us, utilization %d%%",
+                i + 1, stats.sessions, stats.inFlight, (long long)stats.submissions, (long long)stats.busyTime,
+                (long long)stats.avgBatchTime, stats.utilization);
+        }
+    }
+}
+
+uint64_t MosVdboxScheduler::GetCurTime()
+{
+    return MosUtilities::MosGetCurTime();
+}
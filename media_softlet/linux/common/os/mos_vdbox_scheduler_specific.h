@@ -0,0 +1,182 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_vdbox_scheduler_specific.h
+//! \brief    Process wide load aware VDBox scheduler for linux
+//! \details  The scheduler tracks the command buffers in flight on each VDBox ring
+//!           and the time they take to complete, and places new sessions and
+//!           unbound command buffers on the least loaded VDBox.
+//!
+
+#ifndef __MOS_VDBOX_SCHEDULER_SPECIFIC_H__
+#define __MOS_VDBOX_SCHEDULER_SPECIFIC_H__
+
+#include <deque>
+#include <mutex>
+#include "mos_defs.h"
+#include "mos_os.h"
+
+class MosVdboxScheduler
+{
+public:
+    static const uint32_t m_maxVdboxNum = 2;    //!< VDBox rings addressable by exec flags
+
+    //!
+    //! \brief  Utilization counters of one VDBox
+    //!
+    struct EngineStats
+    {
+        uint32_t sessions     = 0;  //!< Sessions of this process bound to the engine
+        uint32_t inFlight     = 0;  //!< Command buffers submitted and not completed yet
+        uint64_t submissions  = 0;  //!< Total command buffers submitted
+        uint64_t busyTime     = 0;  //!< Accumulated busy time in us
+        uint64_t avgBatchTime = 0;  //!< Moving average of command buffer execution time in us
+        uint32_t utilization  = 0;  //!< Busy time percentage since first submission
+    };
+
+    //!
+    //! \brief  Get the process wide scheduler
+    //! \return MosVdboxScheduler &
+    //!
+    static MosVdboxScheduler &Instance();
+
+    //!
+    //! \brief  Select VDBox for a new session and bind the session to it
+    //! \param  [in] sessionCount
+    //!         Sessions bound to each VDBox, including other processes, used as tie breaker
+    //! \return MOS_GPU_NODE
+    //!         MOS_GPU_NODE_VIDEO or MOS_GPU_NODE_VIDEO2
+    //!
+    MOS_GPU_NODE SelectSessionNode(const uint32_t sessionCount[m_maxVdboxNum]);
+
+    //!
+    //! \brief  Bind a session to given VDBox
+    //! \param  [in] node
+    //!         MOS_GPU_NODE_VIDEO or MOS_GPU_NODE_VIDEO2
+    //! \return void
+    //!
+    void AddSession(MOS_GPU_NODE node);
+
+    //!
+    //! \brief  Unbind a session from given VDBox
+    //! \param  [in] node
+    //!         MOS_GPU_NODE_VIDEO or MOS_GPU_NODE_VIDEO2
+    //! \return void
+    //!
+    void RemoveSession(MOS_GPU_NODE node);
+
+    //!
+    //! \brief  Select VDBox for a command buffer not tied to any VDBox
+    //! \return MOS_VDBOX_NODE_IND
+    //!         MOS_VDBOX_NODE_1 or MOS_VDBOX_NODE_2
+    //!
+    MOS_VDBOX_NODE_IND SelectCmdBufferNode();
+
+    //!
+    //! \brief  Track a command buffer submitted to VDBox
+    //! \param  [in] owner
+    //!         Owner of the submission, used to drop its entries on destroy
+    //! \param  [in] node
+    //!         VDBox the command buffer is submitted to
+    //! \param  [in] cmdBo
+    //!         Command buffer bo, completion of which is polled
+    //! \return void
+    //!
+    void OnSubmit(void *owner, MOS_VDBOX_NODE_IND node, MOS_LINUX_BO *cmdBo);
+
+    //!
+    //! \brief  Drop the submissions tracked for owner
+    //! \param  [in] owner
+    //!         Owner of the submissions
+    //! \return void
+    //!
+    void RemoveOwner(void *owner);
+
+    //!
+    //! \brief  Get utilization counters of VDBox
+    //! \param  [in] node
+    //!         MOS_VDBOX_NODE_1 or MOS_VDBOX_NODE_2
+    //! \param  [out] stats
+    //!         Utilization counters
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS GetEngineStats(MOS_VDBOX_NODE_IND node, EngineStats &stats);
+
+    //!
+    //! \brief  Print utilization counters of all VDBoxes to the debug log
+    //! \return void
+    //!
+    void ReportEngineStats();
+
+protected:
+    MosVdboxScheduler() {}
+    virtual ~MosVdboxScheduler() {}
+
+    struct Submission
+    {
+        void         *owner      = nullptr;
+        MOS_LINUX_BO *cmdBo      = nullptr;
+        uint64_t     submitTime  = 0;
+    };
+
+    struct Engine
+    {
+        std::deque<Submission> inFlight;
+        EngineStats            stats;
+        uint64_t               firstSubmitTime    = 0;
+        uint64_t               lastCompleteTime   = 0;
+    };
+
+    //!
+    //! \brief  Retire completed submissions, m_mutex must be held
+    //! \param  [in] now
+    //!         Current time in us
+    //! \return void
+    //!
+    void Retire(uint64_t now);
+
+    //!
+    //! \brief  Estimated time in us to drain the submissions in flight, m_mutex must be held
+    //!
+    uint64_t GetPendingLoad(uint32_t index);
+
+    //!
+    //! \brief  Index of least loaded VDBox, m_mutex must be held
+    //!
+    uint32_t SelectLeastLoaded(const uint32_t *tieBreaker);
+
+    //!
+    //! \brief  Current time in us
+    //!
+    virtual uint64_t GetCurTime();
+
+    static const uint64_t m_defaultBatchTime = 1000;   //!< Assumed execution time in us before any completion observed
+
+    std::mutex m_mutex;
+    Engine     m_engines[m_maxVdboxNum];
+    uint32_t   m_nextIndex = 0;                        //!< Round robin index for equal loads
+
+MEDIA_CLASS_DEFINE_END(MosVdboxScheduler)
+};
+
+#endif // __MOS_VDBOX_SCHEDULER_SPECIFIC_H__
@@ -2135,7 +2135,21 @@ MOS_STATUS MosUtilities::MosLockMutex(PMOS_MUTEX pMutex)
 
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
 
-    if (pthread_mutex_lock(pMutex))
+    if (!m_mosCostAccounting)
+    {
+        return pthread_mutex_lock(pMutex) ? MOS_STATUS_UNKNOWN : MOS_STATUS_SUCCESS;
+    }
+
+    // Uncontended locks take the trylock path, only contended ones pay for the timing
+    int32_t ret = pthread_mutex_trylock(pMutex);
+    if (ret == EBUSY)
+    {
+        uint64_t start = MosGetCurTime();
+        ret            = pthread_mutex_lock(pMutex);
+        MosLockContended(MosGetCurTime() - start);
+    }
+
+    if (ret)
     {
         eStatus = MOS_STATUS_UNKNOWN;
     }
@@ -2143,6 +2157,12 @@ MOS_STATUS MosUtilities::MosLockMutex(PMOS_MUTEX pMutex)
     return eStatus;
 }
 
+void MosUtilities::MosLockContended(uint64_t waitTime)
+{
+    MosAtomicIncrement(&m_mosLockContentionCounter);
+    __atomic_fetch_add(&m_mosLockWaitTime, waitTime, __ATOMIC_RELAXED);
+}
+
 MOS_STATUS MosUtilities::MosUnlockMutex(PMOS_MUTEX pMutex)
 {
     MOS_OS_CHK_NULL_RETURN(pMutex);
@@ -184,6 +184,26 @@ void HalOcaInterfaceNext::On1stLevelBBEnd(MOS_COMMAND_BUFFER &cmdBuffer, MOS_INT
 void HalOcaInterfaceNext::OnSubLevelBBStart(MOS_COMMAND_BUFFER &cmdBuffer, MOS_CONTEXT &mosContext, void *pMosResource, uint32_t offsetOfSubLevelBB, bool bUseSizeOfResource, uint32_t sizeOfSubLevelBB)
 {
     MosInterface::SetObjectCapture((PMOS_RESOURCE)pMosResource);
+
+    MosOcaInterface         *pOcaInterface  = &MosOcaInterfaceSpecific::GetInstance();
+    MOS_OCA_BUFFER_HANDLE   ocaBufHandle    = 0;
+    MOS_STATUS              status          = MOS_STATUS_SUCCESS;
+
+    if (nullptr == pOcaInterface || !((MosOcaInterfaceSpecific*)pOcaInterface)->IsOcaEnabled())
+    {
+        return;
+    }
+    if ((ocaBufHandle = GetOcaBufferHandle(cmdBuffer, mosContext)) == MOS_OCA_INVALID_BUFFER_HANDLE)
+    {
+        // May come here for workloads not enabling UMD_OCA.
+        return;
+    }
+
+    status = pOcaInterface->OnSubLevelBBStart(ocaBufHandle, &mosContext, pMosResource, offsetOfSubLevelBB, bUseSizeOfResource, sizeOfSubLevelBB);
+    if (MOS_FAILED(status))
+    {
+        OnOcaError(&mosContext, status, __FUNCTION__, __LINE__);
+    }
 }
 
 //!
@@ -206,6 +226,26 @@ void HalOcaInterfaceNext::OnSubLevelBBStart(MOS_COMMAND_BUFFER &cmdBuffer, MOS_C
 void HalOcaInterfaceNext::OnIndirectState(MOS_COMMAND_BUFFER &cmdBuffer, MOS_CONTEXT &mosContext, void *pMosResource, uint32_t offsetOfIndirectState, bool bUseSizeOfResource, uint32_t sizeOfIndirectState)
 {
     MosInterface::SetObjectCapture((PMOS_RESOURCE)pMosResource);
+
+    MosOcaInterface         *pOcaInterface  = &MosOcaInterfaceSpecific::GetInstance();
+    MOS_OCA_BUFFER_HANDLE   ocaBufHandle    = 0;
+    MOS_STATUS              status          = MOS_STATUS_SUCCESS;
+
+    if (nullptr == pOcaInterface || !((MosOcaInterfaceSpecific*)pOcaInterface)->IsOcaEnabled())
+    {
+        return;
+    }
+    if ((ocaBufHandle = GetOcaBufferHandle(cmdBuffer, mosContext)) == MOS_OCA_INVALID_BUFFER_HANDLE)
+    {
+        // May come here for workloads not enabling UMD_OCA.
+        return;
+    }
+
+    status = pOcaInterface->OnIndirectState(ocaBufHandle, &mosContext, pMosResource, offsetOfIndirectState, bUseSizeOfResource, sizeOfIndirectState);
+    if (MOS_FAILED(status))
+    {
+        OnOcaError(&mosContext, status, __FUNCTION__, __LINE__);
+    }
 }
 
 //!